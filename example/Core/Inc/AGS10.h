@@ -15,6 +15,10 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /*******************************************************************************
 * Defines
  ******************************************************************************/
@@ -26,55 +30,337 @@
 #define AGS10MA_GAS_RES_REG        0x20
 #define AGS10MA_SET_ADDR_REG       0x21
 #define AGS10MA_DATA_LEN           4U
+#define AGS10MA_FRAME_LEN          (AGS10MA_DATA_LEN + 1U)
+
+#define AGS10MA_TVOC_DELAY_MS      1000U
+#define AGS10MA_VERSION_DELAY_MS   30U
+#define AGS10MA_ACCESS_DELAY_MS    30U     /**< Minimum pointer write to read. */
+#define AGS10MA_XFER_TIMEOUT_MS    100U    /**< Longest an async transfer may stay in flight. */
+
+#define AGS10MA_STATUS_RDY_MSK     0x01U   /**< Set: no new data since last read. */
+#define AGS10MA_STATUS_CH_MSK      0x0EU   /**< Unit, 000b = ppb. */
+#define AGS10MA_TVOC_MSK           0xFFFFFFU
+
+#define AGS10MA_TVOC_POLL_MIN_MS   AGS10MA_ACCESS_DELAY_MS
+#define AGS10MA_TVOC_POLL_MAX_MS   500U
+
+#define AGS10MA_CRC8_POLYNOMIAL    0x31U
+#define AGS10MA_CRC8_INIT          0xFFU
+
+/*
+ * CRC-8 engine used by ags10_crc8(). All engines give bit-identical results,
+ * they only trade flash for speed:
+ *   AGS10_CRC8_ENGINE_BITWISE : no table, 8 shift steps per byte
+ *   AGS10_CRC8_ENGINE_NIBBLE  : 16 byte table, 2 lookups per byte
+ *   AGS10_CRC8_ENGINE_TABLE   : 256 byte table, 1 lookup per byte
+ *   AGS10_CRC8_ENGINE_SLICE4  : 1 KiB of tables, 4 bytes per step (hosts)
+ */
+#define AGS10_CRC8_ENGINE_BITWISE  0
+#define AGS10_CRC8_ENGINE_NIBBLE   1
+#define AGS10_CRC8_ENGINE_TABLE    2
+#define AGS10_CRC8_ENGINE_SLICE4   3
+
+#ifndef AGS10_CRC8_ENGINE
+#define AGS10_CRC8_ENGINE          AGS10_CRC8_ENGINE_NIBBLE
+#endif
+
+/*
+ * Per-handle fault counters, see AGS10_StatsTypeDef. With 0 the counters,
+ * their storage in the handle and ags10_stats_get()/ags10_stats_reset() are
+ * compiled out entirely.
+ */
+#ifndef AGS10_STATS_ENABLE
+#define AGS10_STATS_ENABLE         0
+#endif
+
+/*
+ * Per-phase timing of register reads, see ags10_prof.h. With 0 the
+ * instrumentation points expand to nothing.
+ */
+#ifndef AGS10_PROF_ENABLE
+#define AGS10_PROF_ENABLE          0
+#endif
 /*******************************************************************************/
 
+/*******************************************************************************
+* Status Codes
+ ******************************************************************************/
+/**
+ * @brief Result of a driver call or a bus operation.
+ * 
+ * Bus operations report AGS10_ERR_NACK without a direction; the driver
+ * turns it into AGS10_ERR_NACK_WRITE or AGS10_ERR_NACK_READ depending on
+ * which transfer was refused. A NACK on the write usually means no device
+ * at that address, a NACK on the read a device still busy converting.
+ */
+typedef enum {
+    AGS10_OK = 0,
+    AGS10_ERR_PARAM,        /**< Invalid argument or no transaction started. */
+    AGS10_ERR_BUSY,         /**< Bus busy, or a transaction already running on the handle. */
+    AGS10_ERR_NACK,         /**< Not acknowledged (bus operations only). */
+    AGS10_ERR_NACK_WRITE,   /**< Register pointer or command write not acknowledged. */
+    AGS10_ERR_NACK_READ,    /**< Frame read not acknowledged. */
+    AGS10_ERR_CRC,          /**< Frame received with a bad checksum. */
+    AGS10_ERR_TIMEOUT,      /**< Transfer did not finish in time. */
+    AGS10_ERR_BUS,          /**< Arbitration loss or another bus fault. */
+} AGS10_StatusTypeDef;
+
 /*******************************************************************************
 * I/O Functions to be implemented by the user
  *******************************************************************************/
 
-/**
- * @brief Write data to the AGS10 device via I2C.
- * 
- * This function transmits a data buffer to the AGS10 sensor at the specified
- * I2C address.
- * 
- * @param[in] addr  I2C address of the AGS10 device.
- * @param[in] pData Pointer to the data buffer to send.
- * @param[in] length Number of bytes to transmit.
- * 
- * @retval true  Data written successfully.
- * @retval false Write operation failed.
+/*
+ * Bus access is resolved per handle, so one image can drive sensors on
+ * several buses. Each handle carries a table of bus operations and an opaque
+ * context pointer (e.g. an I2C_HandleTypeDef * or a Linux file descriptor
+ * wrapper) that is passed back on every call.
+ *
+ * Static dispatch: when AGS10_STATIC_BUS_HEADER names a header (for example
+ * -DAGS10_STATIC_BUS_HEADER='"ags10_bus_i2c2.h"'), that header is included
+ * by ags10.c and must provide the three functions below as static inline
+ * definitions. The driver then calls them directly so the compiler can
+ * inline the I/O, and the handle's bus ops table is ignored.
+ *
+ *   static inline AGS10_StatusTypeDef ags10_bus_write(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length);
+ *   static inline AGS10_StatusTypeDef ags10_bus_read(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length);
+ *   static inline void ags10_bus_delay(void *p_ctx, uint16_t ms);
+ *
+ * An asynchronous static bus also defines AGS10_STATIC_BUS_ASYNC and
+ *
+ *   static inline AGS10_BusXferTypeDef ags10_bus_xfer_state(void *p_ctx);
+ *
+ * and one with a millisecond tick defines AGS10_STATIC_BUS_TICK and
+ *
+ *   static inline uint32_t ags10_bus_get_tick_ms(void *p_ctx);
+ *
+ * Asynchronous buses (DMA, interrupt): write and read only start the
+ * transfer and return AGS10_OK once it is queued. The buffer must stay valid
+ * until the transfer ends; the driver only passes buffers that live in the
+ * handle or that it waits on. Completion is reported through xfer_state,
+ * which the back end typically updates from its ISR callbacks. Such buses
+ * are driven with ags10_register_read_poll(); the blocking API also works
+ * and waits in 1 ms delay steps.
  */
-bool AGS10_IO_Write(uint8_t addr, uint8_t *pData, uint16_t length);
 
 /**
- * @brief Read data from the AGS10 device via I2C.
- * 
- * This function reads data from the AGS10 sensor at the specified I2C address
- * and stores it in the provided buffer.
- * 
- * @param addr  I2C address of the AGS10 device.
- * @param pData Pointer to the buffer where received data will be stored.
- * @param length Number of bytes to read.
- * 
- * @retval true  Data read successfully.
- * @retval false Read operation failed.
+ * @brief Progress of the last transfer started on an asynchronous bus.
  */
-bool AGS10_IO_Read(uint8_t addr, uint8_t *pData, uint16_t length);
+typedef enum {
+    AGS10_BUS_XFER_DONE = 0,    /**< Finished, ACKed. */
+    AGS10_BUS_XFER_BUSY,        /**< Still clocking. */
+    AGS10_BUS_XFER_ERROR,       /**< Arbitration loss or bus error. */
+    AGS10_BUS_XFER_NACK,        /**< Address or data not acknowledged. */
+} AGS10_BusXferTypeDef;
 
 /**
- * @brief  Delay in milliseconds.
- * @param  ms: delay duration
+ * @brief Bus operations used by a sensor handle.
  */
-void AGS10_IO_Delay(uint16_t ms);
+typedef struct {
+    /**
+     * @brief Write data to the AGS10 device via I2C.
+     * 
+     * @param[in] p_ctx  Bus context given to ags10_init().
+     * @param[in] addr   I2C address of the AGS10 device.
+     * @param[in] pData  Pointer to the data buffer to send.
+     * @param[in] length Number of bytes to transmit.
+     * 
+     * @retval AGS10_OK          Data written (or, asynchronous, transfer queued).
+     * @retval AGS10_ERR_NACK    Address or data not acknowledged.
+     * @retval AGS10_ERR_BUSY    Bus still occupied.
+     * @retval AGS10_ERR_TIMEOUT Transfer did not finish in time.
+     * @retval AGS10_ERR_BUS     Any other bus fault.
+     */
+    AGS10_StatusTypeDef (*write)(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length);
+
+    /**
+     * @brief Read data from the AGS10 device via I2C.
+     * 
+     * @param[in]  p_ctx  Bus context given to ags10_init().
+     * @param[in]  addr   I2C address of the AGS10 device.
+     * @param[out] pData  Pointer to the buffer where received data will be stored.
+     * @param[in]  length Number of bytes to read.
+     * 
+     * @return Same codes as write.
+     */
+    AGS10_StatusTypeDef (*read)(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length);
+
+    /**
+     * @brief Delay in milliseconds, used by the blocking API only.
+     * 
+     * @param[in] p_ctx Bus context given to ags10_init().
+     * @param[in] ms    Delay duration.
+     */
+    void (*delay)(void *p_ctx, uint16_t ms);
+
+    /**
+     * @brief State of the last write/read, for asynchronous buses only.
+     * 
+     * Leave NULL for buses whose write and read return when the transfer
+     * has finished.
+     * 
+     * @param[in] p_ctx Bus context given to ags10_init().
+     * 
+     * @return Progress of the last transfer started through this context.
+     */
+    AGS10_BusXferTypeDef (*xfer_state)(void *p_ctx);
+
+    /**
+     * @brief Free-running millisecond tick, optional.
+     * 
+     * Only used to timestamp errors in AGS10_StatsTypeDef when the blocking
+     * API has no tick of its own; may be NULL.
+     * 
+     * @param[in] p_ctx Bus context given to ags10_init().
+     * 
+     * @return Millisecond tick, e.g. HAL_GetTick().
+     */
+    uint32_t (*get_tick_ms)(void *p_ctx);
+
+    /**
+     * @brief Address-only probe, optional, used by ags10_scan.
+     *
+     * Sends the address and a STOP without any data and returns once the
+     * acknowledge is known, also on asynchronous buses. May be NULL, then
+     * the scan sends a zero-length write instead, which i2c-dev supports
+     * but not every MCU driver does.
+     *
+     * @param[in] p_ctx Bus context given to ags10_init().
+     * @param[in] addr  I2C address to probe.
+     *
+     * @retval AGS10_OK       Address acknowledged.
+     * @retval AGS10_ERR_NACK Nothing answered.
+     * @return Otherwise the same codes as write.
+     */
+    AGS10_StatusTypeDef (*probe)(void *p_ctx, uint8_t addr);
+
+    /**
+     * @brief Send a transfer the bus holds back, optional.
+     *
+     * For buses that may keep a write back to merge it with the next read,
+     * such as the Linux back end in combine mode. The driver calls it after
+     * the pointer write of a read with a conversion delay, so that the wait
+     * starts with the pointer on the wire. May be NULL for buses that send
+     * every transfer at once; the static bus never holds one back.
+     *
+     * @param[in] p_ctx Bus context given to ags10_init().
+     *
+     * @return AGS10_OK if nothing was held back, else the held-back
+     *         transfer's result, same codes as write.
+     */
+    AGS10_StatusTypeDef (*flush)(void *p_ctx);
+} AGS10_BusOpsTypeDef;
 
 /*******************************************************************************
 * Structs
  ******************************************************************************/
+/**
+ * @brief State of a split-phase register read.
+ */
+typedef enum {
+    AGS10_XFER_IDLE = 0,    /**< No transaction in progress. */
+    AGS10_XFER_WRITING,     /**< Register pointer being sent (async buses). */
+    AGS10_XFER_CONVERTING,  /**< Register pointer sent, waiting for the sensor. */
+    AGS10_XFER_READY,       /**< Wait elapsed, frame can be collected. */
+    AGS10_XFER_READING,     /**< Frame being received (async buses). */
+    AGS10_XFER_FAILED,      /**< A transfer failed, collect to return to idle. */
+    AGS10_XFER_BACKOFF,     /**< An attempt failed, waiting to retry it. */
+} AGS10_XferStateTypeDef;
+
+/**
+ * @brief Result of advancing a split-phase read.
+ */
+typedef enum {
+    AGS10_XFER_PENDING = 0, /**< Not finished yet, poll again later. */
+    AGS10_XFER_DONE,        /**< Value read and CRC verified. */
+    AGS10_XFER_ERROR,       /**< Transfer or CRC failed, handle is idle again. */
+} AGS10_XferResultTypeDef;
+
+/**
+ * @brief How a handle retries a failed register read.
+ * 
+ * A failed pointer write is always sent again. A failed frame read (NACK or
+ * CRC mismatch) either re-reads the 5 bytes straight away, since the sensor
+ * keeps its register pointer, or starts over with the pointer and the full
+ * conversion wait. Retries happen in ags10_register_read_poll() and the
+ * blocking API, and for the pointer write in ags10_register_read_ready();
+ * ags10_register_read_finish() has no clock and does not retry.
+ */
+typedef struct {
+    uint8_t max_attempts;       /**< Tries per read including the first, 1 = no retry. */
+    bool reread;                /**< Failed frame reads re-read without the pointer. */
+    uint16_t backoff_ms;        /**< Wait before the first retry, doubled for each further one. */
+    uint16_t backoff_max_ms;    /**< Upper bound of the wait. */
+} AGS10_RetryPolicyTypeDef;
+
+/**
+ * @brief Fault counters of one sensor, with AGS10_STATS_ENABLE only.
+ * 
+ * Every counter wraps at 2^32. A transaction is one register read or
+ * address write. The failure counters count every failed attempt, retried
+ * or not, so the successful transactions are
+ * transactions - (nack_write + nack_read + crc_fail + timeout + bus_error - retries).
+ */
+typedef struct {
+    uint32_t transactions;  /**< Transactions started. */
+    uint32_t nack_write;    /**< Pointer or command write not acknowledged. */
+    uint32_t nack_read;     /**< Frame read not acknowledged. */
+    uint32_t crc_fail;      /**< Frames with a bad checksum. */
+    uint32_t timeout;       /**< Transfers that did not finish in time. */
+    uint32_t bus_error;     /**< Bus busy or other bus faults. */
+    uint32_t retries;       /**< Failed attempts that were tried again. */
+    uint32_t rescued;       /**< Transactions that succeeded only after a retry. */
+    uint32_t last_error_ms; /**< Tick of the last failure (0 without a tick source). */
+    uint8_t last_error;     /**< AGS10_StatusTypeDef of the last failure. */
+} AGS10_StatsTypeDef;
+
 typedef struct {
     uint8_t i2c_addr;
+
+    const AGS10_BusOpsTypeDef *p_bus_ops;
+    void *p_bus_ctx;
+
+    /* Split-phase read bookkeeping, owned by the driver. */
+    uint8_t xfer_reg;
+    uint8_t xfer_state;
+    uint16_t xfer_delay_ms;
+    uint32_t xfer_start_ms;
+    uint32_t xfer_io_ms;    /**< Tick the transfer in flight was issued at. */
+    uint8_t xfer_frame[AGS10MA_FRAME_LEN];  /**< Receive buffer, DMA target. */
+    uint8_t last_status;    /**< AGS10_StatusTypeDef of the last finished transaction. */
+    uint8_t xfer_attempt;   /**< Retries made so far. */
+    bool xfer_reread;       /**< The pending retry only re-reads the frame. */
+    uint16_t xfer_backoff_ms;
+
+    AGS10_RetryPolicyTypeDef retry;
+
+    /* Readiness-driven TVOC polling, see ags10_tvoc_poll(). */
+    uint32_t tvoc_next_ms;
+    uint32_t tvoc_fresh_ms;
+    uint32_t tvoc_stale_ms;
+    uint16_t tvoc_period_ms;
+    uint16_t tvoc_backoff_ms;
+    uint8_t tvoc_flags;
+
+#if AGS10_STATS_ENABLE
+    AGS10_StatsTypeDef stats;
+#endif
+
+#if AGS10_PROF_ENABLE
+    uint32_t prof_mark;     /**< Start of the phase being timed. */
+#endif
 } AGS10_HandleTypeDef;
 
+/**
+ * @brief A decoded status + TVOC frame.
+ */
+typedef struct {
+    uint32_t tvoc_ppb;      /**< TVOC value, 24 bits. */
+    uint8_t status;         /**< Raw status byte. */
+    bool fresh;             /**< RDY clear: a new value since the last read. */
+    bool preheating;        /**< No fresh value seen yet, sensor still warming up. */
+    uint32_t age_ms;        /**< Time since the last fresh value, UINT32_MAX if none. */
+} AGS10_TvocSampleTypeDef;
+
 /*******************************************************************************
 * Public Function Declaration
  ******************************************************************************/
@@ -84,14 +370,18 @@ typedef struct {
  * 
  * @param ph_sensor A handle to indicate sensor ID.
  * @param i2c_addr I2C address of gas sensor device.
+ * @param p_bus_ops Bus operations for the bus the sensor sits on. May be NULL
+ *                  when AGS10_STATIC_BUS_HEADER is used.
+ * @param p_bus_ctx User context passed back to every bus operation.
  * 
- * @return true : Initialization successful.
- * @return false : Initialization fail.
- *                 Possible causes: null arguments
+ * @retval AGS10_OK        Initialization successful.
+ * @retval AGS10_ERR_PARAM Null arguments.
  * 
  */
-bool ags10_init(AGS10_HandleTypeDef *ph_sensor, 
-                uint8_t i2c_addr);
+AGS10_StatusTypeDef ags10_init(AGS10_HandleTypeDef *ph_sensor, 
+                               uint8_t i2c_addr,
+                               const AGS10_BusOpsTypeDef *p_bus_ops,
+                               void *p_bus_ctx);
 
 /**
  * @brief Read a register value from the AGS10 sensor.
@@ -103,13 +393,145 @@ bool ags10_init(AGS10_HandleTypeDef *ph_sensor,
  * @param delayms Delay in milliseconds before reading (for sensor readiness).
  * @param p_value Pointer to store the read register value.
  * 
- * @retval true  Register read successful.
- * @retval false Read failed or invalid arguments.
+ * @retval AGS10_OK Register read successful.
+ * @return Otherwise the reason of the failure, see AGS10_StatusTypeDef.
+ *         AGS10_ERR_TIMEOUT if an asynchronous bus did not finish within
+ *         AGS10MA_XFER_TIMEOUT_MS.
  */
-bool ags10_register_read(AGS10_HandleTypeDef *ph_sensor, 
-                         uint8_t reg, 
-                         uint16_t delayms, 
-                         uint32_t *p_value);
+AGS10_StatusTypeDef ags10_register_read(AGS10_HandleTypeDef *ph_sensor, 
+                                        uint8_t reg, 
+                                        uint16_t delayms, 
+                                        uint32_t *p_value);
+
+/**
+ * @brief Begin a split-phase register read.
+ * 
+ * Sends the register pointer and records when the sensor was asked for data.
+ * The caller keeps running and later checks ags10_register_read_ready() with
+ * its own monotonic millisecond tick, then collects the value with
+ * ags10_register_read_finish(). No delay is executed here.
+ * 
+ * @param[in] ph_sensor Pointer to the sensor handle structure.
+ * @param[in] reg Register address to read from.
+ * @param[in] delayms Time the sensor needs before the frame can be read.
+ * @param[in] now_ms Current value of the caller's millisecond tick.
+ * 
+ * @retval AGS10_OK        Register pointer sent (or queued), transaction running.
+ *                         With a retry policy, a failed pointer write is
+ *                         also AGS10_OK: the handle is waiting to retry it.
+ * @retval AGS10_ERR_BUSY  A transaction is already running, or the bus is busy.
+ * @retval AGS10_ERR_PARAM Invalid arguments.
+ * @return Otherwise the reason the pointer write failed.
+ */
+AGS10_StatusTypeDef ags10_register_read_start(AGS10_HandleTypeDef *ph_sensor,
+                                              uint8_t reg,
+                                              uint16_t delayms,
+                                              uint32_t now_ms);
+
+/**
+ * @brief Check whether a started read can be collected.
+ * 
+ * Tick wrap-around is handled, so any free-running 32-bit millisecond
+ * counter (e.g. HAL_GetTick()) can be passed.
+ * 
+ * With a retry policy, a pointer write that failed is sent again from here
+ * once its backoff has passed, so keep calling it until it returns true.
+ * 
+ * @param[in] ph_sensor Pointer to the sensor handle structure.
+ * @param[in] now_ms Current value of the caller's millisecond tick.
+ * 
+ * @retval true  The wait has elapsed, or the pointer write failed on its
+ *               last attempt: call ags10_register_read_finish().
+ * @retval false Still converting or waiting to retry, or no transaction
+ *               was started.
+ */
+bool ags10_register_read_ready(AGS10_HandleTypeDef *ph_sensor,
+                               uint32_t now_ms);
+
+/**
+ * @brief Collect the result of a split-phase read.
+ * 
+ * Reads the data frame, checks its CRC and returns the handle to idle,
+ * whether or not the read succeeded. Readiness is the caller's
+ * responsibility; the blocking wrappers call this right after their delay.
+ * 
+ * On an asynchronous bus this only starts the frame read (or checks on it)
+ * and returns AGS10_ERR_BUSY while it is in flight; use
+ * ags10_register_read_poll() there instead.
+ * 
+ * Called while the handle waits to retry a pointer write, i.e. before
+ * ags10_register_read_ready() returned true, it has no clock to wait with
+ * and ends the read with the failure that was to be retried.
+ * 
+ * @param[in] ph_sensor Pointer to the sensor handle structure.
+ * @param[out] p_value Pointer to store the read register value.
+ * 
+ * @retval AGS10_OK        Register read successful.
+ * @retval AGS10_ERR_PARAM No transaction started or invalid arguments.
+ * @return Otherwise the reason of the failure, e.g. AGS10_ERR_CRC.
+ */
+AGS10_StatusTypeDef ags10_register_read_finish(AGS10_HandleTypeDef *ph_sensor,
+                                               uint32_t *p_value);
+
+/**
+ * @brief Advance a split-phase read as far as possible without waiting.
+ * 
+ * Works on synchronous and asynchronous buses alike: checks the pointer
+ * write, the conversion wait against now_ms and the frame read, and verifies
+ * the CRC once the frame has arrived in the handle.
+ * 
+ * @param[in] ph_sensor Pointer to the sensor handle structure.
+ * @param[in] now_ms Current value of the caller's millisecond tick.
+ * @param[out] p_value Pointer to store the register value on AGS10_XFER_DONE.
+ * 
+ * A transfer that an asynchronous bus still reports as busy after
+ * AGS10MA_XFER_TIMEOUT_MS fails with AGS10_ERR_TIMEOUT, so a lost completion
+ * does not leave the handle in flight for ever.
+ * 
+ * @return AGS10_XFER_PENDING, AGS10_XFER_DONE or AGS10_XFER_ERROR. On the
+ *         last two the handle is idle again and its last_status field
+ *         tells why an AGS10_XFER_ERROR happened.
+ */
+AGS10_XferResultTypeDef ags10_register_read_poll(AGS10_HandleTypeDef *ph_sensor,
+                                                 uint32_t now_ms,
+                                                 uint32_t *p_value);
+
+/**
+ * @brief Abandon a started read and return the handle to idle.
+ * 
+ * @param[in] ph_sensor Pointer to the sensor handle structure.
+ */
+void ags10_register_read_abort(AGS10_HandleTypeDef *ph_sensor);
+
+/**
+ * @brief Time until a started read needs to be polled again.
+ * 
+ * Covers the conversion wait and the backoff before a retry, so the caller
+ * can sleep instead of polling.
+ * 
+ * @param[in] ph_sensor Pointer to the sensor handle structure.
+ * @param[in] now_ms Current value of the caller's millisecond tick.
+ * 
+ * @return Milliseconds left, 0 if the read should be polled now (including
+ *         transfers in flight) or nothing is running.
+ */
+uint32_t ags10_register_read_wait_ms(const AGS10_HandleTypeDef *ph_sensor,
+                                     uint32_t now_ms);
+
+/**
+ * @brief Set how failed reads on this handle are retried.
+ * 
+ * ags10_init() starts without retries. max_attempts of 0 is taken as 1.
+ * 
+ * @param[in] ph_sensor Pointer to the sensor handle structure.
+ * @param[in] p_policy Policy to copy into the handle.
+ * 
+ * @retval AGS10_OK        Policy applied to the next read.
+ * @retval AGS10_ERR_BUSY  A read is in progress.
+ * @retval AGS10_ERR_PARAM Null arguments.
+ */
+AGS10_StatusTypeDef ags10_retry_policy_set(AGS10_HandleTypeDef *ph_sensor,
+                                           const AGS10_RetryPolicyTypeDef *p_policy);
 
 
 /**
@@ -120,11 +542,11 @@ bool ags10_register_read(AGS10_HandleTypeDef *ph_sensor,
  * @param[in] ph_sensor Pointer to the sensor handle structure.
  * @param[out] p_version Pointer to store the firmware version.
  * 
- * @retval true  Firmware version read successfully.
- * @retval false Failed to read firmware version or invalid arguments.
+ * @retval AGS10_OK Firmware version read successfully.
+ * @return Otherwise as ags10_register_read().
  */
-bool ags10_firmware_version_get(AGS10_HandleTypeDef *ph_sensor, 
-                                uint32_t *p_version);
+AGS10_StatusTypeDef ags10_firmware_version_get(AGS10_HandleTypeDef *ph_sensor, 
+                                               uint32_t *p_version);
 
 /**
  * @brief Get the Total Volatile Organic Compounds (TVOC) value.
@@ -132,13 +554,51 @@ bool ags10_firmware_version_get(AGS10_HandleTypeDef *ph_sensor,
  * Retrieves the current TVOC concentration measured by the AGS10 sensor.
  * 
  * @param[in] ph_sensor Pointer to the sensor handle structure.
- * @param[out] p_tvoc Pointer to store the TVOC value (in ppb).
+ * @param[out] p_tvoc Pointer to store the TVOC value (in ppb), left
+ *                    unchanged on failure.
+ * 
+ * @retval AGS10_OK TVOC read successfully.
+ * @return Otherwise as ags10_register_read().
+ */
+AGS10_StatusTypeDef ags10_tvoc_get(AGS10_HandleTypeDef *ph_sensor, 
+                                   uint32_t *p_tvoc);
+
+/**
+ * @brief Readiness-driven, non-blocking TVOC acquisition.
+ * 
+ * Call periodically with the caller's millisecond tick. Instead of waiting a
+ * fixed 1000 ms, the status byte is read after the minimum access time and
+ * its RDY bit decides whether the value is new. While the sensor has nothing
+ * new, reads back off from AGS10MA_TVOC_POLL_MIN_MS up to
+ * AGS10MA_TVOC_POLL_MAX_MS. Once values arrive, the update period is learnt
+ * and the next read is aimed just before the following update.
+ * 
+ * A value is only reported as fresh when the sensor says so, so the constant
+ * readings during the warm-up are never mistaken for new data.
+ * 
+ * @param[in] ph_sensor Pointer to the sensor handle structure.
+ * @param[in] now_ms Current value of the caller's millisecond tick.
+ * @param[out] p_sample Updated after every successful read, fresh or not.
  * 
- * @retval true  TVOC read successfully.
- * @retval false Failed to read TVOC or invalid arguments.
+ * @retval true  A fresh value was read into p_sample.
+ * @retval false Nothing new yet (p_sample may still hold an updated, stale
+ *               reading), bus error or invalid arguments. After a failed
+ *               read the handle's last_status field holds the reason.
  */
-bool ags10_tvoc_get(AGS10_HandleTypeDef *ph_sensor, 
-                       uint32_t *p_tvoc);
+bool ags10_tvoc_poll(AGS10_HandleTypeDef *ph_sensor,
+                     uint32_t now_ms,
+                     AGS10_TvocSampleTypeDef *p_sample);
+
+/**
+ * @brief Split a raw status + TVOC register value.
+ * 
+ * Only the frame itself is decoded; preheating and age_ms are left to the
+ * caller (ags10_tvoc_poll() fills them from the handle's history).
+ * 
+ * @param[in] raw Value read from AGS10MA_TVOC_STAT_REG.
+ * @param[out] p_sample Decoded sample.
+ */
+void ags10_tvoc_decode(uint32_t raw, AGS10_TvocSampleTypeDef *p_sample);
 
 /**
  * @brief Change the I2C address of the AGS10 sensor.
@@ -148,11 +608,12 @@ bool ags10_tvoc_get(AGS10_HandleTypeDef *ph_sensor,
  * @param[in] ph_sensor Pointer to the sensor handle structure.
  * @param[in] new_addr New I2C address to assign to the sensor.
  * 
- * @retval true  Address set successfully.
- * @retval false Failed to set address or invalid arguments.
+ * @retval AGS10_OK       Address set successfully.
+ * @retval AGS10_ERR_BUSY A read is in progress on the handle.
+ * @return Otherwise the reason the write failed.
  */
-bool ags10_address_set(AGS10_HandleTypeDef *ph_sensor, 
-        uint8_t new_addr);
+AGS10_StatusTypeDef ags10_address_set(AGS10_HandleTypeDef *ph_sensor, 
+                                      uint8_t new_addr);
 
 /**
  * @brief Compute CRC-8 checksum for data validation.
@@ -165,5 +626,48 @@ bool ags10_address_set(AGS10_HandleTypeDef *ph_sensor,
  * @return Calculated 8-bit CRC value.
  */
 uint8_t ags10_crc8(const uint8_t *p_data, int len);
+
+/**
+ * @brief CRC-8 engines behind ags10_crc8().
+ * 
+ * Every engine is always available so they can be compared against each
+ * other; with -ffunction-sections/--gc-sections only the ones referenced are
+ * linked. ags10_crc8_bitwise() is the reference implementation.
+ * 
+ * @param[in] p_data Pointer to the input data buffer.
+ * @param[in] len Length of the input data buffer.
+ * 
+ * @return Calculated 8-bit CRC value.
+ */
+uint8_t ags10_crc8_bitwise(const uint8_t *p_data, int len);
+uint8_t ags10_crc8_nibble(const uint8_t *p_data, int len);
+uint8_t ags10_crc8_table(const uint8_t *p_data, int len);
+uint8_t ags10_crc8_slice4(const uint8_t *p_data, int len);
+
+#if AGS10_STATS_ENABLE
+/**
+ * @brief Copy the fault counters of a sensor.
+ * 
+ * @param[in] ph_sensor Pointer to the sensor handle structure.
+ * @param[out] p_stats Snapshot of the counters.
+ * 
+ * @retval AGS10_OK        Counters copied.
+ * @retval AGS10_ERR_PARAM Null arguments.
+ */
+AGS10_StatusTypeDef ags10_stats_get(const AGS10_HandleTypeDef *ph_sensor,
+                                    AGS10_StatsTypeDef *p_stats);
+
+/**
+ * @brief Clear the fault counters of a sensor.
+ * 
+ * @param[in] ph_sensor Pointer to the sensor handle structure.
+ */
+void ags10_stats_reset(AGS10_HandleTypeDef *ph_sensor);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* INC_AGS10_H_ */
 
@@ -0,0 +1,32 @@
+/**
+ * @file ags10_flash_hal.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief STM32F1 HAL flash access for the sample log.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_FLASH_HAL_H_
+#define INC_AGS10_FLASH_HAL_H_
+
+#include "stm32f1xx_hal.h"
+#include "ags10_log.h"
+
+/*******************************************************************************
+* Public Variables
+ ******************************************************************************/
+/**
+ * @brief Flash ops for ags10_log_mount() and ags10_clock_storage_set(), context unused (NULL).
+ *
+ * The F103 has a single flash bank, so the CPU stalls while a page erases
+ * (about 20 ms) or a record programs (about 50 us per half-word); the log
+ * keeps both rare by writing whole batches. Addresses must lie in the LOG
+ * or CAL region of the linker script, see _ags10_log_start, _ags10_log_end
+ * and _ags10_cal_start.
+ */
+extern const AGS10_LogFlashOpsTypeDef ags10_flash_hal_ops;
+
+#endif /* INC_AGS10_FLASH_HAL_H_ */
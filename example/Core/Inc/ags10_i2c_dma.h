@@ -0,0 +1,79 @@
+/**
+ * @file ags10_i2c_dma.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief DMA driven STM32 HAL I2C bus for the AGS10 driver.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_I2C_DMA_H_
+#define INC_AGS10_I2C_DMA_H_
+
+#include "stm32f1xx_hal.h"
+#include "ags10.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define AGS10_I2C_DMA_MAX_BUSES        2U
+
+/*******************************************************************************/
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+/**
+ * @brief Bus context, one per I2C peripheral.
+ * 
+ * The hi2c handle must have its hdmatx/hdmarx linked (HAL_I2C_MspInit) and
+ * the DMA channel and I2Cx_EV/ER interrupts enabled.
+ */
+typedef struct {
+    I2C_HandleTypeDef *hi2c;
+    volatile AGS10_BusXferTypeDef xfer;
+} AGS10_I2cDmaTypeDef;
+
+/*******************************************************************************
+* Public Variables
+ ******************************************************************************/
+/**
+ * @brief Bus ops for ags10_init(); pass the AGS10_I2cDmaTypeDef as context.
+ */
+extern const AGS10_BusOpsTypeDef ags10_i2c_dma_bus_ops;
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+
+/**
+ * @brief Bind a bus context to an initialised I2C peripheral.
+ * 
+ * @param[out] p_bus Bus context to initialise.
+ * @param[in] hi2c I2C handle the sensors are attached to.
+ * 
+ * @retval true  Bus registered.
+ * @retval false Null arguments or AGS10_I2C_DMA_MAX_BUSES already in use.
+ */
+bool ags10_i2c_dma_init(AGS10_I2cDmaTypeDef *p_bus, I2C_HandleTypeDef *hi2c);
+
+/**
+ * @brief Report a finished transfer, from the HAL Tx/Rx complete callbacks.
+ * 
+ * The HAL callbacks are application wide, so this module does not define
+ * them; the application forwards to these two functions (see main.c).
+ * 
+ * @param[in] hi2c I2C handle passed to the callback.
+ */
+void ags10_i2c_dma_xfer_cplt(I2C_HandleTypeDef *hi2c);
+
+/**
+ * @brief Report a failed transfer, from the HAL error/abort callbacks.
+ * 
+ * @param[in] hi2c I2C handle passed to the callback.
+ */
+void ags10_i2c_dma_xfer_error(I2C_HandleTypeDef *hi2c);
+
+#endif /* INC_AGS10_I2C_DMA_H_ */
@@ -0,0 +1,105 @@
+/**
+ * @file ags10_i2c_hal.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief STM32 HAL I2C results translated to AGS10 status codes.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_I2C_HAL_H_
+#define INC_AGS10_I2C_HAL_H_
+
+#include "stm32f1xx_hal.h"
+#include "ags10.h"
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief Map an I2C error code (HAL_I2C_GetError()) to a driver status.
+ * 
+ * @param[in] error HAL_I2C_ERROR_xxx bits.
+ * 
+ * @return AGS10_ERR_NACK for an acknowledge failure, AGS10_ERR_TIMEOUT or
+ *         AGS10_ERR_BUS otherwise.
+ */
+static inline AGS10_StatusTypeDef ags10_i2c_hal_error(uint32_t error)
+{
+    if (0U != (error & HAL_I2C_ERROR_AF))
+    {
+        return AGS10_ERR_NACK;
+    }
+
+    if (0U != (error & HAL_I2C_ERROR_TIMEOUT))
+    {
+        return AGS10_ERR_TIMEOUT;
+    }
+
+    return AGS10_ERR_BUS;
+}
+
+/**
+ * @brief Map the return value of a HAL I2C call to a driver status.
+ * 
+ * @param[in] hi2c I2C handle the call was made on.
+ * @param[in] status Value returned by the HAL.
+ * 
+ * @return Matching AGS10_StatusTypeDef.
+ */
+static inline AGS10_StatusTypeDef ags10_i2c_hal_status(I2C_HandleTypeDef *hi2c, HAL_StatusTypeDef status)
+{
+    switch (status)
+    {
+    case HAL_OK:
+        return AGS10_OK;
+    case HAL_BUSY:
+        return AGS10_ERR_BUSY;
+    case HAL_TIMEOUT:
+        return AGS10_ERR_TIMEOUT;
+    case HAL_ERROR:
+    default:
+        return ags10_i2c_hal_error(HAL_I2C_GetError(hi2c));
+    }
+}
+
+/**
+ * @brief Transfer state an asynchronous back end reports after an error.
+ * 
+ * @param[in] error HAL_I2C_ERROR_xxx bits.
+ * 
+ * @return AGS10_BUS_XFER_NACK or AGS10_BUS_XFER_ERROR.
+ */
+static inline AGS10_BusXferTypeDef ags10_i2c_hal_xfer_error(uint32_t error)
+{
+    return (0U != (error & HAL_I2C_ERROR_AF)) ? AGS10_BUS_XFER_NACK : AGS10_BUS_XFER_ERROR;
+}
+
+/**
+ * @brief Address-only probe for the probe bus op, blocking on any back end.
+ * 
+ * HAL_I2C_IsDeviceReady() sends the address and a STOP with no data. Its
+ * HAL_ERROR after the last trial does not set HAL_I2C_ERROR_AF, so any
+ * HAL_ERROR without a timeout bit is taken as no acknowledge.
+ * 
+ * @param[in] hi2c I2C handle.
+ * @param[in] addr 7-bit address.
+ * 
+ * @return AGS10_OK, AGS10_ERR_NACK, AGS10_ERR_BUSY or AGS10_ERR_TIMEOUT.
+ */
+static inline AGS10_StatusTypeDef ags10_i2c_hal_probe(I2C_HandleTypeDef *hi2c, uint8_t addr)
+{
+    HAL_StatusTypeDef status = HAL_I2C_IsDeviceReady(hi2c, (uint16_t)(addr << 1), 1U, 2U);
+
+    if (HAL_ERROR == status)
+    {
+        return (0U != (HAL_I2C_GetError(hi2c) & HAL_I2C_ERROR_TIMEOUT)) ? AGS10_ERR_TIMEOUT : AGS10_ERR_NACK;
+    }
+
+    return ags10_i2c_hal_status(hi2c, status);
+}
+
+#endif /* INC_AGS10_I2C_HAL_H_ */
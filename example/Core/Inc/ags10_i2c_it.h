@@ -0,0 +1,110 @@
+/**
+ * @file ags10_i2c_it.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Interrupt driven STM32 HAL I2C bus for the AGS10 driver.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_I2C_IT_H_
+#define INC_AGS10_I2C_IT_H_
+
+#include "stm32f1xx_hal.h"
+#include "ags10.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define AGS10_I2C_IT_MAX_BUSES         2U
+#define AGS10_I2C_IT_EVQ_LEN           8U    /**< Power of two. */
+/*******************************************************************************/
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+/**
+ * @brief Completion event published by the I2C interrupt.
+ */
+typedef enum {
+    AGS10_I2C_IT_EVT_TX_CPLT = 0,
+    AGS10_I2C_IT_EVT_RX_CPLT,
+    AGS10_I2C_IT_EVT_ERROR,
+} AGS10_I2cItEventTypeDef;
+
+typedef struct {
+    uint8_t event;          /**< AGS10_I2cItEventTypeDef */
+    uint32_t error;         /**< HAL_I2C_GetError() for AGS10_I2C_IT_EVT_ERROR. */
+    uint32_t tick;          /**< HAL_GetTick() when the interrupt fired. */
+} AGS10_I2cItEvtTypeDef;
+
+/**
+ * @brief Bus context, one per I2C peripheral.
+ * 
+ * The interrupt only appends to evq, the main loop only consumes it, so the
+ * queue needs neither locks nor masked interrupts. xfer and last_error
+ * belong to the main loop and are updated when the queue is drained.
+ */
+typedef struct {
+    I2C_HandleTypeDef *hi2c;
+
+    AGS10_BusXferTypeDef xfer;
+    uint32_t last_error;
+
+    AGS10_I2cItEvtTypeDef evq[AGS10_I2C_IT_EVQ_LEN];
+    volatile uint32_t evq_head;     /**< Written by the interrupt only. */
+    volatile uint32_t evq_tail;     /**< Written by the main loop only. */
+    volatile uint32_t evq_dropped;  /**< Events lost to a full queue. */
+} AGS10_I2cItTypeDef;
+
+/*******************************************************************************
+* Public Variables
+ ******************************************************************************/
+/**
+ * @brief Bus ops for ags10_init(); pass the AGS10_I2cItTypeDef as context.
+ */
+extern const AGS10_BusOpsTypeDef ags10_i2c_it_bus_ops;
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+
+/**
+ * @brief Bind a bus context to an initialised I2C peripheral.
+ * 
+ * The I2Cx_EV and I2Cx_ER interrupts must be enabled and call
+ * HAL_I2C_EV_IRQHandler()/HAL_I2C_ER_IRQHandler().
+ * 
+ * @param[out] p_bus Bus context to initialise.
+ * @param[in] hi2c I2C handle the sensors are attached to.
+ * 
+ * @retval true  Bus registered.
+ * @retval false Null arguments or AGS10_I2C_IT_MAX_BUSES already in use.
+ */
+bool ags10_i2c_it_init(AGS10_I2cItTypeDef *p_bus, I2C_HandleTypeDef *hi2c);
+
+/**
+ * @brief Drain the event queue, from the main loop.
+ * 
+ * Also called by the driver whenever it checks on a transfer, so explicit
+ * calls are only needed to observe events sooner.
+ * 
+ * @param[in,out] p_bus Bus context.
+ * 
+ * @return Number of events consumed.
+ */
+uint32_t ags10_i2c_it_process(AGS10_I2cItTypeDef *p_bus);
+
+/**
+ * @brief Publish a completion, from the HAL I2C callbacks (interrupt context).
+ * 
+ * Constant time: one queue slot is written.
+ * 
+ * @param[in] hi2c I2C handle passed to the callback.
+ * @param[in] event Which callback fired.
+ */
+void ags10_i2c_it_isr_event(I2C_HandleTypeDef *hi2c, AGS10_I2cItEventTypeDef event);
+
+#endif /* INC_AGS10_I2C_IT_H_ */
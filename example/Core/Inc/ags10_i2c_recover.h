@@ -0,0 +1,89 @@
+/**
+ * @file ags10_i2c_recover.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Stuck I2C bus detection and recovery for the STM32F1 HAL.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_I2C_RECOVER_H_
+#define INC_AGS10_I2C_RECOVER_H_
+
+#include "stm32f1xx_hal.h"
+#include "ags10.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define AGS10_I2C_RECOVER_PULSES       9U
+
+/*******************************************************************************/
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+/**
+ * @brief Recovery context, one per I2C peripheral.
+ *
+ * The first block is configuration and is filled in by the application, the
+ * rest is zeroed and updated by ags10_i2c_recover(). Timing uses the DWT
+ * cycle counter, which must be running (see app_init()).
+ */
+typedef struct {
+    I2C_HandleTypeDef *hi2c;
+    GPIO_TypeDef *scl_port;
+    uint16_t scl_pin;
+    GPIO_TypeDef *sda_port;
+    uint16_t sda_pin;
+    uint16_t half_period_us;    /**< SCL half period while bit-banging. */
+    void (*reinit)(void);       /**< Peripheral init, e.g. MX_I2C2_Init(). */
+
+    /* Statistics */
+    uint32_t count;             /**< Recoveries run. */
+    uint32_t failed;            /**< Recoveries that left SDA or SCL low. */
+    uint32_t last_us;           /**< Duration of the last recovery. */
+    uint32_t max_us;            /**< Longest recovery. */
+} AGS10_I2cRecoverTypeDef;
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+
+/**
+ * @brief Decide whether a failed transfer left the bus stuck.
+ *
+ * A slave cut off mid-byte keeps SDA low until it is clocked out; the F1
+ * peripheral then sees a permanently busy bus and every HAL call returns
+ * HAL_BUSY, or fails with a bus error or arbitration loss. A NACK or CRC
+ * failure never needs recovery, and neither does a transfer the HAL still
+ * owns.
+ *
+ * @param[in] p_rec Recovery context.
+ * @param[in] status Status of the failed transfer.
+ *
+ * @retval true  Run ags10_i2c_recover().
+ * @retval false The bus is usable.
+ */
+bool ags10_i2c_recover_needed(const AGS10_I2cRecoverTypeDef *p_rec, AGS10_StatusTypeDef status);
+
+/**
+ * @brief Free a stuck bus and re-initialise the peripheral.
+ *
+ * De-initialises the peripheral, drives SCL as an open-drain GPIO for up to
+ * AGS10_I2C_RECOVER_PULSES clocks until the slave releases SDA, generates a
+ * STOP, resets the peripheral through RCC (clearing a latched BUSY flag) and
+ * calls reinit. Blocks for at most about 11 SCL periods.
+ *
+ * Must not be called while an interrupt or DMA transfer is in flight.
+ *
+ * @param[in,out] p_rec Recovery context.
+ *
+ * @retval true  Both lines are high again.
+ * @retval false A line is still held low; counted in failed.
+ */
+bool ags10_i2c_recover(AGS10_I2cRecoverTypeDef *p_rec);
+
+#endif /* INC_AGS10_I2C_RECOVER_H_ */
@@ -0,0 +1,177 @@
+/**
+ * @file ags10_ring.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Fixed-capacity sample history, safe between an interrupt and the main loop.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_RING_H_
+#define INC_AGS10_RING_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#ifndef AGS10_RING_LEN
+#define AGS10_RING_LEN              256U        /**< Samples, power of two. */
+#endif
+
+#define AGS10_RING_TVOC_MAX         0xFFFFFFU
+#define AGS10_RING_DT_MAX_MS        0xFFFFU     /**< Longer gaps are stored as this. */
+#define AGS10_RING_RES_MANT_BITS    12U
+#define AGS10_RING_RES_MANT_MSK     0x0FFFU
+#define AGS10_RING_RES_CODE_MAX     0xFFFFU
+#define AGS10_RING_STATUS_NO_RES    0x80U       /**< Reserved status bit: resistance not read, stored as 0. */
+
+#if (0U != (AGS10_RING_LEN & (AGS10_RING_LEN - 1U)))
+#error "AGS10_RING_LEN must be a power of two"
+#endif
+
+/*******************************************************************************/
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+/**
+ * @brief One sample as pushed and read back.
+ */
+typedef struct {
+    uint32_t t_ms;          /**< Tick of the sample. */
+    uint32_t tvoc;          /**< TVOC in ppb, 24 bits. */
+    uint32_t resistance;    /**< Gas resistance register, 0.1 kOhm units. */
+    uint8_t status;         /**< Status byte of the TVOC frame, may carry AGS10_RING_STATUS_NO_RES. */
+} AGS10_RingSampleTypeDef;
+
+/**
+ * @brief Single-producer, single-consumer sample ring, struct of arrays.
+ *
+ * An entry costs 8 bytes: a 24-bit TVOC, a 16-bit resistance code (4-bit
+ * exponent, 12-bit mantissa, see ags10_ring_res_encode()), the 8-bit status
+ * and a 16-bit tick delta from the previous sample. A tuple of four uint32
+ * would take 16.
+ *
+ * The producer (for example an I2C completion interrupt) only writes head,
+ * the consumer (the main loop) only writes tail, so neither side needs a
+ * lock or masked interrupts. A full ring rejects the new sample; to keep a
+ * rolling history, the consumer discards the oldest entries before the ring
+ * fills (see ags10_ring_discard()).
+ *
+ * Times are rebuilt from the deltas. A rejected sample's delta is carried
+ * into the next accepted one, so the rebuilt times stay exact across drops.
+ * A gap longer than AGS10_RING_DT_MAX_MS is stored as that value and the
+ * rest carried into the following deltas, so only the samples until the
+ * rest is absorbed are early.
+ */
+typedef struct {
+    uint8_t tvoc[AGS10_RING_LEN][3];
+    uint16_t res_code[AGS10_RING_LEN];
+    uint16_t dt_ms[AGS10_RING_LEN];
+    uint8_t status[AGS10_RING_LEN];
+
+    atomic_uint_least32_t head;     /**< Written by the producer only. */
+    atomic_uint_least32_t tail;     /**< Written by the consumer only. */
+
+    uint32_t push_ms;               /**< Producer: tick of the newest entry. */
+    uint32_t pop_ms;                /**< Consumer: tick of the last entry removed. */
+    uint32_t dropped;               /**< Producer: samples rejected by a full ring. */
+} AGS10_RingTypeDef;
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+
+/**
+ * @brief Empty the ring. Neither side may be using it.
+ *
+ * @param[out] p_ring Ring to initialise.
+ * @param[in] now_ms Tick the first sample's delta counts from.
+ */
+void ags10_ring_init(AGS10_RingTypeDef *p_ring, uint32_t now_ms);
+
+/**
+ * @brief Append a sample; producer side, interrupt safe.
+ *
+ * TVOC above 24 bits is clamped, resistance is coded to 16 bits.
+ *
+ * @param[in,out] p_ring Ring.
+ * @param[in] p_sample Sample, t_ms included.
+ *
+ * @retval true  Stored.
+ * @retval false Ring full, sample counted in dropped.
+ */
+bool ags10_ring_push(AGS10_RingTypeDef *p_ring, const AGS10_RingSampleTypeDef *p_sample);
+
+/**
+ * @brief Remove and return the oldest sample; consumer side.
+ *
+ * @param[in,out] p_ring Ring.
+ * @param[out] p_sample Oldest sample.
+ *
+ * @retval true  A sample was removed.
+ * @retval false Ring empty.
+ */
+bool ags10_ring_pop(AGS10_RingTypeDef *p_ring, AGS10_RingSampleTypeDef *p_sample);
+
+/**
+ * @brief Copy samples out without removing them; consumer side.
+ *
+ * @param[in] p_ring Ring.
+ * @param[in] first Index of the first sample, 0 being the oldest.
+ * @param[out] p_samples Room for count samples.
+ * @param[in] count Samples wanted.
+ *
+ * @return Samples copied, fewer than count near the newest end.
+ */
+uint32_t ags10_ring_read(const AGS10_RingTypeDef *p_ring,
+                         uint32_t first,
+                         AGS10_RingSampleTypeDef *p_samples,
+                         uint32_t count);
+
+/**
+ * @brief Drop the oldest samples; consumer side.
+ *
+ * @param[in,out] p_ring Ring.
+ * @param[in] count Samples to drop.
+ *
+ * @return Samples dropped.
+ */
+uint32_t ags10_ring_discard(AGS10_RingTypeDef *p_ring, uint32_t count);
+
+/**
+ * @brief Number of samples stored; either side.
+ *
+ * @param[in] p_ring Ring.
+ *
+ * @return Stored samples, at most AGS10_RING_LEN.
+ */
+uint32_t ags10_ring_count(const AGS10_RingTypeDef *p_ring);
+
+/**
+ * @brief Code a gas resistance into 16 bits: mantissa << exponent.
+ *
+ * Values up to 4095 are exact, larger ones keep 12 significant bits (under
+ * 0.05 % error) up to 4095 << 15; anything above saturates.
+ *
+ * @param[in] resistance Gas resistance register value.
+ *
+ * @return Resistance code.
+ */
+uint16_t ags10_ring_res_encode(uint32_t resistance);
+
+/**
+ * @brief Expand a resistance code.
+ *
+ * @param[in] code Code from ags10_ring_res_encode().
+ *
+ * @return Gas resistance register value, low bits truncated.
+ */
+uint32_t ags10_ring_res_decode(uint16_t code);
+
+#endif /* INC_AGS10_RING_H_ */
@@ -0,0 +1,111 @@
+/**
+ * @file app_sched.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Cooperative run-to-completion task scheduler for the example.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_APP_SCHED_H_
+#define INC_APP_SCHED_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * No HAL dependency: the tick, cycle counter and idle instruction come in
+ * through APP_SchedPortTypeDef, so the scheduler also builds as a host
+ * program driven by a simulated tick.
+ */
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+/**
+ * @brief Task body. Runs to completion and must not block.
+ * 
+ * @param[in] p_arg Argument given in the task table.
+ * 
+ * @return Milliseconds until the task wants to run again.
+ */
+typedef uint32_t (*APP_TaskFn)(void *p_arg);
+
+typedef struct {
+    const char *name;
+    APP_TaskFn fn;
+    void *p_arg;
+
+    /* Maintained by the scheduler */
+    uint32_t next_ms;
+    uint32_t runs;
+    uint32_t wcet_cycles;       /**< Longest single run. */
+    uint32_t total_cycles;
+} APP_TaskTypeDef;
+
+/**
+ * @brief Platform hooks.
+ */
+typedef struct {
+    uint32_t (*get_tick_ms)(void);  /**< Free-running millisecond tick. */
+    uint32_t (*get_cycles)(void);   /**< Free-running cycle counter, e.g. DWT->CYCCNT. */
+    void (*idle)(void);             /**< Sleep until the next interrupt, e.g. __WFI(). */
+} APP_SchedPortTypeDef;
+
+typedef struct {
+    APP_TaskTypeDef *p_tasks;
+    uint8_t count;
+    const APP_SchedPortTypeDef *p_port;
+
+    uint64_t busy_cycles;
+    uint64_t idle_cycles;
+} APP_SchedTypeDef;
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+
+/**
+ * @brief Bind the scheduler to a task table; every task runs on the first pass.
+ * 
+ * @param[out] p_sched Scheduler.
+ * @param[in,out] p_tasks Task table, name/fn/p_arg filled in.
+ * @param[in] count Number of tasks.
+ * @param[in] p_port Platform hooks.
+ * 
+ * @retval true  Scheduler ready.
+ * @retval false Invalid arguments.
+ */
+bool app_sched_init(APP_SchedTypeDef *p_sched,
+                    APP_TaskTypeDef *p_tasks,
+                    uint8_t count,
+                    const APP_SchedPortTypeDef *p_port);
+
+/**
+ * @brief One scheduler pass: run every due task once, or idle if none is due.
+ * 
+ * Call from the main loop forever.
+ * 
+ * @param[in,out] p_sched Scheduler.
+ */
+void app_sched_run_once(APP_SchedTypeDef *p_sched);
+
+/**
+ * @brief Share of cycles spent in the idle hook since the last reset.
+ * 
+ * @param[in] p_sched Scheduler.
+ * 
+ * @return Idle time in percent, 0..100.
+ */
+uint8_t app_sched_idle_percent(const APP_SchedTypeDef *p_sched);
+
+/**
+ * @brief Clear the idle and per-task timing statistics.
+ * 
+ * @param[in,out] p_sched Scheduler.
+ */
+void app_sched_stats_reset(APP_SchedTypeDef *p_sched);
+
+#endif /* INC_APP_SCHED_H_ */
@@ -41,7 +41,14 @@ extern "C" {
 
 /* Exported constants --------------------------------------------------------*/
 /* USER CODE BEGIN EC */
+/* Bus back end used for the AGS10 on I2C2 */
+#define AGS10_EXAMPLE_BUS_BLOCKING   0   /* HAL_I2C_Master_Transmit/Receive */
+#define AGS10_EXAMPLE_BUS_DMA        1   /* HAL_I2C_Master_Seq_*_DMA, see ags10_i2c_dma.c */
+#define AGS10_EXAMPLE_BUS_IT         2   /* HAL_I2C_Master_*_IT, see ags10_i2c_it.c */
 
+#ifndef AGS10_EXAMPLE_BUS
+#define AGS10_EXAMPLE_BUS            AGS10_EXAMPLE_BUS_BLOCKING
+#endif
 /* USER CODE END EC */
 
 /* Exported macro ------------------------------------------------------------*/
@@ -56,7 +56,14 @@ void DebugMon_Handler(void);
 void PendSV_Handler(void);
 void SysTick_Handler(void);
 /* USER CODE BEGIN EFP */
-
+#if (AGS10_EXAMPLE_BUS == AGS10_EXAMPLE_BUS_DMA)
+void DMA1_Channel4_IRQHandler(void);
+void DMA1_Channel5_IRQHandler(void);
+#endif
+#if (AGS10_EXAMPLE_BUS != AGS10_EXAMPLE_BUS_BLOCKING)
+void I2C2_EV_IRQHandler(void);
+void I2C2_ER_IRQHandler(void);
+#endif
 /* USER CODE END EFP */
 
 #ifdef __cplusplus
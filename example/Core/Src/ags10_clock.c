@@ -0,0 +1,413 @@
+/**
+ * @file ags10_clock.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_clock.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static uint32_t clock_tick_ms(const AGS10_ClockCalTypeDef *p_cal)
+{
+    if (NULL == p_cal->p_bus_ops->get_tick_ms)
+    {
+        return 0;
+    }
+
+    return p_cal->p_bus_ops->get_tick_ms(p_cal->p_bus_ctx);
+}
+
+/* Asynchronous buses return once a transfer is queued; the buffers here are on the stack. */
+static AGS10_StatusTypeDef clock_wait(const AGS10_ClockCalTypeDef *p_cal, AGS10_StatusTypeDef status)
+{
+    if ((AGS10_OK != status) || (NULL == p_cal->p_bus_ops->xfer_state))
+    {
+        return status;
+    }
+
+    for (uint16_t waited_ms = 0; waited_ms < AGS10MA_XFER_TIMEOUT_MS; waited_ms++)
+    {
+        switch (p_cal->p_bus_ops->xfer_state(p_cal->p_bus_ctx))
+        {
+        case AGS10_BUS_XFER_DONE:
+            return AGS10_OK;
+        case AGS10_BUS_XFER_NACK:
+            return AGS10_ERR_NACK;
+        case AGS10_BUS_XFER_ERROR:
+            return AGS10_ERR_BUS;
+        case AGS10_BUS_XFER_BUSY:
+        default:
+            break;
+        }
+
+        p_cal->p_bus_ops->delay(p_cal->p_bus_ctx, 1);
+    }
+
+    return AGS10_ERR_TIMEOUT;
+}
+
+static bool clock_set(const AGS10_ClockCalTypeDef *p_cal, uint8_t idx)
+{
+    return p_cal->set_clock(p_cal->p_clock_ctx, p_cal->p_rates[idx]);
+}
+
+/* CRC-8 of the rate in the low byte and its complement above, so an erased half-word never checks. */
+static uint16_t clock_check(uint32_t clock_hz)
+{
+    uint8_t bytes[4] = {
+        (uint8_t)clock_hz,
+        (uint8_t)(clock_hz >> 8),
+        (uint8_t)(clock_hz >> 16),
+        (uint8_t)(clock_hz >> 24),
+    };
+    uint8_t crc = ags10_crc8(bytes, 4);
+
+    return (uint16_t)(crc | ((uint16_t)(uint8_t)~crc << 8));
+}
+
+/* Newest valid record and the first erased slot after the written ones. */
+static void clock_page_scan(AGS10_ClockCalTypeDef *p_cal)
+{
+    uint32_t off = 0;
+
+    p_cal->stored_hz = 0;
+
+    for (; (off + AGS10_CLOCK_REC_LEN) <= p_cal->page_size; off += AGS10_CLOCK_REC_LEN)
+    {
+        uint16_t rec[AGS10_CLOCK_REC_LEN / 2U];
+
+        p_cal->p_flash_ops->read(p_cal->p_flash_ctx, p_cal->flash_addr + off, rec, AGS10_CLOCK_REC_LEN);
+
+        if ((AGS10_LOG_ERASED == rec[0]) && (AGS10_LOG_ERASED == rec[1]) &&
+            (AGS10_LOG_ERASED == rec[2]) && (AGS10_LOG_ERASED == rec[3]))
+        {
+            break;
+        }
+
+        uint32_t clock_hz = (uint32_t)rec[1] | ((uint32_t)rec[2] << 16);
+
+        // a record cut short by power loss is skipped, the one before it stays in force
+        if ((AGS10_CLOCK_REC_MAGIC == rec[0]) && (clock_check(clock_hz) == rec[3]))
+        {
+            p_cal->stored_hz = clock_hz;
+        }
+    }
+
+    p_cal->rec_off = off;
+}
+
+static void clock_save(AGS10_ClockCalTypeDef *p_cal)
+{
+    if ((NULL == p_cal->p_flash_ops) || (p_cal->stored_hz == p_cal->clock_hz))
+    {
+        return;
+    }
+
+    if ((p_cal->rec_off + AGS10_CLOCK_REC_LEN) > p_cal->page_size)
+    {
+        if (!p_cal->p_flash_ops->erase(p_cal->p_flash_ctx, p_cal->flash_addr))
+        {
+            return;
+        }
+        p_cal->rec_off = 0;
+    }
+
+    uint16_t rec[AGS10_CLOCK_REC_LEN / 2U] = {
+        AGS10_CLOCK_REC_MAGIC,
+        (uint16_t)p_cal->clock_hz,
+        (uint16_t)(p_cal->clock_hz >> 16),
+        clock_check(p_cal->clock_hz),
+    };
+    bool ok = p_cal->p_flash_ops->program(p_cal->p_flash_ctx, p_cal->flash_addr + p_cal->rec_off,
+                                          rec, AGS10_CLOCK_REC_LEN / 2U);
+
+    // a failed program may have left bits behind, the slot is not used again
+    p_cal->rec_off += AGS10_CLOCK_REC_LEN;
+    if (ok)
+    {
+        p_cal->stored_hz = p_cal->clock_hz;
+        p_cal->saves++;
+    }
+}
+
+/*
+ * Version frames at the rate already set: one pointer, one conversion wait,
+ * then frame reads only. A pointer that fails is sent again on the next read.
+ * The error budget is per test, so a rate ends as soon as it has spent it.
+ */
+static AGS10_StatusTypeDef clock_test(AGS10_ClockCalTypeDef *p_cal, uint8_t idx)
+{
+    AGS10_ClockStepTypeDef *p_step = &p_cal->steps[idx];
+    AGS10_StatusTypeDef last = AGS10_OK;
+    bool pointed = false;
+
+    memset(p_step, 0, sizeof(*p_step));
+
+    for (uint16_t read = 0; read < p_cal->reads; read++)
+    {
+        uint8_t frame[AGS10MA_FRAME_LEN];
+        AGS10_StatusTypeDef status = AGS10_OK;
+
+        if (!pointed)
+        {
+            uint8_t reg = AGS10MA_VERSION_REG;
+
+            status = clock_wait(p_cal, p_cal->p_bus_ops->write(p_cal->p_bus_ctx, p_cal->addr, &reg, 1));
+            if (AGS10_OK == status)
+            {
+                p_cal->p_bus_ops->delay(p_cal->p_bus_ctx, AGS10MA_VERSION_DELAY_MS);
+                pointed = true;
+            }
+        }
+
+        if (AGS10_OK == status)
+        {
+            status = clock_wait(p_cal, p_cal->p_bus_ops->read(p_cal->p_bus_ctx, p_cal->addr, frame, AGS10MA_FRAME_LEN));
+        }
+
+        if ((AGS10_OK == status) && (ags10_crc8(frame, AGS10MA_DATA_LEN) != frame[AGS10MA_DATA_LEN]))
+        {
+            status = AGS10_ERR_CRC;
+        }
+
+        p_step->reads++;
+        if (AGS10_OK != status)
+        {
+            p_step->errors++;
+            if (AGS10_ERR_CRC == status)
+            {
+                p_step->crc_errors++;
+            }
+            else if ((AGS10_ERR_NACK == status) || (AGS10_ERR_NACK_WRITE == status) || (AGS10_ERR_NACK_READ == status))
+            {
+                p_step->nacks++;
+            }
+            last = status;
+
+            // over budget for the whole test already, the rest cannot save it
+            if (((uint32_t)p_step->errors * 1000U) > ((uint32_t)p_cal->target_permille * p_cal->reads))
+            {
+                break;
+            }
+        }
+    }
+
+    if (((uint32_t)p_step->errors * 1000U) > ((uint32_t)p_cal->target_permille * p_cal->reads))
+    {
+        return last;
+    }
+
+    return AGS10_OK;
+}
+
+static AGS10_StatusTypeDef clock_apply(AGS10_ClockCalTypeDef *p_cal, uint8_t idx)
+{
+    if (!clock_set(p_cal, idx))
+    {
+        return AGS10_ERR_BUS;
+    }
+
+    p_cal->rate_index = idx;
+    p_cal->clock_hz = p_cal->p_rates[idx];
+    clock_save(p_cal);
+
+    return AGS10_OK;
+}
+
+/*******************************************************************************
+* Public Variables
+ ******************************************************************************/
+
+const uint32_t ags10_clock_rates[AGS10_CLOCK_RATE_COUNT] = {
+    10000U, 15000U, 20000U, 25000U, 30000U, 40000U, 50000U, 75000U, 100000U,
+};
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+bool ags10_clock_init(AGS10_ClockCalTypeDef *p_cal,
+                      const AGS10_BusOpsTypeDef *p_bus_ops,
+                      void *p_bus_ctx,
+                      uint8_t addr,
+                      AGS10_ClockSetFn set_clock,
+                      void *p_clock_ctx,
+                      const uint32_t *p_rates,
+                      uint8_t rate_count)
+{
+    if ((NULL == p_cal) || (NULL == p_bus_ops) || (NULL == set_clock) || (NULL == p_rates) ||
+        (0U == rate_count) || (rate_count > AGS10_CLOCK_MAX_RATES) || (0U == p_rates[0]))
+    {
+        return false;
+    }
+
+    for (uint8_t idx = 1; idx < rate_count; idx++)
+    {
+        if (p_rates[idx] <= p_rates[idx - 1U])
+        {
+            return false;
+        }
+    }
+
+    memset(p_cal, 0, sizeof(*p_cal));
+    p_cal->p_bus_ops = p_bus_ops;
+    p_cal->p_bus_ctx = p_bus_ctx;
+    p_cal->addr = addr;
+    p_cal->set_clock = set_clock;
+    p_cal->p_clock_ctx = p_clock_ctx;
+    p_cal->p_rates = p_rates;
+    p_cal->rate_count = rate_count;
+    p_cal->reads = AGS10_CLOCK_READS;
+    p_cal->target_permille = AGS10_CLOCK_TARGET_PERMILLE;
+
+    return true;
+}
+
+bool ags10_clock_storage_set(AGS10_ClockCalTypeDef *p_cal,
+                             const AGS10_LogFlashOpsTypeDef *p_ops,
+                             void *p_ctx,
+                             uint32_t page_addr,
+                             uint32_t page_size)
+{
+    if ((NULL == p_cal) || (NULL == p_ops) || (page_size < AGS10_CLOCK_REC_LEN))
+    {
+        return false;
+    }
+
+    p_cal->p_flash_ops = p_ops;
+    p_cal->p_flash_ctx = p_ctx;
+    p_cal->flash_addr = page_addr;
+    p_cal->page_size = page_size;
+    clock_page_scan(p_cal);
+
+    return true;
+}
+
+AGS10_StatusTypeDef ags10_clock_load(AGS10_ClockCalTypeDef *p_cal)
+{
+    if ((NULL == p_cal) || (NULL == p_cal->p_flash_ops) || (0U == p_cal->stored_hz))
+    {
+        return AGS10_ERR_PARAM;
+    }
+
+    for (uint8_t idx = 0; idx < p_cal->rate_count; idx++)
+    {
+        if (p_cal->p_rates[idx] == p_cal->stored_hz)
+        {
+            return clock_apply(p_cal, idx);
+        }
+    }
+
+    return AGS10_ERR_PARAM;
+}
+
+AGS10_StatusTypeDef ags10_clock_calibrate(AGS10_ClockCalTypeDef *p_cal)
+{
+    if (NULL == p_cal)
+    {
+        return AGS10_ERR_PARAM;
+    }
+
+    uint32_t start_ms = clock_tick_ms(p_cal);
+    AGS10_StatusTypeDef result = AGS10_OK;
+    bool set_failed = false;
+    bool found = false;
+    uint8_t best = 0;
+
+    p_cal->calibrations++;
+
+    for (uint8_t idx = 0; idx < p_cal->rate_count; idx++)
+    {
+        if (!clock_set(p_cal, idx))
+        {
+            set_failed = true;
+            break;
+        }
+
+        // rates above a failing one are not tried, margins only shrink further up
+        result = clock_test(p_cal, idx);
+        if (AGS10_OK != result)
+        {
+            break;
+        }
+        best = idx;
+        found = true;
+    }
+
+    AGS10_StatusTypeDef status = clock_apply(p_cal, best);
+
+    p_cal->cal_ms = clock_tick_ms(p_cal) - start_ms;
+
+    if (AGS10_OK != status)
+    {
+        return status;
+    }
+
+    if (set_failed)
+    {
+        return AGS10_ERR_BUS;
+    }
+
+    return found ? AGS10_OK : result;
+}
+
+AGS10_StatusTypeDef ags10_clock_validate(AGS10_ClockCalTypeDef *p_cal)
+{
+    if (NULL == p_cal)
+    {
+        return AGS10_ERR_PARAM;
+    }
+
+    if (0U == p_cal->clock_hz)
+    {
+        return ags10_clock_calibrate(p_cal);
+    }
+
+    uint8_t idx = p_cal->rate_index;
+    bool set_failed = false;
+
+    p_cal->validations++;
+
+    // the rate in use is set already; only lower ones need switching to
+    AGS10_StatusTypeDef status = clock_test(p_cal, idx);
+
+    while ((AGS10_OK != status) && (0U != idx))
+    {
+        if (!clock_set(p_cal, (uint8_t)(idx - 1U)))
+        {
+            set_failed = true;
+            break;
+        }
+        idx--;
+        status = clock_test(p_cal, idx);
+    }
+
+    // after a failed switch the clock is unknown, so the kept rate is set again
+    if (set_failed || (idx != p_cal->rate_index))
+    {
+        if (idx != p_cal->rate_index)
+        {
+            p_cal->downgrades++;
+        }
+
+        AGS10_StatusTypeDef applied = clock_apply(p_cal, idx);
+
+        if (AGS10_OK != applied)
+        {
+            return applied;
+        }
+    }
+
+    return set_failed ? AGS10_ERR_BUS : status;
+}
+// eof
@@ -0,0 +1,214 @@
+/**
+ * @file ags10_codec.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_codec.h"
+
+#include <stddef.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define VARINT_MORE                 0x80U
+#define VARINT_BITS                 0x7FU
+#define VARINT_LAST_MAX             0x0FU   /**< Fifth byte holds bits 28..31. */
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static uint16_t block_len_get(uint16_t block_len)
+{
+    return (0U == block_len) ? (uint16_t)AGS10_CODEC_BLOCK_LEN : block_len;
+}
+
+static uint32_t zigzag_encode(uint32_t delta)
+{
+    // the sign moves to bit 0, so small steps either way stay small
+    return (delta << 1) ^ (uint32_t)((int32_t)delta >> 31);
+}
+
+static uint32_t zigzag_decode(uint32_t code)
+{
+    return (code >> 1) ^ (0U - (code & 1U));
+}
+
+static uint8_t varint_put(uint32_t value, uint8_t *p_out)
+{
+    uint8_t len = 0;
+
+    while (value > VARINT_BITS)
+    {
+        p_out[len++] = (uint8_t)(value | VARINT_MORE);
+        value >>= 7;
+    }
+    p_out[len++] = (uint8_t)value;
+
+    return len;
+}
+
+static uint8_t varint_get(const uint8_t *p_in, uint32_t len, uint32_t *p_value)
+{
+    uint32_t value = 0;
+
+    for (uint8_t idx = 0; (idx < AGS10_CODEC_MAX_BYTES) && (idx < len); idx++)
+    {
+        uint8_t byte = p_in[idx];
+
+        if ((AGS10_CODEC_MAX_BYTES - 1U) == idx)
+        {
+            if (byte > VARINT_LAST_MAX)
+            {
+                return 0;
+            }
+        }
+
+        value |= (uint32_t)(byte & VARINT_BITS) << (7U * idx);
+
+        if (0U == (byte & VARINT_MORE))
+        {
+            *p_value = value;
+            return (uint8_t)(idx + 1U);
+        }
+    }
+
+    return 0;
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+void ags10_codec_enc_init(AGS10_CodecEncTypeDef *p_enc, uint16_t block_len)
+{
+    p_enc->prev = 0;
+    p_enc->in_block = 0;
+    p_enc->block_len = block_len_get(block_len);
+}
+
+bool ags10_codec_enc_restart(const AGS10_CodecEncTypeDef *p_enc)
+{
+    return (0U == p_enc->in_block);
+}
+
+uint8_t ags10_codec_encode(AGS10_CodecEncTypeDef *p_enc, uint32_t value, uint8_t *p_out)
+{
+    uint32_t code = (0U == p_enc->in_block) ? value : zigzag_encode(value - p_enc->prev);
+
+    p_enc->prev = value;
+    if (++p_enc->in_block >= p_enc->block_len)
+    {
+        p_enc->in_block = 0;
+    }
+
+    return varint_put(code, p_out);
+}
+
+void ags10_codec_dec_init(AGS10_CodecDecTypeDef *p_dec, uint16_t block_len)
+{
+    p_dec->prev = 0;
+    p_dec->in_block = 0;
+    p_dec->block_len = block_len_get(block_len);
+}
+
+uint8_t ags10_codec_decode(AGS10_CodecDecTypeDef *p_dec, const uint8_t *p_in, uint32_t len, uint32_t *p_value)
+{
+    uint32_t code;
+    uint8_t used = varint_get(p_in, len, &code);
+
+    if (0U == used)
+    {
+        return 0;
+    }
+
+    p_dec->prev = (0U == p_dec->in_block) ? code : (p_dec->prev + zigzag_decode(code));
+    if (++p_dec->in_block >= p_dec->block_len)
+    {
+        p_dec->in_block = 0;
+    }
+
+    *p_value = p_dec->prev;
+
+    return used;
+}
+
+uint32_t ags10_codec_index(const uint8_t *p_in,
+                           uint32_t len,
+                           uint16_t block_len,
+                           uint32_t *p_offsets,
+                           uint32_t max_blocks)
+{
+    uint32_t values = 0;
+    uint32_t blocks = 0;
+
+    block_len = block_len_get(block_len);
+
+    for (uint32_t offset = 0; offset < len; offset++)
+    {
+        if (0U == (values % block_len))
+        {
+            // first byte of the first value in a block
+            if (blocks < max_blocks)
+            {
+                p_offsets[blocks] = offset;
+            }
+            blocks++;
+            values++;
+
+            while ((offset < len) && (0U != (p_in[offset] & VARINT_MORE)))
+            {
+                offset++;
+            }
+            continue;
+        }
+
+        if (0U == (p_in[offset] & VARINT_MORE))
+        {
+            values++;
+        }
+    }
+
+    return blocks;
+}
+
+bool ags10_codec_decode_at(const uint8_t *p_in,
+                           uint32_t len,
+                           uint16_t block_len,
+                           const uint32_t *p_offsets,
+                           uint32_t blocks,
+                           uint32_t pos,
+                           uint32_t *p_value)
+{
+    AGS10_CodecDecTypeDef dec;
+
+    ags10_codec_dec_init(&dec, block_len);
+
+    uint32_t block = pos / dec.block_len;
+
+    if ((block >= blocks) || (p_offsets[block] >= len))
+    {
+        return false;
+    }
+
+    uint32_t offset = p_offsets[block];
+
+    for (uint32_t idx = 0; idx <= (pos % dec.block_len); idx++)
+    {
+        uint8_t used = ags10_codec_decode(&dec, &p_in[offset], len - offset, p_value);
+
+        if (0U == used)
+        {
+            return false;
+        }
+        offset += used;
+    }
+
+    return true;
+}
+// eof
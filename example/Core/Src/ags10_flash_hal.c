@@ -0,0 +1,72 @@
+/**
+ * @file ags10_flash_hal.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_flash_hal.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static bool flash_erase(void *p_ctx, uint32_t addr)
+{
+    FLASH_EraseInitTypeDef erase = {
+        .TypeErase = FLASH_TYPEERASE_PAGES,
+        .Banks = FLASH_BANK_1,
+        .PageAddress = addr,
+        .NbPages = 1,
+    };
+    uint32_t page_error = 0;
+    HAL_StatusTypeDef status;
+
+    (void)p_ctx;
+
+    HAL_FLASH_Unlock();
+    status = HAL_FLASHEx_Erase(&erase, &page_error);
+    HAL_FLASH_Lock();
+
+    return (HAL_OK == status) && (0xFFFFFFFFU == page_error);
+}
+
+static bool flash_program(void *p_ctx, uint32_t addr, const uint16_t *p_data, uint32_t count)
+{
+    HAL_StatusTypeDef status = HAL_OK;
+
+    (void)p_ctx;
+
+    // one unlock for the whole record
+    HAL_FLASH_Unlock();
+    for (uint32_t idx = 0; (idx < count) && (HAL_OK == status); idx++)
+    {
+        status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_HALFWORD, addr + (idx * 2U), p_data[idx]);
+    }
+    HAL_FLASH_Lock();
+
+    return HAL_OK == status;
+}
+
+static void flash_read(void *p_ctx, uint32_t addr, void *p_dst, uint32_t len)
+{
+    (void)p_ctx;
+
+    memcpy(p_dst, (const void *)addr, len);
+}
+
+/*******************************************************************************
+* Public Variables
+ ******************************************************************************/
+
+const AGS10_LogFlashOpsTypeDef ags10_flash_hal_ops = {
+    .erase = flash_erase,
+    .program = flash_program,
+    .read = flash_read,
+};
+// eof
@@ -0,0 +1,175 @@
+/**
+ * @file ags10_i2c_dma.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_i2c_dma.h"
+#include "ags10_i2c_hal.h"
+
+#include <stddef.h>
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static AGS10_I2cDmaTypeDef *dma_buses[AGS10_I2C_DMA_MAX_BUSES];
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static AGS10_I2cDmaTypeDef *bus_find(I2C_HandleTypeDef *hi2c)
+{
+    for (uint32_t idx = 0; idx < AGS10_I2C_DMA_MAX_BUSES; idx++)
+    {
+        if ((NULL != dma_buses[idx]) && (hi2c == dma_buses[idx]->hi2c))
+        {
+            return dma_buses[idx];
+        }
+    }
+
+    return NULL;
+}
+
+static AGS10_StatusTypeDef dma_write(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length)
+{
+    AGS10_I2cDmaTypeDef *p_bus = (AGS10_I2cDmaTypeDef *)p_ctx;
+
+    if (AGS10_BUS_XFER_BUSY == p_bus->xfer)
+    {
+        return AGS10_ERR_BUSY;
+    }
+
+    // set before starting, the completion interrupt may fire right away
+    p_bus->xfer = AGS10_BUS_XFER_BUSY;
+
+    HAL_StatusTypeDef status = HAL_I2C_Master_Seq_Transmit_DMA(p_bus->hi2c, addr << 1, pData, length,
+                                                               I2C_FIRST_AND_LAST_FRAME);
+
+    if (HAL_OK != status)
+    {
+        p_bus->xfer = AGS10_BUS_XFER_ERROR;
+        return ags10_i2c_hal_status(p_bus->hi2c, status);
+    }
+
+    return AGS10_OK;
+}
+
+static AGS10_StatusTypeDef dma_read(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length)
+{
+    AGS10_I2cDmaTypeDef *p_bus = (AGS10_I2cDmaTypeDef *)p_ctx;
+
+    if (AGS10_BUS_XFER_BUSY == p_bus->xfer)
+    {
+        return AGS10_ERR_BUSY;
+    }
+
+    p_bus->xfer = AGS10_BUS_XFER_BUSY;
+
+    // the frame lands straight in pData (the sensor handle), no bounce buffer
+    HAL_StatusTypeDef status = HAL_I2C_Master_Seq_Receive_DMA(p_bus->hi2c, addr << 1, pData, length,
+                                                              I2C_FIRST_AND_LAST_FRAME);
+
+    if (HAL_OK != status)
+    {
+        p_bus->xfer = AGS10_BUS_XFER_ERROR;
+        return ags10_i2c_hal_status(p_bus->hi2c, status);
+    }
+
+    return AGS10_OK;
+}
+
+/* Blocking, like the HAL call; only between transfers. */
+static AGS10_StatusTypeDef dma_probe(void *p_ctx, uint8_t addr)
+{
+    AGS10_I2cDmaTypeDef *p_bus = (AGS10_I2cDmaTypeDef *)p_ctx;
+
+    if (AGS10_BUS_XFER_BUSY == p_bus->xfer)
+    {
+        return AGS10_ERR_BUSY;
+    }
+
+    return ags10_i2c_hal_probe(p_bus->hi2c, addr);
+}
+
+static void dma_delay(void *p_ctx, uint16_t ms)
+{
+    (void)p_ctx;
+    HAL_Delay(ms);
+}
+
+static uint32_t dma_get_tick_ms(void *p_ctx)
+{
+    (void)p_ctx;
+    return HAL_GetTick();
+}
+
+static AGS10_BusXferTypeDef dma_xfer_state(void *p_ctx)
+{
+    return ((AGS10_I2cDmaTypeDef *)p_ctx)->xfer;
+}
+
+/*******************************************************************************
+* Public Variables
+ ******************************************************************************/
+
+const AGS10_BusOpsTypeDef ags10_i2c_dma_bus_ops = {
+    .write       = dma_write,
+    .read        = dma_read,
+    .delay       = dma_delay,
+    .xfer_state  = dma_xfer_state,
+    .get_tick_ms = dma_get_tick_ms,
+    .probe       = dma_probe,
+};
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+bool ags10_i2c_dma_init(AGS10_I2cDmaTypeDef *p_bus, I2C_HandleTypeDef *hi2c)
+{
+    if ((NULL == p_bus) || (NULL == hi2c))
+    {
+        return false;
+    }
+
+    p_bus->hi2c = hi2c;
+    p_bus->xfer = AGS10_BUS_XFER_DONE;
+
+    for (uint32_t idx = 0; idx < AGS10_I2C_DMA_MAX_BUSES; idx++)
+    {
+        if ((NULL == dma_buses[idx]) || (p_bus == dma_buses[idx]))
+        {
+            dma_buses[idx] = p_bus;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ags10_i2c_dma_xfer_cplt(I2C_HandleTypeDef *hi2c)
+{
+    AGS10_I2cDmaTypeDef *p_bus = bus_find(hi2c);
+
+    if (NULL != p_bus)
+    {
+        p_bus->xfer = AGS10_BUS_XFER_DONE;
+    }
+}
+
+void ags10_i2c_dma_xfer_error(I2C_HandleTypeDef *hi2c)
+{
+    AGS10_I2cDmaTypeDef *p_bus = bus_find(hi2c);
+
+    if (NULL != p_bus)
+    {
+        p_bus->xfer = ags10_i2c_hal_xfer_error(HAL_I2C_GetError(hi2c));
+    }
+}
+
+// eof
@@ -0,0 +1,234 @@
+/**
+ * @file ags10_i2c_it.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_i2c_it.h"
+#include "ags10_i2c_hal.h"
+
+#include <stddef.h>
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static AGS10_I2cItTypeDef *it_buses[AGS10_I2C_IT_MAX_BUSES];
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static AGS10_I2cItTypeDef *bus_find(I2C_HandleTypeDef *hi2c)
+{
+    for (uint32_t idx = 0; idx < AGS10_I2C_IT_MAX_BUSES; idx++)
+    {
+        if ((NULL != it_buses[idx]) && (hi2c == it_buses[idx]->hi2c))
+        {
+            return it_buses[idx];
+        }
+    }
+
+    return NULL;
+}
+
+static bool it_start(AGS10_I2cItTypeDef *p_bus)
+{
+    // a completion still queued would be mistaken for this transfer's
+    (void)ags10_i2c_it_process(p_bus);
+
+    if (AGS10_BUS_XFER_BUSY == p_bus->xfer)
+    {
+        return false;
+    }
+
+    p_bus->xfer = AGS10_BUS_XFER_BUSY;
+
+    return true;
+}
+
+static AGS10_StatusTypeDef it_write(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length)
+{
+    AGS10_I2cItTypeDef *p_bus = (AGS10_I2cItTypeDef *)p_ctx;
+
+    if (!it_start(p_bus))
+    {
+        return AGS10_ERR_BUSY;
+    }
+
+    HAL_StatusTypeDef status = HAL_I2C_Master_Transmit_IT(p_bus->hi2c, addr << 1, pData, length);
+
+    if (HAL_OK != status)
+    {
+        p_bus->xfer = AGS10_BUS_XFER_ERROR;
+        p_bus->last_error = HAL_I2C_GetError(p_bus->hi2c);
+        return ags10_i2c_hal_status(p_bus->hi2c, status);
+    }
+
+    return AGS10_OK;
+}
+
+static AGS10_StatusTypeDef it_read(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length)
+{
+    AGS10_I2cItTypeDef *p_bus = (AGS10_I2cItTypeDef *)p_ctx;
+
+    if (!it_start(p_bus))
+    {
+        return AGS10_ERR_BUSY;
+    }
+
+    HAL_StatusTypeDef status = HAL_I2C_Master_Receive_IT(p_bus->hi2c, addr << 1, pData, length);
+
+    if (HAL_OK != status)
+    {
+        p_bus->xfer = AGS10_BUS_XFER_ERROR;
+        p_bus->last_error = HAL_I2C_GetError(p_bus->hi2c);
+        return ags10_i2c_hal_status(p_bus->hi2c, status);
+    }
+
+    return AGS10_OK;
+}
+
+/* Blocking, like the HAL call; only between transfers. */
+static AGS10_StatusTypeDef it_probe(void *p_ctx, uint8_t addr)
+{
+    AGS10_I2cItTypeDef *p_bus = (AGS10_I2cItTypeDef *)p_ctx;
+
+    (void)ags10_i2c_it_process(p_bus);
+
+    if (AGS10_BUS_XFER_BUSY == p_bus->xfer)
+    {
+        return AGS10_ERR_BUSY;
+    }
+
+    return ags10_i2c_hal_probe(p_bus->hi2c, addr);
+}
+
+static void it_delay(void *p_ctx, uint16_t ms)
+{
+    (void)p_ctx;
+    HAL_Delay(ms);
+}
+
+static uint32_t it_get_tick_ms(void *p_ctx)
+{
+    (void)p_ctx;
+    return HAL_GetTick();
+}
+
+static AGS10_BusXferTypeDef it_xfer_state(void *p_ctx)
+{
+    AGS10_I2cItTypeDef *p_bus = (AGS10_I2cItTypeDef *)p_ctx;
+
+    (void)ags10_i2c_it_process(p_bus);
+
+    return p_bus->xfer;
+}
+
+/*******************************************************************************
+* Public Variables
+ ******************************************************************************/
+
+const AGS10_BusOpsTypeDef ags10_i2c_it_bus_ops = {
+    .write       = it_write,
+    .read        = it_read,
+    .delay       = it_delay,
+    .xfer_state  = it_xfer_state,
+    .get_tick_ms = it_get_tick_ms,
+    .probe       = it_probe,
+};
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+bool ags10_i2c_it_init(AGS10_I2cItTypeDef *p_bus, I2C_HandleTypeDef *hi2c)
+{
+    if ((NULL == p_bus) || (NULL == hi2c))
+    {
+        return false;
+    }
+
+    p_bus->hi2c = hi2c;
+    p_bus->xfer = AGS10_BUS_XFER_DONE;
+    p_bus->last_error = HAL_I2C_ERROR_NONE;
+    p_bus->evq_head = 0;
+    p_bus->evq_tail = 0;
+    p_bus->evq_dropped = 0;
+
+    for (uint32_t idx = 0; idx < AGS10_I2C_IT_MAX_BUSES; idx++)
+    {
+        if ((NULL == it_buses[idx]) || (p_bus == it_buses[idx]))
+        {
+            it_buses[idx] = p_bus;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+uint32_t ags10_i2c_it_process(AGS10_I2cItTypeDef *p_bus)
+{
+    uint32_t consumed = 0;
+    uint32_t tail = p_bus->evq_tail;
+    uint32_t head = p_bus->evq_head;
+
+    // read the slots only after seeing the head that published them
+    __DMB();
+
+    while (tail != head)
+    {
+        const AGS10_I2cItEvtTypeDef *p_evt = &p_bus->evq[tail & (AGS10_I2C_IT_EVQ_LEN - 1U)];
+
+        if (AGS10_I2C_IT_EVT_ERROR == p_evt->event)
+        {
+            p_bus->xfer = ags10_i2c_hal_xfer_error(p_evt->error);
+            p_bus->last_error = p_evt->error;
+        }
+        else
+        {
+            p_bus->xfer = AGS10_BUS_XFER_DONE;
+        }
+
+        tail++;
+        consumed++;
+    }
+
+    __DMB();
+    p_bus->evq_tail = tail;
+
+    return consumed;
+}
+
+void ags10_i2c_it_isr_event(I2C_HandleTypeDef *hi2c, AGS10_I2cItEventTypeDef event)
+{
+    AGS10_I2cItTypeDef *p_bus = bus_find(hi2c);
+
+    if (NULL == p_bus)
+    {
+        return;
+    }
+
+    uint32_t head = p_bus->evq_head;
+
+    if ((head - p_bus->evq_tail) >= AGS10_I2C_IT_EVQ_LEN)
+    {
+        p_bus->evq_dropped++;
+        return;
+    }
+
+    AGS10_I2cItEvtTypeDef *p_evt = &p_bus->evq[head & (AGS10_I2C_IT_EVQ_LEN - 1U)];
+
+    p_evt->event = (uint8_t)event;
+    p_evt->error = (AGS10_I2C_IT_EVT_ERROR == event) ? HAL_I2C_GetError(hi2c) : HAL_I2C_ERROR_NONE;
+    p_evt->tick = HAL_GetTick();
+
+    // publish the slot before moving the head the consumer watches
+    __DMB();
+    p_bus->evq_head = head + 1U;
+}
+// eof
@@ -0,0 +1,175 @@
+/**
+ * @file ags10_i2c_recover.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_i2c_recover.h"
+
+#include <stddef.h>
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static uint32_t cycles_per_us(void)
+{
+    uint32_t cycles = SystemCoreClock / 1000000U;
+
+    return (0U == cycles) ? 1U : cycles;
+}
+
+static void delay_us(uint32_t us)
+{
+    uint32_t start = DWT->CYCCNT;
+    uint32_t cycles = us * cycles_per_us();
+
+    while ((DWT->CYCCNT - start) < cycles)
+    {
+    }
+}
+
+static bool line_low(GPIO_TypeDef *port, uint16_t pin)
+{
+    return GPIO_PIN_RESET == HAL_GPIO_ReadPin(port, pin);
+}
+
+static void line_set(GPIO_TypeDef *port, uint16_t pin, bool high)
+{
+    HAL_GPIO_WritePin(port, pin, high ? GPIO_PIN_SET : GPIO_PIN_RESET);
+}
+
+static void pins_gpio(const AGS10_I2cRecoverTypeDef *p_rec)
+{
+    GPIO_InitTypeDef init = {0};
+
+    // released (high) before switching, so the switch itself is no edge
+    line_set(p_rec->scl_port, p_rec->scl_pin, true);
+    line_set(p_rec->sda_port, p_rec->sda_pin, true);
+
+    init.Mode = GPIO_MODE_OUTPUT_OD;
+    init.Pull = GPIO_NOPULL;
+    init.Speed = GPIO_SPEED_FREQ_HIGH;
+    init.Pin = p_rec->scl_pin;
+    HAL_GPIO_Init(p_rec->scl_port, &init);
+    init.Pin = p_rec->sda_pin;
+    HAL_GPIO_Init(p_rec->sda_port, &init);
+}
+
+/* Pulse the peripheral's RCC reset; this also clears a BUSY flag the analog filter latched (F1 errata). */
+static void peripheral_reset(const I2C_HandleTypeDef *hi2c)
+{
+    if (I2C1 == hi2c->Instance)
+    {
+        __HAL_RCC_I2C1_FORCE_RESET();
+        __HAL_RCC_I2C1_RELEASE_RESET();
+    }
+#if defined(I2C2)
+    else if (I2C2 == hi2c->Instance)
+    {
+        __HAL_RCC_I2C2_FORCE_RESET();
+        __HAL_RCC_I2C2_RELEASE_RESET();
+    }
+#endif
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+bool ags10_i2c_recover_needed(const AGS10_I2cRecoverTypeDef *p_rec, AGS10_StatusTypeDef status)
+{
+    if ((NULL == p_rec) || (NULL == p_rec->hi2c))
+    {
+        return false;
+    }
+
+    if ((AGS10_ERR_BUSY != status) && (AGS10_ERR_BUS != status) && (AGS10_ERR_TIMEOUT != status))
+    {
+        return false;
+    }
+
+    I2C_HandleTypeDef *hi2c = p_rec->hi2c;
+
+    if (HAL_I2C_STATE_READY != HAL_I2C_GetState(hi2c))
+    {
+        // an interrupt or DMA transfer is still running
+        return false;
+    }
+
+    if (0U != (HAL_I2C_GetError(hi2c) & (HAL_I2C_ERROR_BERR | HAL_I2C_ERROR_ARLO | HAL_I2C_ERROR_TIMEOUT)))
+    {
+        return true;
+    }
+
+    // nothing is on the bus, yet the peripheral or a line says otherwise
+    return (RESET != __HAL_I2C_GET_FLAG(hi2c, I2C_FLAG_BUSY)) ||
+           line_low(p_rec->sda_port, p_rec->sda_pin) ||
+           line_low(p_rec->scl_port, p_rec->scl_pin);
+}
+
+bool ags10_i2c_recover(AGS10_I2cRecoverTypeDef *p_rec)
+{
+    if ((NULL == p_rec) || (NULL == p_rec->hi2c) || (NULL == p_rec->reinit))
+    {
+        return false;
+    }
+
+    uint32_t start = DWT->CYCCNT;
+    uint32_t half_us = (0U == p_rec->half_period_us) ? 5U : p_rec->half_period_us;
+
+    (void)HAL_I2C_DeInit(p_rec->hi2c);
+    pins_gpio(p_rec);
+
+    // clock out whatever byte the slave is stuck in; it lets go of SDA at
+    // the latest on the ninth (acknowledge) clock
+    for (uint32_t pulse = 0; pulse < AGS10_I2C_RECOVER_PULSES; pulse++)
+    {
+        if (!line_low(p_rec->sda_port, p_rec->sda_pin))
+        {
+            break;
+        }
+
+        line_set(p_rec->scl_port, p_rec->scl_pin, false);
+        delay_us(half_us);
+        line_set(p_rec->scl_port, p_rec->scl_pin, true);
+        delay_us(half_us);
+    }
+
+    // STOP: SDA rises while SCL is high
+    line_set(p_rec->scl_port, p_rec->scl_pin, false);
+    delay_us(half_us);
+    line_set(p_rec->sda_port, p_rec->sda_pin, false);
+    delay_us(half_us);
+    line_set(p_rec->scl_port, p_rec->scl_pin, true);
+    delay_us(half_us);
+    line_set(p_rec->sda_port, p_rec->sda_pin, true);
+    delay_us(half_us);
+
+    bool released = !line_low(p_rec->sda_port, p_rec->sda_pin) &&
+                    !line_low(p_rec->scl_port, p_rec->scl_pin);
+
+    // reinit runs HAL_I2C_MspInit(), which hands the pins back to the peripheral
+    peripheral_reset(p_rec->hi2c);
+    p_rec->reinit();
+
+    uint32_t us = (DWT->CYCCNT - start) / cycles_per_us();
+
+    p_rec->count++;
+    p_rec->last_us = us;
+    if (us > p_rec->max_us)
+    {
+        p_rec->max_us = us;
+    }
+    if (!released)
+    {
+        p_rec->failed++;
+    }
+
+    return released;
+}
+// eof
@@ -0,0 +1,461 @@
+/**
+ * @file ags10_log.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_log.h"
+#include "ags10_codec.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define LOG_REC_HW                  ((AGS10_LOG_REC_MAX_LEN + 1U) / 2U)
+#define LOG_BLANK_CHUNK             32U
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static uint32_t page_addr(const AGS10_LogTypeDef *p_log, uint16_t page)
+{
+    return p_log->base + ((uint32_t)page * p_log->page_size);
+}
+
+static uint16_t page_next(const AGS10_LogTypeDef *p_log, uint16_t page)
+{
+    return (uint16_t)((page + 1U) % p_log->page_count);
+}
+
+static uint16_t hw_get(const uint8_t *p_bytes)
+{
+    return (uint16_t)(p_bytes[0] | ((uint16_t)p_bytes[1] << 8));
+}
+
+static uint8_t crc_get(const uint8_t *p_bytes, uint32_t len)
+{
+    return ags10_crc8(p_bytes, (int)len);
+}
+
+/* Half-words as the flash stores them, independent of host byte order. */
+static void hw_pack(uint16_t *p_hw, const uint8_t *p_bytes, uint32_t len)
+{
+    for (uint32_t idx = 0; idx < len; idx += 2U)
+    {
+        p_hw[idx / 2U] = hw_get(&p_bytes[idx]);
+    }
+}
+
+static bool page_header_get(const AGS10_LogTypeDef *p_log, uint16_t page, uint32_t *p_seq)
+{
+    uint8_t hdr[AGS10_LOG_PAGE_HDR_LEN];
+
+    p_log->p_ops->read(p_log->p_ctx, page_addr(p_log, page), hdr, sizeof(hdr));
+
+    if ((AGS10_LOG_PAGE_MAGIC != hw_get(&hdr[0])) || (0U != hdr[7]) ||
+        (crc_get(hdr, 6U) != hdr[6]))
+    {
+        return false;
+    }
+
+    *p_seq = (uint32_t)hw_get(&hdr[2]) | ((uint32_t)hw_get(&hdr[4]) << 16);
+
+    return true;
+}
+
+static bool page_blank(const AGS10_LogTypeDef *p_log, uint16_t page)
+{
+    uint8_t chunk[LOG_BLANK_CHUNK];
+
+    for (uint32_t off = 0; off < p_log->page_size; off += sizeof(chunk))
+    {
+        uint32_t len = ((p_log->page_size - off) < sizeof(chunk)) ? (p_log->page_size - off) : sizeof(chunk);
+
+        p_log->p_ops->read(p_log->p_ctx, page_addr(p_log, page) + off, chunk, len);
+        for (uint32_t idx = 0; idx < len; idx++)
+        {
+            if (0xFFU != chunk[idx])
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/* Erase (unless already blank) and head a page; it becomes the head. */
+static bool page_open(AGS10_LogTypeDef *p_log, uint16_t page, uint32_t seq)
+{
+    uint8_t hdr[AGS10_LOG_PAGE_HDR_LEN] = {
+        (uint8_t)AGS10_LOG_PAGE_MAGIC, (uint8_t)(AGS10_LOG_PAGE_MAGIC >> 8),
+        (uint8_t)seq, (uint8_t)(seq >> 8), (uint8_t)(seq >> 16), (uint8_t)(seq >> 24),
+        0, 0,
+    };
+    uint16_t hw[AGS10_LOG_PAGE_HDR_LEN / 2U];
+
+    if (!page_blank(p_log, page))
+    {
+        p_log->erases++;
+        if (!p_log->p_ops->erase(p_log->p_ctx, page_addr(p_log, page)))
+        {
+            return false;
+        }
+    }
+
+    hdr[6] = crc_get(hdr, 6U);
+    hw_pack(hw, hdr, sizeof(hdr));
+
+    // committed before any record lands in the page
+    p_log->head_page = page;
+    p_log->head_seq = seq;
+    p_log->head_off = p_log->page_size;
+
+    if (!p_log->p_ops->program(p_log->p_ctx, page_addr(p_log, page), hw, AGS10_LOG_PAGE_HDR_LEN / 2U))
+    {
+        return false;
+    }
+
+    p_log->head_off = AGS10_LOG_PAGE_HDR_LEN;
+
+    return true;
+}
+
+/* Total flash bytes of a record with this header, 0 if the header is not one. */
+static uint32_t record_size(uint16_t hdr)
+{
+    uint32_t len = hdr & AGS10_LOG_REC_LEN_MSK;
+
+    if ((AGS10_LOG_REC_MAGIC != (hdr & (uint16_t)~AGS10_LOG_REC_LEN_MSK)) ||
+        (0U == len) || ((AGS10_LOG_REC_MAX_LEN - 4U) < len))
+    {
+        return 0;
+    }
+
+    return 2U + ((len + 1U) & ~1U) + 2U;
+}
+
+static uint32_t record_encode(const AGS10_LogTypeDef *p_log, uint8_t *p_rec)
+{
+    AGS10_CodecEncTypeDef enc_t;
+    AGS10_CodecEncTypeDef enc_tvoc;
+    AGS10_CodecEncTypeDef enc_res;
+    uint32_t len = 3U;
+
+    ags10_codec_enc_init(&enc_t, AGS10_LOG_BATCH);
+    ags10_codec_enc_init(&enc_tvoc, AGS10_LOG_BATCH);
+    ags10_codec_enc_init(&enc_res, AGS10_LOG_BATCH);
+
+    p_rec[2] = (uint8_t)p_log->batch_count;
+    for (uint16_t idx = 0; idx < p_log->batch_count; idx++)
+    {
+        const AGS10_RingSampleTypeDef *p_sample = &p_log->batch[idx];
+
+        len += ags10_codec_encode(&enc_t, p_sample->t_ms, &p_rec[len]);
+        len += ags10_codec_encode(&enc_tvoc, (p_sample->tvoc & AGS10_RING_TVOC_MAX) |
+                                             ((uint32_t)p_sample->status << 24), &p_rec[len]);
+        len += ags10_codec_encode(&enc_res, p_sample->resistance, &p_rec[len]);
+    }
+
+    uint32_t payload = len - 2U;
+    uint16_t hdr = (uint16_t)(AGS10_LOG_REC_MAGIC | payload);
+
+    p_rec[0] = (uint8_t)hdr;
+    p_rec[1] = (uint8_t)(hdr >> 8);
+    if (0U != (len & 1U))
+    {
+        p_rec[len++] = 0;
+    }
+
+    p_rec[len] = crc_get(p_rec, len);
+    p_rec[len + 1U] = 0;
+
+    return len + 2U;
+}
+
+static uint32_t record_visit(const uint8_t *p_rec, uint32_t size, AGS10_LogVisitFn visit, void *p_ctx, bool *p_stop)
+{
+    AGS10_CodecDecTypeDef dec_t;
+    AGS10_CodecDecTypeDef dec_tvoc;
+    AGS10_CodecDecTypeDef dec_res;
+    uint32_t end = 2U + (hw_get(p_rec) & AGS10_LOG_REC_LEN_MSK);
+    uint32_t off = 3U;
+    uint32_t visited = 0;
+
+    (void)size;
+    ags10_codec_dec_init(&dec_t, AGS10_LOG_BATCH);
+    ags10_codec_dec_init(&dec_tvoc, AGS10_LOG_BATCH);
+    ags10_codec_dec_init(&dec_res, AGS10_LOG_BATCH);
+
+    for (uint8_t idx = 0; (idx < p_rec[2]) && !*p_stop; idx++)
+    {
+        AGS10_RingSampleTypeDef sample;
+        uint32_t word;
+        uint8_t used;
+
+        if ((0U == (used = ags10_codec_decode(&dec_t, &p_rec[off], end - off, &sample.t_ms))) ||
+            (0U == (off += used, used = ags10_codec_decode(&dec_tvoc, &p_rec[off], end - off, &word))) ||
+            (0U == (off += used, used = ags10_codec_decode(&dec_res, &p_rec[off], end - off, &sample.resistance))))
+        {
+            break;
+        }
+        off += used;
+
+        sample.tvoc = word & AGS10_RING_TVOC_MAX;
+        sample.status = (uint8_t)(word >> 24);
+        visited++;
+        *p_stop = !visit(p_ctx, &sample);
+    }
+
+    return visited;
+}
+
+/* Read the record at off; its total size, or 0 past the last record. Sets *p_valid on a good CRC. */
+static uint32_t record_read(const AGS10_LogTypeDef *p_log, uint16_t page, uint32_t off, uint8_t *p_rec, bool *p_valid)
+{
+    *p_valid = false;
+    if ((off + 2U) > p_log->page_size)
+    {
+        return 0;
+    }
+
+    p_log->p_ops->read(p_log->p_ctx, page_addr(p_log, page) + off, p_rec, 2U);
+
+    uint32_t size = record_size(hw_get(p_rec));
+
+    if ((0U == size) || ((off + size) > p_log->page_size))
+    {
+        return 0;
+    }
+
+    p_log->p_ops->read(p_log->p_ctx, page_addr(p_log, page) + off + 2U, &p_rec[2], size - 2U);
+    *p_valid = (0U == p_rec[size - 1U]) && (crc_get(p_rec, size - 2U) == p_rec[size - 2U]);
+
+    return size;
+}
+
+static AGS10_StatusTypeDef log_write(AGS10_LogTypeDef *p_log)
+{
+    uint8_t rec[LOG_REC_HW * 2U];
+    uint16_t hw[LOG_REC_HW];
+    uint32_t size = record_encode(p_log, rec);
+
+    if ((p_log->head_off + size) > p_log->page_size)
+    {
+        uint16_t next = page_next(p_log, p_log->head_page);
+
+        if (next == p_log->tail_page)
+        {
+            // recycle the oldest page
+            p_log->tail_page = page_next(p_log, next);
+        }
+
+        if (!page_open(p_log, next, p_log->head_seq + 1U))
+        {
+            return AGS10_ERR_BUS;
+        }
+    }
+
+    uint32_t addr = page_addr(p_log, p_log->head_page) + p_log->head_off;
+
+    hw_pack(hw, rec, size);
+
+    // a failed write may have left half a record; never write over it
+    p_log->head_off += size;
+
+    if (!p_log->p_ops->program(p_log->p_ctx, addr, hw, size / 2U))
+    {
+        return AGS10_ERR_BUS;
+    }
+
+    p_log->records++;
+    p_log->batch_count = 0;
+
+    return AGS10_OK;
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+AGS10_StatusTypeDef ags10_log_mount(AGS10_LogTypeDef *p_log,
+                                    const AGS10_LogFlashOpsTypeDef *p_ops,
+                                    void *p_ctx,
+                                    uint32_t base,
+                                    uint32_t page_size,
+                                    uint16_t page_count)
+{
+    if ((NULL == p_log) || (NULL == p_ops) || (NULL == p_ops->erase) || (NULL == p_ops->program) ||
+        (NULL == p_ops->read) || (page_count < 2U) || (0U != (page_size & 1U)) ||
+        (page_size < (AGS10_LOG_PAGE_HDR_LEN + AGS10_LOG_REC_MAX_LEN + 1U)))
+    {
+        return AGS10_ERR_PARAM;
+    }
+
+    memset(p_log, 0, sizeof(*p_log));
+    p_log->p_ops = p_ops;
+    p_log->p_ctx = p_ctx;
+    p_log->base = base;
+    p_log->page_size = page_size;
+    p_log->page_count = page_count;
+
+    bool found = false;
+    uint32_t tail_seq = 0;
+
+    // headers only: the newest page is the head, the oldest the tail
+    for (uint16_t page = 0; page < page_count; page++)
+    {
+        uint32_t seq;
+
+        if (!page_header_get(p_log, page, &seq))
+        {
+            continue;
+        }
+
+        if (!found || (seq > p_log->head_seq))
+        {
+            p_log->head_seq = seq;
+            p_log->head_page = page;
+        }
+        if (!found || (seq < tail_seq))
+        {
+            tail_seq = seq;
+            p_log->tail_page = page;
+        }
+        found = true;
+    }
+
+    if (!found)
+    {
+        p_log->tail_page = 0;
+        if (!page_open(p_log, 0, 1U))
+        {
+            return AGS10_ERR_BUS;
+        }
+        p_log->mounted = true;
+        return AGS10_OK;
+    }
+
+    // walk the head page alone for the append point
+    uint8_t rec[LOG_REC_HW * 2U];
+    uint32_t off = AGS10_LOG_PAGE_HDR_LEN;
+
+    for (;;)
+    {
+        bool valid;
+        uint32_t size = record_read(p_log, p_log->head_page, off, rec, &valid);
+
+        if (0U == size)
+        {
+            break;
+        }
+        if (!valid)
+        {
+            p_log->bad_records++;
+        }
+        off += size;
+    }
+
+    if (((off + 2U) <= p_log->page_size) &&
+        (AGS10_LOG_ERASED != (p_log->p_ops->read(p_log->p_ctx, page_addr(p_log, p_log->head_page) + off, rec, 2U),
+                              hw_get(rec))))
+    {
+        // neither a record nor free space: close the page
+        p_log->bad_records++;
+        off = p_log->page_size;
+    }
+
+    p_log->head_off = off;
+    p_log->mounted = true;
+
+    return AGS10_OK;
+}
+
+AGS10_StatusTypeDef ags10_log_append(AGS10_LogTypeDef *p_log, const AGS10_RingSampleTypeDef *p_sample)
+{
+    if ((NULL == p_log) || !p_log->mounted || (NULL == p_sample))
+    {
+        return AGS10_ERR_PARAM;
+    }
+
+    if (p_log->batch_count >= AGS10_LOG_BATCH)
+    {
+        // an earlier write failed; try it again before taking more
+        AGS10_StatusTypeDef status = log_write(p_log);
+
+        if (AGS10_OK != status)
+        {
+            return status;
+        }
+    }
+
+    p_log->batch[p_log->batch_count++] = *p_sample;
+
+    return (p_log->batch_count >= AGS10_LOG_BATCH) ? log_write(p_log) : AGS10_OK;
+}
+
+AGS10_StatusTypeDef ags10_log_flush(AGS10_LogTypeDef *p_log)
+{
+    if ((NULL == p_log) || !p_log->mounted)
+    {
+        return AGS10_ERR_PARAM;
+    }
+
+    return (0U == p_log->batch_count) ? AGS10_OK : log_write(p_log);
+}
+
+uint32_t ags10_log_read(const AGS10_LogTypeDef *p_log, AGS10_LogVisitFn visit, void *p_ctx)
+{
+    uint8_t rec[LOG_REC_HW * 2U];
+    uint32_t visited = 0;
+    bool stop = false;
+
+    if ((NULL == p_log) || !p_log->mounted || (NULL == visit))
+    {
+        return 0;
+    }
+
+    uint16_t page = p_log->tail_page;
+
+    for (uint16_t step = 0; (step < p_log->page_count) && !stop; step++)
+    {
+        uint32_t seq;
+
+        if (page_header_get(p_log, page, &seq))
+        {
+            uint32_t end = (page == p_log->head_page) ? p_log->head_off : p_log->page_size;
+
+            for (uint32_t off = AGS10_LOG_PAGE_HDR_LEN; (off < end) && !stop;)
+            {
+                bool valid;
+                uint32_t size = record_read(p_log, page, off, rec, &valid);
+
+                if (0U == size)
+                {
+                    break;
+                }
+                if (valid)
+                {
+                    visited += record_visit(rec, size, visit, p_ctx, &stop);
+                }
+                off += size;
+            }
+        }
+
+        if (page == p_log->head_page)
+        {
+            break;
+        }
+        page = page_next(p_log, page);
+    }
+
+    return visited;
+}
+// eof
@@ -0,0 +1,161 @@
+/**
+ * @file ags10_prof.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#if !(defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L     // clock_gettime()
+#endif
+
+#include "ags10_prof.h"
+
+#if AGS10_PROF_ENABLE
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#if !(defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__))
+#include <time.h>
+#endif
+
+/*******************************************************************************
+* Private Defines
+ ******************************************************************************/
+#define DEMCR_REG          (*(volatile uint32_t *)0xE000EDFCUL)
+#define DEMCR_TRCENA       (1UL << 24)
+#define DWT_CTRL_REG       (*(volatile uint32_t *)0xE0001000UL)
+#define DWT_CTRL_CYCCNTENA (1UL << 0)
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static AGS10_ProfEntryTypeDef prof_table[AGS10_PROF_PHASE_COUNT];
+
+static const char *const prof_phase_names[AGS10_PROF_PHASE_COUNT] = {
+    [AGS10_PROF_PTR_WRITE]  = "ptr_write",
+    [AGS10_PROF_CONVERT]    = "convert",
+    [AGS10_PROF_FRAME_READ] = "frame_read",
+    [AGS10_PROF_CRC]        = "crc",
+    [AGS10_PROF_UNPACK]     = "unpack",
+};
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+void ags10_prof_init(void)
+{
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+    DEMCR_REG |= DEMCR_TRCENA;
+    DWT_CTRL_REG |= DWT_CTRL_CYCCNTENA;
+#endif
+
+    ags10_prof_reset();
+}
+
+void ags10_prof_reset(void)
+{
+    memset(prof_table, 0, sizeof(prof_table));
+}
+
+void ags10_prof_record(AGS10_ProfPhaseTypeDef phase, uint32_t ticks)
+{
+    if ((unsigned)phase >= AGS10_PROF_PHASE_COUNT)
+    {
+        return;
+    }
+
+    AGS10_ProfEntryTypeDef *p_entry = &prof_table[phase];
+
+    if ((0U == p_entry->count) || (ticks < p_entry->min))
+    {
+        p_entry->min = ticks;
+    }
+
+    if (ticks > p_entry->max)
+    {
+        p_entry->max = ticks;
+    }
+
+    p_entry->count++;
+    p_entry->total += ticks;
+}
+
+void ags10_prof_lap(uint32_t *p_mark, AGS10_ProfPhaseTypeDef phase)
+{
+    uint32_t now = AGS10_PROF_CLOCK();
+
+    // unsigned subtraction keeps this correct across counter wrap-around
+    ags10_prof_record(phase, now - *p_mark);
+
+    // the bookkeeping above is charged to nobody, the next phase starts here
+    *p_mark = AGS10_PROF_CLOCK();
+}
+
+const AGS10_ProfEntryTypeDef *ags10_prof_entry_get(AGS10_ProfPhaseTypeDef phase)
+{
+    if ((unsigned)phase >= AGS10_PROF_PHASE_COUNT)
+    {
+        return NULL;
+    }
+
+    return &prof_table[phase];
+}
+
+const char *ags10_prof_phase_name(AGS10_ProfPhaseTypeDef phase)
+{
+    if ((unsigned)phase >= AGS10_PROF_PHASE_COUNT)
+    {
+        return "?";
+    }
+
+    return prof_phase_names[phase];
+}
+
+void ags10_prof_dump(AGS10_ProfPutFn put, void *p_ctx)
+{
+    char line[AGS10_PROF_LINE_LEN + 1U];
+
+    if (NULL == put)
+    {
+        return;
+    }
+
+    (void)snprintf(line, sizeof(line), "%-10s %8s %10s %10s %10s %s",
+                   "phase", "count", "min", "max", "mean", AGS10_PROF_UNIT);
+    put(p_ctx, line);
+
+    for (uint32_t idx = 0; idx < AGS10_PROF_PHASE_COUNT; idx++)
+    {
+        const AGS10_ProfEntryTypeDef *p_entry = &prof_table[idx];
+        uint32_t mean = (0U == p_entry->count) ? 0U : (uint32_t)(p_entry->total / p_entry->count);
+
+        (void)snprintf(line, sizeof(line), "%-10s %8lu %10lu %10lu %10lu",
+                       prof_phase_names[idx],
+                       (unsigned long)p_entry->count,
+                       (unsigned long)p_entry->min,
+                       (unsigned long)p_entry->max,
+                       (unsigned long)mean);
+        put(p_ctx, line);
+    }
+}
+
+#if !(defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__))
+uint32_t ags10_prof_clock_host(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+#endif
+
+#endif /* AGS10_PROF_ENABLE */
+// eof
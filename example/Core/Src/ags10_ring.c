@@ -0,0 +1,175 @@
+/**
+ * @file ags10_ring.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_ring.h"
+
+#include <stddef.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define RING_MSK                    (AGS10_RING_LEN - 1U)
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static void entry_get(const AGS10_RingTypeDef *p_ring, uint32_t pos, uint32_t prev_ms,
+                      AGS10_RingSampleTypeDef *p_sample)
+{
+    uint32_t idx = pos & RING_MSK;
+    const uint8_t *p_tvoc = p_ring->tvoc[idx];
+
+    p_sample->t_ms = prev_ms + p_ring->dt_ms[idx];
+    p_sample->tvoc = ((uint32_t)p_tvoc[0] << 16) | ((uint32_t)p_tvoc[1] << 8) | p_tvoc[2];
+    p_sample->resistance = ags10_ring_res_decode(p_ring->res_code[idx]);
+    p_sample->status = p_ring->status[idx];
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+void ags10_ring_init(AGS10_RingTypeDef *p_ring, uint32_t now_ms)
+{
+    atomic_init(&p_ring->head, 0U);
+    atomic_init(&p_ring->tail, 0U);
+    p_ring->push_ms = now_ms;
+    p_ring->pop_ms = now_ms;
+    p_ring->dropped = 0;
+}
+
+bool ags10_ring_push(AGS10_RingTypeDef *p_ring, const AGS10_RingSampleTypeDef *p_sample)
+{
+    uint32_t head = atomic_load_explicit(&p_ring->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&p_ring->tail, memory_order_acquire);
+
+    if ((head - tail) >= AGS10_RING_LEN)
+    {
+        p_ring->dropped++;
+        return false;
+    }
+
+    uint32_t idx = head & RING_MSK;
+    uint32_t tvoc = (p_sample->tvoc > AGS10_RING_TVOC_MAX) ? AGS10_RING_TVOC_MAX : p_sample->tvoc;
+    uint32_t dt_ms = p_sample->t_ms - p_ring->push_ms;
+
+    p_ring->tvoc[idx][0] = (uint8_t)(tvoc >> 16);
+    p_ring->tvoc[idx][1] = (uint8_t)(tvoc >> 8);
+    p_ring->tvoc[idx][2] = (uint8_t)tvoc;
+    p_ring->res_code[idx] = ags10_ring_res_encode(p_sample->resistance);
+    p_ring->status[idx] = p_sample->status;
+    p_ring->dt_ms[idx] = (uint16_t)((dt_ms > AGS10_RING_DT_MAX_MS) ? AGS10_RING_DT_MAX_MS : dt_ms);
+    p_ring->push_ms += p_ring->dt_ms[idx];
+
+    // publish only after the entry is complete
+    atomic_store_explicit(&p_ring->head, head + 1U, memory_order_release);
+
+    return true;
+}
+
+bool ags10_ring_pop(AGS10_RingTypeDef *p_ring, AGS10_RingSampleTypeDef *p_sample)
+{
+    uint32_t tail = atomic_load_explicit(&p_ring->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&p_ring->head, memory_order_acquire);
+
+    if (head == tail)
+    {
+        return false;
+    }
+
+    entry_get(p_ring, tail, p_ring->pop_ms, p_sample);
+    p_ring->pop_ms = p_sample->t_ms;
+
+    // the slot may be overwritten as soon as tail moves
+    atomic_store_explicit(&p_ring->tail, tail + 1U, memory_order_release);
+
+    return true;
+}
+
+uint32_t ags10_ring_read(const AGS10_RingTypeDef *p_ring,
+                         uint32_t first,
+                         AGS10_RingSampleTypeDef *p_samples,
+                         uint32_t count)
+{
+    uint32_t tail = atomic_load_explicit(&p_ring->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&p_ring->head, memory_order_acquire);
+    uint32_t stored = head - tail;
+    uint32_t t_ms = p_ring->pop_ms;
+    uint32_t copied = 0;
+
+    for (uint32_t pos = 0; (pos < stored) && (copied < count); pos++)
+    {
+        AGS10_RingSampleTypeDef sample;
+
+        entry_get(p_ring, tail + pos, t_ms, &sample);
+        t_ms = sample.t_ms;
+
+        if (pos >= first)
+        {
+            p_samples[copied++] = sample;
+        }
+    }
+
+    return copied;
+}
+
+uint32_t ags10_ring_discard(AGS10_RingTypeDef *p_ring, uint32_t count)
+{
+    uint32_t tail = atomic_load_explicit(&p_ring->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&p_ring->head, memory_order_acquire);
+    uint32_t stored = head - tail;
+
+    if (count > stored)
+    {
+        count = stored;
+    }
+
+    for (uint32_t pos = 0; pos < count; pos++)
+    {
+        p_ring->pop_ms += p_ring->dt_ms[(tail + pos) & RING_MSK];
+    }
+
+    atomic_store_explicit(&p_ring->tail, tail + count, memory_order_release);
+
+    return count;
+}
+
+uint32_t ags10_ring_count(const AGS10_RingTypeDef *p_ring)
+{
+    uint32_t tail = atomic_load_explicit(&p_ring->tail, memory_order_acquire);
+    uint32_t head = atomic_load_explicit(&p_ring->head, memory_order_acquire);
+
+    return head - tail;
+}
+
+uint16_t ags10_ring_res_encode(uint32_t resistance)
+{
+    uint32_t exponent = 0;
+
+    while (resistance > AGS10_RING_RES_MANT_MSK)
+    {
+        resistance >>= 1;
+        exponent++;
+    }
+
+    if (exponent > (AGS10_RING_RES_CODE_MAX >> AGS10_RING_RES_MANT_BITS))
+    {
+        return AGS10_RING_RES_CODE_MAX;
+    }
+
+    return (uint16_t)((exponent << AGS10_RING_RES_MANT_BITS) | resistance);
+}
+
+uint32_t ags10_ring_res_decode(uint16_t code)
+{
+    return (uint32_t)(code & AGS10_RING_RES_MANT_MSK) << (code >> AGS10_RING_RES_MANT_BITS);
+}
+// eof
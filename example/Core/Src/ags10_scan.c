@@ -0,0 +1,268 @@
+/**
+ * @file ags10_scan.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_scan.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static uint32_t scan_tick_ms(const AGS10_ScanBusTypeDef *p_scan)
+{
+    if (NULL == p_scan->p_bus_ops->get_tick_ms)
+    {
+        return 0;
+    }
+
+    return p_scan->p_bus_ops->get_tick_ms(p_scan->p_bus_ctx);
+}
+
+static bool scan_acked(const AGS10_ScanBusTypeDef *p_scan, uint8_t addr)
+{
+    return 0U != (p_scan->ack_map[addr >> 3] & (1U << (addr & 7U)));
+}
+
+/* Asynchronous buses return once a transfer is queued; the buffers here are on the stack. */
+static AGS10_StatusTypeDef scan_wait(const AGS10_BusOpsTypeDef *p_bus_ops, void *p_bus_ctx, AGS10_StatusTypeDef status)
+{
+    if ((AGS10_OK != status) || (NULL == p_bus_ops->xfer_state))
+    {
+        return status;
+    }
+
+    for (uint16_t waited_ms = 0; waited_ms < AGS10MA_XFER_TIMEOUT_MS; waited_ms++)
+    {
+        switch (p_bus_ops->xfer_state(p_bus_ctx))
+        {
+        case AGS10_BUS_XFER_DONE:
+            return AGS10_OK;
+        case AGS10_BUS_XFER_NACK:
+            return AGS10_ERR_NACK;
+        case AGS10_BUS_XFER_ERROR:
+            return AGS10_ERR_BUS;
+        case AGS10_BUS_XFER_BUSY:
+        default:
+            break;
+        }
+
+        p_bus_ops->delay(p_bus_ctx, 1);
+    }
+
+    return AGS10_ERR_TIMEOUT;
+}
+
+/*
+ * Waits out the version conversion from the last pointer write. Buses with a
+ * tick only wait what is left, so after one bus has waited the others on the
+ * same clock go straight on; without a tick only the first bus waits.
+ */
+static void scan_settle(const AGS10_ScanBusTypeDef *p_scan, bool *p_waited)
+{
+    if (NULL != p_scan->p_bus_ops->get_tick_ms)
+    {
+        uint32_t elapsed_ms = scan_tick_ms(p_scan) - p_scan->pointer_ms;
+
+        if (elapsed_ms < AGS10MA_VERSION_DELAY_MS)
+        {
+            p_scan->p_bus_ops->delay(p_scan->p_bus_ctx, (uint16_t)(AGS10MA_VERSION_DELAY_MS - elapsed_ms));
+        }
+    }
+    else if (!*p_waited)
+    {
+        p_scan->p_bus_ops->delay(p_scan->p_bus_ctx, AGS10MA_VERSION_DELAY_MS);
+    }
+
+    *p_waited = true;
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+AGS10_StatusTypeDef ags10_scan_address(const AGS10_BusOpsTypeDef *p_bus_ops, void *p_bus_ctx, uint8_t addr)
+{
+    if (NULL != p_bus_ops->probe)
+    {
+        return p_bus_ops->probe(p_bus_ctx, addr);
+    }
+
+    uint8_t none = 0;
+
+    return scan_wait(p_bus_ops, p_bus_ctx, p_bus_ops->write(p_bus_ctx, addr, &none, 0));
+}
+
+bool ags10_scan_bus_init(AGS10_ScanBusTypeDef *p_scan,
+                         const AGS10_BusOpsTypeDef *p_bus_ops,
+                         void *p_bus_ctx,
+                         AGS10_ScanDeviceTypeDef *p_found,
+                         uint8_t found_max)
+{
+    if ((NULL == p_scan) || (NULL == p_bus_ops) || ((NULL == p_found) && (0U != found_max)))
+    {
+        return false;
+    }
+
+    memset(p_scan, 0, sizeof(*p_scan));
+    p_scan->p_bus_ops = p_bus_ops;
+    p_scan->p_bus_ctx = p_bus_ctx;
+    p_scan->first_addr = AGS10_SCAN_FIRST_ADDR;
+    p_scan->last_addr = AGS10_SCAN_LAST_ADDR;
+    p_scan->p_found = p_found;
+    p_scan->found_max = found_max;
+
+    return true;
+}
+
+AGS10_StatusTypeDef ags10_scan_probe(AGS10_ScanBusTypeDef *p_scan)
+{
+    uint32_t start_ms = scan_tick_ms(p_scan);
+
+    memset(p_scan->ack_map, 0, sizeof(p_scan->ack_map));
+    p_scan->found = 0;
+    p_scan->acked = 0;
+    p_scan->rejected = 0;
+    p_scan->probes = 0;
+    p_scan->confirm_ms = 0;
+    p_scan->last_status = AGS10_OK;
+
+    for (uint32_t addr = p_scan->first_addr; (addr <= p_scan->last_addr) && (addr <= 0x7FU); addr++)
+    {
+        AGS10_StatusTypeDef status = ags10_scan_address(p_scan->p_bus_ops, p_scan->p_bus_ctx, (uint8_t)addr);
+
+        p_scan->probes++;
+        if (AGS10_OK == status)
+        {
+            p_scan->ack_map[addr >> 3] |= (uint8_t)(1U << (addr & 7U));
+            p_scan->acked++;
+        }
+        else if ((AGS10_ERR_NACK != status) && (AGS10_ERR_NACK_WRITE != status))
+        {
+            p_scan->last_status = (uint8_t)status;
+            break;
+        }
+    }
+
+    p_scan->probe_ms = scan_tick_ms(p_scan) - start_ms;
+
+    return (AGS10_StatusTypeDef)p_scan->last_status;
+}
+
+void ags10_scan_confirm_start(AGS10_ScanBusTypeDef *p_scan)
+{
+    uint32_t held_addr = 0;
+
+    p_scan->confirm_start_ms = scan_tick_ms(p_scan);
+
+    for (uint32_t addr = p_scan->first_addr; (addr <= p_scan->last_addr) && (addr <= 0x7FU); addr++)
+    {
+        if (!scan_acked(p_scan, (uint8_t)addr))
+        {
+            continue;
+        }
+
+        uint8_t reg = AGS10MA_VERSION_REG;
+        AGS10_StatusTypeDef status = p_scan->p_bus_ops->write(p_scan->p_bus_ctx, (uint8_t)addr, &reg, 1);
+
+        if (AGS10_OK != scan_wait(p_scan->p_bus_ops, p_scan->p_bus_ctx, status))
+        {
+            p_scan->ack_map[addr >> 3] &= (uint8_t)~(1U << (addr & 7U));
+            p_scan->rejected++;
+            continue;
+        }
+        held_addr = addr;
+    }
+
+    // the last pointer may still be held back to merge with its read; the wait is for it too
+    if ((0U != held_addr) && (NULL != p_scan->p_bus_ops->flush) &&
+        (AGS10_OK != scan_wait(p_scan->p_bus_ops, p_scan->p_bus_ctx, p_scan->p_bus_ops->flush(p_scan->p_bus_ctx))))
+    {
+        p_scan->ack_map[held_addr >> 3] &= (uint8_t)~(1U << (held_addr & 7U));
+        p_scan->rejected++;
+    }
+    p_scan->pointer_ms = scan_tick_ms(p_scan);
+}
+
+uint8_t ags10_scan_confirm_finish(AGS10_ScanBusTypeDef *p_scan)
+{
+    for (uint32_t addr = p_scan->first_addr; (addr <= p_scan->last_addr) && (addr <= 0x7FU); addr++)
+    {
+        if (!scan_acked(p_scan, (uint8_t)addr))
+        {
+            continue;
+        }
+
+        uint8_t frame[AGS10MA_FRAME_LEN];
+        AGS10_StatusTypeDef status = p_scan->p_bus_ops->read(p_scan->p_bus_ctx, (uint8_t)addr, frame, sizeof(frame));
+
+        if ((AGS10_OK != scan_wait(p_scan->p_bus_ops, p_scan->p_bus_ctx, status)) ||
+            (ags10_crc8(frame, AGS10MA_DATA_LEN) != frame[AGS10MA_DATA_LEN]))
+        {
+            p_scan->rejected++;
+            continue;
+        }
+
+        if (p_scan->found < p_scan->found_max)
+        {
+            p_scan->p_found[p_scan->found].addr = (uint8_t)addr;
+            p_scan->p_found[p_scan->found].version = frame[3];
+        }
+        p_scan->found++;
+    }
+
+    p_scan->confirm_ms = scan_tick_ms(p_scan) - p_scan->confirm_start_ms;
+
+    return p_scan->found;
+}
+
+AGS10_StatusTypeDef ags10_scan_bus(AGS10_ScanBusTypeDef *p_scan)
+{
+    AGS10_StatusTypeDef status = ags10_scan_probe(p_scan);
+
+    if ((AGS10_OK == status) && (0U != p_scan->acked))
+    {
+        bool waited = false;
+
+        ags10_scan_confirm_start(p_scan);
+        scan_settle(p_scan, &waited);
+        (void)ags10_scan_confirm_finish(p_scan);
+    }
+
+    return status;
+}
+
+uint16_t ags10_scan(AGS10_ScanBusTypeDef *p_scans, uint16_t count)
+{
+    bool waited = false;
+    uint16_t found = 0;
+
+    // each bus converts while the next one is probed
+    for (uint16_t idx = 0; idx < count; idx++)
+    {
+        if ((AGS10_OK == ags10_scan_probe(&p_scans[idx])) && (0U != p_scans[idx].acked))
+        {
+            ags10_scan_confirm_start(&p_scans[idx]);
+        }
+    }
+
+    for (uint16_t idx = 0; idx < count; idx++)
+    {
+        if ((AGS10_OK == p_scans[idx].last_status) && (0U != p_scans[idx].acked))
+        {
+            scan_settle(&p_scans[idx], &waited);
+            found += ags10_scan_confirm_finish(&p_scans[idx]);
+        }
+    }
+
+    return found;
+}
+// eof
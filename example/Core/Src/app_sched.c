@@ -0,0 +1,111 @@
+/**
+ * @file app_sched.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "app_sched.h"
+
+#include <stddef.h>
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+bool app_sched_init(APP_SchedTypeDef *p_sched,
+                    APP_TaskTypeDef *p_tasks,
+                    uint8_t count,
+                    const APP_SchedPortTypeDef *p_port)
+{
+    if ((NULL == p_sched) || (NULL == p_tasks) || (NULL == p_port) ||
+        (NULL == p_port->get_tick_ms) || (NULL == p_port->get_cycles) ||
+        (NULL == p_port->idle))
+    {
+        return false;
+    }
+
+    p_sched->p_tasks = p_tasks;
+    p_sched->count = count;
+    p_sched->p_port = p_port;
+
+    uint32_t now_ms = p_port->get_tick_ms();
+
+    for (uint8_t idx = 0; idx < count; idx++)
+    {
+        p_tasks[idx].next_ms = now_ms;
+    }
+
+    app_sched_stats_reset(p_sched);
+
+    return true;
+}
+
+void app_sched_run_once(APP_SchedTypeDef *p_sched)
+{
+    const APP_SchedPortTypeDef *p_port = p_sched->p_port;
+    bool ran = false;
+
+    for (uint8_t idx = 0; idx < p_sched->count; idx++)
+    {
+        APP_TaskTypeDef *p_task = &p_sched->p_tasks[idx];
+
+        // signed difference keeps the comparison valid across tick wrap-around
+        if ((int32_t)(p_port->get_tick_ms() - p_task->next_ms) < 0)
+        {
+            continue;
+        }
+
+        uint32_t start = p_port->get_cycles();
+        uint32_t delay_ms = p_task->fn(p_task->p_arg);
+        uint32_t cycles = p_port->get_cycles() - start;
+
+        p_task->next_ms = p_port->get_tick_ms() + delay_ms;
+        p_task->runs++;
+        p_task->total_cycles += cycles;
+        if (cycles > p_task->wcet_cycles)
+        {
+            p_task->wcet_cycles = cycles;
+        }
+
+        p_sched->busy_cycles += cycles;
+        ran = true;
+    }
+
+    if (!ran)
+    {
+        // nothing due: sleep until the next interrupt (at worst the 1 ms tick)
+        uint32_t start = p_port->get_cycles();
+        p_port->idle();
+        p_sched->idle_cycles += p_port->get_cycles() - start;
+    }
+}
+
+uint8_t app_sched_idle_percent(const APP_SchedTypeDef *p_sched)
+{
+    uint64_t total = p_sched->busy_cycles + p_sched->idle_cycles;
+
+    if (0U == total)
+    {
+        return 100U;
+    }
+
+    return (uint8_t)((p_sched->idle_cycles * 100U) / total);
+}
+
+void app_sched_stats_reset(APP_SchedTypeDef *p_sched)
+{
+    p_sched->busy_cycles = 0;
+    p_sched->idle_cycles = 0;
+
+    for (uint8_t idx = 0; idx < p_sched->count; idx++)
+    {
+        p_sched->p_tasks[idx].runs = 0;
+        p_sched->p_tasks[idx].wcet_cycles = 0;
+        p_sched->p_tasks[idx].total_cycles = 0;
+    }
+}
+// eof
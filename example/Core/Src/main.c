@@ -22,6 +22,23 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "ags10.h"
+#include "app_sched.h"
+#include "ags10_i2c_recover.h"
+#include "ags10_ring.h"
+#include "ags10_flash_hal.h"
+#include "ags10_filter.h"
+#include "ags10_scan.h"
+#include "ags10_clock.h"
+#if AGS10_PROF_ENABLE
+#include "ags10_prof.h"
+#endif
+#if (AGS10_EXAMPLE_BUS == AGS10_EXAMPLE_BUS_DMA)
+#include "ags10_i2c_dma.h"
+#elif (AGS10_EXAMPLE_BUS == AGS10_EXAMPLE_BUS_IT)
+#include "ags10_i2c_it.h"
+#else
+#include "ags10_i2c_hal.h"
+#endif
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -32,7 +49,15 @@ AGS10_HandleTypeDef ags10;
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
-
+#define APP_HEARTBEAT_PERIOD_MS   500U
+#define APP_STATS_PERIOD_MS       10000U
+#define APP_AGS10_ATTEMPTS        3U      /* per read, first try included */
+#define APP_AGS10_BACKOFF_MS      2U
+#define APP_I2C_HALF_PERIOD_US    25U     /* recovery pulses at 20 kHz, whatever the calibrated rate */
+#define APP_HISTORY_HEADROOM      8U      /* free ring slots kept, > samples per stats period */
+#define APP_TVOC_STEP_PPB         500U    /* largest TVOC change per sample passed to the smoother */
+#define APP_SCAN_MAX              4U      /* AGS10s kept from the boot scan */
+#define APP_CLOCK_CHECK_PERIOD_MS 600000U /* I2C2 clock re-validation */
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -44,10 +69,58 @@ AGS10_HandleTypeDef ags10;
 I2C_HandleTypeDef hi2c2;
 
 /* USER CODE BEGIN PV */
+#if (AGS10_EXAMPLE_BUS == AGS10_EXAMPLE_BUS_DMA)
+DMA_HandleTypeDef hdma_i2c2_tx;
+DMA_HandleTypeDef hdma_i2c2_rx;
+AGS10_I2cDmaTypeDef ags10_i2c2;
+#elif (AGS10_EXAMPLE_BUS == AGS10_EXAMPLE_BUS_IT)
+AGS10_I2cItTypeDef ags10_i2c2;
+#endif
 uint32_t tvoc = 0;
+uint8_t tvoc_status = 0;
+AGS10_TvocSampleTypeDef tvoc_sample;    /* last TVOC read, fresh or not: preheating, age_ms */
+uint32_t gas_res = 0;
+AGS10_StatusTypeDef tvoc_error = AGS10_OK;
+AGS10_StatusTypeDef gas_res_error = AGS10_OK;
+
+/* Rolling history of the last AGS10_RING_LEN - APP_HISTORY_HEADROOM samples, one per fresh TVOC */
+AGS10_RingTypeDef tvoc_history;
+uint32_t tvoc_avg = 0;
+
+/* Clamp, median of 5 and EMA (alpha 1/8) over each good TVOC sample, in ppb */
+static const AGS10_FilterConfigTypeDef tvoc_filter_cfg = {
+    .ema_alpha  = AGS10_FILTER_ALPHA_ONE / 8U,
+    .clamp_step = AGS10_FILTER_FROM_PPB(APP_TVOC_STEP_PPB),
+};
+AGS10_FilterTypeDef tvoc_filter;
+uint32_t tvoc_smooth = 0;
+
+/* Samples kept across resets in the LOG flash region, AGS10_LOG_BATCH per record */
+extern uint8_t _ags10_log_start[];
+extern uint8_t _ags10_log_end[];
+AGS10_LogTypeDef sample_log;
+AGS10_StatusTypeDef sample_log_error = AGS10_OK;
 uint32_t firmware_version = 0;
+
+/* Boot scan of I2C2; per-address results and timing for the debugger */
+AGS10_ScanBusTypeDef bus_scan;
+AGS10_ScanDeviceTypeDef bus_found[APP_SCAN_MAX];
+
+/* I2C2 clock, calibrated against the sensor and kept in the CAL flash page */
+extern uint8_t _ags10_cal_start[];
+AGS10_ClockCalTypeDef i2c2_clock;
+AGS10_StatusTypeDef i2c2_clock_error = AGS10_OK;
 uint8_t sensor_initialized = 0;
 
+/* Scheduler statistics, refreshed every APP_STATS_PERIOD_MS (watch in the debugger) */
+uint8_t app_idle_percent = 0;
+#if AGS10_STATS_ENABLE
+AGS10_StatsTypeDef ags10_stats;
+#endif
+
+static uint32_t sample_start_ms;
+static uint8_t sensor_reg = AGS10MA_TVOC_STAT_REG;
+
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -55,16 +128,66 @@ void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
 static void MX_I2C2_Init(void);
 /* USER CODE BEGIN PFP */
-bool AGS10_IO_Write(uint8_t addr, uint8_t *pData, uint16_t length);
-bool AGS10_IO_Read(uint8_t addr, uint8_t *pData, uint16_t length);
-bool AGS10_IO_Read(uint8_t addr, uint8_t *pData, uint16_t length);
-void AGS10_IO_Delay(uint16_t ms);
+#if (AGS10_EXAMPLE_BUS == AGS10_EXAMPLE_BUS_BLOCKING)
+static AGS10_StatusTypeDef AGS10_IO_Write(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length);
+static AGS10_StatusTypeDef AGS10_IO_Read(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length);
+static void AGS10_IO_Delay(void *p_ctx, uint16_t ms);
+static uint32_t AGS10_IO_GetTick(void *p_ctx);
+static AGS10_StatusTypeDef AGS10_IO_Probe(void *p_ctx, uint8_t addr);
+#endif
+static bool app_i2c_clock_set(void *p_ctx, uint32_t clock_hz);
 void app_init(void);
+static uint32_t app_tick_ms(void);
+static uint32_t app_cycles(void);
+static void app_idle(void);
+static uint32_t sensor_task(void *p_arg);
+static uint32_t sensor_wait_ms(const AGS10_HandleTypeDef *ph_sensor, uint32_t now_ms);
+static void sensor_fault(AGS10_StatusTypeDef error);
+static void history_update(void);
+static uint32_t heartbeat_task(void *p_arg);
+static uint32_t stats_task(void *p_arg);
+static uint32_t clock_task(void *p_arg);
+#if AGS10_PROF_ENABLE
+static void prof_put(void *p_ctx, const char *p_line);
+#endif
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
-
+static const APP_SchedPortTypeDef app_sched_port = {
+    .get_tick_ms = app_tick_ms,
+    .get_cycles  = app_cycles,
+    .idle        = app_idle,
+};
+
+APP_TaskTypeDef app_tasks[] = {
+    { .name = "ags10",     .fn = sensor_task,    .p_arg = &ags10 },
+    { .name = "heartbeat", .fn = heartbeat_task, .p_arg = NULL },
+    { .name = "stats",     .fn = stats_task,     .p_arg = NULL },
+    { .name = "clock",     .fn = clock_task,     .p_arg = &i2c2_clock },
+};
+
+APP_SchedTypeDef app_sched;
+
+/* Stuck-bus recovery on PB10 (SCL) / PB11 (SDA); count and timing are watchable in the debugger */
+AGS10_I2cRecoverTypeDef i2c2_recover = {
+    .hi2c           = &hi2c2,
+    .scl_port       = GPIOB,
+    .scl_pin        = GPIO_PIN_10,
+    .sda_port       = GPIOB,
+    .sda_pin        = GPIO_PIN_11,
+    .half_period_us = APP_I2C_HALF_PERIOD_US,
+    .reinit         = MX_I2C2_Init,
+};
+#if (AGS10_EXAMPLE_BUS == AGS10_EXAMPLE_BUS_BLOCKING)
+static const AGS10_BusOpsTypeDef ags10_bus_ops = {
+    .write       = AGS10_IO_Write,
+    .read        = AGS10_IO_Read,
+    .delay       = AGS10_IO_Delay,
+    .get_tick_ms = AGS10_IO_GetTick,
+    .probe       = AGS10_IO_Probe,
+};
+#endif
 /* USER CODE END 0 */
 
 /**
@@ -111,10 +234,7 @@ int main(void)
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
-      if (!ags10_tvoc_get(&ags10, &tvoc))
-      {
-          tvoc = 0xFFFFFFFF;
-      }
+      app_sched_run_once(&app_sched);
   }
   /* USER CODE END 3 */
 }
@@ -187,7 +307,11 @@ static void MX_I2C2_Init(void)
     Error_Handler();
   }
   /* USER CODE BEGIN I2C2_Init 2 */
-
+  /* Bus recovery re-runs this init; keep the calibrated rate rather than the one above */
+  if ((0U != i2c2_clock.clock_hz) && (i2c2_clock.clock_hz != hi2c2.Init.ClockSpeed))
+  {
+    (void)app_i2c_clock_set(&hi2c2, i2c2_clock.clock_hz);
+  }
   /* USER CODE END I2C2_Init 2 */
 
 }
@@ -224,27 +348,306 @@ static void MX_GPIO_Init(void)
 }
 
 /* USER CODE BEGIN 4 */
-bool AGS10_IO_Write(uint8_t addr, uint8_t *pData, uint16_t length) {
-    return HAL_I2C_Master_Transmit(&hi2c2, addr << 1, pData, length, 100) == HAL_OK;
+#if (AGS10_EXAMPLE_BUS == AGS10_EXAMPLE_BUS_BLOCKING)
+static AGS10_StatusTypeDef AGS10_IO_Write(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length) {
+    I2C_HandleTypeDef *hi2c = (I2C_HandleTypeDef *)p_ctx;
+    return ags10_i2c_hal_status(hi2c, HAL_I2C_Master_Transmit(hi2c, addr << 1, pData, length, 100));
 }
 
-bool AGS10_IO_Read(uint8_t addr, uint8_t *pData, uint16_t length) {
-    return HAL_I2C_Master_Receive(&hi2c2, addr << 1, pData, length, 100) == HAL_OK;
+static AGS10_StatusTypeDef AGS10_IO_Read(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length) {
+    I2C_HandleTypeDef *hi2c = (I2C_HandleTypeDef *)p_ctx;
+    return ags10_i2c_hal_status(hi2c, HAL_I2C_Master_Receive(hi2c, addr << 1, pData, length, 100));
 }
 
-void AGS10_IO_Delay(uint16_t ms) {
+static void AGS10_IO_Delay(void *p_ctx, uint16_t ms) {
+    (void)p_ctx;
     HAL_Delay(ms);
 }
 
+static uint32_t AGS10_IO_GetTick(void *p_ctx) {
+    (void)p_ctx;
+    return HAL_GetTick();
+}
+
+static AGS10_StatusTypeDef AGS10_IO_Probe(void *p_ctx, uint8_t addr) {
+    return ags10_i2c_hal_probe((I2C_HandleTypeDef *)p_ctx, addr);
+}
+#endif
+
 void app_init(void) {
-    ags10_init(&ags10, AGS10MA_I2C_DEVICE_ADDR);
+#if (AGS10_EXAMPLE_BUS == AGS10_EXAMPLE_BUS_DMA)
+    ags10_i2c_dma_init(&ags10_i2c2, &hi2c2);
+    const AGS10_BusOpsTypeDef *p_bus_ops = &ags10_i2c_dma_bus_ops;
+    void *p_bus_ctx = &ags10_i2c2;
+#elif (AGS10_EXAMPLE_BUS == AGS10_EXAMPLE_BUS_IT)
+    ags10_i2c_it_init(&ags10_i2c2, &hi2c2);
+    const AGS10_BusOpsTypeDef *p_bus_ops = &ags10_i2c_it_bus_ops;
+    void *p_bus_ctx = &ags10_i2c2;
+#else
+    const AGS10_BusOpsTypeDef *p_bus_ops = &ags10_bus_ops;
+    void *p_bus_ctx = &hi2c2;
+#endif
+
+    /* Talk to the first AGS10 that answers, whatever its address; the factory one if none does */
+    uint8_t sensor_addr = AGS10MA_I2C_DEVICE_ADDR;
+    if (ags10_scan_bus_init(&bus_scan, p_bus_ops, p_bus_ctx, bus_found, APP_SCAN_MAX) &&
+        (AGS10_OK == ags10_scan_bus(&bus_scan)) && (0U != bus_scan.found)) {
+        sensor_addr = bus_found[0].addr;
+    }
+
+    /* The stored clock if it still holds (lowered if need be), else a fresh sweep; only with a sensor to test against */
+    if (ags10_clock_init(&i2c2_clock, p_bus_ops, p_bus_ctx, sensor_addr, app_i2c_clock_set, &hi2c2,
+                         ags10_clock_rates, AGS10_CLOCK_RATE_COUNT) &&
+        ags10_clock_storage_set(&i2c2_clock, &ags10_flash_hal_ops, NULL, (uint32_t)_ags10_cal_start, FLASH_PAGE_SIZE) &&
+        (0U != bus_scan.found)) {
+        if ((AGS10_OK != ags10_clock_load(&i2c2_clock)) || (AGS10_OK != ags10_clock_validate(&i2c2_clock))) {
+            i2c2_clock_error = ags10_clock_calibrate(&i2c2_clock);
+        }
+    }
+    ags10_init(&ags10, sensor_addr, p_bus_ops, p_bus_ctx);
+
+    /* A corrupted frame is read again a few ms later instead of losing the sample */
+    const AGS10_RetryPolicyTypeDef retry = {
+        .max_attempts   = APP_AGS10_ATTEMPTS,
+        .reread         = true,
+        .backoff_ms     = APP_AGS10_BACKOFF_MS,
+        .backoff_max_ms = 4U * APP_AGS10_BACKOFF_MS,
+    };
+    ags10_retry_policy_set(&ags10, &retry);
 
     uint32_t version;
-    if (ags10_firmware_version_get(&ags10, &version)) {
+    if (AGS10_OK == ags10_firmware_version_get(&ags10, &version)) {
     } else {
 
     }
+
+    /* DWT cycle counter for the scheduler's per-task timing */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    ags10_ring_init(&tvoc_history, HAL_GetTick());
+    ags10_filter_init(&tvoc_filter, &tvoc_filter_cfg);
+    sample_log_error = ags10_log_mount(&sample_log, &ags10_flash_hal_ops, NULL,
+                                       (uint32_t)_ags10_log_start, FLASH_PAGE_SIZE,
+                                       (uint16_t)((_ags10_log_end - _ags10_log_start) / FLASH_PAGE_SIZE));
+    app_sched_init(&app_sched, app_tasks, sizeof(app_tasks) / sizeof(app_tasks[0]), &app_sched_port);
+
+#if AGS10_PROF_ENABLE
+    ags10_prof_init();
+#endif
+}
+
+static uint32_t app_tick_ms(void) {
+    return HAL_GetTick();
+}
+
+static uint32_t app_cycles(void) {
+    return DWT->CYCCNT;
+}
+
+static void app_idle(void) {
+    /* SysTick wakes us at least every millisecond */
+    __WFI();
+}
+
+/* Time until the read in flight, or the next TVOC read ags10_tvoc_poll() has planned, is due */
+static uint32_t sensor_wait_ms(const AGS10_HandleTypeDef *ph_sensor, uint32_t now_ms) {
+    if (AGS10_XFER_IDLE != ph_sensor->xfer_state) {
+        uint32_t wait_ms = ags10_register_read_wait_ms(ph_sensor, now_ms);
+        return (0U != wait_ms) ? wait_ms : 1U;
+    }
+    int32_t until_ms = (int32_t)(ph_sensor->tvoc_next_ms - now_ms);
+    return (until_ms > 0) ? (uint32_t)until_ms : 0U;
+}
+
+/* TVOC whenever the sensor has a new value, then gas resistance, without ever blocking the loop */
+static uint32_t sensor_task(void *p_arg) {
+    AGS10_HandleTypeDef *ph_sensor = (AGS10_HandleTypeDef *)p_arg;
+    uint32_t now_ms = HAL_GetTick();
+    uint32_t raw;
+    AGS10_StatusTypeDef error;
+
+    if (AGS10MA_TVOC_STAT_REG == sensor_reg) {
+        /* ags10_tvoc_poll() moves its next read time exactly when a read ends: fresh, stale or failed */
+        uint32_t next_ms = ph_sensor->tvoc_next_ms;
+
+        if (ags10_tvoc_poll(ph_sensor, now_ms, &tvoc_sample)) {
+            sample_start_ms = now_ms;
+            tvoc = tvoc_sample.tvoc_ppb;
+            tvoc_status = tvoc_sample.status;
+            tvoc_error = AGS10_OK;
+            sensor_reg = AGS10MA_GAS_RES_REG;
+            return 0;
+        }
+        if ((next_ms != ph_sensor->tvoc_next_ms) && (AGS10_OK != ph_sensor->last_status)) {
+            /* no TVOC, no sample; ags10_tvoc_poll() backs off before the next try */
+            tvoc_error = (AGS10_StatusTypeDef)ph_sensor->last_status;
+            tvoc = 0xFFFFFFFF;
+            sensor_fault(tvoc_error);
+        }
+        return sensor_wait_ms(ph_sensor, now_ms);
+    }
+
+    if (AGS10_XFER_IDLE == ph_sensor->xfer_state) {
+        error = ags10_register_read_start(ph_sensor, AGS10MA_GAS_RES_REG,
+                                          AGS10MA_ACCESS_DELAY_MS, now_ms);
+        if (AGS10_OK == error) {
+            return AGS10MA_ACCESS_DELAY_MS;
+        }
+    } else {
+        switch (ags10_register_read_poll(ph_sensor, now_ms, &raw)) {
+        case AGS10_XFER_PENDING:
+            return sensor_wait_ms(ph_sensor, now_ms);
+        case AGS10_XFER_DONE:
+            gas_res = raw;
+            break;
+        default:
+            break;
+        }
+        error = (AGS10_StatusTypeDef)ph_sensor->last_status;
+    }
+
+    /* the TVOC is good; a failed resistance read only marks the sample */
+    gas_res_error = error;
+
+    const AGS10_RingSampleTypeDef sample = {
+        .t_ms       = sample_start_ms,
+        .tvoc       = tvoc,
+        .resistance = (AGS10_OK == error) ? gas_res : 0U,
+        .status     = (AGS10_OK == error) ? tvoc_status : (uint8_t)(tvoc_status | AGS10_RING_STATUS_NO_RES),
+    };
+    (void)ags10_ring_push(&tvoc_history, &sample);
+    tvoc_smooth = AGS10_FILTER_TO_PPB(ags10_filter_update(&tvoc_filter, tvoc));
+    if (sample_log.mounted) {
+        /* Every AGS10_LOG_BATCH samples this programs one record, now and then erasing a page */
+        sample_log_error = ags10_log_append(&sample_log, &sample);
+    }
+    sensor_reg = AGS10MA_TVOC_STAT_REG;
+    sensor_fault(error);
+
+    return sensor_wait_ms(ph_sensor, now_ms);
+}
+
+/* A read cut off mid-byte can leave the AGS10 holding SDA low; clock it free before the next sample */
+static void sensor_fault(AGS10_StatusTypeDef error) {
+    if (ags10_i2c_recover_needed(&i2c2_recover, error)) {
+        (void)ags10_i2c_recover(&i2c2_recover);
+    }
+}
+
+static uint32_t heartbeat_task(void *p_arg) {
+    (void)p_arg;
+    HAL_GPIO_TogglePin(GPIOC, GPIO_PIN_13);
+    return APP_HEARTBEAT_PERIOD_MS;
+}
+
+/* Per-task WCET accumulates in app_tasks[], idle share is per window */
+static uint32_t stats_task(void *p_arg) {
+    (void)p_arg;
+    app_idle_percent = app_sched_idle_percent(&app_sched);
+    app_sched.busy_cycles = 0;
+    app_sched.idle_cycles = 0;
+    history_update();
+#if AGS10_STATS_ENABLE
+    ags10_stats_get(&ags10, &ags10_stats);
+#endif
+#if AGS10_PROF_ENABLE
+    ags10_prof_dump(prof_put, NULL);
+#endif
+    return APP_STATS_PERIOD_MS;
+}
+
+/* Re-test the I2C2 clock; a rate that has started failing is lowered and stored. Blocks for the
+   test reads (one version wait and up to AGS10_CLOCK_READS frames), so it runs rarely */
+static uint32_t clock_task(void *p_arg) {
+    AGS10_ClockCalTypeDef *p_cal = (AGS10_ClockCalTypeDef *)p_arg;
+
+    if (0U == p_cal->clock_hz) {
+        return APP_CLOCK_CHECK_PERIOD_MS;
+    }
+    /* The test reads move the sensor's register pointer; wait for its read to finish */
+    if (AGS10_XFER_IDLE != ags10.xfer_state) {
+        return AGS10MA_ACCESS_DELAY_MS;
+    }
+    i2c2_clock_error = ags10_clock_validate(p_cal);
+    return APP_CLOCK_CHECK_PERIOD_MS;
+}
+
+/* Calibration switches I2C2 between transfers; HAL_I2C_Init() reprograms CCR and TRISE for the rate */
+static bool app_i2c_clock_set(void *p_ctx, uint32_t clock_hz) {
+    I2C_HandleTypeDef *hi2c = (I2C_HandleTypeDef *)p_ctx;
+
+    hi2c->Init.ClockSpeed = clock_hz;
+    return HAL_OK == HAL_I2C_Init(hi2c);
+}
+
+/* Consumer side of tvoc_history: keep room for the producer and average what is kept */
+static void history_update(void) {
+    AGS10_RingSampleTypeDef chunk[16];
+    uint32_t count = ags10_ring_count(&tvoc_history);
+    uint32_t keep = AGS10_RING_LEN - APP_HISTORY_HEADROOM;
+    uint64_t sum = 0;
+    uint32_t read = 0;
+    uint32_t n;
+
+    if (count > keep) {
+        (void)ags10_ring_discard(&tvoc_history, count - keep);
+    }
+
+    while (0U != (n = ags10_ring_read(&tvoc_history, read, chunk, sizeof(chunk) / sizeof(chunk[0])))) {
+        for (uint32_t idx = 0; idx < n; idx++) {
+            sum += chunk[idx].tvoc;
+        }
+        read += n;
+    }
+    tvoc_avg = (0U != read) ? (uint32_t)(sum / read) : 0;
+}
+
+#if AGS10_PROF_ENABLE
+/* Phase timings go out on ITM stimulus port 0 (SWO), readable in the IDE's SWV console */
+static void prof_put(void *p_ctx, const char *p_line) {
+    (void)p_ctx;
+    while (*p_line) {
+        ITM_SendChar((uint32_t)*p_line++);
+    }
+    ITM_SendChar('\n');
+}
+#endif
+
+#if (AGS10_EXAMPLE_BUS == AGS10_EXAMPLE_BUS_DMA)
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    ags10_i2c_dma_xfer_cplt(hi2c);
+}
+
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    ags10_i2c_dma_xfer_cplt(hi2c);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
+    ags10_i2c_dma_xfer_error(hi2c);
+}
+
+void HAL_I2C_AbortCpltCallback(I2C_HandleTypeDef *hi2c) {
+    ags10_i2c_dma_xfer_error(hi2c);
+}
+#elif (AGS10_EXAMPLE_BUS == AGS10_EXAMPLE_BUS_IT)
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    ags10_i2c_it_isr_event(hi2c, AGS10_I2C_IT_EVT_TX_CPLT);
+}
+
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    ags10_i2c_it_isr_event(hi2c, AGS10_I2C_IT_EVT_RX_CPLT);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
+    ags10_i2c_it_isr_event(hi2c, AGS10_I2C_IT_EVT_ERROR);
+}
+
+void HAL_I2C_AbortCpltCallback(I2C_HandleTypeDef *hi2c) {
+    ags10_i2c_it_isr_event(hi2c, AGS10_I2C_IT_EVT_ERROR);
 }
+#endif
 /* USER CODE END 4 */
 
 /**
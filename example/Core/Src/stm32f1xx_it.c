@@ -57,7 +57,11 @@
 /* External variables --------------------------------------------------------*/
 
 /* USER CODE BEGIN EV */
-
+extern I2C_HandleTypeDef hi2c2;
+#if (AGS10_EXAMPLE_BUS == AGS10_EXAMPLE_BUS_DMA)
+extern DMA_HandleTypeDef hdma_i2c2_tx;
+extern DMA_HandleTypeDef hdma_i2c2_rx;
+#endif
 /* USER CODE END EV */
 
 /******************************************************************************/
@@ -199,5 +203,39 @@ void SysTick_Handler(void)
 /******************************************************************************/
 
 /* USER CODE BEGIN 1 */
+#if (AGS10_EXAMPLE_BUS == AGS10_EXAMPLE_BUS_DMA)
+/**
+  * @brief This function handles DMA1 channel4 global interrupt (I2C2_TX).
+  */
+void DMA1_Channel4_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_i2c2_tx);
+}
+
+/**
+  * @brief This function handles DMA1 channel5 global interrupt (I2C2_RX).
+  */
+void DMA1_Channel5_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_i2c2_rx);
+}
+#endif
 
+#if (AGS10_EXAMPLE_BUS != AGS10_EXAMPLE_BUS_BLOCKING)
+/**
+  * @brief This function handles I2C2 event interrupt.
+  */
+void I2C2_EV_IRQHandler(void)
+{
+  HAL_I2C_EV_IRQHandler(&hi2c2);
+}
+
+/**
+  * @brief This function handles I2C2 error interrupt.
+  */
+void I2C2_ER_IRQHandler(void)
+{
+  HAL_I2C_ER_IRQHandler(&hi2c2);
+}
+#endif
 /* USER CODE END 1 */
@@ -9,108 +9,1033 @@
  *
  */
 #include "ags10.h"
+#include "ags10_prof.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#ifdef AGS10_STATIC_BUS_HEADER
+#include AGS10_STATIC_BUS_HEADER
+#endif
+
+/*******************************************************************************
+* Private Defines
+ ******************************************************************************/
+#define TVOC_FLAG_HAS_FRESH    0x01U   /**< A fresh value has been seen. */
+#define TVOC_FLAG_EDGE         0x02U   /**< The last fresh value followed a stale read closely. */
+#define TVOC_FLAG_STALE        0x04U   /**< A stale read happened since the last fresh value. */
+
+/*******************************************************************************
+* CRC-8 Lookup Tables
+ ******************************************************************************/
+/*
+ * The tables are generated by the preprocessor instead of being pasted in as
+ * magic numbers. Without the init value the CRC is linear over GF(2), so the
+ * entry for any byte is the XOR of the entries for its set bits. Only the
+ * eight single-bit entries of each table are computed by shifting, and each
+ * slice table is the previous one run through the byte table again.
+ */
+#define CRC8_STEP(c)    ((((c) << 1) ^ ((((c) >> 7) & 1U) * AGS10MA_CRC8_POLYNOMIAL)) & 0xFFU)
+#define CRC8_STEP2(c)   CRC8_STEP(CRC8_STEP(c))
+#define CRC8_STEP8(c)   CRC8_STEP2(CRC8_STEP2(CRC8_STEP2(CRC8_STEP2(c))))
+
+#define CRC8_LINEAR(b, B) \
+    ((((b) & 0x01U) ? B##_0 : 0U) ^ (((b) & 0x02U) ? B##_1 : 0U) ^ \
+     (((b) & 0x04U) ? B##_2 : 0U) ^ (((b) & 0x08U) ? B##_3 : 0U) ^ \
+     (((b) & 0x10U) ? B##_4 : 0U) ^ (((b) & 0x20U) ? B##_5 : 0U) ^ \
+     (((b) & 0x40U) ? B##_6 : 0U) ^ (((b) & 0x80U) ? B##_7 : 0U))
+
+#define CRC8_BASIS_NEXT(B, P) \
+    B##_0 = CRC8_LINEAR(P##_0, CRC8_B0), B##_1 = CRC8_LINEAR(P##_1, CRC8_B0), \
+    B##_2 = CRC8_LINEAR(P##_2, CRC8_B0), B##_3 = CRC8_LINEAR(P##_3, CRC8_B0), \
+    B##_4 = CRC8_LINEAR(P##_4, CRC8_B0), B##_5 = CRC8_LINEAR(P##_5, CRC8_B0), \
+    B##_6 = CRC8_LINEAR(P##_6, CRC8_B0), B##_7 = CRC8_LINEAR(P##_7, CRC8_B0)
+
+enum {
+    CRC8_B0_0 = CRC8_STEP8(0x01U), CRC8_B0_1 = CRC8_STEP8(0x02U),
+    CRC8_B0_2 = CRC8_STEP8(0x04U), CRC8_B0_3 = CRC8_STEP8(0x08U),
+    CRC8_B0_4 = CRC8_STEP8(0x10U), CRC8_B0_5 = CRC8_STEP8(0x20U),
+    CRC8_B0_6 = CRC8_STEP8(0x40U), CRC8_B0_7 = CRC8_STEP8(0x80U),
+};
+enum { CRC8_BASIS_NEXT(CRC8_B1, CRC8_B0) };
+enum { CRC8_BASIS_NEXT(CRC8_B2, CRC8_B1) };
+enum { CRC8_BASIS_NEXT(CRC8_B3, CRC8_B2) };
+
+#define CRC8_ROW4(n, B)    CRC8_LINEAR((n), B), CRC8_LINEAR((n) + 1U, B), \
+                           CRC8_LINEAR((n) + 2U, B), CRC8_LINEAR((n) + 3U, B)
+#define CRC8_ROW16(n, B)   CRC8_ROW4((n), B), CRC8_ROW4((n) + 4U, B), \
+                           CRC8_ROW4((n) + 8U, B), CRC8_ROW4((n) + 12U, B)
+#define CRC8_ROW64(n, B)   CRC8_ROW16((n), B), CRC8_ROW16((n) + 16U, B), \
+                           CRC8_ROW16((n) + 32U, B), CRC8_ROW16((n) + 48U, B)
+#define CRC8_ROW256(B)     CRC8_ROW64(0U, B), CRC8_ROW64(64U, B), \
+                           CRC8_ROW64(128U, B), CRC8_ROW64(192U, B)
+
+/* Entry h is the CRC of the high nibble h, i.e. the byte table at index h. */
+static const uint8_t crc8_nibble_lut[16] = { CRC8_ROW16(0U, CRC8_B0) };
+
+/* crc8_lut[k][b]: byte b followed by k zero bytes. */
+static const uint8_t crc8_lut[4][256] = {
+    { CRC8_ROW256(CRC8_B0) },
+    { CRC8_ROW256(CRC8_B1) },
+    { CRC8_ROW256(CRC8_B2) },
+    { CRC8_ROW256(CRC8_B3) },
+};
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static inline AGS10_StatusTypeDef bus_write(AGS10_HandleTypeDef *ph_sensor, uint8_t *pData, uint16_t length)
+{
+#ifdef AGS10_STATIC_BUS_HEADER
+    return ags10_bus_write(ph_sensor->p_bus_ctx, ph_sensor->i2c_addr, pData, length);
+#else
+    return ph_sensor->p_bus_ops->write(ph_sensor->p_bus_ctx, ph_sensor->i2c_addr, pData, length);
+#endif
+}
+
+static inline AGS10_StatusTypeDef bus_read(AGS10_HandleTypeDef *ph_sensor, uint8_t *pData, uint16_t length)
+{
+#ifdef AGS10_STATIC_BUS_HEADER
+    return ags10_bus_read(ph_sensor->p_bus_ctx, ph_sensor->i2c_addr, pData, length);
+#else
+    return ph_sensor->p_bus_ops->read(ph_sensor->p_bus_ctx, ph_sensor->i2c_addr, pData, length);
+#endif
+}
+
+static inline void bus_delay(AGS10_HandleTypeDef *ph_sensor, uint16_t ms)
+{
+#ifdef AGS10_STATIC_BUS_HEADER
+    ags10_bus_delay(ph_sensor->p_bus_ctx, ms);
+#else
+    ph_sensor->p_bus_ops->delay(ph_sensor->p_bus_ctx, ms);
+#endif
+}
+
+static inline AGS10_BusXferTypeDef bus_xfer_state(AGS10_HandleTypeDef *ph_sensor)
+{
+#if defined(AGS10_STATIC_BUS_HEADER) && defined(AGS10_STATIC_BUS_ASYNC)
+    return ags10_bus_xfer_state(ph_sensor->p_bus_ctx);
+#elif defined(AGS10_STATIC_BUS_HEADER)
+    (void)ph_sensor;
+    return AGS10_BUS_XFER_DONE;
+#else
+    if (NULL == ph_sensor->p_bus_ops->xfer_state)
+    {
+        return AGS10_BUS_XFER_DONE;
+    }
+
+    return ph_sensor->p_bus_ops->xfer_state(ph_sensor->p_bus_ctx);
+#endif
+}
+
+static inline AGS10_StatusTypeDef bus_flush(AGS10_HandleTypeDef *ph_sensor)
+{
+#ifdef AGS10_STATIC_BUS_HEADER
+    (void)ph_sensor;
+    return AGS10_OK;
+#else
+    if (NULL == ph_sensor->p_bus_ops->flush)
+    {
+        return AGS10_OK;
+    }
+
+    return ph_sensor->p_bus_ops->flush(ph_sensor->p_bus_ctx);
+#endif
+}
+
+/*
+ * Falls back to the tick the current transaction was started with when the
+ * bus has no clock of its own.
+ */
+static inline uint32_t bus_get_tick_ms(AGS10_HandleTypeDef *ph_sensor)
+{
+#if defined(AGS10_STATIC_BUS_HEADER) && defined(AGS10_STATIC_BUS_TICK)
+    return ags10_bus_get_tick_ms(ph_sensor->p_bus_ctx);
+#elif defined(AGS10_STATIC_BUS_HEADER)
+    return ph_sensor->xfer_start_ms;
+#else
+    if (NULL == ph_sensor->p_bus_ops->get_tick_ms)
+    {
+        return ph_sensor->xfer_start_ms;
+    }
+
+    return ph_sensor->p_bus_ops->get_tick_ms(ph_sensor->p_bus_ctx);
+#endif
+}
+
+/* Bus operations report a NACK without direction, the driver knows it. */
+static inline AGS10_StatusTypeDef bus_status(AGS10_StatusTypeDef status, bool reading)
+{
+    if (AGS10_ERR_NACK == status)
+    {
+        return reading ? AGS10_ERR_NACK_READ : AGS10_ERR_NACK_WRITE;
+    }
+
+    return status;
+}
+
+static inline AGS10_StatusTypeDef bus_xfer_status(AGS10_BusXferTypeDef xfer, bool reading)
+{
+    switch (xfer)
+    {
+    case AGS10_BUS_XFER_DONE:
+        return AGS10_OK;
+    case AGS10_BUS_XFER_BUSY:
+        return AGS10_ERR_BUSY;
+    case AGS10_BUS_XFER_NACK:
+        return bus_status(AGS10_ERR_NACK, reading);
+    case AGS10_BUS_XFER_ERROR:
+    default:
+        return AGS10_ERR_BUS;
+    }
+}
+
+/* Counts one failed attempt, whether or not it is retried. */
+static void xfer_fault(AGS10_HandleTypeDef *ph_sensor, AGS10_StatusTypeDef status)
+{
+#if AGS10_STATS_ENABLE
+    AGS10_StatsTypeDef *p_stats = &ph_sensor->stats;
+
+    switch (status)
+    {
+    case AGS10_ERR_NACK_WRITE:
+        p_stats->nack_write++;
+        break;
+    case AGS10_ERR_NACK_READ:
+        p_stats->nack_read++;
+        break;
+    case AGS10_ERR_CRC:
+        p_stats->crc_fail++;
+        break;
+    case AGS10_ERR_TIMEOUT:
+        p_stats->timeout++;
+        break;
+    default:
+        p_stats->bus_error++;
+        break;
+    }
+
+    p_stats->last_error = (uint8_t)status;
+    p_stats->last_error_ms = bus_get_tick_ms(ph_sensor);
+#else
+    (void)ph_sensor;
+    (void)status;
+#endif
+}
+
+/*
+ * Every transaction that reached the bus ends here exactly once, so the
+ * counters add up to the number of transactions started.
+ */
+static AGS10_StatusTypeDef xfer_end(AGS10_HandleTypeDef *ph_sensor, AGS10_StatusTypeDef status)
+{
+    ph_sensor->last_status = (uint8_t)status;
+
+    if (AGS10_OK != status)
+    {
+        xfer_fault(ph_sensor, status);
+    }
+#if AGS10_STATS_ENABLE
+    else if (ph_sensor->xfer_attempt > 0U)
+    {
+        ph_sensor->stats.rescued++;
+    }
+#endif
+
+    return status;
+}
+
+static inline void xfer_begin(AGS10_HandleTypeDef *ph_sensor)
+{
+    ph_sensor->xfer_attempt = 0;
+
+#if AGS10_STATS_ENABLE
+    ph_sensor->stats.transactions++;
+#endif
+}
+
+/*
+ * Decides whether a failed attempt is tried again. If so the handle waits in
+ * AGS10_XFER_BACKOFF; the wait doubles with every retry up to the cap. The
+ * reason is kept in last_status in case the retry never runs.
+ */
+static bool xfer_retry(AGS10_HandleTypeDef *ph_sensor,
+                       AGS10_StatusTypeDef status,
+                       uint32_t now_ms,
+                       bool reading)
+{
+    const AGS10_RetryPolicyTypeDef *p_policy = &ph_sensor->retry;
+
+    if ((AGS10_ERR_PARAM == status) || ((ph_sensor->xfer_attempt + 1U) >= p_policy->max_attempts))
+    {
+        return false;
+    }
+
+    // a 16-bit wait shifted by at most 16 still fits, whatever max_attempts is
+    uint8_t shift = (ph_sensor->xfer_attempt < 16U) ? ph_sensor->xfer_attempt : 16U;
+    uint32_t backoff_ms = (uint32_t)p_policy->backoff_ms << shift;
+
+    if (backoff_ms > p_policy->backoff_max_ms)
+    {
+        backoff_ms = p_policy->backoff_max_ms;
+    }
+
+    xfer_fault(ph_sensor, status);
+#if AGS10_STATS_ENABLE
+    ph_sensor->stats.retries++;
+#endif
+
+    ph_sensor->last_status = (uint8_t)status;
+    ph_sensor->xfer_attempt++;
+    // the sensor keeps its register pointer, so a bad frame can simply be read again
+    ph_sensor->xfer_reread = reading && p_policy->reread;
+    ph_sensor->xfer_backoff_ms = (uint16_t)backoff_ms;
+    ph_sensor->xfer_start_ms = now_ms;
+    ph_sensor->xfer_state = AGS10_XFER_BACKOFF;
+
+    return true;
+}
+
+/*
+ * Retries need time to pass, so without a clock (elapsed set) the first
+ * failure is final.
+ */
+static AGS10_XferResultTypeDef xfer_fail(AGS10_HandleTypeDef *ph_sensor,
+                                         AGS10_StatusTypeDef status,
+                                         uint32_t now_ms,
+                                         bool elapsed,
+                                         bool reading)
+{
+    if (!elapsed && xfer_retry(ph_sensor, status, now_ms, reading))
+    {
+        return AGS10_XFER_PENDING;
+    }
+
+    ph_sensor->xfer_state = AGS10_XFER_IDLE;
+    (void)xfer_end(ph_sensor, status);
+
+    return AGS10_XFER_ERROR;
+}
+
+/*
+ * An asynchronous transfer still busy after AGS10MA_XFER_TIMEOUT_MS has lost
+ * its completion (a missed interrupt, a hung peripheral) and fails as a
+ * timeout. Without a clock (elapsed set) there is no deadline.
+ */
+static AGS10_XferResultTypeDef xfer_in_flight(AGS10_HandleTypeDef *ph_sensor,
+                                              uint32_t now_ms,
+                                              bool elapsed,
+                                              bool reading)
+{
+    // unsigned subtraction keeps this correct across tick wrap-around
+    if (elapsed || ((uint32_t)(now_ms - ph_sensor->xfer_io_ms) < AGS10MA_XFER_TIMEOUT_MS))
+    {
+        return AGS10_XFER_PENDING;
+    }
+
+    return xfer_fail(ph_sensor, AGS10_ERR_TIMEOUT, now_ms, false, reading);
+}
+
+/*
+ * A failure seen by ags10_register_read_ready(), which has no value to
+ * return: retried if the policy allows, else left for
+ * ags10_register_read_finish() to report.
+ */
+static void xfer_ready_fail(AGS10_HandleTypeDef *ph_sensor,
+                            AGS10_StatusTypeDef status,
+                            uint32_t now_ms)
+{
+    if (!xfer_retry(ph_sensor, status, now_ms, false))
+    {
+        ph_sensor->last_status = (uint8_t)status;
+        ph_sensor->xfer_state = AGS10_XFER_FAILED;
+    }
+}
+
+/* Sends the register pointer, the first step of every attempt that is not a re-read. */
+static AGS10_StatusTypeDef xfer_pointer_send(AGS10_HandleTypeDef *ph_sensor)
+{
+    AGS10_PROF_MARK(ph_sensor);
+
+    AGS10_StatusTypeDef register_addr_send_status = bus_write(ph_sensor, &ph_sensor->xfer_reg, 1);
+
+    if ((AGS10_OK == register_addr_send_status) && (0U != ph_sensor->xfer_delay_ms))
+    {
+        // the conversion delay runs from the pointer, so it cannot wait for the read
+        register_addr_send_status = bus_flush(ph_sensor);
+    }
+
+    if (AGS10_OK != register_addr_send_status)
+    {
+        return bus_status(register_addr_send_status, false);
+    }
+
+    AGS10_BusXferTypeDef xfer = bus_xfer_state(ph_sensor);
+
+    if ((AGS10_BUS_XFER_DONE != xfer) && (AGS10_BUS_XFER_BUSY != xfer))
+    {
+        return bus_xfer_status(xfer, false);
+    }
+
+    if (AGS10_BUS_XFER_BUSY != xfer)
+    {
+        AGS10_PROF_LAP(ph_sensor, AGS10_PROF_PTR_WRITE);
+    }
+
+    ph_sensor->xfer_state = (AGS10_BUS_XFER_BUSY == xfer) ? AGS10_XFER_WRITING
+                                                          : AGS10_XFER_CONVERTING;
+
+    return AGS10_OK;
+}
+
+/*
+ * Waits for an asynchronous write issued by the blocking API. The buffer
+ * may live on the caller's stack, so it must not return before the
+ * transfer has finished.
+ */
+static AGS10_StatusTypeDef bus_write_wait(AGS10_HandleTypeDef *ph_sensor)
+{
+    for (uint16_t waited_ms = 0; waited_ms < AGS10MA_XFER_TIMEOUT_MS; waited_ms++)
+    {
+        AGS10_BusXferTypeDef xfer = bus_xfer_state(ph_sensor);
+
+        if (AGS10_BUS_XFER_BUSY != xfer)
+        {
+            return bus_xfer_status(xfer, false);
+        }
+
+        bus_delay(ph_sensor, 1);
+    }
+
+    return AGS10_ERR_TIMEOUT;
+}
+
+/*
+ * Moves a transaction forward as far as the bus allows. With elapsed set the
+ * conversion wait is treated as over and failures are not retried, which is
+ * what ags10_register_read_finish() relies on. Once the handle is idle again
+ * the outcome is in last_status.
+ */
+static AGS10_XferResultTypeDef xfer_advance(AGS10_HandleTypeDef *ph_sensor,
+                                            uint32_t now_ms,
+                                            bool elapsed,
+                                            uint32_t *p_value)
+{
+    AGS10_BusXferTypeDef xfer;
+    AGS10_StatusTypeDef status;
+
+    switch (ph_sensor->xfer_state)
+    {
+    case AGS10_XFER_BACKOFF:
+        // unsigned subtraction keeps this correct across tick wrap-around
+        if ((uint32_t)(now_ms - ph_sensor->xfer_start_ms) < ph_sensor->xfer_backoff_ms)
+        {
+            return AGS10_XFER_PENDING;
+        }
+
+        if (ph_sensor->xfer_reread)
+        {
+            ph_sensor->xfer_state = AGS10_XFER_READY;
+        }
+        else
+        {
+            ph_sensor->xfer_start_ms = now_ms;
+            ph_sensor->xfer_io_ms = now_ms;
+            status = xfer_pointer_send(ph_sensor);
+            if (AGS10_OK != status)
+            {
+                return xfer_fail(ph_sensor, status, now_ms, elapsed, false);
+            }
+        }
+
+        return xfer_advance(ph_sensor, now_ms, elapsed, p_value);
+
+    case AGS10_XFER_WRITING:
+        xfer = bus_xfer_state(ph_sensor);
+        if (AGS10_BUS_XFER_BUSY == xfer)
+        {
+            return xfer_in_flight(ph_sensor, now_ms, elapsed, false);
+        }
+        if (AGS10_BUS_XFER_DONE != xfer)
+        {
+            return xfer_fail(ph_sensor, bus_xfer_status(xfer, false), now_ms, elapsed, false);
+        }
+        AGS10_PROF_LAP(ph_sensor, AGS10_PROF_PTR_WRITE);
+        ph_sensor->xfer_state = AGS10_XFER_CONVERTING;
+        // fall through
+
+    case AGS10_XFER_CONVERTING:
+        // unsigned subtraction keeps this correct across tick wrap-around
+        if (!elapsed &&
+            ((uint32_t)(now_ms - ph_sensor->xfer_start_ms) < ph_sensor->xfer_delay_ms))
+        {
+            return AGS10_XFER_PENDING;
+        }
+        ph_sensor->xfer_state = AGS10_XFER_READY;
+        // fall through
+
+    case AGS10_XFER_READY:
+        AGS10_PROF_LAP(ph_sensor, AGS10_PROF_CONVERT);
+        ph_sensor->xfer_io_ms = now_ms;
+        status = bus_read(ph_sensor, ph_sensor->xfer_frame, AGS10MA_FRAME_LEN);
+        if (AGS10_OK != status)
+        {
+            return xfer_fail(ph_sensor, bus_status(status, true), now_ms, elapsed, true);
+        }
+        ph_sensor->xfer_state = AGS10_XFER_READING;
+        // fall through
+
+    case AGS10_XFER_READING:
+        xfer = bus_xfer_state(ph_sensor);
+        if (AGS10_BUS_XFER_BUSY == xfer)
+        {
+            return xfer_in_flight(ph_sensor, now_ms, elapsed, true);
+        }
+        if (AGS10_BUS_XFER_DONE != xfer)
+        {
+            return xfer_fail(ph_sensor, bus_xfer_status(xfer, true), now_ms, elapsed, true);
+        }
+        AGS10_PROF_LAP(ph_sensor, AGS10_PROF_FRAME_READ);
+
+        const uint8_t *buff = ph_sensor->xfer_frame;
+        uint8_t crc = ags10_crc8(buff, AGS10MA_DATA_LEN);
+
+        AGS10_PROF_LAP(ph_sensor, AGS10_PROF_CRC);
+
+        if (crc != buff[AGS10MA_DATA_LEN]) 
+        {
+            return xfer_fail(ph_sensor, AGS10_ERR_CRC, now_ms, elapsed, true);
+        }
+
+        *p_value = ((uint32_t)buff[0] << 24) |
+                   ((uint32_t)buff[1] << 16) |
+                   ((uint32_t)buff[2] << 8)  |
+                   ((uint32_t)buff[3]);
+
+        AGS10_PROF_LAP(ph_sensor, AGS10_PROF_UNPACK);
+        ph_sensor->xfer_state = AGS10_XFER_IDLE;
+        (void)xfer_end(ph_sensor, AGS10_OK);
+        return AGS10_XFER_DONE;
+
+    case AGS10_XFER_FAILED:
+        // ags10_register_read_ready() stored the reason when it saw the failure
+        return xfer_fail(ph_sensor, (AGS10_StatusTypeDef)ph_sensor->last_status,
+                         now_ms, elapsed, false);
+
+    case AGS10_XFER_IDLE:
+    default:
+        // nothing was started, so there is nothing to count
+        ph_sensor->last_status = AGS10_ERR_PARAM;
+        return AGS10_XFER_ERROR;
+    }
+}
+
+/* Time left in a conversion or backoff wait, 0 if the transaction can move on. */
+static uint32_t xfer_wait_ms(const AGS10_HandleTypeDef *ph_sensor, uint32_t now_ms)
+{
+    uint32_t elapsed_ms = now_ms - ph_sensor->xfer_start_ms;
+    uint32_t wait_ms;
+
+    switch (ph_sensor->xfer_state)
+    {
+    case AGS10_XFER_CONVERTING:
+        wait_ms = ph_sensor->xfer_delay_ms;
+        break;
+    case AGS10_XFER_BACKOFF:
+        wait_ms = ph_sensor->xfer_backoff_ms;
+        break;
+    default:
+        return 0;
+    }
+
+    return (elapsed_ms < wait_ms) ? (wait_ms - elapsed_ms) : 0U;
+}
+
+static void tvoc_backoff(AGS10_HandleTypeDef *ph_sensor, uint32_t now_ms)
+{
+    ph_sensor->tvoc_next_ms = now_ms + ph_sensor->tvoc_backoff_ms;
+
+    if (ph_sensor->tvoc_backoff_ms < AGS10MA_TVOC_POLL_MAX_MS)
+    {
+        ph_sensor->tvoc_backoff_ms *= 2U;
+
+        if (ph_sensor->tvoc_backoff_ms > AGS10MA_TVOC_POLL_MAX_MS)
+        {
+            ph_sensor->tvoc_backoff_ms = AGS10MA_TVOC_POLL_MAX_MS;
+        }
+    }
+}
 
 /*******************************************************************************
 * Public Function Definitions
  ******************************************************************************/
 
-bool ags10_init(AGS10_HandleTypeDef *ph_sensor, 
-                uint8_t i2c_addr) 
+AGS10_StatusTypeDef ags10_init(AGS10_HandleTypeDef *ph_sensor, 
+                               uint8_t i2c_addr,
+                               const AGS10_BusOpsTypeDef *p_bus_ops,
+                               void *p_bus_ctx) 
 {
+    if (NULL == ph_sensor)
+    {
+        return AGS10_ERR_PARAM;
+    }
+
+#ifndef AGS10_STATIC_BUS_HEADER
+    if ((NULL == p_bus_ops) || (NULL == p_bus_ops->write) ||
+        (NULL == p_bus_ops->read) || (NULL == p_bus_ops->delay))
+    {
+        return AGS10_ERR_PARAM;
+    }
+#endif
+
     ph_sensor->i2c_addr = i2c_addr;
-    return true;
+    ph_sensor->p_bus_ops = p_bus_ops;
+    ph_sensor->p_bus_ctx = p_bus_ctx;
+    ph_sensor->xfer_state = AGS10_XFER_IDLE;
+    ph_sensor->xfer_start_ms = 0;
+    ph_sensor->xfer_io_ms = 0;
+    ph_sensor->xfer_attempt = 0;
+    ph_sensor->last_status = AGS10_OK;
+    ph_sensor->retry.max_attempts = 1;
+    ph_sensor->retry.reread = false;
+    ph_sensor->retry.backoff_ms = 0;
+    ph_sensor->retry.backoff_max_ms = 0;
+    ph_sensor->tvoc_next_ms = 0;
+    ph_sensor->tvoc_fresh_ms = 0;
+    ph_sensor->tvoc_period_ms = 0;
+    ph_sensor->tvoc_backoff_ms = AGS10MA_TVOC_POLL_MIN_MS;
+    ph_sensor->tvoc_stale_ms = 0;
+    ph_sensor->tvoc_flags = 0;
+#if AGS10_STATS_ENABLE
+    ags10_stats_reset(ph_sensor);
+#endif
+    return AGS10_OK;
 }
 
-bool ags10_register_read(AGS10_HandleTypeDef *ph_sensor, 
-                         uint8_t reg, 
-                         uint16_t delayms, 
-                         uint32_t *p_value)
+AGS10_StatusTypeDef ags10_register_read(AGS10_HandleTypeDef *ph_sensor, 
+                                        uint8_t reg, 
+                                        uint16_t delayms, 
+                                        uint32_t *p_value)
 {
-    
+    if (NULL == p_value)
+    {
+        return AGS10_ERR_PARAM;
+    }
 
-    bool register_addr_send_status = AGS10_IO_Write(ph_sensor->i2c_addr, &reg, 1);
+    AGS10_StatusTypeDef status = ags10_register_read_start(ph_sensor, reg, delayms, 0U);
 
-    if (false == register_addr_send_status)
+    if (AGS10_OK != status)
     {
-        return false;
+        return status;
+    }
+
+    // the blocking API keeps its own clock: the time spent in bus_delay()
+    uint32_t now_ms = 0;
+    AGS10_XferResultTypeDef result = xfer_advance(ph_sensor, now_ms, false, p_value);
+
+    while (AGS10_XFER_PENDING == result)
+    {
+        uint32_t wait_ms = xfer_wait_ms(ph_sensor, now_ms);
+
+        if ((AGS10_XFER_WRITING == ph_sensor->xfer_state) ||
+            (AGS10_XFER_READING == ph_sensor->xfer_state))
+        {
+            // only asynchronous buses get here; xfer_advance() times them out
+            wait_ms = 1;
+        }
+
+        if (wait_ms > 0U)
+        {
+            bus_delay(ph_sensor, (uint16_t)wait_ms);
+            now_ms += wait_ms;
+        }
+
+        result = xfer_advance(ph_sensor, now_ms, false, p_value);
     }
-        
 
-    AGS10_IO_Delay(delayms);
+    return (AGS10_StatusTypeDef)ph_sensor->last_status;
+}
+
+AGS10_StatusTypeDef ags10_register_read_start(AGS10_HandleTypeDef *ph_sensor,
+                                              uint8_t reg,
+                                              uint16_t delayms,
+                                              uint32_t now_ms)
+{
+    if (NULL == ph_sensor)
+    {
+        return AGS10_ERR_PARAM;
+    }
+
+    if (AGS10_XFER_IDLE != ph_sensor->xfer_state)
+    {
+        return AGS10_ERR_BUSY;
+    }
+
+    // kept in the handle: an asynchronous bus reads it after we return
+    ph_sensor->xfer_reg = reg;
+    ph_sensor->xfer_delay_ms = delayms;
+    ph_sensor->xfer_start_ms = now_ms;
+    ph_sensor->xfer_io_ms = now_ms;
+    xfer_begin(ph_sensor);
+
+    AGS10_StatusTypeDef status = xfer_pointer_send(ph_sensor);
+
+    if ((AGS10_OK != status) && (false == xfer_retry(ph_sensor, status, now_ms, false)))
+    {
+        return xfer_end(ph_sensor, status);
+    }
 
-    #define READ_BYTE_CNT 5
-    uint8_t buff[READ_BYTE_CNT] = {0U};
+    return AGS10_OK;
+}
 
-    if (!AGS10_IO_Read(ph_sensor->i2c_addr,
-                       buff,
-                       READ_BYTE_CNT))
+bool ags10_register_read_ready(AGS10_HandleTypeDef *ph_sensor,
+                               uint32_t now_ms)
+{
+    if (NULL == ph_sensor)
     {
         return false;
     }
-    #undef READ_BYTE_CNT
 
-    if (ags10_crc8(buff, AGS10MA_DATA_LEN) != buff[AGS10MA_DATA_LEN]) 
+    // unsigned subtraction keeps these correct across tick wrap-around
+    if ((AGS10_XFER_BACKOFF == ph_sensor->xfer_state) &&
+        ((uint32_t)(now_ms - ph_sensor->xfer_start_ms) >= ph_sensor->xfer_backoff_ms))
     {
-        return false; 
+        if (ph_sensor->xfer_reread)
+        {
+            ph_sensor->xfer_state = AGS10_XFER_READY;
+        }
+        else
+        {
+            ph_sensor->xfer_start_ms = now_ms;
+            ph_sensor->xfer_io_ms = now_ms;
+
+            AGS10_StatusTypeDef status = xfer_pointer_send(ph_sensor);
+
+            if (AGS10_OK != status)
+            {
+                xfer_ready_fail(ph_sensor, status, now_ms);
+            }
+        }
     }
 
-    *p_value = ((uint32_t)buff[0] << 24) |
-               ((uint32_t)buff[1] << 16) |
-               ((uint32_t)buff[2] << 8)  |
-               ((uint32_t)buff[3]);
+    if (AGS10_XFER_WRITING == ph_sensor->xfer_state)
+    {
+        AGS10_BusXferTypeDef xfer = bus_xfer_state(ph_sensor);
 
-    return true;
+        if (AGS10_BUS_XFER_DONE == xfer)
+        {
+            AGS10_PROF_LAP(ph_sensor, AGS10_PROF_PTR_WRITE);
+            ph_sensor->xfer_state = AGS10_XFER_CONVERTING;
+        }
+        else if (AGS10_BUS_XFER_BUSY != xfer)
+        {
+            xfer_ready_fail(ph_sensor, bus_xfer_status(xfer, false), now_ms);
+        }
+        else if ((uint32_t)(now_ms - ph_sensor->xfer_io_ms) >= AGS10MA_XFER_TIMEOUT_MS)
+        {
+            xfer_ready_fail(ph_sensor, AGS10_ERR_TIMEOUT, now_ms);
+        }
+    }
+
+    if ((AGS10_XFER_CONVERTING == ph_sensor->xfer_state) &&
+        ((uint32_t)(now_ms - ph_sensor->xfer_start_ms) >= ph_sensor->xfer_delay_ms))
+    {
+        ph_sensor->xfer_state = AGS10_XFER_READY;
+    }
+
+    return (AGS10_XFER_READY == ph_sensor->xfer_state) ||
+           (AGS10_XFER_FAILED == ph_sensor->xfer_state);
 }
 
-bool ags10_firmware_version_get(AGS10_HandleTypeDef *ph_sensor, 
-                                uint32_t *p_version)
+AGS10_StatusTypeDef ags10_register_read_finish(AGS10_HandleTypeDef *ph_sensor,
+                                               uint32_t *p_value)
 {
-    return ags10_register_read(ph_sensor, AGS10MA_VERSION_REG, 30, p_version);
+    if ((NULL == ph_sensor) || (NULL == p_value) ||
+        (AGS10_XFER_IDLE == ph_sensor->xfer_state))
+    {
+        return AGS10_ERR_PARAM;
+    }
+
+    if (AGS10_XFER_BACKOFF == ph_sensor->xfer_state)
+    {
+        // no clock to wait out the backoff with: the failure it follows is final
+        ph_sensor->xfer_state = AGS10_XFER_IDLE;
+#if AGS10_STATS_ENABLE
+        // already counted as a fault, only the retry never ran
+        ph_sensor->stats.retries--;
+#endif
+        return (AGS10_StatusTypeDef)ph_sensor->last_status;
+    }
+
+    if (AGS10_XFER_PENDING == xfer_advance(ph_sensor, 0U, true, p_value))
+    {
+        return AGS10_ERR_BUSY;
+    }
+
+    return (AGS10_StatusTypeDef)ph_sensor->last_status;
 }
 
-bool ags10_tvoc_get(AGS10_HandleTypeDef *ph_sensor, uint32_t *p_tvoc) 
+AGS10_XferResultTypeDef ags10_register_read_poll(AGS10_HandleTypeDef *ph_sensor,
+                                                 uint32_t now_ms,
+                                                 uint32_t *p_value)
 {
-    if (false == ags10_register_read(ph_sensor, 
-                                     AGS10MA_TVOC_STAT_REG, 
-                                     1000, 
-                                     p_tvoc)) 
+    if ((NULL == ph_sensor) || (NULL == p_value))
     {
-        #define FAIL_VAL 0xFFFFFFFF
-        *p_tvoc = FAIL_VAL;
-        #undef FAIL_VAL
+        return AGS10_XFER_ERROR;
     }
 
-    *p_tvoc &= 0xFFFFFF;
+    return xfer_advance(ph_sensor, now_ms, false, p_value);
+}
 
-    return true;
+void ags10_register_read_abort(AGS10_HandleTypeDef *ph_sensor)
+{
+    if (NULL != ph_sensor)
+    {
+        ph_sensor->xfer_state = AGS10_XFER_IDLE;
+    }
+}
+
+uint32_t ags10_register_read_wait_ms(const AGS10_HandleTypeDef *ph_sensor,
+                                     uint32_t now_ms)
+{
+    if (NULL == ph_sensor)
+    {
+        return 0;
+    }
+
+    return xfer_wait_ms(ph_sensor, now_ms);
+}
+
+AGS10_StatusTypeDef ags10_retry_policy_set(AGS10_HandleTypeDef *ph_sensor,
+                                           const AGS10_RetryPolicyTypeDef *p_policy)
+{
+    if ((NULL == ph_sensor) || (NULL == p_policy))
+    {
+        return AGS10_ERR_PARAM;
+    }
+
+    if (AGS10_XFER_IDLE != ph_sensor->xfer_state)
+    {
+        return AGS10_ERR_BUSY;
+    }
+
+    ph_sensor->retry = *p_policy;
+
+    if (0U == ph_sensor->retry.max_attempts)
+    {
+        ph_sensor->retry.max_attempts = 1;
+    }
+
+    if (ph_sensor->retry.backoff_max_ms < ph_sensor->retry.backoff_ms)
+    {
+        ph_sensor->retry.backoff_max_ms = ph_sensor->retry.backoff_ms;
+    }
+
+    return AGS10_OK;
+}
+
+AGS10_StatusTypeDef ags10_firmware_version_get(AGS10_HandleTypeDef *ph_sensor, 
+                                               uint32_t *p_version)
+{
+    return ags10_register_read(ph_sensor, AGS10MA_VERSION_REG, AGS10MA_VERSION_DELAY_MS, p_version);
+}
+
+AGS10_StatusTypeDef ags10_tvoc_get(AGS10_HandleTypeDef *ph_sensor, uint32_t *p_tvoc) 
+{
+    uint32_t raw;
+    AGS10_StatusTypeDef status = ags10_register_read(ph_sensor, 
+                                                     AGS10MA_TVOC_STAT_REG, 
+                                                     AGS10MA_TVOC_DELAY_MS, 
+                                                     &raw);
+
+    if (AGS10_OK == status) 
+    {
+        *p_tvoc = raw & AGS10MA_TVOC_MSK;
+    }
+
+    return status;
+}
+
+bool ags10_tvoc_poll(AGS10_HandleTypeDef *ph_sensor,
+                     uint32_t now_ms,
+                     AGS10_TvocSampleTypeDef *p_sample)
+{
+    if ((NULL == ph_sensor) || (NULL == p_sample))
+    {
+        return false;
+    }
+
+    if (AGS10_XFER_IDLE == ph_sensor->xfer_state)
+    {
+        if ((int32_t)(now_ms - ph_sensor->tvoc_next_ms) < 0)
+        {
+            return false;
+        }
+
+        if (AGS10_OK != ags10_register_read_start(ph_sensor,
+                                                  AGS10MA_TVOC_STAT_REG,
+                                                  AGS10MA_ACCESS_DELAY_MS,
+                                                  now_ms))
+        {
+            tvoc_backoff(ph_sensor, now_ms);
+        }
+
+        return false;
+    }
+
+    if (AGS10MA_TVOC_STAT_REG != ph_sensor->xfer_reg)
+    {
+        return false;
+    }
+
+    uint32_t raw;
+    AGS10_XferResultTypeDef result = ags10_register_read_poll(ph_sensor, now_ms, &raw);
+
+    if (AGS10_XFER_PENDING == result)
+    {
+        return false;
+    }
+
+    if (AGS10_XFER_DONE != result)
+    {
+        tvoc_backoff(ph_sensor, now_ms);
+        return false;
+    }
+
+    ags10_tvoc_decode(raw, p_sample);
+
+    bool has_fresh = (0U != (ph_sensor->tvoc_flags & TVOC_FLAG_HAS_FRESH));
+
+    if (p_sample->fresh)
+    {
+        // only a value caught right after a stale read pins down the update time
+        bool edge = (0U != (ph_sensor->tvoc_flags & TVOC_FLAG_STALE)) &&
+                    ((now_ms - ph_sensor->tvoc_stale_ms) <= (2U * AGS10MA_TVOC_POLL_MIN_MS));
+
+        if (edge && (0U != (ph_sensor->tvoc_flags & TVOC_FLAG_EDGE)))
+        {
+            uint32_t interval_ms = now_ms - ph_sensor->tvoc_fresh_ms;
+
+            if (interval_ms > UINT16_MAX)
+            {
+                interval_ms = UINT16_MAX;
+            }
+
+            ph_sensor->tvoc_period_ms = (0U == ph_sensor->tvoc_period_ms)
+                ? (uint16_t)interval_ms
+                : (uint16_t)((3U * ph_sensor->tvoc_period_ms + interval_ms) / 4U);
+        }
+
+        ph_sensor->tvoc_flags = TVOC_FLAG_HAS_FRESH | (edge ? TVOC_FLAG_EDGE : 0U);
+        ph_sensor->tvoc_fresh_ms = now_ms;
+        ph_sensor->tvoc_backoff_ms = AGS10MA_TVOC_POLL_MIN_MS;
+        ph_sensor->tvoc_next_ms = now_ms + AGS10MA_TVOC_POLL_MIN_MS;
+
+        if (ph_sensor->tvoc_period_ms > (3U * AGS10MA_TVOC_POLL_MIN_MS))
+        {
+            // aim a little early so the next read sees the update arrive
+            ph_sensor->tvoc_next_ms = now_ms + ph_sensor->tvoc_period_ms - (2U * AGS10MA_TVOC_POLL_MIN_MS);
+        }
+    }
+    else
+    {
+        ph_sensor->tvoc_flags |= TVOC_FLAG_STALE;
+        ph_sensor->tvoc_stale_ms = now_ms;
+
+        if (has_fresh &&
+            ((0U == ph_sensor->tvoc_period_ms) ||
+             ((now_ms - ph_sensor->tvoc_fresh_ms) < ((uint32_t)ph_sensor->tvoc_period_ms + AGS10MA_TVOC_POLL_MAX_MS))))
+        {
+            // the update is due any moment (or the period is still being
+            // learnt), poll at the finest step to catch it
+            ph_sensor->tvoc_next_ms = now_ms + AGS10MA_TVOC_POLL_MIN_MS;
+        }
+        else
+        {
+            tvoc_backoff(ph_sensor, now_ms);
+        }
+    }
+
+    has_fresh = (0U != (ph_sensor->tvoc_flags & TVOC_FLAG_HAS_FRESH));
+    p_sample->preheating = !has_fresh;
+    p_sample->age_ms = has_fresh ? (now_ms - ph_sensor->tvoc_fresh_ms) : UINT32_MAX;
+
+    return p_sample->fresh;
 }
 
-bool ags10_address_set(AGS10_HandleTypeDef *ph_sensor, uint8_t new_addr)
+void ags10_tvoc_decode(uint32_t raw, AGS10_TvocSampleTypeDef *p_sample)
+{
+    p_sample->status = (uint8_t)(raw >> 24);
+    p_sample->tvoc_ppb = raw & AGS10MA_TVOC_MSK;
+    p_sample->fresh = (0U == (p_sample->status & AGS10MA_STATUS_RDY_MSK));
+    p_sample->preheating = false;
+    p_sample->age_ms = 0;
+}
+
+AGS10_StatusTypeDef ags10_address_set(AGS10_HandleTypeDef *ph_sensor, uint8_t new_addr)
 {
     uint8_t buf[6] = {
         AGS10MA_SET_ADDR_REG,
         new_addr,
-        ~new_addr,
+        (uint8_t)~new_addr,
         new_addr,
-        ~new_addr,
+        (uint8_t)~new_addr,
         0x00,
     };
 
-    bool status = AGS10_IO_Write(ph_sensor->i2c_addr, buf, 6);
+    // the sensor ignores the frame unless it carries the CRC of the 4 data bytes
+    buf[5] = ags10_crc8(&buf[1], AGS10MA_DATA_LEN);
 
-    if (!status)
+    if (NULL == ph_sensor)
     {
-        return false;
+        return AGS10_ERR_PARAM;
+    }
+
+    if (AGS10_XFER_IDLE != ph_sensor->xfer_state)
+    {
+        return AGS10_ERR_BUSY;
+    }
+
+    xfer_begin(ph_sensor);
+
+    AGS10_StatusTypeDef status = bus_write(ph_sensor, buf, 6);
+
+    if (AGS10_OK == status)
+    {
+        status = bus_write_wait(ph_sensor);
+    }
+
+    status = xfer_end(ph_sensor, bus_status(status, false));
+
+    if (AGS10_OK != status)
+    {
+        return status;
     }
     ph_sensor->i2c_addr = new_addr;
 
-    return true;
+    return AGS10_OK;
 }
 
 uint8_t ags10_crc8(const uint8_t *p_data, int len)
 {
-    const uint8_t POLYNOMIAL = 0x31;
-    uint8_t crc = 0xFF;
+#if (AGS10_CRC8_ENGINE == AGS10_CRC8_ENGINE_BITWISE)
+    return ags10_crc8_bitwise(p_data, len);
+#elif (AGS10_CRC8_ENGINE == AGS10_CRC8_ENGINE_NIBBLE)
+    return ags10_crc8_nibble(p_data, len);
+#elif (AGS10_CRC8_ENGINE == AGS10_CRC8_ENGINE_TABLE)
+    return ags10_crc8_table(p_data, len);
+#elif (AGS10_CRC8_ENGINE == AGS10_CRC8_ENGINE_SLICE4)
+    return ags10_crc8_slice4(p_data, len);
+#else
+#error "AGS10_CRC8_ENGINE: unknown engine"
+#endif
+}
+
+uint8_t ags10_crc8_bitwise(const uint8_t *p_data, int len)
+{
+    const uint8_t POLYNOMIAL = AGS10MA_CRC8_POLYNOMIAL;
+    uint8_t crc = AGS10MA_CRC8_INIT;
 
     for (int idx_1 = 0; idx_1 < len; idx_1++)
     {
@@ -124,4 +1049,74 @@ uint8_t ags10_crc8(const uint8_t *p_data, int len)
 
     return crc;
 }
+
+uint8_t ags10_crc8_nibble(const uint8_t *p_data, int len)
+{
+    uint8_t crc = AGS10MA_CRC8_INIT;
+
+    for (int idx = 0; idx < len; idx++)
+    {
+        crc ^= p_data[idx];
+        crc = (uint8_t)(crc << 4) ^ crc8_nibble_lut[crc >> 4];
+        crc = (uint8_t)(crc << 4) ^ crc8_nibble_lut[crc >> 4];
+    }
+
+    return crc;
+}
+
+uint8_t ags10_crc8_table(const uint8_t *p_data, int len)
+{
+    uint8_t crc = AGS10MA_CRC8_INIT;
+
+    for (int idx = 0; idx < len; idx++)
+    {
+        crc = crc8_lut[0][crc ^ p_data[idx]];
+    }
+
+    return crc;
+}
+
+uint8_t ags10_crc8_slice4(const uint8_t *p_data, int len)
+{
+    uint8_t crc = AGS10MA_CRC8_INIT;
+    int idx = 0;
+
+    for (; (idx + 4) <= len; idx += 4)
+    {
+        crc = crc8_lut[3][crc ^ p_data[idx]] ^
+              crc8_lut[2][p_data[idx + 1]]   ^
+              crc8_lut[1][p_data[idx + 2]]   ^
+              crc8_lut[0][p_data[idx + 3]];
+    }
+
+    for (; idx < len; idx++)
+    {
+        crc = crc8_lut[0][crc ^ p_data[idx]];
+    }
+
+    return crc;
+}
+
+#if AGS10_STATS_ENABLE
+AGS10_StatusTypeDef ags10_stats_get(const AGS10_HandleTypeDef *ph_sensor,
+                                    AGS10_StatsTypeDef *p_stats)
+{
+    if ((NULL == ph_sensor) || (NULL == p_stats))
+    {
+        return AGS10_ERR_PARAM;
+    }
+
+    *p_stats = ph_sensor->stats;
+
+    return AGS10_OK;
+}
+
+void ags10_stats_reset(AGS10_HandleTypeDef *ph_sensor)
+{
+    if (NULL != ph_sensor)
+    {
+        memset(&ph_sensor->stats, 0, sizeof(ph_sensor->stats));
+    }
+}
+#endif
 // eof
\ No newline at end of file
@@ -0,0 +1,215 @@
+/**
+ * @file ags10_clock.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief I2C clock-rate calibration per bus, kept in flash.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_CLOCK_H_
+#define INC_AGS10_CLOCK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ags10.h"
+#include "ags10_log.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define AGS10_CLOCK_MAX_RATES       16U     /**< Entries of a rate table. */
+#define AGS10_CLOCK_READS           50U     /**< Default version reads per rate. */
+#define AGS10_CLOCK_TARGET_PERMILLE 20U     /**< Default error ceiling, per 1000 reads: one in 50. */
+#define AGS10_CLOCK_RATE_COUNT      9U      /**< Entries of ags10_clock_rates. */
+
+#define AGS10_CLOCK_REC_MAGIC       0xA6C1U
+#define AGS10_CLOCK_REC_LEN         8U      /**< Bytes per record: magic, rate, check. */
+
+/*******************************************************************************/
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+/**
+ * @brief Reconfigure the bus clock.
+ *
+ * Called between transfers only. On an STM32 this sets
+ * hi2c->Init.ClockSpeed and runs HAL_I2C_Init() again.
+ *
+ * @param[in] p_ctx Context given to ags10_clock_init().
+ * @param[in] clock_hz New SCL rate.
+ *
+ * @return false if the rate could not be set.
+ */
+typedef bool (*AGS10_ClockSetFn)(void *p_ctx, uint32_t clock_hz);
+
+/**
+ * @brief Outcome of the last test at one rate.
+ */
+typedef struct {
+    uint16_t reads;
+    uint16_t errors;            /**< Reads that failed, for any reason. */
+    uint16_t crc_errors;        /**< Frames that arrived with a bad checksum. */
+    uint16_t nacks;             /**< Pointer writes or reads not acknowledged. */
+} AGS10_ClockStepTypeDef;
+
+/**
+ * @brief Clock calibration of one bus, tested against one AGS10.
+ *
+ * A rate is tested by sending the version register pointer once, waiting
+ * AGS10MA_VERSION_DELAY_MS, then reading the frame `reads` times. The pointer
+ * stays valid, so each further read costs only its bus time, and a pointer
+ * write that fails is sent again before the next read. A rate passes if
+ * no more than target_permille of its reads failed, CRC errors and NACKs
+ * alike.
+ *
+ * The rate table is in ascending order. Calibration sweeps it from the
+ * slowest rate up and keeps the last rate that passed before the first
+ * one that did not, so the result is never above a failing rate.
+ * Validation re-tests the current rate and steps down the table until a
+ * rate passes; it never goes up again, only a new calibration does.
+ *
+ * With storage set, each new rate is appended to one flash page as a
+ * record of a magic, the rate and a CRC-8. The page is erased only when it
+ * is full, and a record cut short by power loss fails its check and is
+ * skipped.
+ *
+ * Times come from the bus's get_tick_ms and are 0 without one.
+ */
+typedef struct {
+    const AGS10_BusOpsTypeDef *p_bus_ops;
+    void *p_bus_ctx;
+    uint8_t addr;               /**< AGS10 used for the test reads. */
+    AGS10_ClockSetFn set_clock;
+    void *p_clock_ctx;
+    const uint32_t *p_rates;
+    uint8_t rate_count;
+
+    uint16_t reads;             /**< AGS10_CLOCK_READS. */
+    uint16_t target_permille;   /**< AGS10_CLOCK_TARGET_PERMILLE. */
+
+    /* Storage, see ags10_clock_storage_set() */
+    const AGS10_LogFlashOpsTypeDef *p_flash_ops;
+    void *p_flash_ctx;
+    uint32_t flash_addr;
+    uint32_t page_size;
+
+    /* Results */
+    uint32_t clock_hz;          /**< Rate in use, 0 before any was applied. */
+    uint8_t rate_index;
+    AGS10_ClockStepTypeDef steps[AGS10_CLOCK_MAX_RATES];    /**< Last test at each rate. */
+    uint32_t cal_ms;            /**< Duration of the last calibration. */
+    uint32_t calibrations;
+    uint32_t validations;
+    uint32_t downgrades;        /**< Rates lowered by validation. */
+    uint32_t saves;             /**< Records written. */
+
+    /* Owned by the calibration */
+    uint32_t stored_hz;         /**< Rate of the newest record, 0 if none. */
+    uint32_t rec_off;           /**< Offset of the next record in the page. */
+} AGS10_ClockCalTypeDef;
+
+/*******************************************************************************
+* Public Variables
+ ******************************************************************************/
+/**
+ * @brief Default rate table, 10 kHz to 100 kHz.
+ *
+ * The AGS10 data sheet gives 15 kHz as the limit and the example has run at
+ * 20 kHz; short traces often do better, long harnesses worse.
+ */
+extern const uint32_t ags10_clock_rates[AGS10_CLOCK_RATE_COUNT];
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+
+/**
+ * @brief Describe a bus to calibrate, with the defaults noted in the struct.
+ *
+ * Nothing is sent and the clock is not touched.
+ *
+ * @param[out] p_cal Calibration to initialise.
+ * @param[in] p_bus_ops Bus operations, as for ags10_init().
+ * @param[in] p_bus_ctx Bus context passed to every operation.
+ * @param[in] addr Address of an AGS10 on the bus.
+ * @param[in] set_clock Clock switch callback.
+ * @param[in] p_clock_ctx Context passed to set_clock.
+ * @param[in] p_rates Rates in ascending order, e.g. ags10_clock_rates.
+ * @param[in] rate_count Entries in p_rates, up to AGS10_CLOCK_MAX_RATES.
+ *
+ * @retval true  Calibration ready.
+ * @retval false Invalid arguments or a table that is not strictly ascending.
+ */
+bool ags10_clock_init(AGS10_ClockCalTypeDef *p_cal,
+                      const AGS10_BusOpsTypeDef *p_bus_ops,
+                      void *p_bus_ctx,
+                      uint8_t addr,
+                      AGS10_ClockSetFn set_clock,
+                      void *p_clock_ctx,
+                      const uint32_t *p_rates,
+                      uint8_t rate_count);
+
+/**
+ * @brief Keep the chosen rate in a flash page of its own.
+ *
+ * @param[in,out] p_cal Calibration.
+ * @param[in] p_ops Flash access.
+ * @param[in] p_ctx Context passed to every op.
+ * @param[in] page_addr Address of the page.
+ * @param[in] page_size Page size in bytes, at least one record.
+ *
+ * @retval true  Storage set.
+ * @retval false Invalid arguments.
+ */
+bool ags10_clock_storage_set(AGS10_ClockCalTypeDef *p_cal,
+                             const AGS10_LogFlashOpsTypeDef *p_ops,
+                             void *p_ctx,
+                             uint32_t page_addr,
+                             uint32_t page_size);
+
+/**
+ * @brief Apply the newest stored rate.
+ *
+ * Follow it with ags10_clock_validate() to check the rate still holds.
+ *
+ * @param[in,out] p_cal Calibration with storage set.
+ *
+ * @retval AGS10_OK        Stored rate applied.
+ * @retval AGS10_ERR_PARAM No storage, no valid record, or a rate that is
+ *                         not in the table.
+ * @retval AGS10_ERR_BUS   set_clock failed.
+ */
+AGS10_StatusTypeDef ags10_clock_load(AGS10_ClockCalTypeDef *p_cal);
+
+/**
+ * @brief Sweep the table and apply and store the fastest good rate.
+ *
+ * @param[in,out] p_cal Calibration.
+ *
+ * @retval AGS10_OK      A rate passed and is in use.
+ * @retval AGS10_ERR_BUS set_clock failed.
+ * @return Otherwise the last read failure at the slowest rate, which is
+ *         left in use.
+ */
+AGS10_StatusTypeDef ags10_clock_calibrate(AGS10_ClockCalTypeDef *p_cal);
+
+/**
+ * @brief Re-test the rate in use, lowering and storing it if it fails.
+ *
+ * Call it periodically, while no other transfer is in progress on the bus.
+ * Runs a calibration if no rate is in use yet.
+ *
+ * @param[in,out] p_cal Calibration.
+ *
+ * @retval AGS10_OK      The rate in use, possibly lowered, passed.
+ * @retval AGS10_ERR_BUS set_clock failed.
+ * @return Otherwise as ags10_clock_calibrate().
+ */
+AGS10_StatusTypeDef ags10_clock_validate(AGS10_ClockCalTypeDef *p_cal);
+
+#endif /* INC_AGS10_CLOCK_H_ */
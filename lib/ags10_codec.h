@@ -0,0 +1,156 @@
+/**
+ * @file ags10_codec.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Delta + zig-zag varint compression of sample streams.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_CODEC_H_
+#define INC_AGS10_CODEC_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define AGS10_CODEC_MAX_BYTES       5U      /**< Longest code of one 32-bit value. */
+#define AGS10_CODEC_BLOCK_LEN       64U     /**< Default values per block. */
+
+/*******************************************************************************/
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+/**
+ * @brief Streaming encoder state, 8 bytes.
+ *
+ * The stream is cut into blocks of block_len values. The first value of a
+ * block is stored as is and every other one as the zig-zag coded difference
+ * to its predecessor, each as a little-endian base-128 varint (7 bits per
+ * byte, top bit set on all but the last byte). A slowly changing TVOC costs
+ * one byte per sample instead of four.
+ *
+ * A block depends on nothing before it, so its first byte is a restart
+ * point: decoding can start there, and a damaged byte only loses the rest
+ * of its block.
+ */
+typedef struct {
+    uint32_t prev;
+    uint16_t in_block;      /**< Values already in the current block. */
+    uint16_t block_len;
+} AGS10_CodecEncTypeDef;
+
+/**
+ * @brief Streaming decoder state, same layout as the encoder's.
+ */
+typedef struct {
+    uint32_t prev;
+    uint16_t in_block;
+    uint16_t block_len;
+} AGS10_CodecDecTypeDef;
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+
+/**
+ * @brief Start a stream.
+ *
+ * @param[out] p_enc Encoder.
+ * @param[in] block_len Values per block, 0 for AGS10_CODEC_BLOCK_LEN.
+ */
+void ags10_codec_enc_init(AGS10_CodecEncTypeDef *p_enc, uint16_t block_len);
+
+/**
+ * @brief Whether the next value starts a block.
+ *
+ * Callers that keep an index note their output offset when this is true.
+ *
+ * @param[in] p_enc Encoder.
+ *
+ * @return true at a restart point.
+ */
+bool ags10_codec_enc_restart(const AGS10_CodecEncTypeDef *p_enc);
+
+/**
+ * @brief Encode one value.
+ *
+ * @param[in,out] p_enc Encoder.
+ * @param[in] value Sample.
+ * @param[out] p_out Room for AGS10_CODEC_MAX_BYTES bytes.
+ *
+ * @return Bytes written, 1 to AGS10_CODEC_MAX_BYTES.
+ */
+uint8_t ags10_codec_encode(AGS10_CodecEncTypeDef *p_enc, uint32_t value, uint8_t *p_out);
+
+/**
+ * @brief Start decoding at a restart point.
+ *
+ * @param[out] p_dec Decoder.
+ * @param[in] block_len Block length the stream was encoded with, 0 for the default.
+ */
+void ags10_codec_dec_init(AGS10_CodecDecTypeDef *p_dec, uint16_t block_len);
+
+/**
+ * @brief Decode one value.
+ *
+ * @param[in,out] p_dec Decoder.
+ * @param[in] p_in Encoded bytes.
+ * @param[in] len Bytes available.
+ * @param[out] p_value Sample.
+ *
+ * @return Bytes consumed, or 0 if the input ends inside a value or the
+ *         value is malformed (longer than 32 bits); the state is then
+ *         unchanged.
+ */
+uint8_t ags10_codec_decode(AGS10_CodecDecTypeDef *p_dec, const uint8_t *p_in, uint32_t len, uint32_t *p_value);
+
+/**
+ * @brief Find the restart points of an encoded stream.
+ *
+ * Only scans for varint ends, no values are decoded.
+ *
+ * @param[in] p_in Encoded stream.
+ * @param[in] len Stream length.
+ * @param[in] block_len Block length it was encoded with, 0 for the default.
+ * @param[out] p_offsets Byte offset of each block.
+ * @param[in] max_blocks Room in p_offsets.
+ *
+ * @return Blocks found (may exceed max_blocks, only max_blocks are stored).
+ */
+uint32_t ags10_codec_index(const uint8_t *p_in,
+                           uint32_t len,
+                           uint16_t block_len,
+                           uint32_t *p_offsets,
+                           uint32_t max_blocks);
+
+/**
+ * @brief Decode the value at a position using an index.
+ *
+ * Costs at most one block of decoding.
+ *
+ * @param[in] p_in Encoded stream.
+ * @param[in] len Stream length.
+ * @param[in] block_len Block length it was encoded with, 0 for the default.
+ * @param[in] p_offsets Index from ags10_codec_index().
+ * @param[in] blocks Entries in p_offsets.
+ * @param[in] pos Position of the value in the stream.
+ * @param[out] p_value Sample.
+ *
+ * @retval true  Value decoded.
+ * @retval false Position outside the stream or corrupt block.
+ */
+bool ags10_codec_decode_at(const uint8_t *p_in,
+                           uint32_t len,
+                           uint16_t block_len,
+                           const uint32_t *p_offsets,
+                           uint32_t blocks,
+                           uint32_t pos,
+                           uint32_t *p_value);
+
+#endif /* INC_AGS10_CODEC_H_ */
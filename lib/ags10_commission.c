@@ -0,0 +1,248 @@
+/**
+ * @file ags10_commission.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_commission.h"
+#include "ags10_scan.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static uint32_t commission_tick_ms(const AGS10_CommissionTypeDef *p_comm)
+{
+    if (NULL == p_comm->p_bus_ops->get_tick_ms)
+    {
+        return 0;
+    }
+
+    return p_comm->p_bus_ops->get_tick_ms(p_comm->p_bus_ctx);
+}
+
+/* Version byte at addr, through the engine's own handle. */
+static AGS10_StatusTypeDef commission_version(AGS10_CommissionTypeDef *p_comm, uint8_t addr, uint8_t *p_version)
+{
+    uint32_t value;
+    AGS10_StatusTypeDef status = ags10_init(&p_comm->sensor, addr, p_comm->p_bus_ops, p_comm->p_bus_ctx);
+
+    if (AGS10_OK == status)
+    {
+        status = ags10_firmware_version_get(&p_comm->sensor, &value);
+    }
+
+    if (AGS10_OK == status)
+    {
+        *p_version = (uint8_t)(value & 0xFFU);
+    }
+
+    return status;
+}
+
+/*
+ * Puts a failed device back where it started. Once the address frame went
+ * out the device may have taken the new address even if the write was
+ * reported as failed, so it is asked at new_addr rather than trusted.
+ */
+static void commission_rollback(AGS10_CommissionTypeDef *p_comm, uint16_t index)
+{
+    AGS10_CommissionEntryTypeDef *p_entry = &p_comm->p_plan[index];
+    bool restored = true;
+
+    if ((p_entry->step >= AGS10_COMMISSION_STEP_ASSIGN) &&
+        (AGS10_OK == ags10_scan_address(p_comm->p_bus_ops, p_comm->p_bus_ctx, p_entry->new_addr)))
+    {
+        restored = (AGS10_OK == ags10_init(&p_comm->sensor, p_entry->new_addr, p_comm->p_bus_ops, p_comm->p_bus_ctx)) &&
+                   (AGS10_OK == ags10_address_set(&p_comm->sensor, p_comm->from_addr));
+    }
+
+    // isolated even if the address could not be restored, so from_addr is free for the next device
+    (void)p_comm->select(p_comm->p_select_ctx, index, false);
+
+    p_entry->rolled_back = restored;
+    if (restored)
+    {
+        p_comm->rolled_back++;
+    }
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+bool ags10_commission_init(AGS10_CommissionTypeDef *p_comm,
+                           const AGS10_BusOpsTypeDef *p_bus_ops,
+                           void *p_bus_ctx,
+                           AGS10_CommissionSelectFn select,
+                           void *p_select_ctx,
+                           AGS10_CommissionEntryTypeDef *p_plan,
+                           uint16_t count)
+{
+    uint8_t used[AGS10_SCAN_MAP_LEN] = {0};
+
+    if ((NULL == p_comm) || (NULL == p_bus_ops) || (NULL == select) || ((NULL == p_plan) && (0U != count)))
+    {
+        return false;
+    }
+
+    for (uint16_t idx = 0; idx < count; idx++)
+    {
+        uint8_t addr = p_plan[idx].new_addr;
+
+        if ((addr < AGS10_SCAN_FIRST_ADDR) || (addr > AGS10_SCAN_LAST_ADDR) ||
+            (AGS10MA_I2C_DEVICE_ADDR == addr) ||
+            (0U != (used[addr >> 3] & (1U << (addr & 7U)))))
+        {
+            return false;
+        }
+        used[addr >> 3] |= (uint8_t)(1U << (addr & 7U));
+    }
+
+    memset(p_comm, 0, sizeof(*p_comm));
+    p_comm->p_bus_ops = p_bus_ops;
+    p_comm->p_bus_ctx = p_bus_ctx;
+    p_comm->select = select;
+    p_comm->p_select_ctx = p_select_ctx;
+    p_comm->p_plan = p_plan;
+    p_comm->count = count;
+    p_comm->from_addr = AGS10MA_I2C_DEVICE_ADDR;
+    p_comm->power_on_ms = AGS10_COMMISSION_POWER_ON_MS;
+
+    return true;
+}
+
+AGS10_StatusTypeDef ags10_commission_device(AGS10_CommissionTypeDef *p_comm, uint16_t index)
+{
+    if ((NULL == p_comm) || (index >= p_comm->count))
+    {
+        return AGS10_ERR_PARAM;
+    }
+
+    AGS10_CommissionEntryTypeDef *p_entry = &p_comm->p_plan[index];
+    uint32_t start_ms = commission_tick_ms(p_comm);
+    AGS10_StatusTypeDef status = AGS10_OK;
+    uint8_t version = 0;
+
+    p_entry->status = AGS10_OK;
+    p_entry->version = 0;
+    p_entry->rolled_back = false;
+
+    p_entry->step = AGS10_COMMISSION_STEP_SELECT;
+    if (!p_comm->select(p_comm->p_select_ctx, index, true))
+    {
+        status = AGS10_ERR_BUS;
+    }
+    else if (0U != p_comm->power_on_ms)
+    {
+        p_comm->p_bus_ops->delay(p_comm->p_bus_ctx, p_comm->power_on_ms);
+    }
+
+    // something already at new_addr would answer the verify read in the device's place
+    if (AGS10_OK == status)
+    {
+        p_entry->step = AGS10_COMMISSION_STEP_CHECK_FREE;
+        status = ags10_scan_address(p_comm->p_bus_ops, p_comm->p_bus_ctx, p_entry->new_addr);
+        status = (AGS10_ERR_NACK == status) ? AGS10_OK : ((AGS10_OK == status) ? AGS10_ERR_BUSY : status);
+    }
+
+    if (AGS10_OK == status)
+    {
+        p_entry->step = AGS10_COMMISSION_STEP_FIND;
+        status = commission_version(p_comm, p_comm->from_addr, &p_entry->version);
+    }
+
+    if (AGS10_OK == status)
+    {
+        p_entry->step = AGS10_COMMISSION_STEP_ASSIGN;
+        status = ags10_address_set(&p_comm->sensor, p_entry->new_addr);
+    }
+
+    if (AGS10_OK == status)
+    {
+        p_entry->step = AGS10_COMMISSION_STEP_VERIFY;
+        status = commission_version(p_comm, p_entry->new_addr, &version);
+        if ((AGS10_OK == status) && (version != p_entry->version))
+        {
+            status = AGS10_ERR_BUS;
+        }
+    }
+
+    // a second device still at from_addr means the select callback did not isolate it
+    if (AGS10_OK == status)
+    {
+        p_entry->step = AGS10_COMMISSION_STEP_RELEASE;
+        status = ags10_scan_address(p_comm->p_bus_ops, p_comm->p_bus_ctx, p_comm->from_addr);
+        status = (AGS10_ERR_NACK == status) ? AGS10_OK : ((AGS10_OK == status) ? AGS10_ERR_BUSY : status);
+    }
+
+    if (AGS10_OK == status)
+    {
+        p_entry->step = AGS10_COMMISSION_STEP_DONE;
+        p_comm->done++;
+    }
+    else
+    {
+        p_entry->status = (uint8_t)status;
+        p_comm->failed++;
+        commission_rollback(p_comm, index);
+    }
+
+    p_entry->elapsed_ms = commission_tick_ms(p_comm) - start_ms;
+
+    return status;
+}
+
+AGS10_StatusTypeDef ags10_commission_run(AGS10_CommissionTypeDef *p_comm)
+{
+    if (NULL == p_comm)
+    {
+        return AGS10_ERR_PARAM;
+    }
+
+    uint32_t start_ms = commission_tick_ms(p_comm);
+    AGS10_StatusTypeDef first = AGS10_OK;
+
+    p_comm->done = 0;
+    p_comm->failed = 0;
+    p_comm->rolled_back = 0;
+
+    for (uint16_t idx = 0; idx < p_comm->count; idx++)
+    {
+        p_comm->p_plan[idx].step = AGS10_COMMISSION_STEP_PENDING;
+        p_comm->p_plan[idx].status = AGS10_OK;
+        p_comm->p_plan[idx].rolled_back = false;
+        p_comm->p_plan[idx].elapsed_ms = 0;
+        (void)p_comm->select(p_comm->p_select_ctx, idx, false);
+    }
+
+    for (uint16_t idx = 0; idx < p_comm->count; idx++)
+    {
+        AGS10_StatusTypeDef status = ags10_commission_device(p_comm, idx);
+
+        if (AGS10_OK != status)
+        {
+            if (AGS10_OK == first)
+            {
+                first = status;
+            }
+
+            if (p_comm->stop_on_failure)
+            {
+                break;
+            }
+        }
+    }
+
+    p_comm->total_ms = commission_tick_ms(p_comm) - start_ms;
+
+    return first;
+}
+// eof
@@ -0,0 +1,162 @@
+/**
+ * @file ags10_commission.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Bulk re-addressing of factory-default AGS10s, one device at a time.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_COMMISSION_H_
+#define INC_AGS10_COMMISSION_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ags10.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define AGS10_COMMISSION_POWER_ON_MS    100U    /**< Default settle time after switching a device on. */
+
+/*******************************************************************************/
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+/**
+ * @brief Step a device reached; on failure, the step that failed.
+ */
+typedef enum {
+    AGS10_COMMISSION_STEP_PENDING = 0,  /**< Not started. */
+    AGS10_COMMISSION_STEP_SELECT,       /**< Switching the device on. */
+    AGS10_COMMISSION_STEP_CHECK_FREE,   /**< Target address must not answer yet. */
+    AGS10_COMMISSION_STEP_FIND,         /**< Version read at the factory address. */
+    AGS10_COMMISSION_STEP_ASSIGN,       /**< Address frame write. */
+    AGS10_COMMISSION_STEP_VERIFY,       /**< Version read at the new address. */
+    AGS10_COMMISSION_STEP_RELEASE,      /**< Factory address must be free again. */
+    AGS10_COMMISSION_STEP_DONE,         /**< Commissioned. */
+} AGS10_CommissionStepTypeDef;
+
+/**
+ * @brief One device of the plan: its target address in, its outcome out.
+ */
+typedef struct {
+    uint8_t new_addr;           /**< Address to assign, unique in the plan. */
+
+    /* Results */
+    uint8_t step;               /**< AGS10_CommissionStepTypeDef reached. */
+    uint8_t status;             /**< AGS10_StatusTypeDef of the failing step, AGS10_OK when done. */
+    uint8_t version;            /**< Firmware version read at the factory address. */
+    bool rolled_back;           /**< Failed, back at the factory address and switched off. */
+    uint32_t elapsed_ms;
+} AGS10_CommissionEntryTypeDef;
+
+/**
+ * @brief Switch device index on or off, or connect and isolate it.
+ *
+ * A power switch, a load switch on VDD or an I2C mux channel all work, as
+ * long as a device that is off does not answer on the bus.
+ *
+ * @param[in] p_ctx Context given to ags10_commission_init().
+ * @param[in] index Index into the plan.
+ * @param[in] on true to connect the device, false to isolate it.
+ *
+ * @return false if the device could not be switched.
+ */
+typedef bool (*AGS10_CommissionSelectFn)(void *p_ctx, uint16_t index, bool on);
+
+/**
+ * @brief Moves every device of a plan from the factory address to its own.
+ *
+ * All devices start isolated. For each device in plan order the engine:
+ * 1. connects it and waits power_on_ms,
+ * 2. checks that nothing answers at its new address yet,
+ * 3. reads the version register at from_addr, so it talks to an AGS10,
+ * 4. writes the address frame (ags10_address_set()),
+ * 5. reads the version again at the new address, and it must match,
+ * 6. checks that from_addr no longer answers.
+ * Something answering where it must not (steps 2 and 6) fails the step with
+ * AGS10_ERR_BUSY, a version that changed with the address with AGS10_ERR_BUS.
+ * A commissioned device stays connected at its new address, which no
+ * later device can collide with.
+ *
+ * A device that fails is rolled back: if it answers at its new address it
+ * is given from_addr again, then it is isolated, so the next device has
+ * from_addr to itself. With stop_on_failure the run ends there, otherwise
+ * it carries on with the next device.
+ *
+ * Times come from the bus's get_tick_ms and are 0 without one.
+ */
+typedef struct {
+    const AGS10_BusOpsTypeDef *p_bus_ops;
+    void *p_bus_ctx;
+    AGS10_CommissionSelectFn select;
+    void *p_select_ctx;
+    AGS10_CommissionEntryTypeDef *p_plan;
+    uint16_t count;
+
+    uint8_t from_addr;          /**< Address every device starts at, AGS10MA_I2C_DEVICE_ADDR. */
+    uint16_t power_on_ms;       /**< AGS10_COMMISSION_POWER_ON_MS. */
+    bool stop_on_failure;       /**< false. */
+
+    /* Results */
+    uint16_t done;
+    uint16_t failed;
+    uint16_t rolled_back;
+    uint32_t total_ms;          /**< Whole run, isolating the devices included. */
+
+    /* Owned by the engine */
+    AGS10_HandleTypeDef sensor;
+} AGS10_CommissionTypeDef;
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+
+/**
+ * @brief Set up a run over a plan, with the defaults noted in the struct.
+ *
+ * @param[out] p_comm Engine to initialise.
+ * @param[in] p_bus_ops Bus operations, as for ags10_init().
+ * @param[in] p_bus_ctx Bus context passed to every operation.
+ * @param[in] select Device switch callback.
+ * @param[in] p_select_ctx Context passed to select.
+ * @param[in,out] p_plan Array of count entries with new_addr filled in.
+ * @param[in] count Devices in the plan.
+ *
+ * @retval true  Ready to run.
+ * @retval false Invalid arguments, a new address outside 0x08..0x77, equal
+ *               to the factory address, or used twice.
+ */
+bool ags10_commission_init(AGS10_CommissionTypeDef *p_comm,
+                           const AGS10_BusOpsTypeDef *p_bus_ops,
+                           void *p_bus_ctx,
+                           AGS10_CommissionSelectFn select,
+                           void *p_select_ctx,
+                           AGS10_CommissionEntryTypeDef *p_plan,
+                           uint16_t count);
+
+/**
+ * @brief Commission one device; the others must be isolated or commissioned.
+ *
+ * @param[in,out] p_comm Engine.
+ * @param[in] index Plan entry.
+ *
+ * @return AGS10_OK, or the status of the step that failed (see the entry).
+ */
+AGS10_StatusTypeDef ags10_commission_device(AGS10_CommissionTypeDef *p_comm, uint16_t index);
+
+/**
+ * @brief Isolate every device, then commission them in plan order.
+ *
+ * @param[in,out] p_comm Engine.
+ *
+ * @return AGS10_OK if every device was commissioned, else the first failure.
+ */
+AGS10_StatusTypeDef ags10_commission_run(AGS10_CommissionTypeDef *p_comm);
+
+#endif /* INC_AGS10_COMMISSION_H_ */
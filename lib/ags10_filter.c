@@ -0,0 +1,136 @@
+/**
+ * @file ags10_filter.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_filter.h"
+
+#include <stddef.h>
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+#if AGS10_FILTER_CLAMP_ENABLE
+static uint32_t clamp_update(AGS10_FilterTypeDef *p_filter, uint32_t value)
+{
+    uint32_t prev = p_filter->clamp_prev;
+    uint32_t step = p_filter->p_cfg->clamp_step;
+
+    if (p_filter->primed)
+    {
+        if ((value > prev) && ((value - prev) > step))
+        {
+            value = prev + step;
+            p_filter->clamped++;
+        }
+        else if ((value < prev) && ((prev - value) > step))
+        {
+            value = prev - step;
+            p_filter->clamped++;
+        }
+    }
+
+    p_filter->clamp_prev = value;
+
+    return value;
+}
+#endif
+
+#if (0 != AGS10_FILTER_MEDIAN_LEN)
+static uint32_t median_update(AGS10_FilterTypeDef *p_filter, uint32_t value)
+{
+    uint32_t *p_sorted = p_filter->sorted;
+    uint8_t len = p_filter->fill;
+    uint8_t idx;
+
+    if (AGS10_FILTER_MEDIAN_LEN == len)
+    {
+        // take the oldest out, closing the gap
+        uint32_t old = p_filter->window[p_filter->oldest];
+
+        for (idx = 0; p_sorted[idx] != old; idx++)
+        {
+        }
+        for (len--; idx < len; idx++)
+        {
+            p_sorted[idx] = p_sorted[idx + 1U];
+        }
+    }
+    else
+    {
+        p_filter->fill++;
+    }
+
+    // insertion step: shift larger entries up
+    for (idx = len; (idx > 0U) && (p_sorted[idx - 1U] > value); idx--)
+    {
+        p_sorted[idx] = p_sorted[idx - 1U];
+    }
+    p_sorted[idx] = value;
+
+    p_filter->window[p_filter->oldest] = value;
+    p_filter->oldest = (uint8_t)((p_filter->oldest + 1U) % AGS10_FILTER_MEDIAN_LEN);
+
+    // lower median while the window fills with an even count
+    return p_sorted[(p_filter->fill - 1U) / 2U];
+}
+#endif
+
+#if AGS10_FILTER_EMA_ENABLE
+static uint32_t ema_update(AGS10_FilterTypeDef *p_filter, uint32_t value)
+{
+    uint32_t alpha = p_filter->p_cfg->ema_alpha;
+
+    if (!p_filter->primed)
+    {
+        p_filter->ema = value;
+    }
+    else
+    {
+        // weighted sum in unsigned 64 bits, rounded: no signed shifts, no overflow
+        uint64_t sum = ((uint64_t)p_filter->ema * (AGS10_FILTER_ALPHA_ONE - alpha)) +
+                       ((uint64_t)value * alpha) + (AGS10_FILTER_ALPHA_ONE / 2U);
+
+        p_filter->ema = (uint32_t)(sum >> 16);
+    }
+
+    return p_filter->ema;
+}
+#endif
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+void ags10_filter_init(AGS10_FilterTypeDef *p_filter, const AGS10_FilterConfigTypeDef *p_cfg)
+{
+    *p_filter = (AGS10_FilterTypeDef){ 0 };
+    p_filter->p_cfg = p_cfg;
+}
+
+uint32_t ags10_filter_update(AGS10_FilterTypeDef *p_filter, uint32_t tvoc_ppb)
+{
+    uint32_t value = AGS10_FILTER_FROM_PPB((tvoc_ppb > AGS10_FILTER_PPB_MAX) ? AGS10_FILTER_PPB_MAX : tvoc_ppb);
+
+#if AGS10_FILTER_CLAMP_ENABLE
+    value = clamp_update(p_filter, value);
+#endif
+#if (0 != AGS10_FILTER_MEDIAN_LEN)
+    value = median_update(p_filter, value);
+#endif
+#if AGS10_FILTER_EMA_ENABLE
+    value = ema_update(p_filter, value);
+#endif
+
+    p_filter->primed = true;
+    p_filter->out = value;
+
+    return value;
+}
+// eof
@@ -0,0 +1,120 @@
+/**
+ * @file ags10_filter.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Fixed-point smoothing chain for TVOC samples.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_FILTER_H_
+#define INC_AGS10_FILTER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+/*
+ * Stages, chosen at build time; a disabled stage leaves no code or state.
+ * Samples pass through them in this order:
+ *   AGS10_FILTER_CLAMP_ENABLE : limit the change per sample (spikes)
+ *   AGS10_FILTER_MEDIAN_LEN   : sliding median over 5 or 7 samples, 0 for none
+ *   AGS10_FILTER_EMA_ENABLE   : exponential moving average
+ */
+#ifndef AGS10_FILTER_CLAMP_ENABLE
+#define AGS10_FILTER_CLAMP_ENABLE   1
+#endif
+
+#ifndef AGS10_FILTER_MEDIAN_LEN
+#define AGS10_FILTER_MEDIAN_LEN     5
+#endif
+
+#ifndef AGS10_FILTER_EMA_ENABLE
+#define AGS10_FILTER_EMA_ENABLE     1
+#endif
+
+#if (0 != AGS10_FILTER_MEDIAN_LEN) && (5 != AGS10_FILTER_MEDIAN_LEN) && (7 != AGS10_FILTER_MEDIAN_LEN)
+#error "AGS10_FILTER_MEDIAN_LEN must be 0, 5 or 7"
+#endif
+
+#define AGS10_FILTER_FRAC_BITS      8U
+#define AGS10_FILTER_ONE            (1UL << AGS10_FILTER_FRAC_BITS)
+#define AGS10_FILTER_PPB_MAX        0xFFFFFFUL  /**< Full 24-bit TVOC range. */
+#define AGS10_FILTER_ALPHA_ONE      0x10000UL   /**< EMA weight 1.0, Q0.16. */
+
+/** ppb to the filter's Q24.8 format. */
+#define AGS10_FILTER_FROM_PPB(ppb)  ((uint32_t)(ppb) << AGS10_FILTER_FRAC_BITS)
+
+/** Q24.8 to ppb, rounded to nearest. */
+#define AGS10_FILTER_TO_PPB(q)      (((uint32_t)(q) + (AGS10_FILTER_ONE / 2U)) >> AGS10_FILTER_FRAC_BITS)
+
+/*******************************************************************************/
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+/**
+ * @brief Stage parameters, typically a static const.
+ */
+typedef struct {
+    uint32_t ema_alpha;         /**< Weight of a new sample, Q0.16, 1 to AGS10_FILTER_ALPHA_ONE. */
+    uint32_t clamp_step;        /**< Largest change per sample, Q24.8 ppb. */
+} AGS10_FilterConfigTypeDef;
+
+/**
+ * @brief Filter chain state of one sensor.
+ *
+ * Values are unsigned Q24.8 (ppb with 8 fraction bits): all 24 bits of a
+ * TVOC reading fit, and 1/256 ppb is finer than the EMA can drift, so no
+ * floating point is needed on the FPU-less Cortex-M3. Every stage costs a
+ * fixed amount of work per sample; the median keeps its window sorted and
+ * moves at most AGS10_FILTER_MEDIAN_LEN entries.
+ *
+ * The first sample primes every stage and passes through unchanged.
+ */
+typedef struct {
+    const AGS10_FilterConfigTypeDef *p_cfg;
+    bool primed;
+    uint32_t out;               /**< Last output, Q24.8. */
+#if AGS10_FILTER_CLAMP_ENABLE
+    uint32_t clamp_prev;
+    uint32_t clamped;           /**< Samples the clamp changed. */
+#endif
+#if (0 != AGS10_FILTER_MEDIAN_LEN)
+    uint32_t window[AGS10_FILTER_MEDIAN_LEN];   /**< Arrival order, oldest at oldest. */
+    uint32_t sorted[AGS10_FILTER_MEDIAN_LEN];
+    uint8_t oldest;
+    uint8_t fill;
+#endif
+#if AGS10_FILTER_EMA_ENABLE
+    uint32_t ema;
+#endif
+} AGS10_FilterTypeDef;
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+
+/**
+ * @brief Reset a chain.
+ *
+ * @param[out] p_filter Chain.
+ * @param[in] p_cfg Stage parameters, kept by reference.
+ */
+void ags10_filter_init(AGS10_FilterTypeDef *p_filter, const AGS10_FilterConfigTypeDef *p_cfg);
+
+/**
+ * @brief Run one sample through the chain.
+ *
+ * @param[in,out] p_filter Chain.
+ * @param[in] tvoc_ppb Sample; values above 24 bits are saturated.
+ *
+ * @return Filtered TVOC, Q24.8; see AGS10_FILTER_TO_PPB().
+ */
+uint32_t ags10_filter_update(AGS10_FilterTypeDef *p_filter, uint32_t tvoc_ppb);
+
+#endif /* INC_AGS10_FILTER_H_ */
@@ -0,0 +1,178 @@
+/**
+ * @file ags10_log.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Wear-levelled, power-loss tolerant sample log in NOR flash.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_LOG_H_
+#define INC_AGS10_LOG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ags10.h"
+#include "ags10_ring.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#ifndef AGS10_LOG_BATCH
+#define AGS10_LOG_BATCH             16U     /**< Samples buffered per flash record. */
+#endif
+
+#define AGS10_LOG_PAGE_MAGIC        0xA610U
+#define AGS10_LOG_REC_MAGIC         0xA000U /**< Top nibble of a record header. */
+#define AGS10_LOG_REC_LEN_MSK       0x0FFFU
+#define AGS10_LOG_PAGE_HDR_LEN      8U
+#define AGS10_LOG_REC_MAX_LEN       (2U + 1U + (AGS10_LOG_BATCH * 3U * 5U) + 1U + 2U)
+#define AGS10_LOG_ERASED            0xFFFFU
+
+/*******************************************************************************/
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+/**
+ * @brief NOR flash access, addresses are absolute.
+ *
+ * Flash follows the STM32F1 rules: a page erases to 0xFF, a half-word can
+ * only be programmed once after that (or to 0x0000).
+ */
+typedef struct {
+    /**
+     * @brief Erase one page.
+     * @return true on success.
+     */
+    bool (*erase)(void *p_ctx, uint32_t addr);
+
+    /**
+     * @brief Program consecutive half-words in one session.
+     * @return true on success.
+     */
+    bool (*program)(void *p_ctx, uint32_t addr, const uint16_t *p_data, uint32_t count);
+
+    /**
+     * @brief Copy out flash contents (memory mapped on the MCU).
+     */
+    void (*read)(void *p_ctx, uint32_t addr, void *p_dst, uint32_t len);
+} AGS10_LogFlashOpsTypeDef;
+
+/**
+ * @brief A log over page_count pages starting at base.
+ *
+ * Pages are written in a circle and each starts with a header holding a
+ * magic and a 32-bit sequence number, so mounting reads one header per
+ * page to find the newest (head) and oldest page; only the head page's
+ * records are walked to find the append point. Recycling the oldest page
+ * spreads erases evenly.
+ *
+ * Samples are buffered in RAM and written AGS10_LOG_BATCH at a time as one
+ * record: a half-word header (magic and payload length), the sample count,
+ * the times, TVOC/status words and resistances each as an
+ * ags10_codec stream (one block per record), and a CRC-8 half-word. At a
+ * 2 s cadence a sample costs under 5 bytes of flash instead of 13.
+ *
+ * A record cut short by power loss fails its CRC and is skipped; a header
+ * that cannot be trusted closes the page, and the next record opens a new
+ * one.
+ */
+typedef struct {
+    const AGS10_LogFlashOpsTypeDef *p_ops;
+    void *p_ctx;
+    uint32_t base;
+    uint32_t page_size;
+    uint16_t page_count;
+
+    uint16_t head_page;
+    uint16_t tail_page;         /**< Oldest page holding data. */
+    uint32_t head_seq;
+    uint32_t head_off;          /**< Append offset in the head page. */
+    bool mounted;
+
+    AGS10_RingSampleTypeDef batch[AGS10_LOG_BATCH];
+    uint16_t batch_count;
+
+    /* Statistics */
+    uint32_t records;           /**< Records written since mount. */
+    uint32_t erases;
+    uint32_t bad_records;       /**< Skipped for a CRC or length fault. */
+} AGS10_LogTypeDef;
+
+/**
+ * @brief Visitor for ags10_log_read().
+ *
+ * @param[in] p_ctx Context given to ags10_log_read().
+ * @param[in] p_sample Sample, oldest first.
+ *
+ * @return false to stop reading.
+ */
+typedef bool (*AGS10_LogVisitFn)(void *p_ctx, const AGS10_RingSampleTypeDef *p_sample);
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+
+/**
+ * @brief Attach to a flash region and recover its state.
+ *
+ * A region without a single valid page header is formatted (first page
+ * erased and headed).
+ *
+ * @param[out] p_log Log to mount.
+ * @param[in] p_ops Flash access.
+ * @param[in] p_ctx Context passed to every op.
+ * @param[in] base Address of the first page.
+ * @param[in] page_size Page size in bytes, a multiple of 2.
+ * @param[in] page_count At least two pages.
+ *
+ * @retval AGS10_OK        Mounted.
+ * @retval AGS10_ERR_PARAM Invalid geometry or null arguments.
+ * @retval AGS10_ERR_BUS   Formatting failed.
+ */
+AGS10_StatusTypeDef ags10_log_mount(AGS10_LogTypeDef *p_log,
+                                    const AGS10_LogFlashOpsTypeDef *p_ops,
+                                    void *p_ctx,
+                                    uint32_t base,
+                                    uint32_t page_size,
+                                    uint16_t page_count);
+
+/**
+ * @brief Add a sample; it reaches flash with its batch.
+ *
+ * @param[in,out] p_log Mounted log.
+ * @param[in] p_sample Sample.
+ *
+ * @retval AGS10_OK        Buffered, or the full batch written.
+ * @retval AGS10_ERR_PARAM Not mounted.
+ * @retval AGS10_ERR_BUS   Flash erase or program failed; the batch is kept.
+ */
+AGS10_StatusTypeDef ags10_log_append(AGS10_LogTypeDef *p_log, const AGS10_RingSampleTypeDef *p_sample);
+
+/**
+ * @brief Write the buffered samples now, e.g. on a brown-out warning.
+ *
+ * @param[in,out] p_log Mounted log.
+ *
+ * @return As ags10_log_append(); AGS10_OK with nothing buffered.
+ */
+AGS10_StatusTypeDef ags10_log_flush(AGS10_LogTypeDef *p_log);
+
+/**
+ * @brief Visit every sample in flash, oldest first.
+ *
+ * Buffered samples are not included.
+ *
+ * @param[in] p_log Mounted log.
+ * @param[in] visit Called per sample.
+ * @param[in] p_ctx Context passed to visit.
+ *
+ * @return Samples visited.
+ */
+uint32_t ags10_log_read(const AGS10_LogTypeDef *p_log, AGS10_LogVisitFn visit, void *p_ctx);
+
+#endif /* INC_AGS10_LOG_H_ */
@@ -0,0 +1,169 @@
+/**
+ * @file ags10_prof.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Per-phase timing of AGS10 register reads.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_PROF_H_
+#define INC_AGS10_PROF_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ags10.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+/*
+ * Time source, in free-running 32-bit ticks:
+ *   Cortex-M3/M4 : DWT->CYCCNT, CPU cycles. ags10_prof_init() enables it.
+ *   Host         : CLOCK_MONOTONIC, nanoseconds.
+ * To time against something else, e.g. the virtual clock of a simulated bus,
+ * point AGS10_PROF_CLOCK_HEADER at a header that defines AGS10_PROF_CLOCK()
+ * (and optionally AGS10_PROF_UNIT) and declares whatever it calls.
+ */
+#ifdef AGS10_PROF_CLOCK_HEADER
+#include AGS10_PROF_CLOCK_HEADER
+#endif
+
+#if !defined(AGS10_PROF_CLOCK)
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+#define AGS10_PROF_CLOCK()         (*(volatile uint32_t *)0xE0001004UL)
+#define AGS10_PROF_UNIT            "cyc"
+#else
+#define AGS10_PROF_CLOCK()         ags10_prof_clock_host()
+#define AGS10_PROF_UNIT            "ns"
+#endif
+#endif
+
+#ifndef AGS10_PROF_UNIT
+#define AGS10_PROF_UNIT            "tick"
+#endif
+
+#define AGS10_PROF_LINE_LEN        64U
+
+/*
+ * Instrumentation points used by ags10.c. MARK starts timing a phase, LAP
+ * records the time since the last mark against a phase and starts the next
+ * one. Without AGS10_PROF_ENABLE they expand to nothing.
+ */
+#if AGS10_PROF_ENABLE
+#define AGS10_PROF_MARK(ph)        ((ph)->prof_mark = AGS10_PROF_CLOCK())
+#define AGS10_PROF_LAP(ph, phase)  ags10_prof_lap(&(ph)->prof_mark, (phase))
+#else
+#define AGS10_PROF_MARK(ph)        ((void)0)
+#define AGS10_PROF_LAP(ph, phase)  ((void)0)
+#endif
+/*******************************************************************************/
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+/**
+ * @brief Phases of one register read, in the order they happen.
+ */
+typedef enum {
+    AGS10_PROF_PTR_WRITE = 0,   /**< Register pointer write, until the bus reports it done. */
+    AGS10_PROF_CONVERT,         /**< Pointer written until the frame read begins. */
+    AGS10_PROF_FRAME_READ,      /**< 5 byte frame read, until the bus reports it done. */
+    AGS10_PROF_CRC,             /**< CRC-8 over the data bytes. */
+    AGS10_PROF_UNPACK,          /**< Frame to register value. */
+    AGS10_PROF_PHASE_COUNT,
+} AGS10_ProfPhaseTypeDef;
+
+/**
+ * @brief Accumulated timing of one phase, in AGS10_PROF_UNIT.
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;     /**< Sum of all samples, mean = total / count. */
+} AGS10_ProfEntryTypeDef;
+
+/**
+ * @brief Receives one formatted line of ags10_prof_dump(), without newline.
+ * 
+ * @param[in] p_ctx Context given to ags10_prof_dump().
+ * @param[in] p_line Null terminated text.
+ */
+typedef void (*AGS10_ProfPutFn)(void *p_ctx, const char *p_line);
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+#if AGS10_PROF_ENABLE
+
+/**
+ * @brief Enable the cycle counter (on target) and clear the table.
+ */
+void ags10_prof_init(void);
+
+/**
+ * @brief Clear the table.
+ */
+void ags10_prof_reset(void);
+
+/**
+ * @brief Add one sample to a phase.
+ * 
+ * @param[in] phase Phase the sample belongs to.
+ * @param[in] ticks Duration in AGS10_PROF_UNIT.
+ */
+void ags10_prof_record(AGS10_ProfPhaseTypeDef phase, uint32_t ticks);
+
+/**
+ * @brief Record the time since *p_mark against a phase and restart *p_mark.
+ * 
+ * @param[in,out] p_mark Start of the phase, set to the current time.
+ * @param[in] phase Phase that just ended.
+ */
+void ags10_prof_lap(uint32_t *p_mark, AGS10_ProfPhaseTypeDef phase);
+
+/**
+ * @brief Read back one phase.
+ * 
+ * @param[in] phase Phase to look up.
+ * 
+ * @return The entry, or NULL for an invalid phase.
+ */
+const AGS10_ProfEntryTypeDef *ags10_prof_entry_get(AGS10_ProfPhaseTypeDef phase);
+
+/**
+ * @brief Name of a phase, for logs.
+ * 
+ * @param[in] phase Phase to name.
+ * 
+ * @return Short lower case name, "?" for an invalid phase.
+ */
+const char *ags10_prof_phase_name(AGS10_ProfPhaseTypeDef phase);
+
+/**
+ * @brief Format the table, one header line and one line per phase.
+ * 
+ * Each line is at most AGS10_PROF_LINE_LEN characters, so put can forward
+ * it to a UART, ITM/SWO or semihosting without buffering.
+ * 
+ * @param[in] put Line sink.
+ * @param[in] p_ctx Context passed to put.
+ */
+void ags10_prof_dump(AGS10_ProfPutFn put, void *p_ctx);
+
+#if !(defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__))
+/**
+ * @brief CLOCK_MONOTONIC in nanoseconds, truncated to 32 bits (host only).
+ * 
+ * @return Current time.
+ */
+uint32_t ags10_prof_clock_host(void);
+#endif
+
+#endif /* AGS10_PROF_ENABLE */
+
+#endif /* INC_AGS10_PROF_H_ */
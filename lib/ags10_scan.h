@@ -0,0 +1,175 @@
+/**
+ * @file ags10_scan.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Discovery of AGS10 devices on one or more I2C buses.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_SCAN_H_
+#define INC_AGS10_SCAN_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ags10.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define AGS10_SCAN_FIRST_ADDR       0x08U   /**< 0x00..0x07 are reserved. */
+#define AGS10_SCAN_LAST_ADDR        0x77U   /**< 0x78..0x7F are reserved. */
+#define AGS10_SCAN_MAP_LEN          16U     /**< Bytes of a 128-address bitmap. */
+
+/*******************************************************************************/
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+/**
+ * @brief A confirmed AGS10.
+ */
+typedef struct {
+    uint8_t addr;
+    uint8_t version;            /**< Firmware version byte. */
+} AGS10_ScanDeviceTypeDef;
+
+/**
+ * @brief Scan of one bus, and its results.
+ *
+ * A scan has two passes. The probe pass addresses every 7-bit address in
+ * [first_addr, last_addr] without data (the probe bus op, or a zero-length
+ * write) and records which ones acknowledge. The confirm pass sends the
+ * version register pointer to each of them, waits AGS10MA_VERSION_DELAY_MS
+ * once for all, and reads their frames. Only a frame with a valid CRC
+ * counts as an AGS10; anything else that answered is counted as rejected.
+ *
+ * Times come from the bus's get_tick_ms and are 0 without one.
+ */
+typedef struct {
+    const AGS10_BusOpsTypeDef *p_bus_ops;
+    void *p_bus_ctx;
+    uint8_t first_addr;
+    uint8_t last_addr;
+    AGS10_ScanDeviceTypeDef *p_found;
+    uint8_t found_max;
+
+    /* Results */
+    uint8_t found;              /**< AGS10s confirmed; only found_max are stored. */
+    uint8_t acked;              /**< Addresses that acknowledged the probe. */
+    uint8_t rejected;           /**< Acknowledged, but not an AGS10. */
+    uint8_t ack_map[AGS10_SCAN_MAP_LEN];    /**< Bit addr set for each acknowledge. */
+    uint8_t last_status;        /**< AGS10_StatusTypeDef that ended the scan. */
+    uint32_t probes;            /**< Probe transfers sent. */
+    uint32_t probe_ms;          /**< Duration of the probe pass. */
+    uint32_t confirm_ms;        /**< Pointer writes, wait and frame reads. */
+
+    /* Owned by the scan */
+    uint32_t confirm_start_ms;
+    uint32_t pointer_ms;        /**< Tick after the last version pointer. */
+} AGS10_ScanBusTypeDef;
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+
+/**
+ * @brief Probe one address: the probe bus op, or a zero-length write.
+ *
+ * @param[in] p_bus_ops Bus operations.
+ * @param[in] p_bus_ctx Bus context.
+ * @param[in] addr 7-bit address.
+ *
+ * @retval AGS10_OK       Something acknowledged.
+ * @retval AGS10_ERR_NACK Address free.
+ * @return Otherwise the bus failure.
+ */
+AGS10_StatusTypeDef ags10_scan_address(const AGS10_BusOpsTypeDef *p_bus_ops, void *p_bus_ctx, uint8_t addr);
+
+/**
+ * @brief Describe a bus to scan over the whole non-reserved address range.
+ *
+ * Narrow first_addr and last_addr afterwards to scan less.
+ *
+ * @param[out] p_scan Scan to initialise.
+ * @param[in] p_bus_ops Bus operations, as for ags10_init().
+ * @param[in] p_bus_ctx Bus context passed to every operation.
+ * @param[out] p_found Array for confirmed devices, in address order.
+ * @param[in] found_max Entries in p_found.
+ *
+ * @retval true  Scan ready.
+ * @retval false Invalid arguments.
+ */
+bool ags10_scan_bus_init(AGS10_ScanBusTypeDef *p_scan,
+                         const AGS10_BusOpsTypeDef *p_bus_ops,
+                         void *p_bus_ctx,
+                         AGS10_ScanDeviceTypeDef *p_found,
+                         uint8_t found_max);
+
+/**
+ * @brief Probe pass: record which addresses acknowledge.
+ *
+ * A NACK only means the address is free. Any other failure (busy or stuck
+ * bus, timeout) ends the pass, since every further probe would wait the
+ * same timeout.
+ *
+ * @param[in,out] p_scan Scan.
+ *
+ * @return AGS10_OK, or the failure that ended the pass.
+ */
+AGS10_StatusTypeDef ags10_scan_probe(AGS10_ScanBusTypeDef *p_scan);
+
+/**
+ * @brief Confirm pass, first half: send the version pointer to every address
+ *        that acknowledged.
+ *
+ * An address that refuses the pointer is rejected straight away. A bus that
+ * holds the last pointer back (see the flush bus op) sends it here. The
+ * caller then waits AGS10MA_VERSION_DELAY_MS, once for any number of buses.
+ *
+ * @param[in,out] p_scan Scan after ags10_scan_probe().
+ */
+void ags10_scan_confirm_start(AGS10_ScanBusTypeDef *p_scan);
+
+/**
+ * @brief Confirm pass, second half: read and check the version frames.
+ *
+ * @param[in,out] p_scan Scan after ags10_scan_confirm_start() and the wait.
+ *
+ * @return Number of AGS10s found on the bus.
+ */
+uint8_t ags10_scan_confirm_finish(AGS10_ScanBusTypeDef *p_scan);
+
+/**
+ * @brief Scan one bus: probe, pointers, wait through the bus's delay op, frames.
+ *
+ * Nothing is read if the probe pass failed or nothing acknowledged.
+ *
+ * @param[in,out] p_scan Scan.
+ *
+ * @return AGS10_OK, or the failure that ended the probe pass.
+ */
+AGS10_StatusTypeDef ags10_scan_bus(AGS10_ScanBusTypeDef *p_scan);
+
+/**
+ * @brief Scan several buses from one thread.
+ *
+ * Probes each bus in turn and sends its version pointers, then reads all
+ * the frames. Each bus's conversion runs while the next bus is probed,
+ * and a bus with a tick only waits what is left of it, so the version
+ * wait is paid about once however many buses there are. Buses whose
+ * probe pass failed are skipped after it. For probes that overlap
+ * in time as well, run ags10_scan_bus() per bus on its own thread, see
+ * ags10_fleet_scan().
+ *
+ * @param[in,out] p_scans Array of count scans.
+ * @param[in] count Number of buses.
+ *
+ * @return AGS10s found on all buses.
+ */
+uint16_t ags10_scan(AGS10_ScanBusTypeDef *p_scans, uint16_t count);
+
+#endif /* INC_AGS10_SCAN_H_ */
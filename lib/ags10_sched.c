@@ -0,0 +1,184 @@
+/**
+ * @file ags10_sched.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_sched.h"
+
+#include <stddef.h>
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+/*
+ * Only one transfer is ever in flight, so the sensor that used the bus last
+ * is the only one that can still be writing or reading.
+ */
+static bool sched_in_flight(const AGS10_SchedTypeDef *p_sched)
+{
+    if (p_sched->last_xfer >= p_sched->count)
+    {
+        return false;
+    }
+
+    uint8_t state = p_sched->p_sensors[p_sched->last_xfer].xfer_state;
+
+    return (AGS10_XFER_WRITING == state) || (AGS10_XFER_READING == state);
+}
+
+/* Sends queued pointers until one stays in flight. */
+static void sched_start_queued(AGS10_SchedTypeDef *p_sched)
+{
+    while ((p_sched->next_start < p_sched->count) && !sched_in_flight(p_sched))
+    {
+        uint16_t idx = p_sched->next_start++;
+        AGS10_SchedResultTypeDef *p_result = &p_sched->p_results[idx];
+        uint32_t now_ms = p_sched->get_tick_ms(p_sched->p_tick_ctx);
+
+        p_result->done_ms = now_ms;
+        p_result->status = (uint8_t)ags10_register_read_start(&p_sched->p_sensors[idx], p_sched->reg,
+                                                              p_sched->delay_ms, now_ms);
+        p_sched->last_xfer = idx;
+
+        if (AGS10_OK != p_result->status)
+        {
+            p_sched->pending--;
+
+            if (0 == p_sched->pending)
+            {
+                p_sched->last_round_ms = now_ms - p_sched->round_start_ms;
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+bool ags10_sched_init(AGS10_SchedTypeDef *p_sched,
+                      AGS10_HandleTypeDef *p_sensors,
+                      AGS10_SchedResultTypeDef *p_results,
+                      uint16_t count,
+                      uint8_t reg,
+                      uint16_t delay_ms,
+                      AGS10_SchedTickFn get_tick_ms,
+                      void *p_tick_ctx)
+{
+    if ((NULL == p_sched) || (NULL == p_sensors) || (NULL == p_results) ||
+        (NULL == get_tick_ms))
+    {
+        return false;
+    }
+
+    p_sched->get_tick_ms = get_tick_ms;
+    p_sched->p_tick_ctx = p_tick_ctx;
+    p_sched->p_sensors = p_sensors;
+    p_sched->p_results = p_results;
+    p_sched->count = count;
+    p_sched->reg = reg;
+    p_sched->delay_ms = delay_ms;
+    p_sched->pending = 0;
+    p_sched->next_start = count;
+    p_sched->last_xfer = count;
+    p_sched->round_start_ms = 0;
+    p_sched->last_round_ms = 0;
+
+    return true;
+}
+
+uint16_t ags10_sched_round_start(AGS10_SchedTypeDef *p_sched)
+{
+    p_sched->round_start_ms = p_sched->get_tick_ms(p_sched->p_tick_ctx);
+
+    for (uint16_t idx = 0; idx < p_sched->count; idx++)
+    {
+        // a sensor left over from an abandoned round must not block this one
+        ags10_register_read_abort(&p_sched->p_sensors[idx]);
+        p_sched->p_results[idx].status = AGS10_ERR_BUSY;
+    }
+
+    p_sched->pending = p_sched->count;
+    p_sched->next_start = 0;
+    p_sched->last_xfer = p_sched->count;
+    sched_start_queued(p_sched);
+
+    return p_sched->pending;
+}
+
+bool ags10_sched_poll(AGS10_SchedTypeDef *p_sched)
+{
+    for (uint16_t idx = 0; (idx < p_sched->count) && (p_sched->pending > 0); idx++)
+    {
+        AGS10_HandleTypeDef *ph_sensor = &p_sched->p_sensors[idx];
+
+        // queued, finished, or kept off the bus by another sensor's transfer
+        if ((AGS10_XFER_IDLE == ph_sensor->xfer_state) ||
+            ((idx != p_sched->last_xfer) && sched_in_flight(p_sched)))
+        {
+            continue;
+        }
+
+        AGS10_SchedResultTypeDef *p_result = &p_sched->p_results[idx];
+        uint32_t now_ms = p_sched->get_tick_ms(p_sched->p_tick_ctx);
+        AGS10_XferResultTypeDef xfer = ags10_register_read_poll(ph_sensor, now_ms, &p_result->value);
+
+        p_sched->last_xfer = idx;
+
+        if (AGS10_XFER_PENDING == xfer)
+        {
+            continue;
+        }
+
+        p_result->status = ph_sensor->last_status;
+        p_result->done_ms = p_sched->get_tick_ms(p_sched->p_tick_ctx);
+        p_sched->pending--;
+
+        if (0 == p_sched->pending)
+        {
+            p_sched->last_round_ms = p_result->done_ms - p_sched->round_start_ms;
+        }
+    }
+
+    sched_start_queued(p_sched);
+
+    return (0 == p_sched->pending);
+}
+
+uint32_t ags10_sched_next_due_ms(const AGS10_SchedTypeDef *p_sched)
+{
+    uint32_t now_ms = p_sched->get_tick_ms(p_sched->p_tick_ctx);
+    uint32_t next_ms = UINT32_MAX;
+
+    for (uint16_t idx = 0; (idx < p_sched->count) && (p_sched->pending > 0); idx++)
+    {
+        const AGS10_HandleTypeDef *ph_sensor = &p_sched->p_sensors[idx];
+
+        if (AGS10_XFER_IDLE == ph_sensor->xfer_state)
+        {
+            continue;
+        }
+
+        // converting or backing off before a retry; anything else wants a poll now
+        uint32_t wait_ms = ags10_register_read_wait_ms(ph_sensor, now_ms);
+
+        if (0U == wait_ms)
+        {
+            return 0;
+        }
+
+        if (wait_ms < next_ms)
+        {
+            next_ms = wait_ms;
+        }
+    }
+
+    return (UINT32_MAX == next_ms) ? 0 : next_ms;
+}
+// eof
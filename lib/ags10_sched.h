@@ -0,0 +1,140 @@
+/**
+ * @file ags10_sched.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Pipelined acquisition over several AGS10 sensors.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_SCHED_H_
+#define INC_AGS10_SCHED_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ags10.h"
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+/**
+ * @brief Outcome of one sensor in the last round.
+ */
+typedef struct {
+    uint32_t value;     /**< Raw register value, valid only if status is AGS10_OK. */
+    uint32_t done_ms;   /**< Tick at which the frame was collected. */
+    uint8_t status;     /**< AGS10_StatusTypeDef of the sensor's transaction. */
+} AGS10_SchedResultTypeDef;
+
+/**
+ * @brief Millisecond tick source, e.g. a wrapper around HAL_GetTick().
+ * 
+ * @param[in] p_ctx Tick context given to ags10_sched_init().
+ * 
+ * @return Free-running millisecond tick.
+ */
+typedef uint32_t (*AGS10_SchedTickFn)(void *p_ctx);
+
+/**
+ * @brief A round-based scheduler over an array of sensor handles.
+ * 
+ * A round sends the register pointer to every sensor back to back, then
+ * collects each frame as soon as that sensor's wait has elapsed. The
+ * conversion waits overlap, so a round costs about one delay no matter how
+ * many sensors share the bus. The tick is sampled around every transfer,
+ * so each sensor's deadline counts from its own pointer write even when the
+ * bus takes a noticeable time to address all of them.
+ *
+ * The sensors are taken to share one bus. On an asynchronous bus (DMA,
+ * interrupt) a transfer is only issued once the previous one is done: the
+ * pointer writes that do not fit are queued and sent from
+ * ags10_sched_poll(), and no frame read starts while a write is in flight.
+ * On a blocking bus every pointer goes out in ags10_sched_round_start().
+ */
+typedef struct {
+    AGS10_SchedTickFn get_tick_ms;
+    void *p_tick_ctx;
+
+    AGS10_HandleTypeDef *p_sensors;
+    AGS10_SchedResultTypeDef *p_results;
+    uint16_t count;
+
+    uint8_t reg;
+    uint16_t delay_ms;
+
+    uint16_t pending;           /**< Sensors queued or in progress. */
+    uint16_t next_start;        /**< First sensor whose pointer is still queued. */
+    uint16_t last_xfer;         /**< Sensor that used the bus last. */
+    uint32_t round_start_ms;
+    uint32_t last_round_ms;
+} AGS10_SchedTypeDef;
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+
+/**
+ * @brief Bind a scheduler to already initialised sensor handles.
+ * 
+ * @param[out] p_sched Scheduler to initialise.
+ * @param[in] p_sensors Array of count sensor handles, see ags10_init().
+ * @param[out] p_results Array of count result slots.
+ * @param[in] count Number of sensors.
+ * @param[in] reg Register read in every round, e.g. AGS10MA_TVOC_STAT_REG.
+ * @param[in] delay_ms Conversion wait of that register.
+ * @param[in] get_tick_ms Millisecond tick source.
+ * @param[in] p_tick_ctx Context passed to get_tick_ms.
+ * 
+ * @retval true  Scheduler ready.
+ * @retval false Invalid arguments.
+ */
+bool ags10_sched_init(AGS10_SchedTypeDef *p_sched,
+                      AGS10_HandleTypeDef *p_sensors,
+                      AGS10_SchedResultTypeDef *p_results,
+                      uint16_t count,
+                      uint8_t reg,
+                      uint16_t delay_ms,
+                      AGS10_SchedTickFn get_tick_ms,
+                      void *p_tick_ctx);
+
+/**
+ * @brief Start a round by sending the register pointer to every sensor.
+ * 
+ * Sensors whose pointer write fails are marked as failed immediately and are
+ * not waited for. On an asynchronous bus the writes after the first one
+ * are queued until the bus is free.
+ * 
+ * @param[in,out] p_sched Scheduler.
+ * 
+ * @return Number of sensors converting or queued.
+ */
+uint16_t ags10_sched_round_start(AGS10_SchedTypeDef *p_sched);
+
+/**
+ * @brief Collect every frame whose wait has elapsed.
+ * 
+ * Call as often as convenient. Each ready sensor costs one 5 byte read.
+ * Queued pointer writes go out here as soon as the bus is free.
+ * 
+ * @param[in,out] p_sched Scheduler.
+ * 
+ * @retval true  No sensor is pending, the round is complete.
+ * @retval false Sensors are still converting.
+ */
+bool ags10_sched_poll(AGS10_SchedTypeDef *p_sched);
+
+/**
+ * @brief Milliseconds until the earliest pending sensor becomes ready.
+ * 
+ * Lets the caller sleep instead of spinning on ags10_sched_poll().
+ * 
+ * @param[in] p_sched Scheduler.
+ * 
+ * @return 0 if a sensor is ready or nothing is pending, the wait otherwise.
+ */
+uint32_t ags10_sched_next_due_ms(const AGS10_SchedTypeDef *p_sched);
+
+#endif /* INC_AGS10_SCHED_H_ */
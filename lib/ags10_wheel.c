@@ -0,0 +1,326 @@
+/**
+ * @file ags10_wheel.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_wheel.h"
+
+#include <stddef.h>
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static uint32_t level_shift(uint32_t level)
+{
+    return level * AGS10_WHEEL_BITS;
+}
+
+static uint32_t lowest_bit(uint64_t bits)
+{
+#if defined(__GNUC__)
+    return (uint32_t)__builtin_ctzll(bits);
+#else
+    uint32_t idx = 0;
+
+    while (0U == (bits & 1U))
+    {
+        bits >>= 1;
+        idx++;
+    }
+
+    return idx;
+#endif
+}
+
+static void slot_push(AGS10_WheelTypeDef *p_wheel, uint32_t id, uint32_t level, uint32_t slot)
+{
+    AGS10_WheelTimerTypeDef *p_timer = &p_wheel->p_slab[id];
+    uint32_t head = p_wheel->heads[level][slot];
+
+    p_timer->level = (uint8_t)level;
+    p_timer->slot = (uint8_t)slot;
+    p_timer->prev = AGS10_WHEEL_NONE;
+    p_timer->next = head;
+    if (AGS10_WHEEL_NONE != head)
+    {
+        p_wheel->p_slab[head].prev = id;
+    }
+    p_wheel->heads[level][slot] = id;
+    p_wheel->occupied[level] |= (uint64_t)1U << slot;
+}
+
+static void slot_unlink(AGS10_WheelTypeDef *p_wheel, uint32_t id)
+{
+    AGS10_WheelTimerTypeDef *p_timer = &p_wheel->p_slab[id];
+
+    if (AGS10_WHEEL_NONE != p_timer->prev)
+    {
+        p_wheel->p_slab[p_timer->prev].next = p_timer->next;
+    }
+    else
+    {
+        p_wheel->heads[p_timer->level][p_timer->slot] = p_timer->next;
+        if (AGS10_WHEEL_NONE == p_timer->next)
+        {
+            p_wheel->occupied[p_timer->level] &= ~((uint64_t)1U << p_timer->slot);
+        }
+    }
+
+    if (AGS10_WHEEL_NONE != p_timer->next)
+    {
+        p_wheel->p_slab[p_timer->next].prev = p_timer->prev;
+    }
+}
+
+/* Take a whole slot list out of the wheel; returns its first timer. */
+static uint32_t slot_take(AGS10_WheelTypeDef *p_wheel, uint32_t level, uint32_t slot)
+{
+    uint32_t head = p_wheel->heads[level][slot];
+
+    p_wheel->heads[level][slot] = AGS10_WHEEL_NONE;
+    p_wheel->occupied[level] &= ~((uint64_t)1U << slot);
+
+    return head;
+}
+
+/* Slot by the deadline's bits at the lowest level whose span covers it.
+   Due now lands in the current slot, which only a cascade may still expire. */
+static void timer_place(AGS10_WheelTypeDef *p_wheel, uint32_t id)
+{
+    uint32_t expires = p_wheel->p_slab[id].expires_ms;
+    uint32_t delta = expires - p_wheel->now_ms;
+    uint32_t level = 0;
+
+    if (delta > (uint32_t)INT32_MAX)
+    {
+        // overdue: the next tick
+        delta = 1U;
+        expires = p_wheel->now_ms + 1U;
+    }
+    else if (delta > AGS10_WHEEL_SPAN_MS)
+    {
+        // parked at the far end, placed again when cascaded
+        delta = AGS10_WHEEL_SPAN_MS;
+        expires = p_wheel->now_ms + AGS10_WHEEL_SPAN_MS;
+    }
+
+    while (((level + 1U) < AGS10_WHEEL_LEVELS) && (delta >= (1UL << level_shift(level + 1U))))
+    {
+        level++;
+    }
+
+    slot_push(p_wheel, id, level, (expires >> level_shift(level)) & AGS10_WHEEL_SLOT_MSK);
+}
+
+/* Move the current slot of a level down; true if the level above is due too. */
+static bool level_cascade(AGS10_WheelTypeDef *p_wheel, uint32_t level)
+{
+    uint32_t slot = (p_wheel->now_ms >> level_shift(level)) & AGS10_WHEEL_SLOT_MSK;
+    uint32_t id = slot_take(p_wheel, level, slot);
+
+    while (AGS10_WHEEL_NONE != id)
+    {
+        uint32_t next = p_wheel->p_slab[id].next;
+
+        timer_place(p_wheel, id);
+        p_wheel->cascaded++;
+        id = next;
+    }
+
+    return 0U == slot;
+}
+
+static uint32_t tick_expire(AGS10_WheelTypeDef *p_wheel, AGS10_WheelExpireFn expire, void *p_ctx)
+{
+    uint32_t slot = p_wheel->now_ms & AGS10_WHEEL_SLOT_MSK;
+    uint32_t expired = 0;
+
+    if (0U == slot)
+    {
+        for (uint32_t level = 1; (level < AGS10_WHEEL_LEVELS) && level_cascade(p_wheel, level); level++)
+        {
+        }
+    }
+
+    // detached first, so callbacks can add timers for the next tick
+    uint32_t id = slot_take(p_wheel, 0, slot);
+
+    while (AGS10_WHEEL_NONE != id)
+    {
+        AGS10_WheelTimerTypeDef *p_timer = &p_wheel->p_slab[id];
+        uint32_t next = p_timer->next;
+
+        if ((int32_t)(p_timer->expires_ms - p_wheel->now_ms) > 0)
+        {
+            // a parked timer that came round early
+            timer_place(p_wheel, id);
+            id = next;
+            continue;
+        }
+
+        p_timer->armed = false;
+        p_timer->next = p_wheel->free_head;
+        p_wheel->free_head = id;
+        p_wheel->count--;
+        expired++;
+
+        if (NULL != expire)
+        {
+            expire(p_ctx, id, p_timer->arg, p_timer->expires_ms);
+        }
+        id = next;
+    }
+
+    return expired;
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+bool ags10_wheel_init(AGS10_WheelTypeDef *p_wheel,
+                      AGS10_WheelTimerTypeDef *p_slab,
+                      uint32_t slab_len,
+                      uint32_t now_ms)
+{
+    if ((NULL == p_wheel) || (NULL == p_slab) || (0U == slab_len) || (slab_len >= AGS10_WHEEL_NONE))
+    {
+        return false;
+    }
+
+    p_wheel->p_slab = p_slab;
+    p_wheel->slab_len = slab_len;
+    p_wheel->count = 0;
+    p_wheel->now_ms = now_ms;
+    p_wheel->cascaded = 0;
+
+    for (uint32_t level = 0; level < AGS10_WHEEL_LEVELS; level++)
+    {
+        for (uint32_t slot = 0; slot < AGS10_WHEEL_SLOTS; slot++)
+        {
+            p_wheel->heads[level][slot] = AGS10_WHEEL_NONE;
+        }
+        p_wheel->occupied[level] = 0;
+    }
+
+    for (uint32_t id = 0; id < slab_len; id++)
+    {
+        p_slab[id].armed = false;
+        p_slab[id].next = ((id + 1U) < slab_len) ? (id + 1U) : AGS10_WHEEL_NONE;
+    }
+    p_wheel->free_head = 0;
+
+    return true;
+}
+
+uint32_t ags10_wheel_add(AGS10_WheelTypeDef *p_wheel, uint32_t expires_ms, uint32_t arg)
+{
+    uint32_t id = p_wheel->free_head;
+
+    if (AGS10_WHEEL_NONE == id)
+    {
+        return AGS10_WHEEL_NONE;
+    }
+
+    AGS10_WheelTimerTypeDef *p_timer = &p_wheel->p_slab[id];
+
+    p_wheel->free_head = p_timer->next;
+    p_timer->expires_ms = expires_ms;
+    p_timer->arg = arg;
+    p_timer->armed = true;
+    p_wheel->count++;
+    if (expires_ms == p_wheel->now_ms)
+    {
+        // this tick is already done
+        slot_push(p_wheel, id, 0, (expires_ms + 1U) & AGS10_WHEEL_SLOT_MSK);
+    }
+    else
+    {
+        timer_place(p_wheel, id);
+    }
+
+    return id;
+}
+
+bool ags10_wheel_cancel(AGS10_WheelTypeDef *p_wheel, uint32_t id)
+{
+    if ((id >= p_wheel->slab_len) || !p_wheel->p_slab[id].armed)
+    {
+        return false;
+    }
+
+    slot_unlink(p_wheel, id);
+    p_wheel->p_slab[id].armed = false;
+    p_wheel->p_slab[id].next = p_wheel->free_head;
+    p_wheel->free_head = id;
+    p_wheel->count--;
+
+    return true;
+}
+
+uint32_t ags10_wheel_advance(AGS10_WheelTypeDef *p_wheel,
+                             uint32_t now_ms,
+                             AGS10_WheelExpireFn expire,
+                             void *p_ctx)
+{
+    uint32_t expired = 0;
+
+    while (p_wheel->now_ms != now_ms)
+    {
+        uint32_t slot = p_wheel->now_ms & AGS10_WHEEL_SLOT_MSK;
+        uint32_t left = now_ms - p_wheel->now_ms;
+
+        if (left > (uint32_t)INT32_MAX)
+        {
+            // now_ms went backwards
+            break;
+        }
+
+        // jump over empty level 0 slots up to the next cascade
+        if ((AGS10_WHEEL_SLOT_MSK != slot) && (0U == (p_wheel->occupied[0] >> (slot + 1U))))
+        {
+            uint32_t skip = AGS10_WHEEL_SLOT_MSK - slot;
+
+            if (skip >= left)
+            {
+                p_wheel->now_ms = now_ms;
+                break;
+            }
+            p_wheel->now_ms += skip;
+        }
+
+        p_wheel->now_ms++;
+        expired += tick_expire(p_wheel, expire, p_ctx);
+    }
+
+    return expired;
+}
+
+uint32_t ags10_wheel_idle_ms(const AGS10_WheelTypeDef *p_wheel)
+{
+    uint32_t slot = p_wheel->now_ms & AGS10_WHEEL_SLOT_MSK;
+
+    if (0U == p_wheel->count)
+    {
+        return UINT32_MAX;
+    }
+
+    if (AGS10_WHEEL_SLOT_MSK != slot)
+    {
+        uint64_t ahead = p_wheel->occupied[0] >> (slot + 1U);
+
+        if (0U != ahead)
+        {
+            return lowest_bit(ahead) + 1U;
+        }
+    }
+
+    return AGS10_WHEEL_SLOTS - slot;
+}
+// eof
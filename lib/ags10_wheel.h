@@ -0,0 +1,176 @@
+/**
+ * @file ags10_wheel.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Hierarchical timer wheel over a static timer slab.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_WHEEL_H_
+#define INC_AGS10_WHEEL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#ifndef AGS10_WHEEL_LEVELS
+#define AGS10_WHEEL_LEVELS          4U      /**< 6 bits each: 4 levels reach 2^24 ms, 4.6 h. */
+#endif
+
+#define AGS10_WHEEL_BITS            6U
+#define AGS10_WHEEL_SLOTS           (1UL << AGS10_WHEEL_BITS)
+#define AGS10_WHEEL_SLOT_MSK        (AGS10_WHEEL_SLOTS - 1U)
+#define AGS10_WHEEL_SPAN_MS         ((1UL << (AGS10_WHEEL_BITS * AGS10_WHEEL_LEVELS)) - 1U)
+#define AGS10_WHEEL_NONE            0xFFFFFFFFUL    /**< No timer / end of a list. */
+
+#if (AGS10_WHEEL_LEVELS < 1U) || (AGS10_WHEEL_LEVELS > 5U)
+#error "AGS10_WHEEL_LEVELS must be 1 to 5"
+#endif
+
+/*******************************************************************************/
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+/**
+ * @brief One timer; the slab is an array of these owned by the application.
+ */
+typedef struct {
+    uint32_t expires_ms;
+    uint32_t arg;               /**< Application value, e.g. a sensor index. */
+    uint32_t next;              /**< Slot list or free list link. */
+    uint32_t prev;
+    uint8_t level;
+    uint8_t slot;
+    bool armed;
+} AGS10_WheelTimerTypeDef;
+
+/**
+ * @brief Hashed hierarchical timer wheel, millisecond ticks.
+ *
+ * Level 0 has one slot per millisecond for the next 64 ms, level 1 one slot
+ * per 64 ms for the next 4 s, and so on, each slot a doubly linked list of
+ * slab indices. Adding and cancelling a timer are O(1) list operations, and
+ * so is expiring one: when level 0 wraps, the current slot of level 1 is
+ * moved down (cascaded) into level 0, and likewise up the levels, so each
+ * timer moves at most AGS10_WHEEL_LEVELS - 1 times. A bitmap per level lets
+ * ags10_wheel_advance() jump over empty slots. Deadlines beyond
+ * AGS10_WHEEL_SPAN_MS are parked at the far end and re-placed as they come
+ * closer.
+ *
+ * All storage is static: the slab and AGS10_WHEEL_LEVELS * 64 list heads
+ * (1 KiB at 4 levels). Not thread safe.
+ */
+typedef struct {
+    AGS10_WheelTimerTypeDef *p_slab;
+    uint32_t slab_len;
+    uint32_t free_head;
+    uint32_t count;             /**< Armed timers. */
+    uint32_t now_ms;            /**< Last tick processed. */
+
+    uint32_t heads[AGS10_WHEEL_LEVELS][AGS10_WHEEL_SLOTS];
+    uint64_t occupied[AGS10_WHEEL_LEVELS];      /**< Bit per non-empty slot. */
+
+    /* Statistics */
+    uint32_t cascaded;          /**< Timers moved to a lower level. */
+} AGS10_WheelTypeDef;
+
+/**
+ * @brief Called for each expired timer, tick by tick.
+ *
+ * The timer is already free, so the callback may add timers, including
+ * reusing the same slot for the next deadline.
+ *
+ * @param[in] p_ctx Context given to ags10_wheel_advance().
+ * @param[in] id Timer that expired.
+ * @param[in] arg Its application value.
+ * @param[in] expires_ms Its deadline.
+ */
+typedef void (*AGS10_WheelExpireFn)(void *p_ctx, uint32_t id, uint32_t arg, uint32_t expires_ms);
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+
+/**
+ * @brief Start an empty wheel.
+ *
+ * @param[out] p_wheel Wheel.
+ * @param[in] p_slab Timer storage.
+ * @param[in] slab_len Timers in p_slab, below AGS10_WHEEL_NONE.
+ * @param[in] now_ms Current tick.
+ *
+ * @retval true  Wheel ready.
+ * @retval false Invalid arguments.
+ */
+bool ags10_wheel_init(AGS10_WheelTypeDef *p_wheel,
+                      AGS10_WheelTimerTypeDef *p_slab,
+                      uint32_t slab_len,
+                      uint32_t now_ms);
+
+/**
+ * @brief Arm a timer.
+ *
+ * A deadline that is not after the last processed tick expires on the next
+ * one, as does one more than 2^31 ms ahead (taken as wrapped).
+ *
+ * @param[in,out] p_wheel Wheel.
+ * @param[in] expires_ms Deadline tick.
+ * @param[in] arg Application value handed back on expiry.
+ *
+ * @return Timer id, or AGS10_WHEEL_NONE if the slab is exhausted.
+ */
+uint32_t ags10_wheel_add(AGS10_WheelTypeDef *p_wheel, uint32_t expires_ms, uint32_t arg);
+
+/**
+ * @brief Disarm a timer.
+ *
+ * @param[in,out] p_wheel Wheel.
+ * @param[in] id Timer from ags10_wheel_add().
+ *
+ * @retval true  Cancelled.
+ * @retval false Not armed (already expired or cancelled).
+ */
+bool ags10_wheel_cancel(AGS10_WheelTypeDef *p_wheel, uint32_t id);
+
+/**
+ * @brief Process every tick up to now_ms and expire the timers due.
+ *
+ * @param[in,out] p_wheel Wheel.
+ * @param[in] now_ms Current tick; must not go backwards.
+ * @param[in] expire Called per expired timer.
+ * @param[in] p_ctx Context passed to expire.
+ *
+ * @return Timers expired.
+ */
+uint32_t ags10_wheel_advance(AGS10_WheelTypeDef *p_wheel,
+                             uint32_t now_ms,
+                             AGS10_WheelExpireFn expire,
+                             void *p_ctx);
+
+/**
+ * @brief Ticks the caller may sleep before calling ags10_wheel_advance().
+ *
+ * Exact when the next timer is within 64 ms; otherwise the time to the
+ * next cascade, which may find nothing due yet.
+ *
+ * @param[in] p_wheel Wheel.
+ *
+ * @return Milliseconds, at least 1; UINT32_MAX with no timer armed.
+ */
+uint32_t ags10_wheel_idle_ms(const AGS10_WheelTypeDef *p_wheel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_AGS10_WHEEL_H_ */
@@ -0,0 +1,331 @@
+/**
+ * @file ags10.hpp
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Header-only C++17 AGS10 driver with compile-time bus and address.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_HPP_
+#define INC_AGS10_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "ags10.h"
+
+namespace ags10 {
+
+/*******************************************************************************
+* Status and Results
+ ******************************************************************************/
+/** Same codes as the C driver. */
+using Status = AGS10_StatusTypeDef;
+
+/**
+ * @brief A value or the reason there is none, in the spirit of std::expected.
+ *
+ * @tparam T Value type, default constructible.
+ */
+template <typename T>
+class Result {
+public:
+    static constexpr Result success(T value) { return Result(value, AGS10_OK); }
+    static constexpr Result failure(Status status) { return Result(T{}, status); }
+
+    constexpr bool ok() const { return AGS10_OK == status_; }
+    constexpr explicit operator bool() const { return ok(); }
+    constexpr Status status() const { return status_; }
+
+    /** The value; only meaningful when ok(). */
+    constexpr const T &value() const { return value_; }
+    constexpr const T &operator*() const { return value_; }
+    constexpr const T *operator->() const { return &value_; }
+    constexpr T value_or(T fallback) const { return ok() ? value_ : fallback; }
+
+    constexpr std::optional<T> to_optional() const
+    {
+        return ok() ? std::optional<T>(value_) : std::nullopt;
+    }
+
+private:
+    constexpr Result(T value, Status status) : value_(value), status_(status) {}
+
+    T value_;
+    Status status_;
+};
+
+/**
+ * @brief A decoded status + TVOC frame.
+ */
+struct Tvoc {
+    std::uint32_t ppb;
+    std::uint8_t status;
+
+    /** RDY clear: a new value since the last read. */
+    constexpr bool fresh() const { return 0U == (status & AGS10MA_STATUS_RDY_MSK); }
+};
+
+/*******************************************************************************
+* CRC-8
+ ******************************************************************************/
+namespace detail {
+
+/** Engines as in the C driver; the table ones are built at compile time. */
+enum class Crc8Engine { Bitwise, Nibble, Table };
+
+#if (AGS10_CRC8_ENGINE == AGS10_CRC8_ENGINE_BITWISE)
+inline constexpr Crc8Engine crc8_engine = Crc8Engine::Bitwise;
+#elif (AGS10_CRC8_ENGINE == AGS10_CRC8_ENGINE_NIBBLE)
+inline constexpr Crc8Engine crc8_engine = Crc8Engine::Nibble;
+#else
+// SLICE4 only pays off on long buffers; frames are 4 bytes
+inline constexpr Crc8Engine crc8_engine = Crc8Engine::Table;
+#endif
+
+constexpr std::uint8_t crc8_step(std::uint8_t crc)
+{
+    for (int bit = 0; bit < 8; bit++)
+    {
+        crc = (crc & 0x80U) ? static_cast<std::uint8_t>((crc << 1) ^ AGS10MA_CRC8_POLYNOMIAL)
+                            : static_cast<std::uint8_t>(crc << 1);
+    }
+
+    return crc;
+}
+
+template <std::size_t N>
+struct Crc8Table {
+    std::uint8_t lut[N];
+};
+
+template <std::size_t N>
+constexpr Crc8Table<N> crc8_table_make()
+{
+    Crc8Table<N> table{};
+
+    // with N == 16, entry h is the CRC of the high nibble h, i.e. the byte table at index h
+    for (std::size_t idx = 0; idx < N; idx++)
+    {
+        table.lut[idx] = crc8_step(static_cast<std::uint8_t>(idx));
+    }
+
+    return table;
+}
+
+inline constexpr Crc8Table<16> crc8_nibble_lut = crc8_table_make<16>();
+inline constexpr Crc8Table<256> crc8_byte_lut = crc8_table_make<256>();
+
+constexpr std::uint8_t crc8(const std::uint8_t *p_data, std::size_t len)
+{
+    std::uint8_t crc = AGS10MA_CRC8_INIT;
+
+    for (std::size_t idx = 0; idx < len; idx++)
+    {
+        if constexpr (Crc8Engine::Bitwise == crc8_engine)
+        {
+            crc = crc8_step(static_cast<std::uint8_t>(crc ^ p_data[idx]));
+        }
+        else if constexpr (Crc8Engine::Nibble == crc8_engine)
+        {
+            crc ^= p_data[idx];
+            crc = static_cast<std::uint8_t>((crc << 4) ^ crc8_nibble_lut.lut[crc >> 4]);
+            crc = static_cast<std::uint8_t>((crc << 4) ^ crc8_nibble_lut.lut[crc >> 4]);
+        }
+        else
+        {
+            crc = crc8_byte_lut.lut[crc ^ p_data[idx]];
+        }
+    }
+
+    return crc;
+}
+
+/** Bus NACKs carry no direction; the driver knows which transfer it was. */
+constexpr Status direction(Status status, bool reading)
+{
+    return (AGS10_ERR_NACK != status) ? status : (reading ? AGS10_ERR_NACK_READ : AGS10_ERR_NACK_WRITE);
+}
+
+/** CRC check and big-endian unpacking of a received frame. */
+constexpr Result<std::uint32_t> frame_decode(const std::uint8_t *p_frame)
+{
+    if (crc8(p_frame, AGS10MA_DATA_LEN) != p_frame[AGS10MA_DATA_LEN])
+    {
+        return Result<std::uint32_t>::failure(AGS10_ERR_CRC);
+    }
+
+    return Result<std::uint32_t>::success((static_cast<std::uint32_t>(p_frame[0]) << 24) |
+                                          (static_cast<std::uint32_t>(p_frame[1]) << 16) |
+                                          (static_cast<std::uint32_t>(p_frame[2]) << 8) |
+                                          static_cast<std::uint32_t>(p_frame[3]));
+}
+
+/** Split a TVOC register value. */
+constexpr Tvoc tvoc_decode(std::uint32_t raw)
+{
+    return Tvoc{ raw & AGS10MA_TVOC_MSK, static_cast<std::uint8_t>(raw >> 24) };
+}
+
+/** The address command frame, CRC included, as a compile-time constant. */
+template <std::uint8_t NewAddress>
+struct AddressFrame {
+    static constexpr std::uint8_t inv = static_cast<std::uint8_t>(~NewAddress);
+    static constexpr std::uint8_t data[AGS10MA_DATA_LEN] = { NewAddress, inv, NewAddress, inv };
+    static constexpr std::uint8_t bytes[6] = {
+        AGS10MA_SET_ADDR_REG, NewAddress, inv, NewAddress, inv, crc8(data, AGS10MA_DATA_LEN),
+    };
+};
+
+} // namespace detail
+
+/*******************************************************************************
+* Bus Policies
+ ******************************************************************************/
+/*
+ * A Bus policy is any class with these members (static or not):
+ *
+ *   Status write(std::uint8_t addr, const std::uint8_t *p_data, std::uint16_t length);
+ *   Status read(std::uint8_t addr, std::uint8_t *p_data, std::uint16_t length);
+ *   void delay_ms(std::uint16_t ms);
+ *
+ * They are called directly, so an inline policy leaves no indirect call in
+ * a read. A NACK is reported as AGS10_ERR_NACK, as with the C bus ops.
+ */
+
+/**
+ * @brief Policy over a C bus ops table, to reuse an existing back end.
+ *
+ * Calls stay indirect, as in the C driver.
+ */
+class OpsBus {
+public:
+    OpsBus(const AGS10_BusOpsTypeDef *p_ops, void *p_ctx) : p_ops_(p_ops), p_ctx_(p_ctx) {}
+
+    Status write(std::uint8_t addr, const std::uint8_t *p_data, std::uint16_t length)
+    {
+        return p_ops_->write(p_ctx_, addr, const_cast<std::uint8_t *>(p_data), length);
+    }
+
+    Status read(std::uint8_t addr, std::uint8_t *p_data, std::uint16_t length)
+    {
+        return p_ops_->read(p_ctx_, addr, p_data, length);
+    }
+
+    void delay_ms(std::uint16_t ms)
+    {
+        p_ops_->delay(p_ctx_, ms);
+    }
+
+private:
+    const AGS10_BusOpsTypeDef *p_ops_;
+    void *p_ctx_;
+};
+
+/*******************************************************************************
+* Driver
+ ******************************************************************************/
+/**
+ * @brief One AGS10 at a fixed address on a Bus.
+ *
+ * The address is a template argument: it reaches the bus as an immediate,
+ * and set_address() sends a command frame whose CRC was computed by the
+ * compiler. A stateless Bus adds no storage (empty base).
+ *
+ * Reads are blocking and not retried; use the C driver for split-phase
+ * reads, retry policies and statistics.
+ *
+ * @tparam Bus Bus policy, see above.
+ * @tparam Address 7-bit I2C address.
+ */
+template <typename Bus, std::uint8_t Address = AGS10MA_I2C_DEVICE_ADDR>
+class Ags10 : private Bus {
+    static_assert((Address >= 0x08U) && (Address <= 0x77U), "Address must be a non-reserved 7-bit address");
+
+public:
+    static constexpr std::uint8_t address = Address;
+
+    explicit Ags10(Bus bus = Bus{}) : Bus(bus) {}
+
+    Bus &bus() { return *this; }
+
+    /**
+     * @brief Read a register: pointer write, wait, 5-byte frame, CRC check.
+     */
+    Result<std::uint32_t> register_read(std::uint8_t reg, std::uint16_t delay_ms)
+    {
+        std::uint8_t frame[AGS10MA_FRAME_LEN];
+        Status status = bus().write(Address, &reg, 1U);
+
+        if (AGS10_OK != status)
+        {
+            return Result<std::uint32_t>::failure(detail::direction(status, false));
+        }
+
+        bus().delay_ms(delay_ms);
+
+        status = bus().read(Address, frame, AGS10MA_FRAME_LEN);
+        if (AGS10_OK != status)
+        {
+            return Result<std::uint32_t>::failure(detail::direction(status, true));
+        }
+
+        return detail::frame_decode(frame);
+    }
+
+    /**
+     * @brief TVOC and status byte; waits for a conversion like ags10_tvoc_get().
+     */
+    Result<Tvoc> tvoc(std::uint16_t delay_ms = AGS10MA_TVOC_DELAY_MS)
+    {
+        Result<std::uint32_t> raw = register_read(AGS10MA_TVOC_STAT_REG, delay_ms);
+
+        if (!raw)
+        {
+            return Result<Tvoc>::failure(raw.status());
+        }
+
+        return Result<Tvoc>::success(detail::tvoc_decode(*raw));
+    }
+
+    /**
+     * @brief Firmware version, the low byte of the version register.
+     */
+    Result<std::uint8_t> version()
+    {
+        Result<std::uint32_t> raw = register_read(AGS10MA_VERSION_REG, AGS10MA_VERSION_DELAY_MS);
+
+        return raw ? Result<std::uint8_t>::success(static_cast<std::uint8_t>(*raw))
+                   : Result<std::uint8_t>::failure(raw.status());
+    }
+
+    /**
+     * @brief Gas resistance in 0.1 kOhm units.
+     */
+    Result<std::uint32_t> resistance()
+    {
+        return register_read(AGS10MA_GAS_RES_REG, AGS10MA_ACCESS_DELAY_MS);
+    }
+
+    /**
+     * @brief Move the sensor to NewAddress; it keeps it across power cycles.
+     *
+     * On success talk to it through an Ags10<Bus, NewAddress>.
+     */
+    template <std::uint8_t NewAddress>
+    Status set_address()
+    {
+        static_assert((NewAddress >= 0x08U) && (NewAddress <= 0x77U), "NewAddress must be a non-reserved 7-bit address");
+
+        return detail::direction(bus().write(Address, detail::AddressFrame<NewAddress>::bytes,
+                                             sizeof(detail::AddressFrame<NewAddress>::bytes)), false);
+    }
+};
+
+} // namespace ags10
+
+#endif /* INC_AGS10_HPP_ */
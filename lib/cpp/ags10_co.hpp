@@ -0,0 +1,587 @@
+/**
+ * @file ags10_co.hpp
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief C++20 coroutine AGS10 driver on a single-threaded timerfd loop (Linux).
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_CO_HPP_
+#define INC_AGS10_CO_HPP_
+
+#include <algorithm>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "ags10.hpp"
+
+namespace ags10::co {
+
+class Loop;
+
+/*******************************************************************************
+* Frame Pool
+ ******************************************************************************/
+namespace detail {
+
+/**
+ * @brief Recycles coroutine frames in size classes of 64 bytes up to 1 KiB.
+ *
+ * Blocks are carved from 64-block chunks and never returned to the heap, so
+ * once the pool has grown to the peak number of live frames, starting a
+ * coroutine costs a free-list pop instead of malloc(). Larger frames fall
+ * back to ::operator new. One pool per thread; a frame must be freed on the
+ * thread that allocated it, which the single-threaded Loop guarantees.
+ */
+class FramePool {
+public:
+    static constexpr std::size_t granule = 64U;
+    static constexpr std::size_t classes = 16U;
+    static constexpr std::size_t chunk_blocks = 64U;
+
+    FramePool() = default;
+    FramePool(const FramePool &) = delete;
+    FramePool &operator=(const FramePool &) = delete;
+
+    ~FramePool()
+    {
+        for (Chunk *p_chunk = p_chunks_; nullptr != p_chunk;)
+        {
+            Chunk *p_next = p_chunk->p_next;
+
+            ::operator delete(p_chunk);
+            p_chunk = p_next;
+        }
+    }
+
+    void *allocate(std::size_t size)
+    {
+        std::size_t cls = (size + granule - 1U) / granule;
+
+        if (cls > classes)
+        {
+            fallback++;
+            return ::operator new(size);
+        }
+
+        if ((nullptr == p_free_[cls - 1U]) && !grow(cls))
+        {
+            return nullptr;
+        }
+
+        Block *p_block = p_free_[cls - 1U];
+
+        p_free_[cls - 1U] = p_block->p_next;
+        in_use++;
+        allocations++;
+
+        return p_block;
+    }
+
+    void release(void *p, std::size_t size)
+    {
+        std::size_t cls = (size + granule - 1U) / granule;
+
+        if (cls > classes)
+        {
+            ::operator delete(p);
+            return;
+        }
+
+        Block *p_block = static_cast<Block *>(p);
+
+        p_block->p_next = p_free_[cls - 1U];
+        p_free_[cls - 1U] = p_block;
+        in_use--;
+    }
+
+    /* Statistics */
+    std::size_t allocations = 0;    /**< Frames handed out. */
+    std::size_t in_use = 0;         /**< Frames live now. */
+    std::size_t chunks = 0;         /**< Heap allocations made by the pool. */
+    std::size_t fallback = 0;       /**< Frames too large for the pool. */
+
+private:
+    struct Block {
+        Block *p_next;
+    };
+
+    struct Chunk {
+        Chunk *p_next;
+        std::size_t pad;            /**< Keeps the blocks 16-byte aligned. */
+    };
+
+    bool grow(std::size_t cls)
+    {
+        std::size_t block = cls * granule;
+        void *p_mem = ::operator new(sizeof(Chunk) + (block * chunk_blocks), std::nothrow);
+
+        if (nullptr == p_mem)
+        {
+            return false;
+        }
+
+        Chunk *p_chunk = static_cast<Chunk *>(p_mem);
+        auto *p_bytes = reinterpret_cast<unsigned char *>(p_chunk + 1);
+
+        p_chunk->p_next = p_chunks_;
+        p_chunks_ = p_chunk;
+        chunks++;
+
+        for (std::size_t idx = chunk_blocks; idx > 0U; idx--)
+        {
+            Block *p_block = reinterpret_cast<Block *>(p_bytes + ((idx - 1U) * block));
+
+            p_block->p_next = p_free_[cls - 1U];
+            p_free_[cls - 1U] = p_block;
+        }
+
+        return true;
+    }
+
+    Block *p_free_[classes] = {};
+    Chunk *p_chunks_ = nullptr;
+};
+
+inline FramePool &frame_pool()
+{
+    static thread_local FramePool pool;
+
+    return pool;
+}
+
+/**
+ * @brief Promise parts shared by every Task: pooled frames and the hand-off
+ *        to whoever awaits the task.
+ */
+struct PromiseBase {
+    std::coroutine_handle<> continuation;
+    Loop *p_loop = nullptr;         /**< Set for tasks detached by Loop::spawn(). */
+
+    static void *operator new(std::size_t size)
+    {
+        void *p = frame_pool().allocate(size);
+
+        if (nullptr == p)
+        {
+            std::terminate();
+        }
+
+        return p;
+    }
+
+    static void operator delete(void *p, std::size_t size)
+    {
+        frame_pool().release(p, size);
+    }
+
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept;
+
+        void await_resume() noexcept {}
+    };
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    FinalAwaiter final_suspend() noexcept { return {}; }
+    void unhandled_exception() noexcept { std::terminate(); }
+};
+
+template <typename T>
+struct Promise : PromiseBase {
+    std::optional<T> value;
+
+    void return_value(T result) { value.emplace(std::move(result)); }
+};
+
+template <>
+struct Promise<void> : PromiseBase {
+    void return_void() noexcept {}
+};
+
+} // namespace detail
+
+/*******************************************************************************
+* Task
+ ******************************************************************************/
+/**
+ * @brief A lazily started coroutine; co_await it to run it and get its value.
+ *
+ * The awaiting coroutine is resumed straight from the task's final suspend
+ * (symmetric transfer), so deep await chains use no stack and no loop round
+ * trip.
+ */
+template <typename T = void>
+class Task {
+public:
+    struct promise_type : detail::Promise<T> {
+        Task get_return_object()
+        {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+    };
+
+    Task(Task &&other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    ~Task()
+    {
+        if (handle_)
+        {
+            handle_.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        handle_.promise().continuation = awaiting;
+        return handle_;
+    }
+
+    T await_resume()
+    {
+        if constexpr (!std::is_void_v<T>)
+        {
+            return std::move(*handle_.promise().value);
+        }
+    }
+
+    /** Give up ownership of the frame, see Loop::spawn(). */
+    std::coroutine_handle<promise_type> release() noexcept
+    {
+        return std::exchange(handle_, nullptr);
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/*******************************************************************************
+* Loop
+ ******************************************************************************/
+/**
+ * @brief Single-threaded event loop: a timer heap behind one timerfd.
+ *
+ * Any number of sleeping coroutines share the one timerfd, which is only
+ * re-armed when the earliest deadline changes, and every timer due at a
+ * wake-up is run in that same pass. Deadlines are rounded up to
+ * timer_slack_ns for the timerfd, so sensors polled a fraction of a
+ * millisecond apart are served by one wake-up. The clock is read once per
+ * pass.
+ */
+class Loop {
+public:
+    Loop()
+    {
+        timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+        ok_ = (timer_fd_ >= 0);
+        now_ns_ = clock_ns();
+    }
+
+    Loop(const Loop &) = delete;
+    Loop &operator=(const Loop &) = delete;
+
+    ~Loop()
+    {
+        if (timer_fd_ >= 0)
+        {
+            close(timer_fd_);
+        }
+    }
+
+    /** false if the timerfd could not be created. */
+    bool ok() const { return ok_; }
+
+    /** CLOCK_MONOTONIC as of the current pass, in nanoseconds. */
+    std::uint64_t now_ns() const { return now_ns_; }
+
+    std::uint32_t now_ms() const { return static_cast<std::uint32_t>(now_ns_ / 1000000U); }
+
+    /**
+     * @brief Awaitable that resumes the coroutine at a CLOCK_MONOTONIC deadline.
+     */
+    auto sleep_until(std::uint64_t deadline_ns)
+    {
+        struct Awaiter {
+            Loop &loop;
+            std::uint64_t deadline_ns;
+
+            bool await_ready() const noexcept { return deadline_ns <= loop.now_ns_; }
+            void await_suspend(std::coroutine_handle<> h) { loop.timer_add(deadline_ns, h); }
+            void await_resume() const noexcept {}
+        };
+
+        return Awaiter{ *this, deadline_ns };
+    }
+
+    auto sleep_ms(std::uint32_t ms)
+    {
+        return sleep_until(now_ns_ + (static_cast<std::uint64_t>(ms) * 1000000U));
+    }
+
+    /**
+     * @brief Start a task that owns itself; its frame is freed when it ends.
+     *
+     * The task runs up to its first suspension before spawn() returns.
+     */
+    void spawn(Task<void> task)
+    {
+        auto handle = task.release();
+
+        handle.promise().p_loop = this;
+        live_++;
+        handle.resume();
+    }
+
+    /**
+     * @brief Run until every spawned task has ended, or stop() is called.
+     */
+    void run()
+    {
+        stopped_ = false;
+        while (ok_ && !stopped_ && (0U != live_))
+        {
+            now_ns_ = clock_ns();
+            timers_run();
+
+            if ((0U == live_) || stopped_)
+            {
+                break;
+            }
+            if (timers_.empty())
+            {
+                // nothing left that could wake a task
+                break;
+            }
+
+            timer_arm();
+
+            // blocks until the timerfd expires; a signal just starts another pass
+            std::uint64_t expirations;
+
+            wakeups++;
+            if (sizeof(expirations) == read(timer_fd_, &expirations, sizeof(expirations)))
+            {
+                armed_ns_ = 0;
+            }
+        }
+    }
+
+    void stop() { stopped_ = true; }
+
+    /** Spawned tasks that have not ended. */
+    std::size_t live() const { return live_; }
+
+    /**
+     * Timers may run this late so that nearby deadlines share one wake-up
+     * (and one timerfd_settime()); never early. 0 for exact wake-ups.
+     */
+    std::uint64_t timer_slack_ns = 1000000U;
+
+    /* Statistics */
+    std::uint64_t wakeups = 0;      /**< Waits on the timerfd. */
+    std::uint64_t timer_arms = 0;   /**< timerfd_settime() calls. */
+    std::uint64_t resumes = 0;      /**< Coroutines resumed by the loop. */
+
+    /** Called by a spawned task as its frame is freed. */
+    void task_done() { live_--; }
+
+private:
+    struct Timer {
+        std::uint64_t deadline_ns;
+        std::uint64_t seq;          /**< Equal deadlines resume in order. */
+        std::coroutine_handle<> handle;
+
+        bool operator>(const Timer &other) const
+        {
+            return (deadline_ns != other.deadline_ns) ? (deadline_ns > other.deadline_ns) : (seq > other.seq);
+        }
+    };
+
+    static std::uint64_t clock_ns()
+    {
+        timespec ts{};
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+
+        return (static_cast<std::uint64_t>(ts.tv_sec) * 1000000000U) + static_cast<std::uint64_t>(ts.tv_nsec);
+    }
+
+    void timer_add(std::uint64_t deadline_ns, std::coroutine_handle<> h)
+    {
+        timers_.push_back(Timer{ deadline_ns, timer_seq_++, h });
+        std::push_heap(timers_.begin(), timers_.end(), std::greater<Timer>());
+    }
+
+    void timers_run()
+    {
+        // timers added while running wait for the next pass unless already due
+        while (!timers_.empty() && (timers_.front().deadline_ns <= now_ns_))
+        {
+            std::pop_heap(timers_.begin(), timers_.end(), std::greater<Timer>());
+
+            std::coroutine_handle<> h = timers_.back().handle;
+
+            timers_.pop_back();
+            resumes++;
+            h.resume();
+        }
+    }
+
+    void timer_arm()
+    {
+        std::uint64_t deadline_ns = 0;
+
+        if (!timers_.empty())
+        {
+            // round up to the slack: timers due close together share a wake-up
+            std::uint64_t slack_ns = (0U != timer_slack_ns) ? timer_slack_ns : 1U;
+
+            deadline_ns = ((timers_.front().deadline_ns + slack_ns - 1U) / slack_ns) * slack_ns;
+        }
+
+        if (deadline_ns == armed_ns_)
+        {
+            return;
+        }
+
+        itimerspec spec{};
+
+        spec.it_value.tv_sec = static_cast<time_t>(deadline_ns / 1000000000U);
+        spec.it_value.tv_nsec = static_cast<long>(deadline_ns % 1000000000U);
+        (void)timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &spec, nullptr);
+        armed_ns_ = deadline_ns;
+        timer_arms++;
+    }
+
+    int timer_fd_ = -1;
+    bool ok_ = false;
+    bool stopped_ = false;
+    std::uint64_t now_ns_ = 0;
+    std::uint64_t armed_ns_ = 0;    /**< Deadline the timerfd is set to, 0 if none. */
+    std::uint64_t timer_seq_ = 0;
+    std::vector<Timer> timers_;
+    std::size_t live_ = 0;
+};
+
+template <typename Promise>
+std::coroutine_handle<> detail::PromiseBase::FinalAwaiter::await_suspend(std::coroutine_handle<Promise> h) noexcept
+{
+    PromiseBase &promise = h.promise();
+
+    if (promise.continuation)
+    {
+        return promise.continuation;
+    }
+
+    if (nullptr != promise.p_loop)
+    {
+        Loop *p_loop = promise.p_loop;
+
+        h.destroy();
+        p_loop->task_done();
+    }
+
+    return std::noop_coroutine();
+}
+
+/*******************************************************************************
+* Driver
+ ******************************************************************************/
+/**
+ * @brief One AGS10 whose conversion waits suspend the coroutine instead of
+ *        the thread.
+ *
+ * The Bus policy is the one of ags10::Ags10 (its delay_ms() is not used).
+ * Linux i2c-dev has no asynchronous transfers, so the pointer write and the
+ * frame read run inline (well under a millisecond each); only the wait in
+ * between, up to a second, goes through the loop. The address is a runtime
+ * value so that thousands of sensors can share one type.
+ *
+ * Each call returns a Task whose frame comes from the thread's frame pool.
+ */
+template <typename Bus>
+class Sensor : private Bus {
+public:
+    Sensor(Loop &loop, Bus bus, std::uint8_t address = AGS10MA_I2C_DEVICE_ADDR)
+        : Bus(bus), loop_(loop), address_(address) {}
+
+    Bus &bus() { return *this; }
+
+    std::uint8_t address() const { return address_; }
+
+    /**
+     * @brief Pointer write, suspend for delay_ms, frame read and CRC check.
+     */
+    Task<Result<std::uint32_t>> register_read(std::uint8_t reg, std::uint16_t delay_ms)
+    {
+        std::uint8_t frame[AGS10MA_FRAME_LEN];
+        Status status = bus().write(address_, &reg, 1U);
+
+        if (AGS10_OK != status)
+        {
+            co_return Result<std::uint32_t>::failure(ags10::detail::direction(status, false));
+        }
+
+        co_await loop_.sleep_ms(delay_ms);
+
+        status = bus().read(address_, frame, AGS10MA_FRAME_LEN);
+        if (AGS10_OK != status)
+        {
+            co_return Result<std::uint32_t>::failure(ags10::detail::direction(status, true));
+        }
+
+        co_return ags10::detail::frame_decode(frame);
+    }
+
+    Task<Result<Tvoc>> tvoc(std::uint16_t delay_ms = AGS10MA_TVOC_DELAY_MS)
+    {
+        Result<std::uint32_t> raw = co_await register_read(AGS10MA_TVOC_STAT_REG, delay_ms);
+
+        co_return raw ? Result<Tvoc>::success(ags10::detail::tvoc_decode(*raw))
+                      : Result<Tvoc>::failure(raw.status());
+    }
+
+    Task<Result<std::uint8_t>> version()
+    {
+        Result<std::uint32_t> raw = co_await register_read(AGS10MA_VERSION_REG, AGS10MA_VERSION_DELAY_MS);
+
+        co_return raw ? Result<std::uint8_t>::success(static_cast<std::uint8_t>(*raw))
+                      : Result<std::uint8_t>::failure(raw.status());
+    }
+
+    Task<Result<std::uint32_t>> resistance()
+    {
+        co_return co_await register_read(AGS10MA_GAS_RES_REG, AGS10MA_ACCESS_DELAY_MS);
+    }
+
+private:
+    Loop &loop_;
+    std::uint8_t address_;
+};
+
+} // namespace ags10::co
+
+#endif /* INC_AGS10_CO_HPP_ */
@@ -0,0 +1,389 @@
+/**
+ * @file ags10_fleet.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_fleet.h"
+
+#include <sched.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static bool fleet_stopping(const AGS10_FleetTypeDef *p_fleet)
+{
+    return atomic_load_explicit(&p_fleet->stop, memory_order_relaxed);
+}
+
+static uint32_t bus_tick_ms(const AGS10_FleetBusTypeDef *p_bus)
+{
+    const AGS10_HandleTypeDef *ph_sensor = &p_bus->p_sensors[0];
+
+    return ph_sensor->p_bus_ops->get_tick_ms(ph_sensor->p_bus_ctx);
+}
+
+/* Sleeps on the bus's own delay op, so a simulated bus runs on virtual time. */
+static void bus_sleep(const AGS10_FleetBusTypeDef *p_bus, uint32_t ms)
+{
+    const AGS10_HandleTypeDef *ph_sensor = &p_bus->p_sensors[0];
+
+    while ((ms > 0) && !fleet_stopping(p_bus->p_fleet))
+    {
+        uint32_t slice_ms = (ms < AGS10_FLEET_SLEEP_SLICE_MS) ? ms : AGS10_FLEET_SLEEP_SLICE_MS;
+
+        ph_sensor->p_bus_ops->delay(ph_sensor->p_bus_ctx, (uint16_t)slice_ms);
+        ms -= slice_ms;
+    }
+}
+
+static bool bus_round(AGS10_FleetBusTypeDef *p_bus)
+{
+    AGS10_SchedTypeDef *p_sched = &p_bus->sched;
+
+    (void)ags10_sched_round_start(p_sched);
+
+    while (!ags10_sched_poll(p_sched))
+    {
+        if (fleet_stopping(p_bus->p_fleet))
+        {
+            for (uint16_t idx = 0; idx < p_bus->count; idx++)
+            {
+                ags10_register_read_abort(&p_bus->p_sensors[idx]);
+            }
+            return false;
+        }
+
+        uint32_t wait_ms = ags10_sched_next_due_ms(p_sched);
+
+        bus_sleep(p_bus, (0U != wait_ms) ? wait_ms : 1U);
+    }
+
+    if (p_sched->last_round_ms > p_bus->round_max_ms)
+    {
+        p_bus->round_max_ms = p_sched->last_round_ms;
+    }
+
+    return true;
+}
+
+static void bus_publish(AGS10_FleetBusTypeDef *p_bus)
+{
+    for (uint16_t idx = 0; idx < p_bus->count; idx++)
+    {
+        const AGS10_SchedResultTypeDef *p_result = &p_bus->p_results[idx];
+        AGS10_FleetSampleTypeDef sample = {
+            .t_ms   = p_result->done_ms,
+            .value  = p_result->value,
+            .bus    = p_bus->index,
+            .sensor = idx,
+            .addr   = p_bus->p_sensors[idx].i2c_addr,
+            .status = p_result->status,
+        };
+
+        if (AGS10_OK == p_result->status)
+        {
+            p_bus->samples++;
+        }
+        else
+        {
+            p_bus->failures++;
+        }
+
+        while (!ags10_fleet_queue_push(&p_bus->p_fleet->queue, &sample))
+        {
+            if (!p_bus->p_fleet->lossless || fleet_stopping(p_bus->p_fleet))
+            {
+                p_bus->dropped++;
+                break;
+            }
+            sched_yield();
+        }
+    }
+}
+
+static void *bus_worker(void *p_arg)
+{
+    AGS10_FleetBusTypeDef *p_bus = (AGS10_FleetBusTypeDef *)p_arg;
+    AGS10_FleetTypeDef *p_fleet = p_bus->p_fleet;
+    uint32_t slot_ms = bus_tick_ms(p_bus);
+
+    while (!fleet_stopping(p_fleet) && ((0U == p_fleet->rounds) || (p_bus->rounds < p_fleet->rounds)))
+    {
+        uint32_t now_ms = bus_tick_ms(p_bus);
+        int32_t early_ms = (int32_t)(slot_ms - now_ms);
+
+        if (early_ms > 0)
+        {
+            bus_sleep(p_bus, (uint32_t)early_ms);
+            continue;
+        }
+
+        uint32_t late_ms = now_ms - slot_ms;
+
+        if (late_ms >= p_fleet->period_ms)
+        {
+            // a whole slot was missed; start a new schedule from here
+            p_bus->overruns++;
+            slot_ms = now_ms;
+        }
+        else
+        {
+            p_bus->jitter_sum_ms += late_ms;
+            if (late_ms > p_bus->jitter_max_ms)
+            {
+                p_bus->jitter_max_ms = late_ms;
+            }
+        }
+
+        if (!bus_round(p_bus))
+        {
+            break;
+        }
+
+        bus_publish(p_bus);
+        p_bus->rounds++;
+        slot_ms += p_fleet->period_ms;
+    }
+
+    atomic_fetch_sub_explicit(&p_fleet->running, 1U, memory_order_release);
+
+    return NULL;
+}
+
+static void *scan_worker(void *p_arg)
+{
+    (void)ags10_scan_bus((AGS10_ScanBusTypeDef *)p_arg);
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+bool ags10_fleet_bus_init(AGS10_FleetBusTypeDef *p_bus,
+                          AGS10_HandleTypeDef *p_sensors,
+                          AGS10_SchedResultTypeDef *p_results,
+                          uint16_t count)
+{
+    if ((NULL == p_bus) || (NULL == p_sensors) || (NULL == p_results) || (0 == count) ||
+        (NULL == p_sensors[0].p_bus_ops) || (NULL == p_sensors[0].p_bus_ops->get_tick_ms))
+    {
+        return false;
+    }
+
+    memset(p_bus, 0, sizeof(*p_bus));
+    p_bus->p_sensors = p_sensors;
+    p_bus->p_results = p_results;
+    p_bus->count = count;
+
+    return ags10_sched_init(&p_bus->sched, p_sensors, p_results, count,
+                            AGS10MA_TVOC_STAT_REG, AGS10MA_ACCESS_DELAY_MS,
+                            p_sensors[0].p_bus_ops->get_tick_ms, p_sensors[0].p_bus_ctx);
+}
+
+bool ags10_fleet_init(AGS10_FleetTypeDef *p_fleet,
+                      AGS10_FleetBusTypeDef *p_buses,
+                      uint16_t bus_count,
+                      uint32_t period_ms,
+                      uint32_t rounds)
+{
+    if ((NULL == p_fleet) || (NULL == p_buses) || (0 == bus_count) || (0U == period_ms))
+    {
+        return false;
+    }
+
+    p_fleet->p_buses = p_buses;
+    p_fleet->bus_count = bus_count;
+    p_fleet->period_ms = period_ms;
+    p_fleet->rounds = rounds;
+    p_fleet->lossless = false;
+    p_fleet->started = 0;
+    atomic_init(&p_fleet->stop, false);
+    atomic_init(&p_fleet->running, 0U);
+
+    AGS10_FleetQueueTypeDef *p_queue = &p_fleet->queue;
+
+    for (uint32_t idx = 0; idx < AGS10_FLEET_QUEUE_LEN; idx++)
+    {
+        atomic_init(&p_queue->slots[idx].seq, idx);
+    }
+    atomic_init(&p_queue->tail, 0U);
+    p_queue->head = 0;
+
+    for (uint16_t idx = 0; idx < bus_count; idx++)
+    {
+        p_buses[idx].p_fleet = p_fleet;
+        p_buses[idx].index = idx;
+    }
+
+    return true;
+}
+
+bool ags10_fleet_start(AGS10_FleetTypeDef *p_fleet)
+{
+    atomic_store(&p_fleet->running, p_fleet->bus_count);
+
+    for (uint16_t idx = 0; idx < p_fleet->bus_count; idx++)
+    {
+        AGS10_FleetBusTypeDef *p_bus = &p_fleet->p_buses[idx];
+
+        if (0 != pthread_create(&p_bus->thread, NULL, bus_worker, p_bus))
+        {
+            atomic_fetch_sub(&p_fleet->running, (unsigned)(p_fleet->bus_count - idx));
+            ags10_fleet_stop(p_fleet);
+            ags10_fleet_join(p_fleet);
+            return false;
+        }
+
+        p_fleet->started++;
+    }
+
+    return true;
+}
+
+void ags10_fleet_stop(AGS10_FleetTypeDef *p_fleet)
+{
+    atomic_store(&p_fleet->stop, true);
+}
+
+void ags10_fleet_join(AGS10_FleetTypeDef *p_fleet)
+{
+    for (uint16_t idx = 0; idx < p_fleet->started; idx++)
+    {
+        (void)pthread_join(p_fleet->p_buses[idx].thread, NULL);
+    }
+
+    p_fleet->started = 0;
+}
+
+uint16_t ags10_fleet_scan(AGS10_ScanBusTypeDef *p_scans, uint16_t count)
+{
+    pthread_t threads[AGS10_FLEET_SCAN_THREADS];
+    bool started[AGS10_FLEET_SCAN_THREADS];
+    uint16_t found = 0;
+
+    for (uint16_t first = 0; first < count; first += AGS10_FLEET_SCAN_THREADS)
+    {
+        uint16_t batch = (uint16_t)(count - first);
+
+        if (batch > AGS10_FLEET_SCAN_THREADS)
+        {
+            batch = AGS10_FLEET_SCAN_THREADS;
+        }
+
+        for (uint16_t idx = 0; idx < batch; idx++)
+        {
+            started[idx] = (0 == pthread_create(&threads[idx], NULL, scan_worker, &p_scans[first + idx]));
+            if (!started[idx])
+            {
+                (void)scan_worker(&p_scans[first + idx]);
+            }
+        }
+
+        for (uint16_t idx = 0; idx < batch; idx++)
+        {
+            if (started[idx])
+            {
+                (void)pthread_join(threads[idx], NULL);
+            }
+            found += p_scans[first + idx].found;
+        }
+    }
+
+    return found;
+}
+
+bool ags10_fleet_queue_push(AGS10_FleetQueueTypeDef *p_queue, const AGS10_FleetSampleTypeDef *p_sample)
+{
+    uint_fast32_t pos = atomic_load_explicit(&p_queue->tail, memory_order_relaxed);
+
+    for (;;)
+    {
+        uint_fast32_t seq = atomic_load_explicit(&p_queue->slots[pos % AGS10_FLEET_QUEUE_LEN].seq,
+                                                 memory_order_acquire);
+        int32_t diff = (int32_t)((uint32_t)seq - (uint32_t)pos);
+
+        if (0 == diff)
+        {
+            // slot free for this lap; claim it, or retry from whatever tail a competitor left
+            if (atomic_compare_exchange_weak_explicit(&p_queue->tail, &pos, pos + 1U,
+                                                      memory_order_relaxed, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // the consumer has not freed this slot from the previous lap
+            return false;
+        }
+        else
+        {
+            pos = atomic_load_explicit(&p_queue->tail, memory_order_relaxed);
+        }
+    }
+
+    p_queue->slots[pos % AGS10_FLEET_QUEUE_LEN].sample = *p_sample;
+    atomic_store_explicit(&p_queue->slots[pos % AGS10_FLEET_QUEUE_LEN].seq, pos + 1U, memory_order_release);
+
+    return true;
+}
+
+bool ags10_fleet_queue_pop(AGS10_FleetQueueTypeDef *p_queue, AGS10_FleetSampleTypeDef *p_sample)
+{
+    uint32_t pos = p_queue->head;
+    uint_fast32_t seq = atomic_load_explicit(&p_queue->slots[pos % AGS10_FLEET_QUEUE_LEN].seq,
+                                             memory_order_acquire);
+
+    if ((uint32_t)seq != (pos + 1U))
+    {
+        return false;
+    }
+
+    *p_sample = p_queue->slots[pos % AGS10_FLEET_QUEUE_LEN].sample;
+    atomic_store_explicit(&p_queue->slots[pos % AGS10_FLEET_QUEUE_LEN].seq, pos + AGS10_FLEET_QUEUE_LEN,
+                          memory_order_release);
+    p_queue->head = pos + 1U;
+
+    return true;
+}
+
+uint64_t ags10_fleet_consume(AGS10_FleetTypeDef *p_fleet, AGS10_FleetSinkFn sink, void *p_ctx)
+{
+    const struct timespec idle = { .tv_sec = 0, .tv_nsec = AGS10_FLEET_IDLE_US * 1000L };
+    AGS10_FleetSampleTypeDef sample;
+    uint64_t consumed = 0;
+
+    for (;;)
+    {
+        // read before popping: once it is 0, every sample has been published
+        bool finished = (0U == atomic_load_explicit(&p_fleet->running, memory_order_acquire));
+
+        if (ags10_fleet_queue_pop(&p_fleet->queue, &sample))
+        {
+            sink(p_ctx, &sample);
+            consumed++;
+            continue;
+        }
+
+        if (finished)
+        {
+            break;
+        }
+
+        nanosleep(&idle, NULL);
+    }
+
+    return consumed;
+}
+// eof
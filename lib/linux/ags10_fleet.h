@@ -0,0 +1,250 @@
+/**
+ * @file ags10_fleet.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Multi-bus AGS10 polling with a worker thread per I2C adapter.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_FLEET_H_
+#define INC_AGS10_FLEET_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "ags10.h"
+#include "ags10_sched.h"
+#include "ags10_scan.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define AGS10_FLEET_QUEUE_LEN          4096U   /**< Power of two. */
+#define AGS10_FLEET_SLEEP_SLICE_MS     100U    /**< Longest sleep between stop checks. */
+#define AGS10_FLEET_IDLE_US            1000U   /**< Consumer back-off on an empty queue. */
+#define AGS10_FLEET_SCAN_THREADS       16U     /**< Buses scanned at once by ags10_fleet_scan(). */
+
+/*******************************************************************************/
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+/**
+ * @brief One TVOC reading, as handed from a worker to the consumer.
+ */
+typedef struct {
+    uint32_t t_ms;              /**< Bus tick when the frame was collected. */
+    uint32_t value;             /**< Raw register value, valid if status is AGS10_OK. */
+    uint16_t bus;               /**< Index into the fleet's bus array. */
+    uint16_t sensor;            /**< Index into that bus's sensor array. */
+    uint8_t addr;
+    uint8_t status;             /**< AGS10_StatusTypeDef of the read. */
+} AGS10_FleetSampleTypeDef;
+
+/**
+ * @brief Bounded lock-free multi-producer, single-consumer queue.
+ *
+ * Each slot carries a sequence number: producers claim a slot with a CAS on
+ * tail and publish it by advancing its sequence, the consumer owns head
+ * alone.
+ */
+typedef struct {
+    struct {
+        atomic_uint_fast32_t seq;
+        AGS10_FleetSampleTypeDef sample;
+    } slots[AGS10_FLEET_QUEUE_LEN];
+    atomic_uint_fast32_t tail;
+    uint32_t head;
+} AGS10_FleetQueueTypeDef;
+
+struct AGS10_FleetTypeDef;
+
+/**
+ * @brief One I2C adapter and the sensors on it, driven by its own thread.
+ *
+ * Sensors must be initialised with ags10_init() on bus ops that provide
+ * get_tick_ms; the worker sleeps through the first sensor's delay op.
+ * Rounds are pipelined by ags10_sched: all pointers go out back to back and
+ * the conversions overlap.
+ *
+ * Cadence jitter is the lateness of each round start against its slot
+ * (first round start + n * period). A round that misses a whole slot is
+ * counted as an overrun and the schedule restarts from it.
+ */
+typedef struct {
+    AGS10_HandleTypeDef *p_sensors;
+    AGS10_SchedResultTypeDef *p_results;
+    uint16_t count;
+
+    /* Owned by the worker */
+    struct AGS10_FleetTypeDef *p_fleet;
+    uint16_t index;
+    pthread_t thread;
+    AGS10_SchedTypeDef sched;
+
+    /* Statistics, written by the worker, read them after ags10_fleet_join() */
+    uint32_t rounds;
+    uint32_t samples;
+    uint32_t failures;
+    uint32_t overruns;
+    uint32_t dropped;           /**< Samples lost to a full queue. */
+    uint32_t jitter_max_ms;
+    uint64_t jitter_sum_ms;
+    uint32_t round_max_ms;      /**< Longest pointer-to-last-frame time. */
+} AGS10_FleetBusTypeDef;
+
+/**
+ * @brief A set of buses polled at a common period.
+ *
+ * A worker that finds the queue full drops the sample rather than stall its
+ * cadence behind a slow consumer. Simulated buses run on virtual time and
+ * outpace any consumer, so set lossless for them: the worker then yields
+ * until there is space.
+ */
+typedef struct AGS10_FleetTypeDef {
+    AGS10_FleetBusTypeDef *p_buses;
+    uint16_t bus_count;
+    uint32_t period_ms;
+    uint32_t rounds;            /**< Rounds per bus, 0 to run until stopped. */
+    bool lossless;              /**< Wait for queue space instead of dropping. */
+
+    AGS10_FleetQueueTypeDef queue;
+    atomic_bool stop;
+    atomic_uint running;        /**< Workers not yet finished. */
+    uint16_t started;           /**< Threads to join. */
+} AGS10_FleetTypeDef;
+
+/**
+ * @brief Consumer callback, see ags10_fleet_consume().
+ *
+ * @param[in] p_ctx Context given to ags10_fleet_consume().
+ * @param[in] p_sample Sample, valid for the duration of the call.
+ */
+typedef void (*AGS10_FleetSinkFn)(void *p_ctx, const AGS10_FleetSampleTypeDef *p_sample);
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+
+/**
+ * @brief Describe one bus.
+ *
+ * @param[out] p_bus Bus to initialise.
+ * @param[in] p_sensors Array of count initialised sensor handles.
+ * @param[out] p_results Array of count result slots.
+ * @param[in] count Number of sensors, at least one.
+ *
+ * @retval true  Bus ready.
+ * @retval false Invalid arguments, or the sensors' bus has no get_tick_ms.
+ */
+bool ags10_fleet_bus_init(AGS10_FleetBusTypeDef *p_bus,
+                          AGS10_HandleTypeDef *p_sensors,
+                          AGS10_SchedResultTypeDef *p_results,
+                          uint16_t count);
+
+/**
+ * @brief Initialise a fleet over an array of buses.
+ *
+ * The fleet holds the queue, so it is large (about 100 kB); give it static
+ * or heap storage.
+ *
+ * @param[out] p_fleet Fleet to initialise.
+ * @param[in] p_buses Array of bus_count buses, see ags10_fleet_bus_init().
+ * @param[in] bus_count Number of buses.
+ * @param[in] period_ms Round period of every bus.
+ * @param[in] rounds Rounds per bus before its worker ends, 0 for no limit.
+ *                   lossless starts false.
+ *
+ * @retval true  Fleet ready.
+ * @retval false Invalid arguments.
+ */
+bool ags10_fleet_init(AGS10_FleetTypeDef *p_fleet,
+                      AGS10_FleetBusTypeDef *p_buses,
+                      uint16_t bus_count,
+                      uint32_t period_ms,
+                      uint32_t rounds);
+
+/**
+ * @brief Start one worker thread per bus.
+ *
+ * @param[in,out] p_fleet Fleet.
+ *
+ * @retval true  All workers started.
+ * @retval false A thread could not be created; the started ones are stopped and joined.
+ */
+bool ags10_fleet_start(AGS10_FleetTypeDef *p_fleet);
+
+/**
+ * @brief Ask every worker to finish, at the latest one sleep slice later.
+ *
+ * Safe to call from a signal handler.
+ *
+ * @param[in,out] p_fleet Fleet.
+ */
+void ags10_fleet_stop(AGS10_FleetTypeDef *p_fleet);
+
+/**
+ * @brief Wait for every worker thread to end.
+ *
+ * @param[in,out] p_fleet Fleet.
+ */
+void ags10_fleet_join(AGS10_FleetTypeDef *p_fleet);
+
+/**
+ * @brief Push a sample; producer side, any thread.
+ *
+ * @param[in,out] p_queue Queue.
+ * @param[in] p_sample Sample to copy in.
+ *
+ * @retval true  Queued.
+ * @retval false Queue full, nothing queued.
+ */
+bool ags10_fleet_queue_push(AGS10_FleetQueueTypeDef *p_queue, const AGS10_FleetSampleTypeDef *p_sample);
+
+/**
+ * @brief Pop the oldest sample; consumer side, one thread only.
+ *
+ * @param[in,out] p_queue Queue.
+ * @param[out] p_sample Sample copied out.
+ *
+ * @retval true  A sample was popped.
+ * @retval false Queue empty.
+ */
+bool ags10_fleet_queue_pop(AGS10_FleetQueueTypeDef *p_queue, AGS10_FleetSampleTypeDef *p_sample);
+
+/**
+ * @brief Hand every sample to sink until all workers have ended.
+ *
+ * Runs on the calling thread, which becomes the single consumer. Sleeps
+ * AGS10_FLEET_IDLE_US whenever the queue is empty.
+ *
+ * @param[in,out] p_fleet Started fleet.
+ * @param[in] sink Called once per sample, in queue order.
+ * @param[in] p_ctx Context passed to sink.
+ *
+ * @return Number of samples consumed.
+ */
+uint64_t ags10_fleet_consume(AGS10_FleetTypeDef *p_fleet, AGS10_FleetSinkFn sink, void *p_ctx);
+
+/**
+ * @brief Discover the AGS10s on several adapters at once.
+ *
+ * Runs ags10_scan_bus() for every scan, each on its own thread, up to
+ * AGS10_FLEET_SCAN_THREADS at a time, so the buses are probed in parallel
+ * and the whole scan takes about as long as the slowest bus. A scan whose
+ * thread cannot be created runs on the calling thread. Call it before
+ * ags10_fleet_start(): the scans use the buses without the workers.
+ *
+ * @param[in,out] p_scans Array of count scans, see ags10_scan_bus_init().
+ * @param[in] count Number of buses.
+ *
+ * @return AGS10s found on all buses.
+ */
+uint16_t ags10_fleet_scan(AGS10_ScanBusTypeDef *p_scans, uint16_t count);
+
+#endif /* INC_AGS10_FLEET_H_ */
@@ -0,0 +1,317 @@
+/**
+ * @file ags10_fleetd.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Fleet polling daemon: TVOC from many AGS10s on many i2c-dev adapters.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Usage:
+ *   ags10_fleetd [-p period_ms] [-n rounds] /dev/i2c-1:0x1a,0x1b /dev/i2c-3 ...
+ *   ags10_fleetd [-p period_ms] [-n rounds] -s buses:sensors
+ *
+ * Samples go to stdout as CSV (t_ms,bus,addr,status,tvoc_ppb), the per-bus
+ * summary to stderr on exit. An adapter given without addresses is
+ * scanned for AGS10s first, all such adapters in parallel, and the scan
+ * report goes to stderr. -s runs on simulated buses in virtual time,
+ * already past preheat. SIGINT/SIGTERM stop the workers.
+ */
+#include "ags10_fleet.h"
+#include "ags10_linux.h"
+#include "ags10_sim.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define FLEETD_PERIOD_MS            2000U
+#define FLEETD_MAX_SENSORS          112U    /**< 0x08..0x77 */
+#define FLEETD_SIM_FIRST_ADDR       0x08U
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+typedef struct {
+    AGS10_HandleTypeDef sensors[FLEETD_MAX_SENSORS];
+    AGS10_SchedResultTypeDef results[FLEETD_MAX_SENSORS];
+    uint16_t count;
+    AGS10_LinuxBusTypeDef linux_bus;
+    AGS10_SimBusTypeDef sim_bus;
+    AGS10_SimDeviceTypeDef sim_devices[FLEETD_MAX_SENSORS];
+    bool scan;                  /**< No addresses given, discover them. */
+} FLEETD_BusTypeDef;
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static AGS10_FleetTypeDef fleet;
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    ags10_fleet_stop(&fleet);
+}
+
+static void sample_print(void *p_ctx, const AGS10_FleetSampleTypeDef *p_sample)
+{
+    FILE *p_out = (FILE *)p_ctx;
+
+    if (AGS10_OK == p_sample->status)
+    {
+        fprintf(p_out, "%u,%u,0x%02x,0,%u\n", p_sample->t_ms, p_sample->bus, p_sample->addr,
+                p_sample->value & AGS10MA_TVOC_MSK);
+    }
+    else
+    {
+        fprintf(p_out, "%u,%u,0x%02x,%u,\n", p_sample->t_ms, p_sample->bus, p_sample->addr,
+                p_sample->status);
+    }
+}
+
+static bool bus_sim_setup(FLEETD_BusTypeDef *p_bus, uint16_t index, uint16_t count)
+{
+    p_bus->count = count;
+    ags10_sim_bus_init(&p_bus->sim_bus, p_bus->sim_devices, count, 0);
+
+    for (uint16_t idx = 0; idx < count; idx++)
+    {
+        uint8_t addr = (uint8_t)(FLEETD_SIM_FIRST_ADDR + idx);
+
+        ags10_sim_device_init(&p_bus->sim_devices[idx], addr);
+        p_bus->sim_devices[idx].tvoc_ppb = (1000U * index) + idx;
+        ags10_init(&p_bus->sensors[idx], addr, &ags10_sim_bus_ops, &p_bus->sim_bus);
+    }
+
+    ags10_sim_advance_us(&p_bus->sim_bus, (uint64_t)AGS10_SIM_PREHEAT_MS * 1000U);
+
+    return true;
+}
+
+/* "/dev/i2c-1:0x1a,0x1b", or "/dev/i2c-1" to scan */
+static bool bus_linux_setup(FLEETD_BusTypeDef *p_bus, char *p_spec)
+{
+    char *p_addrs = strchr(p_spec, ':');
+
+    if (NULL != p_addrs)
+    {
+        *p_addrs++ = '\0';
+    }
+
+    if (AGS10_OK != ags10_linux_open(&p_bus->linux_bus, p_spec, NULL, NULL))
+    {
+        fprintf(stderr, "%s: %s\n", p_spec, strerror(p_bus->linux_bus.last_errno));
+        return false;
+    }
+
+    if (NULL == p_addrs)
+    {
+        p_bus->scan = true;
+        return true;
+    }
+
+    for (char *p_tok = strtok(p_addrs, ","); NULL != p_tok; p_tok = strtok(NULL, ","))
+    {
+        unsigned long addr = strtoul(p_tok, NULL, 0);
+
+        if ((FLEETD_MAX_SENSORS <= p_bus->count) || (0x7FU < addr))
+        {
+            fprintf(stderr, "%s: bad or too many addresses\n", p_spec);
+            return false;
+        }
+
+        ags10_init(&p_bus->sensors[p_bus->count++], (uint8_t)addr, &ags10_linux_bus_ops, &p_bus->linux_bus);
+    }
+
+    return (0 < p_bus->count);
+}
+
+/* Scans every bus that was given without addresses and adds what it finds. */
+static bool bus_linux_discover(FLEETD_BusTypeDef *p_buses, uint16_t bus_count, char **pp_specs)
+{
+    AGS10_ScanBusTypeDef *p_scans = calloc(bus_count, sizeof(*p_scans));
+    AGS10_ScanDeviceTypeDef *p_found = calloc((size_t)bus_count * FLEETD_MAX_SENSORS, sizeof(*p_found));
+    uint16_t *p_index = calloc(bus_count, sizeof(*p_index));
+    uint16_t count = 0;
+    bool ok = (NULL != p_scans) && (NULL != p_found) && (NULL != p_index);
+
+    for (uint16_t idx = 0; ok && (idx < bus_count); idx++)
+    {
+        if (p_buses[idx].scan)
+        {
+            (void)ags10_scan_bus_init(&p_scans[count], &ags10_linux_bus_ops, &p_buses[idx].linux_bus,
+                                      &p_found[(size_t)count * FLEETD_MAX_SENSORS], FLEETD_MAX_SENSORS);
+            p_index[count++] = idx;
+        }
+    }
+
+    if (ok && (0 != count))
+    {
+        (void)ags10_fleet_scan(p_scans, count);
+        fprintf(stderr, "bus device probes acked rejected found status probe_ms confirm_ms\n");
+    }
+
+    for (uint16_t idx = 0; ok && (idx < count); idx++)
+    {
+        const AGS10_ScanBusTypeDef *p_scan = &p_scans[idx];
+        FLEETD_BusTypeDef *p_bus = &p_buses[p_index[idx]];
+
+        fprintf(stderr, "%3u %s %6u %5u %8u %5u %6u %8u %10u\n",
+                p_index[idx], pp_specs[p_index[idx]], p_scan->probes, p_scan->acked, p_scan->rejected,
+                p_scan->found, p_scan->last_status, p_scan->probe_ms, p_scan->confirm_ms);
+
+        for (uint16_t dev = 0; dev < p_scan->found; dev++)
+        {
+            ags10_init(&p_bus->sensors[p_bus->count++], p_scan->p_found[dev].addr,
+                       &ags10_linux_bus_ops, &p_bus->linux_bus);
+        }
+
+        if (0 == p_bus->count)
+        {
+            fprintf(stderr, "%s: no AGS10 found\n", pp_specs[p_index[idx]]);
+            ok = false;
+        }
+    }
+
+    free(p_index);
+    free(p_found);
+    free(p_scans);
+
+    return ok;
+}
+
+static void summary_print(const AGS10_FleetTypeDef *p_fleet)
+{
+    fprintf(stderr, "bus sensors rounds samples failures dropped overruns jitter_avg_ms jitter_max_ms round_max_ms\n");
+
+    for (uint16_t idx = 0; idx < p_fleet->bus_count; idx++)
+    {
+        const AGS10_FleetBusTypeDef *p_bus = &p_fleet->p_buses[idx];
+        uint32_t on_time = p_bus->rounds - p_bus->overruns;
+
+        fprintf(stderr, "%3u %7u %6u %7u %8u %7u %8u %13.2f %13u %12u\n",
+                idx, p_bus->count, p_bus->rounds, p_bus->samples, p_bus->failures, p_bus->dropped, p_bus->overruns,
+                (0U != on_time) ? ((double)p_bus->jitter_sum_ms / on_time) : 0.0,
+                p_bus->jitter_max_ms, p_bus->round_max_ms);
+    }
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    uint32_t period_ms = FLEETD_PERIOD_MS;
+    uint32_t rounds = 0;
+    unsigned sim_buses = 0;
+    unsigned sim_sensors = 0;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "p:n:s:")))
+    {
+        switch (opt)
+        {
+        case 'p':
+            period_ms = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'n':
+            rounds = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            if ((2 != sscanf(optarg, "%u:%u", &sim_buses, &sim_sensors)) ||
+                (0U == sim_sensors) || (FLEETD_MAX_SENSORS < sim_sensors))
+            {
+                fprintf(stderr, "-s buses:sensors, 1..%u sensors per bus\n", FLEETD_MAX_SENSORS);
+                return EXIT_FAILURE;
+            }
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-p period_ms] [-n rounds] (-s buses:sensors | dev[:addr,...] ...)\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    uint16_t bus_count = (uint16_t)((0U != sim_buses) ? sim_buses : (unsigned)(argc - optind));
+
+    if (0 == bus_count)
+    {
+        fprintf(stderr, "no buses given\n");
+        return EXIT_FAILURE;
+    }
+
+    FLEETD_BusTypeDef *p_buses = calloc(bus_count, sizeof(*p_buses));
+    AGS10_FleetBusTypeDef *p_fleet_buses = calloc(bus_count, sizeof(*p_fleet_buses));
+
+    if ((NULL == p_buses) || (NULL == p_fleet_buses))
+    {
+        fprintf(stderr, "out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    for (uint16_t idx = 0; idx < bus_count; idx++)
+    {
+        bool ok = (0U != sim_buses) ? bus_sim_setup(&p_buses[idx], idx, (uint16_t)sim_sensors)
+                                    : bus_linux_setup(&p_buses[idx], argv[optind + idx]);
+
+        if (!ok)
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    if ((0U == sim_buses) && !bus_linux_discover(p_buses, bus_count, &argv[optind]))
+    {
+        return EXIT_FAILURE;
+    }
+
+    for (uint16_t idx = 0; idx < bus_count; idx++)
+    {
+        if (!ags10_fleet_bus_init(&p_fleet_buses[idx], p_buses[idx].sensors,
+                                  p_buses[idx].results, p_buses[idx].count))
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!ags10_fleet_init(&fleet, p_fleet_buses, bus_count, period_ms, rounds))
+    {
+        fprintf(stderr, "invalid period\n");
+        return EXIT_FAILURE;
+    }
+    fleet.lossless = (0U != sim_buses);
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    if (!ags10_fleet_start(&fleet))
+    {
+        fprintf(stderr, "cannot start workers\n");
+        return EXIT_FAILURE;
+    }
+
+    (void)ags10_fleet_consume(&fleet, sample_print, stdout);
+    ags10_fleet_join(&fleet);
+    fflush(stdout);
+    summary_print(&fleet);
+
+    for (uint16_t idx = 0; (0U == sim_buses) && (idx < bus_count); idx++)
+    {
+        ags10_linux_close(&p_buses[idx].linux_bus);
+    }
+
+    free(p_fleet_buses);
+    free(p_buses);
+
+    return EXIT_SUCCESS;
+}
+// eof
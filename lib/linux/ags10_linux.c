@@ -0,0 +1,314 @@
+/**
+ * @file ags10_linux.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_linux.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static int sys_open(void *p_ctx, const char *p_path)
+{
+    (void)p_ctx;
+    return open(p_path, O_RDWR | O_CLOEXEC);
+}
+
+static int sys_close(void *p_ctx, int fd)
+{
+    (void)p_ctx;
+    return close(fd);
+}
+
+static int sys_ioctl(void *p_ctx, int fd, unsigned long request, void *p_arg)
+{
+    (void)p_ctx;
+    return ioctl(fd, request, p_arg);
+}
+
+static uint64_t sys_clock_ns(void *p_ctx)
+{
+    struct timespec ts;
+
+    (void)p_ctx;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+/* Absolute deadline: a signal restarts the sleep without stretching it. */
+static void sys_sleep_until(void *p_ctx, uint64_t deadline_ns)
+{
+    struct timespec ts = {
+        .tv_sec  = (time_t)(deadline_ns / 1000000000U),
+        .tv_nsec = (long)(deadline_ns % 1000000000U),
+    };
+
+    (void)p_ctx;
+    while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL))
+    {
+    }
+}
+
+static AGS10_StatusTypeDef bus_transfer(AGS10_LinuxBusTypeDef *p_bus, struct i2c_msg *p_msgs, uint32_t count)
+{
+    struct i2c_rdwr_ioctl_data data = {
+        .msgs  = p_msgs,
+        .nmsgs = count,
+    };
+
+    p_bus->syscalls++;
+    p_bus->transfers++;
+    if (0 > p_bus->p_sys->ioctl(p_bus->p_sys_ctx, p_bus->fd, I2C_RDWR, &data))
+    {
+        p_bus->errors++;
+        p_bus->last_errno = errno;
+        return ags10_linux_errno_status(p_bus->last_errno);
+    }
+
+    return AGS10_OK;
+}
+
+static AGS10_StatusTypeDef bus_flush(AGS10_LinuxBusTypeDef *p_bus)
+{
+    if (!p_bus->deferred)
+    {
+        return AGS10_OK;
+    }
+
+    struct i2c_msg msg = {
+        .addr  = p_bus->deferred_addr,
+        .flags = 0,
+        .len   = 1,
+        .buf   = &p_bus->deferred_reg,
+    };
+
+    p_bus->deferred = false;
+
+    AGS10_StatusTypeDef status = bus_transfer(p_bus, &msg, 1);
+
+    if (AGS10_OK != status)
+    {
+        // reported by the next read from that address, not by whichever transfer flushed it
+        p_bus->flush_status = (uint8_t)status;
+        p_bus->flush_addr = (uint8_t)msg.addr;
+    }
+
+    return status;
+}
+
+static AGS10_StatusTypeDef linux_write(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length)
+{
+    AGS10_LinuxBusTypeDef *p_bus = (AGS10_LinuxBusTypeDef *)p_ctx;
+
+    (void)bus_flush(p_bus);
+    if (addr == p_bus->flush_addr)
+    {
+        // a new pointer for this address supersedes the one that failed
+        p_bus->flush_status = AGS10_OK;
+    }
+
+    if (p_bus->combine && (1U == length))
+    {
+        p_bus->deferred = true;
+        p_bus->deferred_addr = addr;
+        p_bus->deferred_reg = pData[0];
+        return AGS10_OK;
+    }
+
+    struct i2c_msg msg = {
+        .addr  = addr,
+        .flags = 0,
+        .len   = length,
+        .buf   = pData,
+    };
+
+    return bus_transfer(p_bus, &msg, 1);
+}
+
+static AGS10_StatusTypeDef linux_read(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length)
+{
+    AGS10_LinuxBusTypeDef *p_bus = (AGS10_LinuxBusTypeDef *)p_ctx;
+    struct i2c_msg msgs[2] = {
+        {
+            .addr  = p_bus->deferred_addr,
+            .flags = 0,
+            .len   = 1,
+            .buf   = &p_bus->deferred_reg,
+        },
+        {
+            .addr  = addr,
+            .flags = I2C_M_RD,
+            .len   = length,
+            .buf   = pData,
+        },
+    };
+
+    if (p_bus->deferred && (addr == p_bus->deferred_addr))
+    {
+        // pointer write, repeated start and read in one ioctl
+        p_bus->deferred = false;
+        p_bus->merged++;
+        return bus_transfer(p_bus, msgs, 2);
+    }
+
+    (void)bus_flush(p_bus);
+    if ((AGS10_OK != p_bus->flush_status) && (addr == p_bus->flush_addr))
+    {
+        AGS10_StatusTypeDef status = (AGS10_StatusTypeDef)p_bus->flush_status;
+
+        p_bus->flush_status = AGS10_OK;
+        return status;
+    }
+
+    return bus_transfer(p_bus, &msgs[1], 1);
+}
+
+static void linux_delay(void *p_ctx, uint16_t ms)
+{
+    AGS10_LinuxBusTypeDef *p_bus = (AGS10_LinuxBusTypeDef *)p_ctx;
+
+    // the wait is for the sensor, so whatever it waits on goes out first
+    (void)bus_flush(p_bus);
+
+    p_bus->syscalls += 2U;
+    uint64_t now_ns = p_bus->p_sys->clock_ns(p_bus->p_sys_ctx);
+    p_bus->p_sys->sleep_until(p_bus->p_sys_ctx, now_ns + ((uint64_t)ms * 1000000U));
+}
+
+/* The driver reports a failure here itself, so the next read does not. */
+static AGS10_StatusTypeDef linux_flush(void *p_ctx)
+{
+    AGS10_LinuxBusTypeDef *p_bus = (AGS10_LinuxBusTypeDef *)p_ctx;
+    AGS10_StatusTypeDef status = bus_flush(p_bus);
+
+    if (AGS10_OK != status)
+    {
+        p_bus->flush_status = AGS10_OK;
+    }
+
+    return status;
+}
+
+static uint32_t linux_get_tick_ms(void *p_ctx)
+{
+    AGS10_LinuxBusTypeDef *p_bus = (AGS10_LinuxBusTypeDef *)p_ctx;
+
+    p_bus->syscalls++;
+
+    return (uint32_t)(p_bus->p_sys->clock_ns(p_bus->p_sys_ctx) / 1000000U);
+}
+
+/*******************************************************************************
+* Public Variables
+ ******************************************************************************/
+
+const AGS10_BusOpsTypeDef ags10_linux_bus_ops = {
+    .write       = linux_write,
+    .read        = linux_read,
+    .delay       = linux_delay,
+    .get_tick_ms = linux_get_tick_ms,
+    .flush       = linux_flush,
+};
+
+const AGS10_LinuxSysTypeDef ags10_linux_sys = {
+    .open        = sys_open,
+    .close       = sys_close,
+    .ioctl       = sys_ioctl,
+    .clock_ns    = sys_clock_ns,
+    .sleep_until = sys_sleep_until,
+};
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+AGS10_StatusTypeDef ags10_linux_open(AGS10_LinuxBusTypeDef *p_bus,
+                                     const char *p_path,
+                                     const AGS10_LinuxSysTypeDef *p_sys,
+                                     void *p_sys_ctx)
+{
+    if ((NULL == p_bus) || (NULL == p_path))
+    {
+        return AGS10_ERR_PARAM;
+    }
+
+    memset(p_bus, 0, sizeof(*p_bus));
+    p_bus->p_sys = (NULL == p_sys) ? &ags10_linux_sys : p_sys;
+    p_bus->p_sys_ctx = p_sys_ctx;
+
+    p_bus->syscalls++;
+    p_bus->fd = p_bus->p_sys->open(p_bus->p_sys_ctx, p_path);
+    if (0 > p_bus->fd)
+    {
+        p_bus->last_errno = errno;
+        return AGS10_ERR_BUS;
+    }
+
+    unsigned long funcs = 0;
+
+    p_bus->syscalls++;
+    if (0 > p_bus->p_sys->ioctl(p_bus->p_sys_ctx, p_bus->fd, I2C_FUNCS, &funcs))
+    {
+        p_bus->last_errno = errno;
+        ags10_linux_close(p_bus);
+        return AGS10_ERR_BUS;
+    }
+
+    if (0U == (funcs & I2C_FUNC_I2C))
+    {
+        p_bus->last_errno = EOPNOTSUPP;
+        ags10_linux_close(p_bus);
+        return AGS10_ERR_BUS;
+    }
+
+    return AGS10_OK;
+}
+
+void ags10_linux_close(AGS10_LinuxBusTypeDef *p_bus)
+{
+    if ((NULL == p_bus) || (NULL == p_bus->p_sys) || (0 > p_bus->fd))
+    {
+        return;
+    }
+
+    (void)bus_flush(p_bus);
+
+    p_bus->syscalls++;
+    (void)p_bus->p_sys->close(p_bus->p_sys_ctx, p_bus->fd);
+    p_bus->fd = -1;
+}
+
+AGS10_StatusTypeDef ags10_linux_errno_status(int err)
+{
+    switch (err)
+    {
+    case ENXIO:
+    case EREMOTEIO:
+        return AGS10_ERR_NACK;
+    case ETIMEDOUT:
+        return AGS10_ERR_TIMEOUT;
+    case EAGAIN:
+    case EBUSY:
+        return AGS10_ERR_BUSY;
+    default:
+        return AGS10_ERR_BUS;
+    }
+}
+// eof
@@ -0,0 +1,125 @@
+/**
+ * @file ags10_linux.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Linux i2c-dev bus for the AGS10 driver.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_LINUX_H_
+#define INC_AGS10_LINUX_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ags10.h"
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+/**
+ * @brief System calls used by the bus, replaceable for testing.
+ *
+ * Each call follows its POSIX counterpart: -1 and errno on failure. The
+ * clock is CLOCK_MONOTONIC in nanoseconds, and sleep_until() returns once
+ * that clock has reached the deadline.
+ */
+typedef struct {
+    int (*open)(void *p_ctx, const char *p_path);
+    int (*close)(void *p_ctx, int fd);
+    int (*ioctl)(void *p_ctx, int fd, unsigned long request, void *p_arg);
+    uint64_t (*clock_ns)(void *p_ctx);
+    void (*sleep_until)(void *p_ctx, uint64_t deadline_ns);
+} AGS10_LinuxSysTypeDef;
+
+/**
+ * @brief One /dev/i2c-N adapter, shared by every sensor on it.
+ *
+ * Every transfer is one I2C_RDWR ioctl. The address travels in the message,
+ * so unlike read()/write() there is no I2C_SLAVE ioctl per address change
+ * and sensors at different addresses share one file descriptor for free.
+ *
+ * With combine set, a one-byte register pointer write is held back and sent
+ * with the next read from the same address as a single write + read
+ * I2C_RDWR (repeated start). The AGS10 needs AGS10MA_ACCESS_DELAY_MS
+ * between the two, so this only merges reads issued with a zero delay:
+ * the driver flushes the pointer of a read with a delay through the bus
+ * ops' flush, and a blocking delay flushes it too. If a send that no
+ * caller sees fails, the next read from the address reports the error
+ * instead of fetching a frame from the previous register.
+ */
+typedef struct {
+    int fd;
+    const AGS10_LinuxSysTypeDef *p_sys;
+    void *p_sys_ctx;
+    bool combine;               /**< Merge pointer write and read, see above. */
+    bool deferred;              /**< A pointer write is held back. */
+    uint8_t deferred_addr;
+    uint8_t deferred_reg;
+    uint8_t flush_status;       /**< Failed flush of a held-back write, for the next read from flush_addr. */
+    uint8_t flush_addr;
+
+    /* Statistics */
+    uint32_t syscalls;          /**< Every call made through p_sys, sleeps included. */
+    uint32_t transfers;         /**< I2C_RDWR ioctls. */
+    uint32_t merged;            /**< Transfers that carried a pointer write and a read. */
+    uint32_t errors;
+    int last_errno;
+} AGS10_LinuxBusTypeDef;
+
+/*******************************************************************************
+* Public Variables
+ ******************************************************************************/
+/**
+ * @brief Bus ops for ags10_init(); pass the AGS10_LinuxBusTypeDef as context.
+ */
+extern const AGS10_BusOpsTypeDef ags10_linux_bus_ops;
+
+/**
+ * @brief The real system calls, used when ags10_linux_open() gets NULL.
+ */
+extern const AGS10_LinuxSysTypeDef ags10_linux_sys;
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+
+/**
+ * @brief Open an adapter and check that it supports I2C_RDWR.
+ *
+ * @param[out] p_bus Bus to initialise.
+ * @param[in] p_path Device node, e.g. "/dev/i2c-1".
+ * @param[in] p_sys System calls, NULL for ags10_linux_sys.
+ * @param[in] p_sys_ctx Context passed to every p_sys call.
+ *
+ * @return AGS10_OK, AGS10_ERR_PARAM for null arguments, AGS10_ERR_BUS if
+ *         the node cannot be opened or queried (errno in last_errno) or the
+ *         adapter lacks I2C_FUNC_I2C (SMBus-only controllers).
+ */
+AGS10_StatusTypeDef ags10_linux_open(AGS10_LinuxBusTypeDef *p_bus,
+                                     const char *p_path,
+                                     const AGS10_LinuxSysTypeDef *p_sys,
+                                     void *p_sys_ctx);
+
+/**
+ * @brief Send any held-back pointer write and close the adapter.
+ *
+ * @param[in,out] p_bus Bus.
+ */
+void ags10_linux_close(AGS10_LinuxBusTypeDef *p_bus);
+
+/**
+ * @brief Map an errno value from an I2C transfer to a driver status.
+ *
+ * i2c bus drivers report a missing acknowledge as ENXIO or EREMOTEIO.
+ *
+ * @param[in] err errno.
+ *
+ * @return Matching AGS10_StatusTypeDef.
+ */
+AGS10_StatusTypeDef ags10_linux_errno_status(int err);
+
+#endif /* INC_AGS10_LINUX_H_ */
@@ -0,0 +1,189 @@
+/**
+ * @file ags10_linux_fake.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_linux_fake.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define FAKE_FD                 3
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static int status_errno(AGS10_StatusTypeDef status)
+{
+    switch (status)
+    {
+    case AGS10_ERR_NACK:
+        return ENXIO;
+    case AGS10_ERR_BUSY:
+        return EAGAIN;
+    case AGS10_ERR_TIMEOUT:
+        return ETIMEDOUT;
+    default:
+        return EIO;
+    }
+}
+
+static int fake_rdwr(AGS10_LinuxFakeTypeDef *p_fake, const struct i2c_rdwr_ioctl_data *p_data)
+{
+    if ((NULL == p_data) || (0U == p_data->nmsgs) || (I2C_RDWR_IOCTL_MAX_MSGS < p_data->nmsgs))
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    p_fake->rdwr++;
+
+    for (uint32_t idx = 0; idx < p_data->nmsgs; idx++)
+    {
+        const struct i2c_msg *p_msg = &p_data->msgs[idx];
+        AGS10_StatusTypeDef status;
+
+        p_fake->msgs++;
+        if (0U != (p_msg->flags & I2C_M_RD))
+        {
+            status = ags10_sim_bus_ops.read(p_fake->p_sim, (uint8_t)p_msg->addr, p_msg->buf, p_msg->len);
+        }
+        else
+        {
+            status = ags10_sim_bus_ops.write(p_fake->p_sim, (uint8_t)p_msg->addr, p_msg->buf, p_msg->len);
+        }
+
+        if (AGS10_OK != status)
+        {
+            // the kernel aborts the whole transaction at the first failure
+            errno = status_errno(status);
+            return -1;
+        }
+    }
+
+    return (int)p_data->nmsgs;
+}
+
+static int fake_open(void *p_ctx, const char *p_path)
+{
+    AGS10_LinuxFakeTypeDef *p_fake = (AGS10_LinuxFakeTypeDef *)p_ctx;
+
+    (void)p_path;
+    p_fake->opens++;
+    if (p_fake->open)
+    {
+        errno = EBUSY;
+        return -1;
+    }
+
+    p_fake->open = true;
+
+    return FAKE_FD;
+}
+
+static int fake_close(void *p_ctx, int fd)
+{
+    AGS10_LinuxFakeTypeDef *p_fake = (AGS10_LinuxFakeTypeDef *)p_ctx;
+
+    p_fake->closes++;
+    if (!p_fake->open || (FAKE_FD != fd))
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    p_fake->open = false;
+
+    return 0;
+}
+
+static int fake_ioctl(void *p_ctx, int fd, unsigned long request, void *p_arg)
+{
+    AGS10_LinuxFakeTypeDef *p_fake = (AGS10_LinuxFakeTypeDef *)p_ctx;
+
+    p_fake->ioctls++;
+    if (!p_fake->open || (FAKE_FD != fd))
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    switch (request)
+    {
+    case I2C_FUNCS:
+        *(unsigned long *)p_arg = p_fake->funcs;
+        return 0;
+    case I2C_RDWR:
+        if (0U == (p_fake->funcs & I2C_FUNC_I2C))
+        {
+            errno = EOPNOTSUPP;
+            return -1;
+        }
+        return fake_rdwr(p_fake, (const struct i2c_rdwr_ioctl_data *)p_arg);
+    default:
+        errno = ENOTTY;
+        return -1;
+    }
+}
+
+static uint64_t fake_clock_ns(void *p_ctx)
+{
+    AGS10_LinuxFakeTypeDef *p_fake = (AGS10_LinuxFakeTypeDef *)p_ctx;
+
+    p_fake->clock_reads++;
+
+    return p_fake->p_sim->now_us * 1000U;
+}
+
+static void fake_sleep_until(void *p_ctx, uint64_t deadline_ns)
+{
+    AGS10_LinuxFakeTypeDef *p_fake = (AGS10_LinuxFakeTypeDef *)p_ctx;
+    uint64_t deadline_us = (deadline_ns + 999U) / 1000U;
+
+    p_fake->sleeps++;
+    if (deadline_us > p_fake->p_sim->now_us)
+    {
+        ags10_sim_advance_us(p_fake->p_sim, deadline_us - p_fake->p_sim->now_us);
+    }
+}
+
+/*******************************************************************************
+* Public Variables
+ ******************************************************************************/
+
+const AGS10_LinuxSysTypeDef ags10_linux_fake_sys = {
+    .open        = fake_open,
+    .close       = fake_close,
+    .ioctl       = fake_ioctl,
+    .clock_ns    = fake_clock_ns,
+    .sleep_until = fake_sleep_until,
+};
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+void ags10_linux_fake_init(AGS10_LinuxFakeTypeDef *p_fake, AGS10_SimBusTypeDef *p_sim)
+{
+    memset(p_fake, 0, sizeof(*p_fake));
+    p_fake->p_sim = p_sim;
+    p_fake->funcs = I2C_FUNC_I2C;
+}
+
+uint32_t ags10_linux_fake_syscalls(const AGS10_LinuxFakeTypeDef *p_fake)
+{
+    return p_fake->opens + p_fake->closes + p_fake->ioctls + p_fake->clock_reads + p_fake->sleeps;
+}
+// eof
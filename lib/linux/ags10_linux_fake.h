@@ -0,0 +1,77 @@
+/**
+ * @file ags10_linux_fake.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Userspace fake i2c-dev adapter over the AGS10 simulator.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_LINUX_FAKE_H_
+#define INC_AGS10_LINUX_FAKE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ags10_linux.h"
+#include "ags10_sim.h"
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+/**
+ * @brief A fake /dev/i2c-N backed by a simulated bus.
+ *
+ * Passed with ags10_linux_fake_sys to ags10_linux_open(), it runs the same
+ * back end code as the kernel path: I2C_RDWR messages go to the simulated
+ * devices, a NACK fails the ioctl with ENXIO, and the clock and sleeps use
+ * the simulator's virtual time, so a 1 s conversion costs nothing. The
+ * counters give syscalls per sample without a kernel driver.
+ */
+typedef struct {
+    AGS10_SimBusTypeDef *p_sim;
+    unsigned long funcs;        /**< Answer to I2C_FUNCS, I2C_FUNC_I2C by default. */
+    bool open;
+
+    /* Statistics */
+    uint32_t opens;
+    uint32_t closes;
+    uint32_t ioctls;
+    uint32_t rdwr;              /**< I2C_RDWR ioctls. */
+    uint32_t msgs;              /**< Messages carried by them. */
+    uint32_t clock_reads;
+    uint32_t sleeps;
+} AGS10_LinuxFakeTypeDef;
+
+/*******************************************************************************
+* Public Variables
+ ******************************************************************************/
+/**
+ * @brief System calls for ags10_linux_open(); pass the AGS10_LinuxFakeTypeDef as context.
+ */
+extern const AGS10_LinuxSysTypeDef ags10_linux_fake_sys;
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+
+/**
+ * @brief Initialise a fake adapter over a simulated bus.
+ *
+ * @param[out] p_fake Adapter to initialise.
+ * @param[in] p_sim Simulated bus, see ags10_sim_bus_init().
+ */
+void ags10_linux_fake_init(AGS10_LinuxFakeTypeDef *p_fake, AGS10_SimBusTypeDef *p_sim);
+
+/**
+ * @brief System calls made so far, sleeps and clock reads included.
+ *
+ * @param[in] p_fake Adapter.
+ *
+ * @return Sum of all counters.
+ */
+uint32_t ags10_linux_fake_syscalls(const AGS10_LinuxFakeTypeDef *p_fake);
+
+#endif /* INC_AGS10_LINUX_FAKE_H_ */
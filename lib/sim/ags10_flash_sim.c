@@ -0,0 +1,205 @@
+/**
+ * @file ags10_flash_sim.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_flash_sim.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static uint32_t rand_next(AGS10_FlashSimTypeDef *p_flash)
+{
+    // xorshift32, only needs to scatter bits
+    p_flash->seed ^= p_flash->seed << 13;
+    p_flash->seed ^= p_flash->seed >> 17;
+    p_flash->seed ^= p_flash->seed << 5;
+
+    return p_flash->seed;
+}
+
+static bool region_has(const AGS10_FlashSimTypeDef *p_flash, uint32_t addr, uint32_t len)
+{
+    uint32_t size = p_flash->page_size * p_flash->page_count;
+
+    return (addr >= p_flash->base) && ((addr - p_flash->base) <= size) &&
+           (len <= (size - (addr - p_flash->base)));
+}
+
+/* Spend one operation; false once the power is gone. */
+static bool op_start(AGS10_FlashSimTypeDef *p_flash)
+{
+    if (!p_flash->powered)
+    {
+        return false;
+    }
+
+    if (p_flash->cut_armed)
+    {
+        if (0U == p_flash->cut_after)
+        {
+            p_flash->powered = false;
+            p_flash->cut_armed = false;
+            return false;
+        }
+        p_flash->cut_after--;
+    }
+
+    return true;
+}
+
+static bool flash_erase(void *p_ctx, uint32_t addr)
+{
+    AGS10_FlashSimTypeDef *p_flash = (AGS10_FlashSimTypeDef *)p_ctx;
+
+    if (!region_has(p_flash, addr, p_flash->page_size) ||
+        (0U != ((addr - p_flash->base) % p_flash->page_size)))
+    {
+        p_flash->errors++;
+        return false;
+    }
+
+    uint8_t *p_page = &p_flash->p_mem[addr - p_flash->base];
+    uint16_t page = (uint16_t)((addr - p_flash->base) / p_flash->page_size);
+    bool done = op_start(p_flash);
+
+    if (!done && !p_flash->powered)
+    {
+        // cut mid-erase: some bits already set
+        for (uint32_t idx = 0; idx < p_flash->page_size; idx++)
+        {
+            p_page[idx] |= (uint8_t)rand_next(p_flash);
+        }
+    }
+    if (!done)
+    {
+        p_flash->errors++;
+        return false;
+    }
+
+    memset(p_page, 0xFF, p_flash->page_size);
+    p_flash->p_wear[page]++;
+    p_flash->erases++;
+    p_flash->now_us += AGS10_FLASH_SIM_ERASE_US;
+
+    return true;
+}
+
+static bool flash_program(void *p_ctx, uint32_t addr, const uint16_t *p_data, uint32_t count)
+{
+    AGS10_FlashSimTypeDef *p_flash = (AGS10_FlashSimTypeDef *)p_ctx;
+
+    if ((0U != (addr & 1U)) || !region_has(p_flash, addr, count * 2U))
+    {
+        p_flash->errors++;
+        return false;
+    }
+
+    for (uint32_t idx = 0; idx < count; idx++)
+    {
+        uint8_t *p_cell = &p_flash->p_mem[(addr - p_flash->base) + (idx * 2U)];
+        uint16_t old = (uint16_t)(p_cell[0] | ((uint16_t)p_cell[1] << 8));
+        uint16_t value = p_data[idx];
+
+        if (!op_start(p_flash))
+        {
+            if (!p_flash->powered && (AGS10_LOG_ERASED == old))
+            {
+                // cut mid-program: some bits already cleared
+                value |= (uint16_t)rand_next(p_flash);
+                p_cell[0] = (uint8_t)value;
+                p_cell[1] = (uint8_t)(value >> 8);
+            }
+            p_flash->errors++;
+            return false;
+        }
+
+        if ((AGS10_LOG_ERASED != old) && (0U != value))
+        {
+            // PGERR
+            p_flash->errors++;
+            return false;
+        }
+
+        p_cell[0] = (uint8_t)value;
+        p_cell[1] = (uint8_t)(value >> 8);
+        p_flash->programmed++;
+        p_flash->now_us += AGS10_FLASH_SIM_PROGRAM_US;
+    }
+
+    return true;
+}
+
+static void flash_read(void *p_ctx, uint32_t addr, void *p_dst, uint32_t len)
+{
+    AGS10_FlashSimTypeDef *p_flash = (AGS10_FlashSimTypeDef *)p_ctx;
+
+    if (!region_has(p_flash, addr, len))
+    {
+        memset(p_dst, 0xFF, len);
+        p_flash->errors++;
+        return;
+    }
+
+    memcpy(p_dst, &p_flash->p_mem[addr - p_flash->base], len);
+    p_flash->bytes_read += len;
+    p_flash->read_ns += (uint64_t)((len + 1U) / 2U) * AGS10_FLASH_SIM_READ_NS;
+    p_flash->now_us += p_flash->read_ns / 1000U;
+    p_flash->read_ns %= 1000U;
+}
+
+/*******************************************************************************
+* Public Variables
+ ******************************************************************************/
+
+const AGS10_LogFlashOpsTypeDef ags10_flash_sim_ops = {
+    .erase = flash_erase,
+    .program = flash_program,
+    .read = flash_read,
+};
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+void ags10_flash_sim_init(AGS10_FlashSimTypeDef *p_flash,
+                          uint8_t *p_mem,
+                          uint32_t *p_wear,
+                          uint32_t base,
+                          uint32_t page_size,
+                          uint16_t page_count)
+{
+    memset(p_flash, 0, sizeof(*p_flash));
+    p_flash->p_mem = p_mem;
+    p_flash->p_wear = p_wear;
+    p_flash->base = base;
+    p_flash->page_size = page_size;
+    p_flash->page_count = page_count;
+    p_flash->powered = true;
+    p_flash->seed = 1U;
+
+    memset(p_mem, 0xFF, (size_t)page_size * page_count);
+    memset(p_wear, 0, sizeof(*p_wear) * page_count);
+}
+
+void ags10_flash_sim_cut(AGS10_FlashSimTypeDef *p_flash, uint32_t ops, uint32_t seed)
+{
+    p_flash->cut_after = ops;
+    p_flash->cut_armed = true;
+    p_flash->seed = (0U == seed) ? 1U : seed;
+}
+
+void ags10_flash_sim_power_on(AGS10_FlashSimTypeDef *p_flash)
+{
+    p_flash->powered = true;
+    p_flash->cut_armed = false;
+}
+// eof
@@ -0,0 +1,110 @@
+/**
+ * @file ags10_flash_sim.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Host-side NOR flash emulator with STM32F1 program/erase rules.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_FLASH_SIM_H_
+#define INC_AGS10_FLASH_SIM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ags10_log.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define AGS10_FLASH_SIM_ERASE_US    20000U      /**< Page erase, F103 datasheet typ. */
+#define AGS10_FLASH_SIM_PROGRAM_US  53U         /**< Half-word program, typ. 52.5 us. */
+#define AGS10_FLASH_SIM_READ_NS     42U         /**< Half-word read, 72 MHz and two wait states. */
+/*******************************************************************************/
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+/**
+ * @brief Flash region held in host memory.
+ *
+ * As on the STM32F1, an erase sets a whole page to 0xFF and a half-word can
+ * only be programmed while it reads 0xFFFF, or to 0x0000; anything else is
+ * refused (PGERR) and leaves the cell unchanged. Time is virtual and only
+ * moves with the ops, so mount time is measured the same on every host.
+ *
+ * A power cut can be armed to hit after a number of operations (an erase or
+ * one half-word); the operation it hits leaves random bits behind, and every
+ * later op fails until ags10_flash_sim_power_on().
+ */
+typedef struct {
+    uint8_t *p_mem;
+    uint32_t *p_wear;           /**< Erases per page. */
+    uint32_t base;
+    uint32_t page_size;
+    uint16_t page_count;
+
+    uint32_t cut_after;         /**< Operations left before the cut, if armed. */
+    bool cut_armed;
+    bool powered;
+    uint32_t seed;
+
+    uint64_t now_us;
+    uint64_t read_ns;           /**< Read time not yet rounded into now_us. */
+
+    /* Statistics */
+    uint32_t erases;
+    uint32_t programmed;        /**< Half-words programmed. */
+    uint32_t errors;            /**< Refused ops. */
+    uint64_t bytes_read;
+} AGS10_FlashSimTypeDef;
+
+/*******************************************************************************
+* Public Variables
+ ******************************************************************************/
+/**
+ * @brief Flash ops for ags10_log_mount(); pass the AGS10_FlashSimTypeDef as context.
+ */
+extern const AGS10_LogFlashOpsTypeDef ags10_flash_sim_ops;
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+
+/**
+ * @brief Initialise an erased region.
+ *
+ * @param[out] p_flash Emulator.
+ * @param[in] p_mem page_size * page_count bytes of storage.
+ * @param[out] p_wear page_count erase counters.
+ * @param[in] base Address of the first page.
+ * @param[in] page_size Page size in bytes.
+ * @param[in] page_count Number of pages.
+ */
+void ags10_flash_sim_init(AGS10_FlashSimTypeDef *p_flash,
+                          uint8_t *p_mem,
+                          uint32_t *p_wear,
+                          uint32_t base,
+                          uint32_t page_size,
+                          uint16_t page_count);
+
+/**
+ * @brief Arm a power cut.
+ *
+ * @param[in,out] p_flash Emulator.
+ * @param[in] ops Operations that complete before the cut.
+ * @param[in] seed Seed for the bits the cut leaves behind.
+ */
+void ags10_flash_sim_cut(AGS10_FlashSimTypeDef *p_flash, uint32_t ops, uint32_t seed);
+
+/**
+ * @brief Restore power after a cut; flash contents are kept.
+ *
+ * @param[in,out] p_flash Emulator.
+ */
+void ags10_flash_sim_power_on(AGS10_FlashSimTypeDef *p_flash);
+
+#endif /* INC_AGS10_FLASH_SIM_H_ */
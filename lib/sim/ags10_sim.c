@@ -0,0 +1,406 @@
+/**
+ * @file ags10_sim.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_sim.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static AGS10_SimDeviceTypeDef *device_find(AGS10_SimBusTypeDef *p_bus, uint8_t addr)
+{
+    for (uint16_t idx = 0; idx < p_bus->count; idx++)
+    {
+        AGS10_SimDeviceTypeDef *p_dev = &p_bus->p_devices[idx];
+
+        if (p_dev->powered && (p_dev->addr == addr))
+        {
+            return p_dev;
+        }
+    }
+
+    return NULL;
+}
+
+/* Start, address byte, payload bytes (8 data + ack clocks each) and stop. */
+static void bus_clock(AGS10_SimBusTypeDef *p_bus, uint16_t payload_len)
+{
+    uint64_t clocks = 2U + (9U * (1U + (uint64_t)payload_len));
+    uint64_t us = (clocks * 1000000U + p_bus->clock_hz - 1U) / p_bus->clock_hz;
+
+    p_bus->transfers++;
+    p_bus->bytes += 1U + payload_len;
+    p_bus->busy_us += us;
+    p_bus->now_us += us;
+}
+
+static uint32_t rand_next(AGS10_SimBusTypeDef *p_bus)
+{
+    // xorshift32, only needs to scatter glitches
+    p_bus->seed ^= p_bus->seed << 13;
+    p_bus->seed ^= p_bus->seed >> 17;
+    p_bus->seed ^= p_bus->seed << 5;
+
+    return p_bus->seed;
+}
+
+/* Odds grow linearly from none at clean_hz to every transfer at fail_hz, in 1/65536. */
+static bool bus_glitch(AGS10_SimBusTypeDef *p_bus)
+{
+    if ((0U == p_bus->clean_hz) || (p_bus->clock_hz <= p_bus->clean_hz))
+    {
+        return false;
+    }
+
+    // drawn even at fail_hz, the caller picks the kind of glitch from the upper bits
+    uint32_t draw = rand_next(p_bus);
+
+    if (p_bus->clock_hz < p_bus->fail_hz)
+    {
+        uint64_t odds = ((uint64_t)(p_bus->clock_hz - p_bus->clean_hz) << 16) / (p_bus->fail_hz - p_bus->clean_hz);
+
+        if ((draw & 0xFFFFU) >= odds)
+        {
+            return false;
+        }
+    }
+
+    p_bus->glitches++;
+
+    return true;
+}
+
+/* The HAL polls the busy flag until its timeout, then gives up without touching the bus. */
+static bool bus_stuck(AGS10_SimBusTypeDef *p_bus)
+{
+    if (!p_bus->stuck)
+    {
+        return false;
+    }
+
+    p_bus->stuck_rejects++;
+    p_bus->now_us += AGS10_SIM_BUSY_TIMEOUT_MS * 1000U;
+
+    return true;
+}
+
+static uint64_t device_sample_index(const AGS10_SimBusTypeDef *p_bus,
+                                    const AGS10_SimDeviceTypeDef *p_dev)
+{
+    uint64_t up_ms = (p_bus->now_us - p_dev->power_on_us) / 1000U;
+
+    if (up_ms < AGS10_SIM_PREHEAT_MS)
+    {
+        return 0;
+    }
+
+    return 1U + ((up_ms - AGS10_SIM_PREHEAT_MS) / AGS10_SIM_SAMPLE_MS);
+}
+
+static void frame_put(uint8_t *p_frame, uint32_t value)
+{
+    p_frame[0] = (uint8_t)(value >> 24);
+    p_frame[1] = (uint8_t)(value >> 16);
+    p_frame[2] = (uint8_t)(value >> 8);
+    p_frame[3] = (uint8_t)value;
+    p_frame[AGS10MA_DATA_LEN] = ags10_crc8_bitwise(p_frame, AGS10MA_DATA_LEN);
+}
+
+static bool device_address_set(AGS10_SimDeviceTypeDef *p_dev, const uint8_t *p_data)
+{
+    uint8_t new_addr = p_data[0];
+
+    if ((0xFFU != (uint8_t)(new_addr ^ p_data[1])) ||
+        (new_addr != p_data[2]) ||
+        (0xFFU != (uint8_t)(new_addr ^ p_data[3])) ||
+        (ags10_crc8_bitwise(p_data, AGS10MA_DATA_LEN) != p_data[AGS10MA_DATA_LEN]))
+    {
+        return false;
+    }
+
+    p_dev->addr = new_addr;
+    p_dev->addr_nv = new_addr;
+
+    return true;
+}
+
+/* Other parts found on a bus: none of them answers with a valid AGS10 frame. */
+static AGS10_StatusTypeDef decoy_write(AGS10_SimBusTypeDef *p_bus,
+                                       AGS10_SimDeviceTypeDef *p_dev,
+                                       const uint8_t *pData,
+                                       uint16_t length)
+{
+    if ((AGS10_SIM_DECOY_ADDR_ONLY == p_dev->kind) && (0 != length))
+    {
+        bus_clock(p_bus, 0);
+        p_bus->nacks++;
+        return AGS10_ERR_NACK;
+    }
+
+    bus_clock(p_bus, length);
+    if (0 != length)
+    {
+        p_dev->pointer = pData[0];
+    }
+
+    return AGS10_OK;
+}
+
+static void decoy_read(AGS10_SimBusTypeDef *p_bus,
+                       const AGS10_SimDeviceTypeDef *p_dev,
+                       uint8_t *pData,
+                       uint16_t length)
+{
+    bus_clock(p_bus, length);
+
+    for (uint16_t idx = 0; idx < length; idx++)
+    {
+        switch (p_dev->kind)
+        {
+        case AGS10_SIM_DECOY_REGISTERS:
+            pData[idx] = (uint8_t)(p_dev->pointer + idx);
+            break;
+        case AGS10_SIM_DECOY_FLOATING:
+            pData[idx] = 0xFFU;
+            break;
+        case AGS10_SIM_DECOY_ADDR_ONLY:
+        default:
+            pData[idx] = 0x00U;
+            break;
+        }
+    }
+}
+
+static AGS10_StatusTypeDef sim_write(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length)
+{
+    AGS10_SimBusTypeDef *p_bus = (AGS10_SimBusTypeDef *)p_ctx;
+
+    if (bus_stuck(p_bus))
+    {
+        return AGS10_ERR_BUSY;
+    }
+
+    AGS10_SimDeviceTypeDef *p_dev = device_find(p_bus, addr);
+
+    if (NULL == p_dev)
+    {
+        bus_clock(p_bus, 0);
+        p_bus->nacks++;
+        return AGS10_ERR_NACK;
+    }
+
+    if (AGS10_SIM_AGS10 != p_dev->kind)
+    {
+        return decoy_write(p_bus, p_dev, pData, length);
+    }
+
+    if (bus_glitch(p_bus))
+    {
+        bus_clock(p_bus, 0);
+        p_bus->nacks++;
+        return AGS10_ERR_NACK;
+    }
+
+    bus_clock(p_bus, length);
+
+    if (0 == length)
+    {
+        return AGS10_OK;
+    }
+
+    if ((AGS10MA_SET_ADDR_REG == pData[0]) && ((1U + AGS10MA_FRAME_LEN) == length))
+    {
+        // a malformed frame is acknowledged but ignored, like the real part
+        (void)device_address_set(p_dev, &pData[1]);
+        p_dev->pointer_valid = false;
+        return AGS10_OK;
+    }
+
+    p_dev->pointer = pData[0];
+    p_dev->pointer_valid = true;
+    p_dev->pointer_us = p_bus->now_us;
+
+    return AGS10_OK;
+}
+
+static AGS10_StatusTypeDef sim_read(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length)
+{
+    AGS10_SimBusTypeDef *p_bus = (AGS10_SimBusTypeDef *)p_ctx;
+
+    if (bus_stuck(p_bus))
+    {
+        return AGS10_ERR_BUSY;
+    }
+
+    AGS10_SimDeviceTypeDef *p_dev = device_find(p_bus, addr);
+
+    if ((NULL != p_dev) && (AGS10_SIM_AGS10 != p_dev->kind))
+    {
+        decoy_read(p_bus, p_dev, pData, length);
+        return AGS10_OK;
+    }
+
+    if ((NULL == p_dev) || !p_dev->pointer_valid ||
+        ((p_bus->now_us - p_dev->pointer_us) < (AGS10_SIM_ACCESS_MS * 1000U)))
+    {
+        // absent, or still busy answering the pointer write
+        bus_clock(p_bus, 0);
+        p_bus->nacks++;
+        return AGS10_ERR_NACK;
+    }
+
+    // a glitch either loses the address or, on odd draws, flips a bit of the frame
+    bool corrupt = bus_glitch(p_bus);
+
+    if (corrupt && (0U == (p_bus->seed & 0x10000U)))
+    {
+        bus_clock(p_bus, 0);
+        p_bus->nacks++;
+        return AGS10_ERR_NACK;
+    }
+
+    uint8_t frame[AGS10MA_FRAME_LEN];
+
+    switch (p_dev->pointer)
+    {
+    case AGS10MA_TVOC_STAT_REG:
+    {
+        uint64_t sample = device_sample_index(p_bus, p_dev);
+        uint32_t status = AGS10_SIM_STATUS_RDY;
+        uint32_t tvoc = 0;
+
+        if (sample > 0)
+        {
+            tvoc = p_dev->tvoc_ppb & 0xFFFFFFU;
+            if (sample > p_dev->sample_seen)
+            {
+                status &= ~AGS10_SIM_STATUS_RDY;
+                p_dev->sample_seen = sample;
+            }
+        }
+
+        frame_put(frame, (status << 24) | tvoc);
+        break;
+    }
+    case AGS10MA_VERSION_REG:
+        frame_put(frame, p_dev->version);
+        break;
+    case AGS10MA_GAS_RES_REG:
+        frame_put(frame, p_dev->gas_res);
+        break;
+    default:
+        bus_clock(p_bus, 0);
+        p_bus->nacks++;
+        return AGS10_ERR_NACK;
+    }
+
+    bus_clock(p_bus, length);
+
+    // bytes past the frame read back as 0xFF, an idle bus
+    memset(pData, 0xFF, length);
+    memcpy(pData, frame, (length < AGS10MA_FRAME_LEN) ? length : AGS10MA_FRAME_LEN);
+    if (corrupt && (0 != length))
+    {
+        uint32_t bit = (p_bus->seed >> 20) % (8U * length);
+
+        pData[bit >> 3] ^= (uint8_t)(1U << (bit & 7U));
+    }
+
+    return AGS10_OK;
+}
+
+static void sim_delay(void *p_ctx, uint16_t ms)
+{
+    ags10_sim_advance_us((AGS10_SimBusTypeDef *)p_ctx, (uint64_t)ms * 1000U);
+}
+
+/*******************************************************************************
+* Public Variables
+ ******************************************************************************/
+
+const AGS10_BusOpsTypeDef ags10_sim_bus_ops = {
+    .write       = sim_write,
+    .read        = sim_read,
+    .delay       = sim_delay,
+    .get_tick_ms = ags10_sim_tick_ms,
+};
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+void ags10_sim_bus_init(AGS10_SimBusTypeDef *p_bus,
+                        AGS10_SimDeviceTypeDef *p_devices,
+                        uint16_t count,
+                        uint32_t clock_hz)
+{
+    memset(p_bus, 0, sizeof(*p_bus));
+    p_bus->p_devices = p_devices;
+    p_bus->count = count;
+    p_bus->clock_hz = (0U == clock_hz) ? AGS10_SIM_DEFAULT_CLOCK_HZ : clock_hz;
+    p_bus->seed = 1U;
+}
+
+void ags10_sim_device_init(AGS10_SimDeviceTypeDef *p_dev, uint8_t addr)
+{
+    memset(p_dev, 0, sizeof(*p_dev));
+    p_dev->addr = addr;
+    p_dev->addr_nv = addr;
+    p_dev->powered = true;
+    p_dev->version = AGS10_SIM_VERSION;
+}
+
+void ags10_sim_device_power(AGS10_SimBusTypeDef *p_bus,
+                            AGS10_SimDeviceTypeDef *p_dev,
+                            bool on)
+{
+    if (on && !p_dev->powered)
+    {
+        p_dev->addr = p_dev->addr_nv;
+        p_dev->pointer_valid = false;
+        p_dev->power_on_us = p_bus->now_us;
+        p_dev->sample_seen = 0;
+    }
+
+    p_dev->powered = on;
+}
+
+void ags10_sim_bus_stuck(AGS10_SimBusTypeDef *p_bus)
+{
+    p_bus->stuck = true;
+}
+
+bool ags10_sim_bus_recover(AGS10_SimBusTypeDef *p_bus)
+{
+    bool was_stuck = p_bus->stuck;
+
+    p_bus->now_us += (AGS10_SIM_RECOVER_CLOCKS * 1000000ULL + p_bus->clock_hz - 1U) / p_bus->clock_hz;
+    p_bus->stuck = false;
+    if (was_stuck)
+    {
+        p_bus->recoveries++;
+    }
+
+    return was_stuck;
+}
+
+void ags10_sim_advance_us(AGS10_SimBusTypeDef *p_bus, uint64_t us)
+{
+    p_bus->now_us += us;
+}
+
+uint32_t ags10_sim_tick_ms(void *p_bus)
+{
+    return (uint32_t)(((AGS10_SimBusTypeDef *)p_bus)->now_us / 1000U);
+}
+// eof
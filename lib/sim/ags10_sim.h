@@ -0,0 +1,200 @@
+/**
+ * @file ags10_sim.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Host-side AGS10 device and I2C bus simulator.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_SIM_H_
+#define INC_AGS10_SIM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ags10.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define AGS10_SIM_DEFAULT_CLOCK_HZ   20000U      /**< Same as the STM32 example. */
+#define AGS10_SIM_ACCESS_MS          20U         /**< Pointer write to read, driver allows 30. */
+#define AGS10_SIM_SAMPLE_MS          1500U       /**< Internal TVOC update period. */
+#define AGS10_SIM_PREHEAT_MS         120000U     /**< Warm-up after power on. */
+#define AGS10_SIM_VERSION            0x0BU
+#define AGS10_SIM_BUSY_TIMEOUT_MS    25U         /**< HAL wait for a busy bus to free. */
+#define AGS10_SIM_RECOVER_CLOCKS     11U         /**< Nine pulses and a STOP. */
+
+#define AGS10_SIM_STATUS_RDY         0x01U       /**< Set while no fresh data. */
+/*******************************************************************************/
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+/**
+ * @brief What sits at a simulated address, for discovery tests.
+ */
+typedef enum {
+    AGS10_SIM_AGS10 = 0,        /**< A real AGS10. */
+    AGS10_SIM_DECOY_ADDR_ONLY,  /**< ACKs its address, NACKs any data byte written. */
+    AGS10_SIM_DECOY_REGISTERS,  /**< Plain register file: reads return pointer, pointer + 1, ... */
+    AGS10_SIM_DECOY_FLOATING,   /**< ACKs everything, reads return 0xFF. */
+} AGS10_SimKindTypeDef;
+
+/**
+ * @brief Model of one AGS10 on the simulated bus, or of a decoy.
+ * 
+ * Fields marked "model input" may be changed by the test at any time.
+ * Decoys answer without conversion delay and never change address.
+ */
+typedef struct {
+    uint8_t addr;               /**< Address the device answers on. */
+    uint8_t addr_nv;            /**< Address restored at power on. */
+    bool powered;
+
+    uint32_t tvoc_ppb;          /**< Model input: TVOC reported by new samples. */
+    uint32_t gas_res;           /**< Model input: resistance in 0.1 kOhm. */
+    uint8_t version;            /**< Model input: firmware version byte. */
+    uint8_t kind;               /**< Model input: AGS10_SimKindTypeDef, AGS10 by default. */
+
+    /* Internal state */
+    uint8_t pointer;
+    bool pointer_valid;
+    uint64_t pointer_us;
+    uint64_t power_on_us;
+    uint64_t sample_seen;       /**< Index of the last sample reported as fresh. */
+    uint32_t sample_tvoc;       /**< TVOC latched by the last internal sample. */
+} AGS10_SimDeviceTypeDef;
+
+/**
+ * @brief A simulated I2C bus with virtual time.
+ * 
+ * Time only moves when the driver transfers bytes (at the configured clock
+ * rate, 9 clocks per byte plus start and stop) or calls the delay op, so a
+ * 1000 ms wait costs nothing on the host and every run is deterministic.
+ *
+ * Signal integrity is modelled as a clock limit. Up to clean_hz every
+ * transfer to an AGS10 gets through; above it a share of them, growing
+ * linearly to all of them at fail_hz, glitches: the address is not
+ * acknowledged, or a read returns a frame with one bit flipped. The
+ * glitches are drawn from seed, so a run still repeats exactly.
+ */
+typedef struct {
+    AGS10_SimDeviceTypeDef *p_devices;
+    uint16_t count;
+    uint32_t clock_hz;          /**< Model input: may change between transfers. */
+    uint64_t now_us;
+    bool stuck;                 /**< SDA held low, see ags10_sim_bus_stuck(). */
+    uint32_t clean_hz;          /**< Model input: fastest clock without glitches, 0 for none at all. */
+    uint32_t fail_hz;           /**< Model input: clock at which every transfer glitches. */
+    uint32_t seed;              /**< Model input: xorshift32 state, not 0. */
+
+    /* Statistics */
+    uint32_t transfers;
+    uint32_t nacks;
+    uint32_t stuck_rejects;     /**< Transfers refused while stuck. */
+    uint32_t recoveries;
+    uint32_t glitches;          /**< Transfers lost or corrupted by the clock limit. */
+    uint64_t bytes;
+    uint64_t busy_us;
+} AGS10_SimBusTypeDef;
+
+/*******************************************************************************
+* Public Variables
+ ******************************************************************************/
+/**
+ * @brief Bus ops for ags10_init(); pass the AGS10_SimBusTypeDef as context.
+ */
+extern const AGS10_BusOpsTypeDef ags10_sim_bus_ops;
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+
+/**
+ * @brief Initialise a bus over an array of devices, at virtual time zero.
+ * 
+ * @param[out] p_bus Bus to initialise.
+ * @param[in] p_devices Devices on the bus, see ags10_sim_device_init().
+ * @param[in] count Number of devices.
+ * @param[in] clock_hz SCL rate used for transfer timing.
+ */
+void ags10_sim_bus_init(AGS10_SimBusTypeDef *p_bus,
+                        AGS10_SimDeviceTypeDef *p_devices,
+                        uint16_t count,
+                        uint32_t clock_hz);
+
+/**
+ * @brief Initialise a device that is powered on at virtual time zero.
+ * 
+ * @param[out] p_dev Device to initialise.
+ * @param[in] addr Persisted (factory) address.
+ */
+void ags10_sim_device_init(AGS10_SimDeviceTypeDef *p_dev, uint8_t addr);
+
+/**
+ * @brief Switch a device off or on.
+ * 
+ * Powering on restores the persisted address and restarts preheat.
+ * 
+ * @param[in] p_bus Bus the device sits on, for the current time.
+ * @param[in,out] p_dev Device.
+ * @param[in] on New power state.
+ */
+void ags10_sim_device_power(AGS10_SimBusTypeDef *p_bus,
+                            AGS10_SimDeviceTypeDef *p_dev,
+                            bool on);
+
+/**
+ * @brief Inject a stuck bus, as left by a read cut off mid-byte.
+ * 
+ * Until ags10_sim_bus_recover() every transfer waits out the busy flag
+ * timeout of an STM32 HAL (AGS10_SIM_BUSY_TIMEOUT_MS) and fails with
+ * AGS10_ERR_BUSY, the way HAL_BUSY is reported on the target.
+ * 
+ * @param[in,out] p_bus Bus.
+ */
+void ags10_sim_bus_stuck(AGS10_SimBusTypeDef *p_bus);
+
+/**
+ * @brief Clock a stuck bus free: nine SCL pulses and a STOP.
+ * 
+ * Costs the same bus time as the bit-banged sequence on the target.
+ * 
+ * @param[in,out] p_bus Bus.
+ * 
+ * @return true if the bus was stuck.
+ */
+bool ags10_sim_bus_recover(AGS10_SimBusTypeDef *p_bus);
+
+/**
+ * @brief Advance virtual time.
+ * 
+ * @param[in,out] p_bus Bus.
+ * @param[in] us Microseconds to advance.
+ */
+void ags10_sim_advance_us(AGS10_SimBusTypeDef *p_bus, uint64_t us);
+
+/**
+ * @brief Millisecond tick of the virtual clock.
+ * 
+ * Matches the tick source signature used by ags10_sched.
+ * 
+ * @param[in] p_bus AGS10_SimBusTypeDef.
+ * 
+ * @return Virtual time in milliseconds, wrapping at 32 bits.
+ */
+uint32_t ags10_sim_tick_ms(void *p_bus);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_AGS10_SIM_H_ */
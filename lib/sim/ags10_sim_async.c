@@ -0,0 +1,167 @@
+/**
+ * @file ags10_sim_async.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_sim_async.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+/* Publishes the outcome once its time has come, as the interrupt would. */
+static void async_complete(AGS10_SimAsyncTypeDef *p_async)
+{
+    if ((AGS10_BUS_XFER_BUSY != p_async->xfer) || p_async->lost ||
+        (p_async->p_bus->now_us < p_async->done_us))
+    {
+        return;
+    }
+
+    if (0U != p_async->lose_completions)
+    {
+        p_async->lose_completions--;
+        p_async->lost_completions++;
+        p_async->lost = true;
+        return;
+    }
+
+    if ((NULL != p_async->p_dst) && (AGS10_OK == p_async->result))
+    {
+        memcpy(p_async->p_dst, p_async->frame, p_async->length);
+    }
+
+    switch (p_async->result)
+    {
+    case AGS10_OK:
+        p_async->xfer = AGS10_BUS_XFER_DONE;
+        break;
+    case AGS10_ERR_NACK:
+        p_async->xfer = AGS10_BUS_XFER_NACK;
+        break;
+    default:
+        p_async->xfer = AGS10_BUS_XFER_ERROR;
+        break;
+    }
+
+    p_async->completions++;
+}
+
+static bool async_start(AGS10_SimAsyncTypeDef *p_async)
+{
+    async_complete(p_async);
+
+    if (AGS10_BUS_XFER_BUSY == p_async->xfer)
+    {
+        p_async->busy_rejects++;
+        return false;
+    }
+
+    p_async->xfer = AGS10_BUS_XFER_BUSY;
+    p_async->lost = false;
+    p_async->p_dst = NULL;
+    p_async->started++;
+
+    return true;
+}
+
+static AGS10_StatusTypeDef async_write(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length)
+{
+    AGS10_SimAsyncTypeDef *p_async = (AGS10_SimAsyncTypeDef *)p_ctx;
+
+    if (!async_start(p_async))
+    {
+        return AGS10_ERR_BUSY;
+    }
+
+    p_async->result = ags10_sim_bus_ops.write(p_async->p_bus, addr, pData, length);
+    p_async->done_us = p_async->p_bus->now_us + p_async->latency_us;
+
+    return AGS10_OK;
+}
+
+static AGS10_StatusTypeDef async_read(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length)
+{
+    AGS10_SimAsyncTypeDef *p_async = (AGS10_SimAsyncTypeDef *)p_ctx;
+
+    if (length > sizeof(p_async->frame))
+    {
+        return AGS10_ERR_PARAM;
+    }
+
+    if (!async_start(p_async))
+    {
+        return AGS10_ERR_BUSY;
+    }
+
+    // the frame is held back and lands in pData only at completion
+    p_async->result = ags10_sim_bus_ops.read(p_async->p_bus, addr, p_async->frame, length);
+    p_async->p_dst = pData;
+    p_async->length = length;
+    p_async->done_us = p_async->p_bus->now_us + p_async->latency_us;
+
+    return AGS10_OK;
+}
+
+static void async_delay(void *p_ctx, uint16_t ms)
+{
+    AGS10_SimAsyncTypeDef *p_async = (AGS10_SimAsyncTypeDef *)p_ctx;
+
+    ags10_sim_advance_us(p_async->p_bus, (uint64_t)ms * 1000U);
+}
+
+static uint32_t async_get_tick_ms(void *p_ctx)
+{
+    return ags10_sim_tick_ms(((AGS10_SimAsyncTypeDef *)p_ctx)->p_bus);
+}
+
+static AGS10_BusXferTypeDef async_xfer_state(void *p_ctx)
+{
+    AGS10_SimAsyncTypeDef *p_async = (AGS10_SimAsyncTypeDef *)p_ctx;
+
+    async_complete(p_async);
+
+    return p_async->xfer;
+}
+
+/*******************************************************************************
+* Public Variables
+ ******************************************************************************/
+
+const AGS10_BusOpsTypeDef ags10_sim_async_bus_ops = {
+    .write       = async_write,
+    .read        = async_read,
+    .delay       = async_delay,
+    .xfer_state  = async_xfer_state,
+    .get_tick_ms = async_get_tick_ms,
+};
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+void ags10_sim_async_init(AGS10_SimAsyncTypeDef *p_async, AGS10_SimBusTypeDef *p_bus)
+{
+    memset(p_async, 0, sizeof(*p_async));
+    p_async->p_bus = p_bus;
+    p_async->latency_us = AGS10_SIM_ASYNC_LATENCY_US;
+    p_async->xfer = AGS10_BUS_XFER_DONE;
+}
+
+void ags10_sim_async_abort(AGS10_SimAsyncTypeDef *p_async)
+{
+    if (AGS10_BUS_XFER_BUSY == p_async->xfer)
+    {
+        p_async->xfer = AGS10_BUS_XFER_ERROR;
+    }
+    p_async->lost = false;
+}
+// eof
@@ -0,0 +1,92 @@
+/**
+ * @file ags10_sim_async.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Asynchronous (DMA or interrupt style) bus over the simulated bus.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_SIM_ASYNC_H_
+#define INC_AGS10_SIM_ASYNC_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ags10_sim.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define AGS10_SIM_ASYNC_LATENCY_US   1000U      /**< End of the bytes to the completion interrupt. */
+/*******************************************************************************/
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+/**
+ * @brief A bus whose write and read only start a transfer.
+ *
+ * The bytes are clocked through the simulated bus when the transfer is
+ * started, but the outcome is only published latency_us later, like a DMA
+ * or interrupt completion: until then xfer_state reports
+ * AGS10_BUS_XFER_BUSY, and a read's frame lands in the caller's buffer
+ * only at completion. A transfer started while another is in flight is
+ * refused with AGS10_ERR_BUSY and counted in busy_rejects, as the STM32
+ * back ends do.
+ *
+ * Setting lose_completions drops that many of the next completions: the
+ * transfer stays busy until ags10_sim_async_abort(), the way a missed
+ * interrupt leaves the peripheral.
+ */
+typedef struct {
+    AGS10_SimBusTypeDef *p_bus;
+    uint32_t latency_us;        /**< Model input: AGS10_SIM_ASYNC_LATENCY_US. */
+    uint32_t lose_completions;  /**< Model input: completions to drop. */
+
+    /* Transfer in flight */
+    AGS10_BusXferTypeDef xfer;
+    AGS10_StatusTypeDef result;
+    uint64_t done_us;
+    bool lost;
+    uint8_t *p_dst;             /**< Read destination, filled at completion. */
+    uint8_t frame[AGS10MA_FRAME_LEN];
+    uint16_t length;
+
+    /* Statistics */
+    uint32_t started;
+    uint32_t completions;
+    uint32_t lost_completions;
+    uint32_t busy_rejects;      /**< Transfers refused because one was in flight. */
+} AGS10_SimAsyncTypeDef;
+
+/*******************************************************************************
+* Public Variables
+ ******************************************************************************/
+/**
+ * @brief Bus ops for ags10_init(); pass the AGS10_SimAsyncTypeDef as context.
+ */
+extern const AGS10_BusOpsTypeDef ags10_sim_async_bus_ops;
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+
+/**
+ * @brief Put an asynchronous bus in front of a simulated bus.
+ *
+ * @param[out] p_async Bus to initialise, idle.
+ * @param[in] p_bus Simulated bus that carries the bytes and the clock.
+ */
+void ags10_sim_async_init(AGS10_SimAsyncTypeDef *p_async, AGS10_SimBusTypeDef *p_bus);
+
+/**
+ * @brief Abandon the transfer in flight, like HAL_I2C_Master_Abort_IT().
+ *
+ * @param[in,out] p_async Bus.
+ */
+void ags10_sim_async_abort(AGS10_SimAsyncTypeDef *p_async);
+
+#endif /* INC_AGS10_SIM_ASYNC_H_ */
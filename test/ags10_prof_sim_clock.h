@@ -0,0 +1,36 @@
+/**
+ * @file ags10_prof_sim_clock.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Profiler time source for the host tests: the simulated bus clock.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_PROF_SIM_CLOCK_H_
+#define INC_AGS10_PROF_SIM_CLOCK_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define AGS10_PROF_CLOCK()         ags10_prof_sim_us()
+#define AGS10_PROF_UNIT            "us"
+
+/*******************************************************************************/
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+
+/**
+ * @brief Virtual time of the bus under test, defined by the test.
+ *
+ * @return Microseconds, truncated to 32 bits.
+ */
+uint32_t ags10_prof_sim_us(void);
+
+#endif /* INC_AGS10_PROF_SIM_CLOCK_H_ */
@@ -0,0 +1,53 @@
+/**
+ * @file ags10_static_sim_bus.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Static bus for the host tests: the simulated bus behind the
+ *        AGS10_STATIC_BUS_HEADER functions.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_STATIC_SIM_BUS_H_
+#define INC_AGS10_STATIC_SIM_BUS_H_
+
+#include "ags10_sim.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define AGS10_STATIC_BUS_TICK
+
+/*******************************************************************************/
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+/*
+ * The context is the AGS10_SimBusTypeDef given to ags10_init(); the handle's
+ * bus ops table is never read in this configuration.
+ */
+static inline AGS10_StatusTypeDef ags10_bus_write(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length)
+{
+    return ags10_sim_bus_ops.write(p_ctx, addr, pData, length);
+}
+
+static inline AGS10_StatusTypeDef ags10_bus_read(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length)
+{
+    return ags10_sim_bus_ops.read(p_ctx, addr, pData, length);
+}
+
+static inline void ags10_bus_delay(void *p_ctx, uint16_t ms)
+{
+    ags10_sim_advance_us((AGS10_SimBusTypeDef *)p_ctx, (uint64_t)ms * 1000U);
+}
+
+static inline uint32_t ags10_bus_get_tick_ms(void *p_ctx)
+{
+    return ags10_sim_tick_ms(p_ctx);
+}
+
+#endif /* INC_AGS10_STATIC_SIM_BUS_H_ */
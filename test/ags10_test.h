@@ -0,0 +1,110 @@
+/**
+ * @file ags10_test.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Minimal check and timing helpers for the host tests and benchmarks.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_AGS10_TEST_H_
+#define INC_AGS10_TEST_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+/**
+ * @brief Record a failed condition and carry on with the test.
+ */
+#define AGS10_TEST_CHECK(cond)                                                  \
+    do {                                                                        \
+        ags10_test_checks++;                                                    \
+        if (!(cond))                                                            \
+        {                                                                       \
+            ags10_test_failures++;                                              \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+        }                                                                       \
+    } while (0)
+
+/**
+ * @brief Like AGS10_TEST_CHECK, for two integers that must be equal.
+ */
+#define AGS10_TEST_EQ(actual, expected)                                         \
+    do {                                                                        \
+        unsigned long long act_ = (unsigned long long)(actual);                 \
+        unsigned long long exp_ = (unsigned long long)(expected);               \
+        ags10_test_checks++;                                                    \
+        if (act_ != exp_)                                                       \
+        {                                                                       \
+            ags10_test_failures++;                                              \
+            fprintf(stderr, "%s:%d: %s is %llu (0x%llX), expected %llu (0x%llX)\n", \
+                    __FILE__, __LINE__, #actual, act_, act_, exp_, exp_);       \
+        }                                                                       \
+    } while (0)
+
+/*******************************************************************************/
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static unsigned long ags10_test_checks;
+static unsigned long ags10_test_failures;
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief Print the summary line of a test program.
+ *
+ * @param[in] p_name Test name.
+ *
+ * @return Exit status for main(): 0 if every check passed.
+ */
+static inline int ags10_test_done(const char *p_name)
+{
+    printf("%s: %lu checks, %lu failed\n", p_name, ags10_test_checks, ags10_test_failures);
+
+    return (0U == ags10_test_failures) ? 0 : 1;
+}
+
+/**
+ * @brief Deterministic xorshift32, so every run sees the same inputs.
+ *
+ * @param[in,out] p_state Generator state, never 0.
+ *
+ * @return Next value.
+ */
+static inline uint32_t ags10_test_rand(uint32_t *p_state)
+{
+    uint32_t x = *p_state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *p_state = x;
+
+    return x;
+}
+
+/**
+ * @brief Monotonic time for the benchmarks.
+ *
+ * @return Nanoseconds from an arbitrary origin.
+ */
+static inline uint64_t ags10_test_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+#endif /* INC_AGS10_TEST_H_ */
@@ -0,0 +1,201 @@
+/**
+ * @file bench_co.cpp
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief 10 000 simulated sensors polled by coroutines on one thread: CPU
+ *        per sample, loop wake-ups and frame pool growth.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_co.hpp"
+#include "ags10_sim.h"
+#include "ags10_test.h"
+
+#include <thread>
+#include <vector>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define BENCH_SENSORS       10000U
+#define BENCH_PER_BUS       100U
+#define BENCH_ROUNDS        3U
+#define BENCH_PERIOD_MS     500U
+#define BENCH_CONV_MS       250U
+#define BENCH_BUS_HZ        100000U
+#define BENCH_WARM_NS       200000000000ULL     /**< Devices past preheat. */
+#define BENCH_FRAMES        3U      /**< Live frames per sensor: the poll loop, tvoc() and register_read(). */
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+/**
+ * @brief One run: how the first reads are spread and how the loop wakes.
+ */
+struct BenchCase {
+    const char *name;
+    bool spread;                /**< Start times spread over the period, or all at once. */
+    std::uint64_t slack_ns;
+};
+
+static const BenchCase bench_cases[] = {
+    { "all at once", false, 1000000U },
+    { "spread",      true,  1000000U },
+    { "spread, exact wake-ups", true, 0U },
+};
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+/** Simulated bus whose virtual clock follows the loop's. */
+struct SimBus {
+    AGS10_SimBusTypeDef *p_bus;
+    ags10::co::Loop *p_loop;
+    std::uint64_t t0_ns;
+
+    void sync()
+    {
+        std::uint64_t us = (p_loop->now_ns() - t0_ns) / 1000U;
+
+        p_bus->now_us = (us > p_bus->now_us) ? us : p_bus->now_us;
+    }
+
+    ags10::Status write(std::uint8_t addr, const std::uint8_t *p_data, std::uint16_t length)
+    {
+        sync();
+        return ags10_sim_bus_ops.write(p_bus, addr, const_cast<std::uint8_t *>(p_data), length);
+    }
+
+    ags10::Status read(std::uint8_t addr, std::uint8_t *p_data, std::uint16_t length)
+    {
+        sync();
+        return ags10_sim_bus_ops.read(p_bus, addr, p_data, length);
+    }
+
+    void delay_ms(std::uint16_t) {}
+};
+
+/** Outcome of one run. */
+struct BenchResult {
+    std::uint64_t samples = 0;
+    std::uint64_t fails = 0;
+    std::size_t chunks_spawned = 0;     /**< Pool chunks once every task reached its first wait. */
+    std::size_t chunks_end = 0;
+    std::uint64_t wakeups = 0;
+    std::uint64_t cpu_ns = 0;
+};
+
+static ags10::co::Task<> sensor_poll(ags10::co::Loop &loop, ags10::co::Sensor<SimBus> &sensor,
+                                     std::uint64_t offset_ns, BenchResult &result)
+{
+    co_await loop.sleep_until(loop.now_ns() + offset_ns);
+
+    std::uint64_t next_ns = loop.now_ns();
+
+    for (std::uint32_t round = 0; round < BENCH_ROUNDS; round++)
+    {
+        ags10::Result<ags10::Tvoc> tvoc = co_await sensor.tvoc(BENCH_CONV_MS);
+
+        result.samples += tvoc.ok() ? 1U : 0U;
+        result.fails += tvoc.ok() ? 0U : 1U;
+
+        next_ns += static_cast<std::uint64_t>(BENCH_PERIOD_MS) * 1000000U;
+        co_await loop.sleep_until(next_ns);
+    }
+}
+
+static std::uint64_t cpu_now_ns()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+
+    return (static_cast<std::uint64_t>(ts.tv_sec) * 1000000000ULL) + static_cast<std::uint64_t>(ts.tv_nsec);
+}
+
+/**
+ * @brief One run on the calling thread, so it starts with an empty frame pool.
+ */
+static void bench_run(const BenchCase &bench, BenchResult &result)
+{
+    const std::uint32_t bus_count = (BENCH_SENSORS + BENCH_PER_BUS - 1U) / BENCH_PER_BUS;
+    ags10::co::Loop loop;
+    std::vector<AGS10_SimBusTypeDef> buses(bus_count);
+    std::vector<std::vector<AGS10_SimDeviceTypeDef>> devices(bus_count);
+    std::vector<ags10::co::Sensor<SimBus>> sensors;
+    std::uint64_t t0_ns = loop.now_ns() - BENCH_WARM_NS;
+
+    AGS10_TEST_CHECK(loop.ok());
+    loop.timer_slack_ns = bench.slack_ns;
+    sensors.reserve(BENCH_SENSORS);
+
+    for (std::uint32_t b = 0; b < bus_count; b++)
+    {
+        devices[b].resize(BENCH_PER_BUS);
+        for (std::uint32_t idx = 0; idx < BENCH_PER_BUS; idx++)
+        {
+            ags10_sim_device_init(&devices[b][idx], static_cast<std::uint8_t>(0x10U + idx));
+            devices[b][idx].tvoc_ppb = 100U + idx;
+        }
+        ags10_sim_bus_init(&buses[b], devices[b].data(), BENCH_PER_BUS, BENCH_BUS_HZ);
+        for (std::uint32_t idx = 0; idx < BENCH_PER_BUS; idx++)
+        {
+            sensors.emplace_back(loop, SimBus{ &buses[b], &loop, t0_ns }, static_cast<std::uint8_t>(0x10U + idx));
+        }
+    }
+
+    std::uint64_t start = cpu_now_ns();
+
+    for (std::uint32_t idx = 0; idx < BENCH_SENSORS; idx++)
+    {
+        std::uint64_t offset_ns = bench.spread ? ((static_cast<std::uint64_t>(BENCH_PERIOD_MS) * 1000000U * idx) / BENCH_SENSORS) : 0U;
+
+        loop.spawn(sensor_poll(loop, sensors[idx], offset_ns, result));
+    }
+    result.chunks_spawned = ags10::co::detail::frame_pool().chunks;
+
+    loop.run();
+
+    result.cpu_ns = cpu_now_ns() - start;
+    result.chunks_end = ags10::co::detail::frame_pool().chunks;
+    result.wakeups = loop.wakeups;
+    AGS10_TEST_EQ(loop.live(), 0);
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main()
+{
+    for (const BenchCase &bench : bench_cases)
+    {
+        BenchResult result;
+        std::thread thread(bench_run, std::cref(bench), std::ref(result));
+
+        thread.join();
+
+        AGS10_TEST_EQ(result.samples, BENCH_SENSORS * BENCH_ROUNDS);
+        AGS10_TEST_EQ(result.fails, 0);
+        // never more chunks than every sensor's frames live at once; all of
+        // them are live at the first wait when no start is delayed
+        std::size_t chunks_max = BENCH_FRAMES * ((BENCH_SENSORS + ags10::co::detail::FramePool::chunk_blocks - 1U) /
+                                                 ags10::co::detail::FramePool::chunk_blocks);
+
+        AGS10_TEST_CHECK(result.chunks_end <= chunks_max);
+        if (!bench.spread)
+        {
+            AGS10_TEST_EQ(result.chunks_end, result.chunks_spawned);
+        }
+
+        printf("co %-22s: %5.2f us CPU/sample, %6llu wake-ups, %3zu pool chunks (%zu at the first wait)\n",
+               bench.name, static_cast<double>(result.cpu_ns) / 1000.0 / static_cast<double>(result.samples),
+               static_cast<unsigned long long>(result.wakeups), result.chunks_end, result.chunks_spawned);
+    }
+
+    return ags10_test_done("bench co");
+}
+// eof
@@ -0,0 +1,149 @@
+/**
+ * @file bench_codec.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Size and throughput of the sample codec on a synthetic TVOC trace.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_codec.h"
+#include "ags10_test.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define BENCH_SAMPLES   (1024U * 1024U)
+#define BENCH_RUNS      5U
+#define BENCH_LOOKUPS   100000U
+#define BENCH_BLOCKS    ((BENCH_SAMPLES / 16U) + 1U)
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static uint32_t bench_in[BENCH_SAMPLES];
+static uint32_t bench_out[BENCH_SAMPLES];
+static uint8_t bench_code[BENCH_SAMPLES * AGS10_CODEC_MAX_BYTES];
+static uint32_t bench_offs[BENCH_BLOCKS];
+
+static const uint16_t bench_block_lens[] = { 16U, 64U, 256U };
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief Slow drift towards 250 ppb, noise of a few ppb and rare spikes,
+ *        plus the edge values of a 32-bit stream.
+ */
+static void trace_make(void)
+{
+    uint32_t seed = 1;
+    double base = 300.0;
+
+    for (uint32_t idx = 0; idx < BENCH_SAMPLES; idx++)
+    {
+        base += ((double)(ags10_test_rand(&seed) % 7U) - 3.0) * 0.5;
+        if (0U == (ags10_test_rand(&seed) % 5000U))
+        {
+            base += (double)(ags10_test_rand(&seed) % 3000U);
+        }
+        base += (250.0 - base) * 0.001;
+        base = (base < 0.0) ? 0.0 : base;
+        bench_in[idx] = (uint32_t)base;
+    }
+
+    bench_in[10] = 0xFFFFFFU;
+    bench_in[11] = 0U;
+    bench_in[12] = 0xFFFFFFFFU;
+    bench_in[13] = 0x80000000U;
+}
+
+static uint32_t trace_encode(uint16_t block_len)
+{
+    AGS10_CodecEncTypeDef enc;
+    uint32_t len = 0;
+
+    ags10_codec_enc_init(&enc, block_len);
+    for (uint32_t idx = 0; idx < BENCH_SAMPLES; idx++)
+    {
+        len += ags10_codec_encode(&enc, bench_in[idx], &bench_code[len]);
+    }
+
+    return len;
+}
+
+static uint32_t trace_decode(uint16_t block_len, uint32_t len)
+{
+    AGS10_CodecDecTypeDef dec;
+    uint32_t off = 0;
+
+    ags10_codec_dec_init(&dec, block_len);
+    for (uint32_t idx = 0; idx < BENCH_SAMPLES; idx++)
+    {
+        off += ags10_codec_decode(&dec, &bench_code[off], len - off, &bench_out[idx]);
+    }
+
+    return off;
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    trace_make();
+
+    for (uint32_t b = 0; b < sizeof(bench_block_lens) / sizeof(bench_block_lens[0]); b++)
+    {
+        uint16_t block_len = bench_block_lens[b];
+        uint32_t len = 0;
+        uint32_t off = 0;
+        uint32_t seed = 1;
+        uint32_t misses = 0;
+
+        uint64_t start = ags10_test_now_ns();
+        for (uint32_t run = 0; run < BENCH_RUNS; run++)
+        {
+            len = trace_encode(block_len);
+        }
+        uint64_t enc_ns = ags10_test_now_ns() - start;
+
+        start = ags10_test_now_ns();
+        for (uint32_t run = 0; run < BENCH_RUNS; run++)
+        {
+            off = trace_decode(block_len, len);
+        }
+        uint64_t dec_ns = ags10_test_now_ns() - start;
+
+        AGS10_TEST_EQ(off, len);
+        AGS10_TEST_CHECK(0 == memcmp(bench_in, bench_out, sizeof(bench_in)));
+
+        uint32_t blocks = ags10_codec_index(bench_code, len, block_len, bench_offs, BENCH_BLOCKS);
+
+        AGS10_TEST_EQ(blocks, (BENCH_SAMPLES + block_len - 1U) / block_len);
+        for (uint32_t n = 0; n < BENCH_LOOKUPS; n++)
+        {
+            uint32_t pos = ags10_test_rand(&seed) % BENCH_SAMPLES;
+            uint32_t value = 0;
+
+            misses += (!ags10_codec_decode_at(bench_code, len, block_len, bench_offs, blocks, pos, &value) ||
+                       (value != bench_in[pos])) ? 1U : 0U;
+        }
+        AGS10_TEST_EQ(misses, 0);
+
+        // MB/s of raw uint32_t input: bytes * runs * 1000 / ns
+        double raw = (double)sizeof(bench_in) * BENCH_RUNS * 1000.0;
+
+        printf("codec block %3u: %.3f B/sample, ratio %.2fx, encode %6.1f MB/s, decode %6.1f MB/s\n",
+               block_len, (double)len / BENCH_SAMPLES, (double)sizeof(bench_in) / len,
+               raw / (double)enc_ns, raw / (double)dec_ns);
+    }
+
+    return ags10_test_done("bench codec");
+}
+// eof
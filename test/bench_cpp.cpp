@@ -0,0 +1,111 @@
+/**
+ * @file bench_cpp.cpp
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Cost of a TVOC read through the C++ driver and through the C
+ *        driver, on an in-memory bus.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10.hpp"
+#include "ags10_test.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define BENCH_ADDR      0x1AU
+#define BENCH_READS     10000000U
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static std::uint8_t bench_frame[AGS10MA_FRAME_LEN] = { 0x00, 0x00, 0x01, 0x2C, 0x00 };
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+/** Stateless bus returning the same frame, inline for the C++ driver. */
+struct MemBus {
+    ags10::Status write(std::uint8_t, const std::uint8_t *, std::uint16_t) { return AGS10_OK; }
+
+    ags10::Status read(std::uint8_t, std::uint8_t *p_data, std::uint16_t length)
+    {
+        for (std::uint16_t idx = 0; idx < length; idx++)
+        {
+            p_data[idx] = bench_frame[idx];
+        }
+
+        return AGS10_OK;
+    }
+
+    void delay_ms(std::uint16_t) {}
+};
+
+/* The same bus as C operations, for the C driver. */
+static AGS10_StatusTypeDef mem_write(void *, uint8_t addr, uint8_t *p_data, uint16_t length)
+{
+    return MemBus{}.write(addr, p_data, length);
+}
+
+static AGS10_StatusTypeDef mem_read(void *, uint8_t addr, uint8_t *p_data, uint16_t length)
+{
+    return MemBus{}.read(addr, p_data, length);
+}
+
+static void mem_delay(void *, uint16_t) {}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main()
+{
+    ags10::Ags10<MemBus, BENCH_ADDR> sensor;
+    AGS10_BusOpsTypeDef mem_ops = {};
+    AGS10_HandleTypeDef h_sensor;
+    volatile uint32_t sink = 0;
+    uint32_t good = 0;
+
+    bench_frame[AGS10MA_DATA_LEN] = ags10_crc8(bench_frame, AGS10MA_DATA_LEN);
+    mem_ops.write = mem_write;
+    mem_ops.read = mem_read;
+    mem_ops.delay = mem_delay;
+    AGS10_TEST_EQ(ags10_init(&h_sensor, BENCH_ADDR, &mem_ops, NULL), AGS10_OK);
+
+    uint64_t start = ags10_test_now_ns();
+
+    for (uint32_t n = 0; n < BENCH_READS; n++)
+    {
+        ags10::Result<ags10::Tvoc> tvoc = sensor.tvoc(0);
+
+        good += tvoc.ok() ? 1U : 0U;
+        sink = tvoc->ppb;
+    }
+
+    uint64_t cpp_ns = ags10_test_now_ns() - start;
+
+    AGS10_TEST_EQ(good, BENCH_READS);
+    good = 0;
+    start = ags10_test_now_ns();
+
+    for (uint32_t n = 0; n < BENCH_READS; n++)
+    {
+        uint32_t raw = 0;
+
+        good += (AGS10_OK == ags10_register_read(&h_sensor, AGS10MA_TVOC_STAT_REG, 0, &raw)) ? 1U : 0U;
+        sink = raw & AGS10MA_TVOC_MSK;
+    }
+
+    uint64_t c_ns = ags10_test_now_ns() - start;
+
+    AGS10_TEST_EQ(good, BENCH_READS);
+    AGS10_TEST_EQ(sink, 300U);
+    printf("tvoc read, crc engine %d: C++ %5.1f ns, C %5.1f ns\n", AGS10_CRC8_ENGINE,
+           static_cast<double>(cpp_ns) / BENCH_READS, static_cast<double>(c_ns) / BENCH_READS);
+
+    return ags10_test_done("bench cpp");
+}
+// eof
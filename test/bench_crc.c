@@ -0,0 +1,69 @@
+/**
+ * @file bench_crc.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Throughput of each CRC-8 engine over a 1 MiB buffer.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10.h"
+#include "ags10_test.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define BENCH_LEN       (1024 * 1024)
+#define BENCH_RUNS      20U
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static uint8_t bench_buf[BENCH_LEN];
+
+static const struct {
+    const char *name;
+    uint8_t (*fn)(const uint8_t *p_data, int len);
+} bench_engines[] = {
+    { "bitwise", ags10_crc8_bitwise },
+    { "nibble",  ags10_crc8_nibble },
+    { "table",   ags10_crc8_table },
+    { "slice4",  ags10_crc8_slice4 },
+};
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    uint32_t seed = 1;
+
+    for (uint32_t idx = 0; idx < BENCH_LEN; idx++)
+    {
+        bench_buf[idx] = (uint8_t)ags10_test_rand(&seed);
+    }
+
+    uint8_t ref = ags10_crc8_bitwise(bench_buf, BENCH_LEN);
+
+    for (uint32_t e = 0; e < sizeof(bench_engines) / sizeof(bench_engines[0]); e++)
+    {
+        volatile uint8_t crc = 0;
+        uint64_t start = ags10_test_now_ns();
+
+        for (uint32_t run = 0; run < BENCH_RUNS; run++)
+        {
+            crc = bench_engines[e].fn(bench_buf, BENCH_LEN);
+        }
+
+        uint64_t elapsed = ags10_test_now_ns() - start;
+
+        AGS10_TEST_EQ(crc, ref);
+        printf("crc8 %-8s %7.1f MB/s\n", bench_engines[e].name,
+               ((double)BENCH_LEN * BENCH_RUNS * 1000.0) / (double)elapsed);
+    }
+
+    return ags10_test_done("bench crc");
+}
+// eof
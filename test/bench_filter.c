@@ -0,0 +1,70 @@
+/**
+ * @file bench_filter.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Cost per sample of the filter chain as configured at build time.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_filter.h"
+#include "ags10_test.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define BENCH_SAMPLES   (2U * 1024U * 1024U)
+#define BENCH_RUNS      5U
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static uint32_t bench_in[BENCH_SAMPLES];
+
+static const AGS10_FilterConfigTypeDef bench_cfg = {
+    .ema_alpha  = AGS10_FILTER_ALPHA_ONE / 8U,
+    .clamp_step = AGS10_FILTER_FROM_PPB(200),
+};
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    AGS10_FilterTypeDef filter;
+    volatile uint32_t sink = 0;
+    uint32_t seed = 3;
+    uint32_t base = 300;
+
+    // random walk with noise and spikes, so the clamp and median branch
+    for (uint32_t idx = 0; idx < BENCH_SAMPLES; idx++)
+    {
+        base = base + (ags10_test_rand(&seed) % 21U) - ((base >= 10U) ? 10U : base);
+        bench_in[idx] = base + (ags10_test_rand(&seed) % 7U) +
+                        ((0U == (ags10_test_rand(&seed) % 200U)) ? 3000U : 0U);
+    }
+
+    ags10_filter_init(&filter, &bench_cfg);
+
+    uint64_t start = ags10_test_now_ns();
+
+    for (uint32_t run = 0; run < BENCH_RUNS; run++)
+    {
+        for (uint32_t idx = 0; idx < BENCH_SAMPLES; idx++)
+        {
+            sink = ags10_filter_update(&filter, bench_in[idx]);
+        }
+    }
+
+    uint64_t elapsed = ags10_test_now_ns() - start;
+
+    (void)sink;
+    printf("filter clamp %d, median %d, ema %d: %5.1f ns/sample\n",
+           AGS10_FILTER_CLAMP_ENABLE, AGS10_FILTER_MEDIAN_LEN, AGS10_FILTER_EMA_ENABLE,
+           (double)elapsed / ((double)BENCH_SAMPLES * BENCH_RUNS));
+
+    return ags10_test_done("bench filter");
+}
+// eof
@@ -0,0 +1,145 @@
+/**
+ * @file bench_log.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Flash cost and mount time of the sample log on the flash simulator,
+ *        with a synthetic TVOC trace at a 2 s cadence.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_log.h"
+#include "ags10_flash_sim.h"
+#include "ags10_test.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define BENCH_BASE          0x0800E000UL
+#define BENCH_PAGE_SIZE     1024U
+#define BENCH_PAGES         8U
+#define BENCH_PERIOD_MS     2000U
+#define BENCH_SAMPLES       200000U     /**< About 4.6 days, every page recycled >100 times. */
+#define BENCH_MOUNTS        1000U       /**< Host-time mounts to average. */
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static uint8_t bench_mem[BENCH_PAGE_SIZE * BENCH_PAGES];
+static uint32_t bench_wear[BENCH_PAGES];
+static AGS10_FlashSimTypeDef bench_flash;
+static AGS10_LogTypeDef bench_log;
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+/* Virtual flash time in ns. */
+static uint64_t flash_ns(void)
+{
+    return (bench_flash.now_us * 1000U) + bench_flash.read_ns;
+}
+
+static bool count_visit(void *p_ctx, const AGS10_RingSampleTypeDef *p_sample)
+{
+    (void)p_ctx;
+    (void)p_sample;
+
+    return true;
+}
+
+/**
+ * @brief Slow TVOC drift towards 250 ppb with noise and rare spikes, a
+ *        resistance following it, and a steady status.
+ */
+static AGS10_StatusTypeDef trace_append(void)
+{
+    uint32_t seed = 1;
+    double base = 300.0;
+
+    for (uint32_t idx = 0; idx < BENCH_SAMPLES; idx++)
+    {
+        base += ((double)(ags10_test_rand(&seed) % 7U) - 3.0) * 0.5;
+        if (0U == (ags10_test_rand(&seed) % 5000U))
+        {
+            base += (double)(ags10_test_rand(&seed) % 3000U);
+        }
+        base += (250.0 - base) * 0.001;
+        base = (base < 0.0) ? 0.0 : base;
+
+        AGS10_RingSampleTypeDef sample = {
+            .t_ms = idx * BENCH_PERIOD_MS,
+            .tvoc = (uint32_t)base,
+            .resistance = 60000U - ((uint32_t)base * 10U) + (ags10_test_rand(&seed) % 5U),
+            .status = 0x00U,
+        };
+        AGS10_StatusTypeDef status = ags10_log_append(&bench_log, &sample);
+
+        if (AGS10_OK != status)
+        {
+            return status;
+        }
+    }
+
+    return ags10_log_flush(&bench_log);
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    ags10_flash_sim_init(&bench_flash, bench_mem, bench_wear, BENCH_BASE, BENCH_PAGE_SIZE, BENCH_PAGES);
+    AGS10_TEST_EQ(ags10_log_mount(&bench_log, &ags10_flash_sim_ops, &bench_flash, BENCH_BASE, BENCH_PAGE_SIZE,
+                                  BENCH_PAGES), AGS10_OK);
+    AGS10_TEST_EQ(trace_append(), AGS10_OK);
+    AGS10_TEST_EQ(bench_flash.errors, 0);
+
+    uint32_t records = bench_log.records;
+    uint32_t wear_min = bench_wear[0];
+    uint32_t wear_max = bench_wear[0];
+
+    for (uint32_t page = 1; page < BENCH_PAGES; page++)
+    {
+        wear_min = (bench_wear[page] < wear_min) ? bench_wear[page] : wear_min;
+        wear_max = (bench_wear[page] > wear_max) ? bench_wear[page] : wear_max;
+    }
+
+    uint32_t retained = ags10_log_read(&bench_log, count_visit, NULL);
+
+    // a full log: one header per page, then the head page's records
+    uint64_t read_before = bench_flash.bytes_read;
+    uint64_t start = flash_ns();
+
+    AGS10_TEST_EQ(ags10_log_mount(&bench_log, &ags10_flash_sim_ops, &bench_flash, BENCH_BASE, BENCH_PAGE_SIZE,
+                                  BENCH_PAGES), AGS10_OK);
+
+    uint64_t mount_ns = flash_ns() - start;
+    uint64_t mount_read = bench_flash.bytes_read - read_before;
+    uint64_t region_ns = (uint64_t)(BENCH_PAGE_SIZE * BENCH_PAGES / 2U) * AGS10_FLASH_SIM_READ_NS;
+
+    AGS10_TEST_EQ(ags10_log_read(&bench_log, count_visit, NULL), retained);
+    AGS10_TEST_CHECK(mount_read < (BENCH_PAGE_SIZE * BENCH_PAGES / 4U));
+
+    uint64_t host = ags10_test_now_ns();
+
+    for (uint32_t run = 0; run < BENCH_MOUNTS; run++)
+    {
+        (void)ags10_log_mount(&bench_log, &ags10_flash_sim_ops, &bench_flash, BENCH_BASE, BENCH_PAGE_SIZE,
+                              BENCH_PAGES);
+    }
+    uint64_t host_ns = (ags10_test_now_ns() - host) / BENCH_MOUNTS;
+
+    printf("log write: %.2f B/sample (13 raw), %.1f B/record of %u samples, %.2f erases/1000 samples, "
+           "wear %u-%u\n",
+           (double)bench_flash.programmed * 2.0 / BENCH_SAMPLES, (double)bench_flash.programmed * 2.0 / records,
+           AGS10_LOG_BATCH, (double)bench_flash.erases * 1000.0 / BENCH_SAMPLES, wear_min, wear_max);
+    printf("log mount: %.1f us flash, %u bytes read (%.1f us for the region), %u ns host; %u samples retained\n",
+           (double)mount_ns / 1000.0, (unsigned)mount_read, (double)region_ns / 1000.0, (unsigned)host_ns,
+           retained);
+
+    return ags10_test_done("bench log");
+}
+// eof
@@ -0,0 +1,201 @@
+/**
+ * @file bench_sched.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Length and bus utilisation of a pipelined 64-sensor round against
+ *        reading one at a time.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10.h"
+#include "ags10_sched.h"
+#include "ags10_sim.h"
+#include "ags10_test.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define BENCH_SENSORS       64U
+#define BENCH_DELAY_MS      AGS10MA_TVOC_DELAY_MS
+#define BENCH_WRITE_MS      1U      /**< Fixed-cost bus: one pointer write. */
+#define BENCH_READ_MS       3U      /**< Fixed-cost bus: one frame read. */
+#define BENCH_ROUNDS        100U
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+/* Fixed-cost bus: every sensor answers with its own address as the value. */
+static uint32_t fixed_ms;
+static uint64_t fixed_busy_us;      /**< Time spent in writes and reads. */
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static AGS10_StatusTypeDef fixed_write(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length)
+{
+    (void)p_ctx;
+    (void)addr;
+    (void)pData;
+    (void)length;
+    fixed_ms += BENCH_WRITE_MS;
+    fixed_busy_us += BENCH_WRITE_MS * 1000U;
+
+    return AGS10_OK;
+}
+
+static AGS10_StatusTypeDef fixed_read(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length)
+{
+    uint8_t frame[5] = {0, 0, 0, addr, 0};
+
+    (void)p_ctx;
+    frame[4] = ags10_crc8(frame, 4);
+    memcpy(pData, frame, (length < sizeof(frame)) ? length : sizeof(frame));
+    fixed_ms += BENCH_READ_MS;
+    fixed_busy_us += BENCH_READ_MS * 1000U;
+
+    return AGS10_OK;
+}
+
+static void fixed_delay(void *p_ctx, uint16_t ms)
+{
+    (void)p_ctx;
+    fixed_ms += ms;
+}
+
+static uint32_t fixed_tick_ms(void *p_ctx)
+{
+    (void)p_ctx;
+    return fixed_ms;
+}
+
+static uint64_t fixed_busy(void *p_ctx)
+{
+    (void)p_ctx;
+    return fixed_busy_us;
+}
+
+static uint64_t sim_busy(void *p_ctx)
+{
+    return ((AGS10_SimBusTypeDef *)p_ctx)->busy_us;
+}
+
+static const AGS10_BusOpsTypeDef fixed_bus_ops = {
+    .write       = fixed_write,
+    .read        = fixed_read,
+    .delay       = fixed_delay,
+    .get_tick_ms = fixed_tick_ms,
+};
+
+/* One round, sleeping on the bus's delay op as ags10_sched_next_due_ms() says. */
+static void bench_round(AGS10_SchedTypeDef *p_sched, const AGS10_BusOpsTypeDef *p_ops, void *p_ctx)
+{
+    (void)ags10_sched_round_start(p_sched);
+
+    while (!ags10_sched_poll(p_sched))
+    {
+        uint32_t wait_ms = ags10_sched_next_due_ms(p_sched);
+
+        p_ops->delay(p_ctx, (uint16_t)((0U != wait_ms) ? wait_ms : 1U));
+    }
+}
+
+/* Share of elapsed_ms the bus spent clocking transfers, in percent. */
+static double bench_util(uint64_t busy_us, uint32_t elapsed_ms)
+{
+    return (0U != elapsed_ms) ? ((double)busy_us / (10.0 * (double)elapsed_ms)) : 0.0;
+}
+
+/*
+ * p_busy returns the bus's total transfer time in microseconds, so the
+ * rest of a round is time the bus sat idle.
+ */
+static void bench_bus(const char *p_name, const AGS10_BusOpsTypeDef *p_ops, void *p_ctx, uint8_t first_addr,
+                      uint64_t (*p_busy)(void *p_ctx))
+{
+    static AGS10_HandleTypeDef sensors[BENCH_SENSORS];
+    static AGS10_SchedResultTypeDef results[BENCH_SENSORS];
+    AGS10_SchedTypeDef sched;
+    uint32_t ok = 0;
+
+    for (uint32_t idx = 0; idx < BENCH_SENSORS; idx++)
+    {
+        (void)ags10_init(&sensors[idx], (uint8_t)(first_addr + idx), p_ops, p_ctx);
+    }
+
+    (void)ags10_sched_init(&sched, sensors, results, BENCH_SENSORS, AGS10MA_TVOC_STAT_REG,
+                           BENCH_DELAY_MS, p_ops->get_tick_ms, p_ctx);
+
+    uint32_t rounds_start = p_ops->get_tick_ms(p_ctx);
+    uint64_t rounds_busy = p_busy(p_ctx);
+    uint64_t start_ns = ags10_test_now_ns();
+
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++)
+    {
+        bench_round(&sched, p_ops, p_ctx);
+    }
+
+    uint64_t host_ns = ags10_test_now_ns() - start_ns;
+    uint32_t rounds_ms = p_ops->get_tick_ms(p_ctx) - rounds_start;
+
+    rounds_busy = p_busy(p_ctx) - rounds_busy;
+    AGS10_TEST_CHECK(rounds_busy <= ((uint64_t)rounds_ms * 1000U));
+
+    for (uint32_t idx = 0; idx < BENCH_SENSORS; idx++)
+    {
+        ok += (AGS10_OK == results[idx].status) ? 1U : 0U;
+    }
+    AGS10_TEST_EQ(ok, BENCH_SENSORS);
+
+    // one at a time, through the blocking read
+    uint32_t seq_start = p_ops->get_tick_ms(p_ctx);
+    uint64_t seq_busy = p_busy(p_ctx);
+
+    for (uint32_t idx = 0; idx < BENCH_SENSORS; idx++)
+    {
+        uint32_t value;
+
+        AGS10_TEST_EQ(ags10_register_read(&sensors[idx], AGS10MA_TVOC_STAT_REG, BENCH_DELAY_MS, &value), AGS10_OK);
+    }
+
+    uint32_t seq_ms = p_ops->get_tick_ms(p_ctx) - seq_start;
+
+    seq_busy = p_busy(p_ctx) - seq_busy;
+
+    printf("%-22s %u sensors: round %5u ms, one at a time %6u ms, host %.1f us/round\n",
+           p_name, BENCH_SENSORS, sched.last_round_ms, seq_ms,
+           (double)host_ns / (1000.0 * BENCH_ROUNDS));
+    printf("%-22s bus busy: round %5.1f %% (%.1f ms in transfers, %.1f ms idle), one at a time %5.1f %%\n",
+           p_name, bench_util(rounds_busy, rounds_ms),
+           (double)rounds_busy / (1000.0 * BENCH_ROUNDS),
+           (double)((uint64_t)rounds_ms * 1000U - rounds_busy) / (1000.0 * BENCH_ROUNDS),
+           bench_util(seq_busy, seq_ms));
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    static AGS10_SimDeviceTypeDef devices[BENCH_SENSORS];
+    AGS10_SimBusTypeDef sim;
+
+    bench_bus("fixed 1 ms/3 ms bus", &fixed_bus_ops, NULL, 0x08, fixed_busy);
+
+    for (uint32_t idx = 0; idx < BENCH_SENSORS; idx++)
+    {
+        ags10_sim_device_init(&devices[idx], (uint8_t)(0x08U + idx));
+    }
+    ags10_sim_bus_init(&sim, devices, BENCH_SENSORS, AGS10_SIM_DEFAULT_CLOCK_HZ);
+    ags10_sim_advance_us(&sim, (uint64_t)AGS10_SIM_PREHEAT_MS * 1000U);
+
+    bench_bus("simulator at 20 kHz", &ags10_sim_bus_ops, &sim, 0x08, sim_busy);
+
+    return ags10_test_done("bench sched");
+}
+// eof
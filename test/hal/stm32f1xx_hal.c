@@ -0,0 +1,227 @@
+/**
+ * @file stm32f1xx_hal.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "stm32f1xx_hal.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static I2C_HandleTypeDef *mock_handles[HAL_MOCK_MAX_HANDLES];
+static AGS10_SimBusTypeDef *mock_clock;
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static void mock_complete(I2C_HandleTypeDef *hi2c)
+{
+    if ((HAL_MOCK_XFER_NONE == hi2c->xfer) || (hi2c->p_sim->now_us < hi2c->done_us))
+    {
+        return;
+    }
+
+    uint8_t xfer = hi2c->xfer;
+
+    // the peripheral is free again before the callback runs, as in the HAL
+    hi2c->xfer = HAL_MOCK_XFER_NONE;
+
+    if (0U != hi2c->lose_callbacks)
+    {
+        hi2c->lose_callbacks--;
+        hi2c->lost_callbacks++;
+        return;
+    }
+
+    hi2c->callbacks++;
+
+    if (AGS10_OK != hi2c->result)
+    {
+        hi2c->ErrorCode = (AGS10_ERR_NACK == hi2c->result) ? HAL_I2C_ERROR_AF : HAL_I2C_ERROR_BERR;
+        HAL_I2C_ErrorCallback(hi2c);
+    }
+    else if (HAL_MOCK_XFER_RX == xfer)
+    {
+        memcpy(hi2c->p_dst, hi2c->frame, hi2c->length);
+        HAL_I2C_MasterRxCpltCallback(hi2c);
+    }
+    else
+    {
+        HAL_I2C_MasterTxCpltCallback(hi2c);
+    }
+}
+
+static HAL_StatusTypeDef mock_start(I2C_HandleTypeDef *hi2c, uint8_t xfer, uint16_t DevAddress, uint8_t *pData,
+                                    uint16_t Size)
+{
+    if (HAL_MOCK_XFER_NONE != hi2c->xfer)
+    {
+        hi2c->busy_rejects++;
+        return HAL_BUSY;
+    }
+
+    if ((HAL_MOCK_XFER_RX == xfer) && (Size > sizeof(hi2c->frame)))
+    {
+        return HAL_ERROR;
+    }
+
+    hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+    hi2c->xfer = xfer;
+    hi2c->started++;
+
+    if (HAL_MOCK_XFER_RX == xfer)
+    {
+        hi2c->result = ags10_sim_bus_ops.read(hi2c->p_sim, (uint8_t)(DevAddress >> 1), hi2c->frame, Size);
+        hi2c->p_dst = pData;
+        hi2c->length = Size;
+    }
+    else
+    {
+        hi2c->result = ags10_sim_bus_ops.write(hi2c->p_sim, (uint8_t)(DevAddress >> 1), pData, Size);
+    }
+
+    // a stuck bus is refused up front, like the HAL's busy flag check
+    if (AGS10_ERR_BUSY == hi2c->result)
+    {
+        hi2c->xfer = HAL_MOCK_XFER_NONE;
+        return HAL_BUSY;
+    }
+
+    hi2c->done_us = hi2c->p_sim->now_us + hi2c->latency_us;
+
+    return HAL_OK;
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+void hal_mock_i2c_init(I2C_HandleTypeDef *hi2c, AGS10_SimBusTypeDef *p_sim)
+{
+    memset(hi2c, 0, sizeof(*hi2c));
+    hi2c->p_sim = p_sim;
+    hi2c->latency_us = HAL_MOCK_LATENCY_US;
+
+    if (NULL == mock_clock)
+    {
+        mock_clock = p_sim;
+    }
+
+    for (uint32_t idx = 0; idx < HAL_MOCK_MAX_HANDLES; idx++)
+    {
+        if ((NULL == mock_handles[idx]) || (hi2c == mock_handles[idx]))
+        {
+            mock_handles[idx] = hi2c;
+            return;
+        }
+    }
+}
+
+void hal_mock_irq(void)
+{
+    for (uint32_t idx = 0; idx < HAL_MOCK_MAX_HANDLES; idx++)
+    {
+        if (NULL != mock_handles[idx])
+        {
+            mock_complete(mock_handles[idx]);
+        }
+    }
+}
+
+void hal_mock_run(uint32_t us)
+{
+    // in steps of 100 us, so a callback fires close to when it is due
+    while (0U != us)
+    {
+        uint32_t step = (us < 100U) ? us : 100U;
+
+        ags10_sim_advance_us(mock_clock, step);
+        hal_mock_irq();
+        us -= step;
+    }
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return ags10_sim_tick_ms(mock_clock);
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+    hal_mock_run(Delay * 1000U);
+}
+
+uint32_t HAL_I2C_GetError(I2C_HandleTypeDef *hi2c)
+{
+    return hi2c->ErrorCode;
+}
+
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint32_t Trials,
+                                        uint32_t Timeout)
+{
+    (void)Trials;
+    (void)Timeout;
+
+    if (HAL_MOCK_XFER_NONE != hi2c->xfer)
+    {
+        return HAL_BUSY;
+    }
+
+    switch (ags10_sim_bus_ops.write(hi2c->p_sim, (uint8_t)(DevAddress >> 1), NULL, 0))
+    {
+    case AGS10_OK:
+        return HAL_OK;
+    case AGS10_ERR_BUSY:
+        return HAL_BUSY;
+    default:
+        hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+        return HAL_ERROR;
+    }
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                                  uint16_t Size, uint32_t XferOptions)
+{
+    (void)XferOptions;
+    return mock_start(hi2c, HAL_MOCK_XFER_TX, DevAddress, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Receive_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                                 uint16_t Size, uint32_t XferOptions)
+{
+    (void)XferOptions;
+    return mock_start(hi2c, HAL_MOCK_XFER_RX, DevAddress, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                             uint16_t Size)
+{
+    return mock_start(hi2c, HAL_MOCK_XFER_TX, DevAddress, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                            uint16_t Size)
+{
+    return mock_start(hi2c, HAL_MOCK_XFER_RX, DevAddress, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Abort_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress)
+{
+    (void)DevAddress;
+
+    // the callback comes even if the transfer it cuts off had already ended
+    hi2c->xfer = HAL_MOCK_XFER_NONE;
+    HAL_I2C_AbortCpltCallback(hi2c);
+
+    return HAL_OK;
+}
+// eof
@@ -0,0 +1,135 @@
+/**
+ * @file stm32f1xx_hal.h
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Host stand-in for the STM32 HAL, just enough for the example's I2C
+ *        back ends, over the simulated bus.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef INC_STM32F1XX_HAL_H_
+#define INC_STM32F1XX_HAL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ags10_sim.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define HAL_I2C_ERROR_NONE          0x00000000U
+#define HAL_I2C_ERROR_BERR          0x00000001U
+#define HAL_I2C_ERROR_AF            0x00000004U
+#define HAL_I2C_ERROR_TIMEOUT       0x00000020U
+
+#define I2C_FIRST_AND_LAST_FRAME    0x00000008U
+
+#define HAL_MOCK_MAX_HANDLES        2U
+#define HAL_MOCK_LATENCY_US         500U    /**< End of the bytes to the interrupt. */
+
+/* The host's full barrier stands in for the Cortex-M one. */
+#define __DMB()                     __sync_synchronize()
+
+/*******************************************************************************/
+
+/*******************************************************************************
+* Structs
+ ******************************************************************************/
+typedef enum {
+    HAL_OK      = 0x00U,
+    HAL_ERROR   = 0x01U,
+    HAL_BUSY    = 0x02U,
+    HAL_TIMEOUT = 0x03U,
+} HAL_StatusTypeDef;
+
+/**
+ * @brief Transfer the mock has started and not yet completed.
+ */
+typedef enum {
+    HAL_MOCK_XFER_NONE = 0,
+    HAL_MOCK_XFER_TX,
+    HAL_MOCK_XFER_RX,
+} HAL_MockXferTypeDef;
+
+/**
+ * @brief I2C handle: ErrorCode as in the HAL, then the mock's own state.
+ *
+ * A transfer runs on the simulated bus when it is started. Its callback
+ * fires latency_us later, from HAL_Delay() or hal_mock_run(), the way the
+ * interrupt would preempt the main loop. ErrorCode is set before
+ * HAL_I2C_ErrorCallback(), as the HAL does.
+ */
+typedef struct {
+    volatile uint32_t ErrorCode;
+
+    /* Host mock */
+    AGS10_SimBusTypeDef *p_sim;
+    uint32_t latency_us;            /**< Model input: HAL_MOCK_LATENCY_US. */
+    uint32_t lose_callbacks;        /**< Model input: callbacks to drop. */
+    uint8_t xfer;                   /**< HAL_MockXferTypeDef */
+    AGS10_StatusTypeDef result;
+    uint64_t done_us;
+    uint8_t *p_dst;
+    uint8_t frame[AGS10MA_FRAME_LEN];
+    uint16_t length;
+
+    /* Statistics */
+    uint32_t started;
+    uint32_t busy_rejects;          /**< Starts refused with HAL_BUSY. */
+    uint32_t callbacks;
+    uint32_t lost_callbacks;
+} I2C_HandleTypeDef;
+
+/*******************************************************************************
+* Public Function Declaration
+ ******************************************************************************/
+
+/**
+ * @brief Attach a handle to the simulated bus, as MX_I2Cx_Init() would.
+ *
+ * The first bus attached also drives HAL_GetTick() and HAL_Delay().
+ *
+ * @param[out] hi2c Handle to initialise.
+ * @param[in] p_sim Simulated bus.
+ */
+void hal_mock_i2c_init(I2C_HandleTypeDef *hi2c, AGS10_SimBusTypeDef *p_sim);
+
+/**
+ * @brief Fire the callback of every transfer that is due, then return.
+ */
+void hal_mock_irq(void);
+
+/**
+ * @brief Advance virtual time, firing callbacks as they fall due.
+ *
+ * @param[in] us Microseconds to run.
+ */
+void hal_mock_run(uint32_t us);
+
+/* HAL subset used by the example */
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+uint32_t HAL_I2C_GetError(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint32_t Trials,
+                                        uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                                  uint16_t Size, uint32_t XferOptions);
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Receive_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                                 uint16_t Size, uint32_t XferOptions);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                             uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                            uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Abort_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress);
+
+/* Defined by the test, as by the application on the target */
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_AbortCpltCallback(I2C_HandleTypeDef *hi2c);
+
+#endif /* INC_STM32F1XX_HAL_H_ */
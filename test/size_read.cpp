@@ -0,0 +1,94 @@
+/**
+ * @file size_read.cpp
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Smallest program doing one TVOC read, for make size.
+ *
+ * Built three times at -Os with unused sections dropped:
+ * AGS10_SIZE_READ 0 sets up the bus and reads nothing, 1 reads through
+ * ags10_tvoc_get() and 2 through the C++ driver. The bus is the same out
+ * of line ops table in all three, so the difference to the first is the
+ * code a TVOC read pulls in.
+ *
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10.hpp"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#ifndef AGS10_SIZE_READ
+#define AGS10_SIZE_READ     0
+#endif
+
+#define SIZE_ADDR           0x1AU
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static volatile std::uint8_t size_bus_byte;
+static volatile std::uint32_t size_sink;
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+__attribute__((noinline)) static AGS10_StatusTypeDef size_write(void *, uint8_t, uint8_t *p_data, uint16_t length)
+{
+    for (uint16_t idx = 0; idx < length; idx++)
+    {
+        size_bus_byte = p_data[idx];
+    }
+
+    return AGS10_OK;
+}
+
+__attribute__((noinline)) static AGS10_StatusTypeDef size_read(void *, uint8_t, uint8_t *p_data, uint16_t length)
+{
+    for (uint16_t idx = 0; idx < length; idx++)
+    {
+        p_data[idx] = size_bus_byte;
+    }
+
+    return AGS10_OK;
+}
+
+__attribute__((noinline)) static void size_delay(void *, uint16_t ms)
+{
+    size_bus_byte = static_cast<std::uint8_t>(ms);
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main()
+{
+    static AGS10_BusOpsTypeDef size_ops = {};
+
+    size_ops.write = size_write;
+    size_ops.read = size_read;
+    size_ops.delay = size_delay;
+
+#if (1 == AGS10_SIZE_READ)
+    AGS10_HandleTypeDef h_sensor;
+    uint32_t tvoc = 0;
+
+    (void)ags10_init(&h_sensor, SIZE_ADDR, &size_ops, NULL);
+    size_sink = (AGS10_OK == ags10_tvoc_get(&h_sensor, &tvoc)) ? tvoc : 0U;
+#elif (2 == AGS10_SIZE_READ)
+    ags10::Ags10<ags10::OpsBus, SIZE_ADDR> sensor(ags10::OpsBus(&size_ops, nullptr));
+    ags10::Result<ags10::Tvoc> tvoc = sensor.tvoc();
+
+    size_sink = tvoc.ok() ? tvoc->ppb : 0U;
+#else
+    // keep the bus, as the reads would
+    size_sink = reinterpret_cast<std::uintptr_t>(&size_ops);
+#endif
+
+    return 0;
+}
+// eof
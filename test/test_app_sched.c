@@ -0,0 +1,188 @@
+/**
+ * @file test_app_sched.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief The example's task scheduler on a simulated tick and cycle counter.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "app_sched.h"
+#include "ags10_test.h"
+
+#include <stddef.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define TEST_CYCLES_PER_MS  72000U      /**< SYSCLK of the example. */
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+/* Simulated core: the tick follows the cycle counter. */
+static uint64_t sim_cycles;
+static uint32_t sim_tick_base;
+static uint32_t sim_idles;
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static uint32_t sim_get_tick_ms(void)
+{
+    return sim_tick_base + (uint32_t)(sim_cycles / TEST_CYCLES_PER_MS);
+}
+
+static uint32_t sim_get_cycles(void)
+{
+    return (uint32_t)sim_cycles;
+}
+
+/* __WFI(): sleep until the next SysTick. */
+static void sim_idle(void)
+{
+    sim_cycles += TEST_CYCLES_PER_MS - (sim_cycles % TEST_CYCLES_PER_MS);
+    sim_idles++;
+}
+
+static const APP_SchedPortTypeDef sim_port = {
+    .get_tick_ms = sim_get_tick_ms,
+    .get_cycles  = sim_get_cycles,
+    .idle        = sim_idle,
+};
+
+typedef struct {
+    uint32_t cost_cycles;
+    uint32_t period_ms;
+} TEST_TaskArgTypeDef;
+
+static uint32_t test_task(void *p_arg)
+{
+    const TEST_TaskArgTypeDef *p_task = (const TEST_TaskArgTypeDef *)p_arg;
+
+    sim_cycles += p_task->cost_cycles;
+
+    return p_task->period_ms;
+}
+
+static void test_reset(uint32_t tick_base)
+{
+    sim_cycles = 0;
+    sim_tick_base = tick_base;
+    sim_idles = 0;
+}
+
+static void test_run_ms(APP_SchedTypeDef *p_sched, uint32_t ms)
+{
+    uint32_t start = sim_get_tick_ms();
+
+    while ((sim_get_tick_ms() - start) < ms)
+    {
+        app_sched_run_once(p_sched);
+    }
+}
+
+static void test_periods(void)
+{
+    TEST_TaskArgTypeDef fast = { .cost_cycles = 1000U, .period_ms = 10U };
+    TEST_TaskArgTypeDef slow = { .cost_cycles = 3600U, .period_ms = 25U };
+    APP_TaskTypeDef tasks[] = {
+        { .name = "fast", .fn = test_task, .p_arg = &fast },
+        { .name = "slow", .fn = test_task, .p_arg = &slow },
+    };
+    APP_SchedTypeDef sched;
+
+    test_reset(0);
+    AGS10_TEST_CHECK(app_sched_init(&sched, tasks, 2, &sim_port));
+    test_run_ms(&sched, 1000U);
+
+    // both run at once, then at tick 10, 20, ... and 25, 50, ...
+    AGS10_TEST_EQ(tasks[0].runs, 100);
+    AGS10_TEST_EQ(tasks[1].runs, 40);
+    AGS10_TEST_EQ(tasks[0].wcet_cycles, 1000);
+    AGS10_TEST_EQ(tasks[1].total_cycles, 40U * 3600U);
+    AGS10_TEST_EQ(sched.busy_cycles, (100U * 1000U) + (40U * 3600U));
+    AGS10_TEST_EQ(sched.busy_cycles + sched.idle_cycles, 1000ULL * TEST_CYCLES_PER_MS);
+    AGS10_TEST_EQ(app_sched_idle_percent(&sched), 99);
+
+    // a longer run raises the worst case, the reset clears it
+    slow.cost_cycles = 36000U;
+    test_run_ms(&sched, 25U);
+    AGS10_TEST_EQ(tasks[1].wcet_cycles, 36000);
+    app_sched_stats_reset(&sched);
+    AGS10_TEST_EQ(tasks[1].wcet_cycles, 0);
+    AGS10_TEST_EQ(tasks[0].runs, 0);
+    AGS10_TEST_EQ(app_sched_idle_percent(&sched), 100);
+}
+
+static void test_load(void)
+{
+    TEST_TaskArgTypeDef busy = { .cost_cycles = TEST_CYCLES_PER_MS / 4U, .period_ms = 1U };
+    TEST_TaskArgTypeDef spin = { .cost_cycles = 100U, .period_ms = 0U };
+    APP_TaskTypeDef tasks[] = {
+        { .name = "busy", .fn = test_task, .p_arg = &busy },
+    };
+    APP_SchedTypeDef sched;
+
+    // a task due every millisecond for a quarter of it: 75 % idle
+    test_reset(0);
+    AGS10_TEST_CHECK(app_sched_init(&sched, tasks, 1, &sim_port));
+    test_run_ms(&sched, 1000U);
+    AGS10_TEST_EQ(app_sched_idle_percent(&sched), 75);
+
+    // a task that is always due never lets the core sleep
+    tasks[0].p_arg = &spin;
+    app_sched_stats_reset(&sched);
+    sim_idles = 0;
+    test_run_ms(&sched, 10U);
+    AGS10_TEST_EQ(sim_idles, 0);
+    AGS10_TEST_EQ(app_sched_idle_percent(&sched), 0);
+}
+
+static void test_wrap(void)
+{
+    TEST_TaskArgTypeDef task = { .cost_cycles = 500U, .period_ms = 10U };
+    APP_TaskTypeDef tasks[] = {
+        { .name = "wrap", .fn = test_task, .p_arg = &task },
+    };
+    APP_SchedTypeDef sched;
+
+    // the tick wraps 50 ms in; the period must hold across it
+    test_reset(0xFFFFFFFFU - 49U);
+    AGS10_TEST_CHECK(app_sched_init(&sched, tasks, 1, &sim_port));
+    test_run_ms(&sched, 100U);
+    AGS10_TEST_EQ(tasks[0].runs, 10);
+    AGS10_TEST_EQ(sim_get_tick_ms(), 50);
+}
+
+static void test_args(void)
+{
+    static const APP_SchedPortTypeDef no_idle = {
+        .get_tick_ms = sim_get_tick_ms,
+        .get_cycles  = sim_get_cycles,
+    };
+    APP_TaskTypeDef tasks[1] = { { .name = "none", .fn = test_task } };
+    APP_SchedTypeDef sched;
+
+    AGS10_TEST_CHECK(!app_sched_init(NULL, tasks, 1, &sim_port));
+    AGS10_TEST_CHECK(!app_sched_init(&sched, NULL, 1, &sim_port));
+    AGS10_TEST_CHECK(!app_sched_init(&sched, tasks, 1, NULL));
+    AGS10_TEST_CHECK(!app_sched_init(&sched, tasks, 1, &no_idle));
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    test_periods();
+    test_load();
+    test_wrap();
+    test_args();
+
+    return ags10_test_done("app_sched");
+}
+// eof
@@ -0,0 +1,188 @@
+/**
+ * @file test_async.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Driver and scheduler on an asynchronous bus: completions, lost
+ *        completions and one transfer in flight at a time.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10.h"
+#include "ags10_sched.h"
+#include "ags10_sim.h"
+#include "ags10_sim_async.h"
+#include "ags10_test.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define TEST_SENSORS    8U
+#define TEST_ADDR       0x1AU
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static AGS10_SimDeviceTypeDef devices[TEST_SENSORS];
+static AGS10_SimBusTypeDef bus;
+static AGS10_SimAsyncTypeDef async;
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static void test_setup(uint16_t count)
+{
+    for (uint16_t idx = 0; idx < count; idx++)
+    {
+        ags10_sim_device_init(&devices[idx], (uint8_t)(TEST_ADDR + idx));
+        devices[idx].tvoc_ppb = 100U + idx;
+    }
+    ags10_sim_bus_init(&bus, devices, count, AGS10_SIM_DEFAULT_CLOCK_HZ);
+    ags10_sim_advance_us(&bus, (uint64_t)AGS10_SIM_PREHEAT_MS * 1000U);
+    ags10_sim_async_init(&async, &bus);
+}
+
+/* Polls every millisecond until the read ends. */
+static AGS10_XferResultTypeDef test_poll(AGS10_HandleTypeDef *ph_sensor, uint32_t *p_value, uint32_t *p_ms)
+{
+    uint32_t start_ms = ags10_sim_tick_ms(&bus);
+    AGS10_XferResultTypeDef result;
+
+    while (AGS10_XFER_PENDING == (result = ags10_register_read_poll(ph_sensor, ags10_sim_tick_ms(&bus), p_value)))
+    {
+        ags10_sim_advance_us(&bus, 1000U);
+    }
+    *p_ms = ags10_sim_tick_ms(&bus) - start_ms;
+
+    return result;
+}
+
+static void test_poll_path(void)
+{
+    AGS10_HandleTypeDef sensor;
+    uint32_t value = 0;
+    uint32_t ms;
+
+    test_setup(1);
+    (void)ags10_init(&sensor, TEST_ADDR, &ags10_sim_async_bus_ops, &async);
+
+    // the pointer write stays in flight until its completion is published
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_VERSION_REG, AGS10MA_VERSION_DELAY_MS,
+                                            ags10_sim_tick_ms(&bus)), AGS10_OK);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_WRITING);
+    AGS10_TEST_EQ(ags10_register_read_poll(&sensor, ags10_sim_tick_ms(&bus), &value), AGS10_XFER_PENDING);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_WRITING);
+
+    ags10_sim_advance_us(&bus, AGS10_SIM_ASYNC_LATENCY_US);
+    AGS10_TEST_EQ(ags10_register_read_poll(&sensor, ags10_sim_tick_ms(&bus), &value), AGS10_XFER_PENDING);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_CONVERTING);
+
+    AGS10_TEST_EQ(test_poll(&sensor, &value, &ms), AGS10_XFER_DONE);
+    AGS10_TEST_EQ(value & 0xFFU, AGS10_SIM_VERSION);
+    AGS10_TEST_EQ(sensor.last_status, AGS10_OK);
+    AGS10_TEST_EQ(async.completions, 2);
+
+    // a frame that arrives after its completion only
+    AGS10_TEST_EQ(ags10_firmware_version_get(&sensor, &value), AGS10_OK);
+    AGS10_TEST_EQ(value, AGS10_SIM_VERSION);
+    AGS10_TEST_EQ(async.busy_rejects, 0);
+}
+
+static void test_lost_completion(void)
+{
+    AGS10_HandleTypeDef sensor;
+    uint32_t value = 0;
+    uint32_t ms;
+
+    test_setup(1);
+    (void)ags10_init(&sensor, TEST_ADDR, &ags10_sim_async_bus_ops, &async);
+
+    // pointer write never completes: the poll path gives up at the deadline
+    uint32_t start_ms = ags10_sim_tick_ms(&bus);
+
+    async.lose_completions = 1;
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_VERSION_REG, AGS10MA_VERSION_DELAY_MS,
+                                            start_ms), AGS10_OK);
+    AGS10_TEST_EQ(test_poll(&sensor, &value, &ms), AGS10_XFER_ERROR);
+    AGS10_TEST_EQ(sensor.last_status, AGS10_ERR_TIMEOUT);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_IDLE);
+    AGS10_TEST_EQ(ags10_sim_tick_ms(&bus) - start_ms, AGS10MA_XFER_TIMEOUT_MS);
+    ags10_sim_async_abort(&async);
+
+    // frame read never completes
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_VERSION_REG, AGS10MA_VERSION_DELAY_MS,
+                                            ags10_sim_tick_ms(&bus)), AGS10_OK);
+    ags10_sim_advance_us(&bus, AGS10_SIM_ASYNC_LATENCY_US);
+    (void)ags10_register_read_poll(&sensor, ags10_sim_tick_ms(&bus), &value);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_CONVERTING);
+    async.lose_completions = 1;
+    AGS10_TEST_EQ(test_poll(&sensor, &value, &ms), AGS10_XFER_ERROR);
+    AGS10_TEST_EQ(sensor.last_status, AGS10_ERR_TIMEOUT);
+    AGS10_TEST_EQ(async.lost_completions, 2);
+    ags10_sim_async_abort(&async);
+
+    // the blocking API times out the same way
+    async.lose_completions = 1;
+    AGS10_TEST_EQ(ags10_firmware_version_get(&sensor, &value), AGS10_ERR_TIMEOUT);
+    ags10_sim_async_abort(&async);
+    AGS10_TEST_EQ(ags10_firmware_version_get(&sensor, &value), AGS10_OK);
+}
+
+static void test_sched_round(void)
+{
+    AGS10_HandleTypeDef sensors[TEST_SENSORS];
+    AGS10_SchedResultTypeDef results[TEST_SENSORS];
+    AGS10_SchedTypeDef sched;
+
+    test_setup(TEST_SENSORS);
+    for (uint16_t idx = 0; idx < TEST_SENSORS; idx++)
+    {
+        (void)ags10_init(&sensors[idx], (uint8_t)(TEST_ADDR + idx), &ags10_sim_async_bus_ops, &async);
+    }
+    AGS10_TEST_CHECK(ags10_sched_init(&sched, sensors, results, TEST_SENSORS, AGS10MA_TVOC_STAT_REG,
+                                      AGS10MA_TVOC_DELAY_MS, ags10_sim_tick_ms, &bus));
+
+    for (uint32_t round = 0; round < 3U; round++)
+    {
+        uint32_t ok = 0;
+
+        // every sensor counts as pending, though only one pointer is on the bus
+        AGS10_TEST_EQ(ags10_sched_round_start(&sched), TEST_SENSORS);
+        AGS10_TEST_EQ(sensors[0].xfer_state, AGS10_XFER_WRITING);
+        AGS10_TEST_EQ(sensors[1].xfer_state, AGS10_XFER_IDLE);
+
+        while (!ags10_sched_poll(&sched))
+        {
+            uint32_t wait_ms = ags10_sched_next_due_ms(&sched);
+
+            ags10_sim_advance_us(&bus, (uint64_t)((0U != wait_ms) ? wait_ms : 1U) * 1000U);
+        }
+
+        for (uint16_t idx = 0; idx < TEST_SENSORS; idx++)
+        {
+            ok += ((AGS10_OK == results[idx].status) &&
+                   ((results[idx].value & AGS10MA_TVOC_MSK) == (100U + idx))) ? 1U : 0U;
+        }
+        AGS10_TEST_EQ(ok, TEST_SENSORS);
+        // the conversions still overlap
+        AGS10_TEST_CHECK(sched.last_round_ms < (AGS10MA_TVOC_DELAY_MS + 100U));
+    }
+
+    AGS10_TEST_EQ(async.busy_rejects, 0);
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    test_poll_path();
+    test_lost_completion();
+    test_sched_round();
+
+    return ags10_test_done("async");
+}
+// eof
@@ -0,0 +1,215 @@
+/**
+ * @file test_clock.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Clock calibration on the simulator's clean_hz/fail_hz model, with
+ *        its record kept on the flash simulator.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_clock.h"
+#include "ags10_sim.h"
+#include "ags10_flash_sim.h"
+#include "ags10_test.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define TEST_ADDR       0x1AU
+#define TEST_PAGE_ADDR  0x0800DC00UL
+#define TEST_PAGE_SIZE  1024U
+#define TEST_SEEDS      1000U
+#define TEST_SAVES      300U            /**< Enough records to wrap the page twice. */
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static AGS10_SimDeviceTypeDef device;
+static AGS10_SimBusTypeDef bus;
+
+static uint8_t flash_mem[TEST_PAGE_SIZE];
+static uint32_t flash_wear[1];
+static AGS10_FlashSimTypeDef flash;
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static bool set_clock(void *p_ctx, uint32_t clock_hz)
+{
+    ((AGS10_SimBusTypeDef *)p_ctx)->clock_hz = clock_hz;
+
+    return true;
+}
+
+static bool cal_init(AGS10_ClockCalTypeDef *p_cal)
+{
+    return ags10_clock_init(p_cal, &ags10_sim_bus_ops, &bus, TEST_ADDR, set_clock, &bus,
+                            ags10_clock_rates, AGS10_CLOCK_RATE_COUNT);
+}
+
+static void bus_reset(uint32_t clean_hz, uint32_t fail_hz, uint32_t seed)
+{
+    ags10_sim_device_init(&device, TEST_ADDR);
+    ags10_sim_bus_init(&bus, &device, 1, AGS10_SIM_DEFAULT_CLOCK_HZ);
+    bus.clean_hz = clean_hz;
+    bus.fail_hz = fail_hz;
+    bus.seed = seed;
+}
+
+/**
+ * @brief Seeded sweeps: the result is the fastest clean rate and never a
+ *        rate where reads glitch, whatever the draws.
+ */
+static void test_sweeps(void)
+{
+    AGS10_ClockCalTypeDef cal;
+    uint32_t at_30k = 0;
+    uint32_t above_15k = 0;
+    uint64_t cal_ms = 0;
+
+    for (uint32_t seed = 1; seed <= TEST_SEEDS; seed++)
+    {
+        bus_reset(30000U, 60000U, seed * 2654435761U);
+        (void)cal_init(&cal);
+        at_30k += ((AGS10_OK == ags10_clock_calibrate(&cal)) && (30000U == cal.clock_hz)) ? 1U : 0U;
+        cal_ms += cal.cal_ms;
+
+        bus_reset(12000U, 25000U, seed * 2654435761U);
+        (void)cal_init(&cal);
+        (void)ags10_clock_calibrate(&cal);
+        above_15k += (cal.clock_hz > 15000U) ? 1U : 0U;
+    }
+
+    AGS10_TEST_EQ(at_30k, TEST_SEEDS);
+    AGS10_TEST_EQ(above_15k, 0);
+    // README: about 1 s of bus time per sweep
+    AGS10_TEST_CHECK((cal_ms / TEST_SEEDS) >= 900U);
+    AGS10_TEST_CHECK((cal_ms / TEST_SEEDS) <= 1100U);
+}
+
+/**
+ * @brief Store, reload after a reboot, lower on a degraded bus, and keep
+ *        the slowest rate on a dead one.
+ */
+static void test_lifecycle(void)
+{
+    AGS10_ClockCalTypeDef cal;
+    AGS10_ClockCalTypeDef boot;
+
+    ags10_flash_sim_init(&flash, flash_mem, flash_wear, TEST_PAGE_ADDR, TEST_PAGE_SIZE, 1);
+    bus_reset(30000U, 60000U, 1U);
+
+    AGS10_TEST_CHECK(cal_init(&cal));
+    AGS10_TEST_CHECK(ags10_clock_storage_set(&cal, &ags10_flash_sim_ops, &flash, TEST_PAGE_ADDR, TEST_PAGE_SIZE));
+    AGS10_TEST_EQ(ags10_clock_load(&cal), AGS10_ERR_PARAM);
+    AGS10_TEST_EQ(ags10_clock_calibrate(&cal), AGS10_OK);
+    AGS10_TEST_EQ(cal.clock_hz, 30000U);
+    AGS10_TEST_EQ(bus.clock_hz, 30000U);
+    AGS10_TEST_EQ(cal.saves, 1);
+
+    // reboot: the stored rate comes back and still holds
+    bus.clock_hz = AGS10_SIM_DEFAULT_CLOCK_HZ;
+    AGS10_TEST_CHECK(cal_init(&boot));
+    AGS10_TEST_CHECK(ags10_clock_storage_set(&boot, &ags10_flash_sim_ops, &flash, TEST_PAGE_ADDR, TEST_PAGE_SIZE));
+    AGS10_TEST_EQ(ags10_clock_load(&boot), AGS10_OK);
+    AGS10_TEST_EQ(boot.clock_hz, 30000U);
+    AGS10_TEST_EQ(bus.clock_hz, 30000U);
+    AGS10_TEST_EQ(boot.rate_index, 4);
+    AGS10_TEST_EQ(ags10_clock_validate(&boot), AGS10_OK);
+    AGS10_TEST_EQ(boot.downgrades, 0);
+    AGS10_TEST_EQ(boot.saves, 0);
+
+    // the harness degrades: validation steps down and stores the lower rate
+    bus.clean_hz = 12000U;
+    bus.fail_hz = 25000U;
+    AGS10_TEST_EQ(ags10_clock_validate(&boot), AGS10_OK);
+    AGS10_TEST_CHECK(boot.clock_hz <= 15000U);
+    AGS10_TEST_EQ(boot.downgrades, 1);
+    AGS10_TEST_EQ(boot.saves, 1);
+    AGS10_TEST_CHECK(ags10_clock_storage_set(&cal, &ags10_flash_sim_ops, &flash, TEST_PAGE_ADDR, TEST_PAGE_SIZE));
+    AGS10_TEST_EQ(cal.stored_hz, boot.clock_hz);
+
+    // nothing passes: the slowest rate is left in use
+    bus.clean_hz = 1000U;
+    bus.fail_hz = 5000U;
+    AGS10_TEST_CHECK(AGS10_OK != ags10_clock_calibrate(&boot));
+    AGS10_TEST_EQ(boot.clock_hz, ags10_clock_rates[0]);
+    AGS10_TEST_EQ(bus.clock_hz, ags10_clock_rates[0]);
+}
+
+/**
+ * @brief Records wrap the page, and a power cut mid-record keeps the
+ *        previous one.
+ */
+static void test_storage(void)
+{
+    AGS10_ClockCalTypeDef cal;
+    AGS10_ClockCalTypeDef boot;
+
+    ags10_flash_sim_init(&flash, flash_mem, flash_wear, TEST_PAGE_ADDR, TEST_PAGE_SIZE, 1);
+    bus_reset(0U, 25000U, 1U);
+    AGS10_TEST_CHECK(cal_init(&cal));
+    AGS10_TEST_CHECK(ags10_clock_storage_set(&cal, &ags10_flash_sim_ops, &flash, TEST_PAGE_ADDR, TEST_PAGE_SIZE));
+
+    // alternate between a clean bus (100 kHz) and a poor one (10 kHz)
+    for (uint32_t n = 0; n < TEST_SAVES; n++)
+    {
+        bus.clean_hz = (0U != (n & 1U)) ? 0U : 12000U;
+        cal.clock_hz = 0;
+        (void)ags10_clock_validate(&cal);
+    }
+
+    AGS10_TEST_EQ(cal.saves, TEST_SAVES);
+    AGS10_TEST_EQ(flash.erases, (TEST_SAVES * AGS10_CLOCK_REC_LEN) / TEST_PAGE_SIZE);
+    AGS10_TEST_CHECK(cal_init(&boot));
+    AGS10_TEST_CHECK(ags10_clock_storage_set(&boot, &ags10_flash_sim_ops, &flash, TEST_PAGE_ADDR, TEST_PAGE_SIZE));
+    AGS10_TEST_EQ(boot.stored_hz, cal.clock_hz);
+    AGS10_TEST_EQ(boot.rec_off, cal.rec_off);
+
+    // the next record is cut short by a power loss
+    uint32_t before_hz = cal.stored_hz;
+
+    bus.clean_hz = 12000U;
+    ags10_flash_sim_cut(&flash, 2, 7);
+    cal.clock_hz = 0;
+    (void)ags10_clock_validate(&cal);
+    ags10_flash_sim_power_on(&flash);
+
+    AGS10_TEST_CHECK(cal.clock_hz != before_hz);
+    AGS10_TEST_CHECK(cal_init(&boot));
+    AGS10_TEST_CHECK(ags10_clock_storage_set(&boot, &ags10_flash_sim_ops, &flash, TEST_PAGE_ADDR, TEST_PAGE_SIZE));
+    AGS10_TEST_EQ(boot.stored_hz, before_hz);
+}
+
+static void test_init(void)
+{
+    static const uint32_t descending[] = { 20000U, 10000U };
+    static const uint32_t repeated[] = { 10000U, 10000U };
+    AGS10_ClockCalTypeDef cal;
+
+    AGS10_TEST_CHECK(!ags10_clock_init(&cal, &ags10_sim_bus_ops, &bus, TEST_ADDR, set_clock, &bus, descending, 2));
+    AGS10_TEST_CHECK(!ags10_clock_init(&cal, &ags10_sim_bus_ops, &bus, TEST_ADDR, set_clock, &bus, repeated, 2));
+    AGS10_TEST_CHECK(!ags10_clock_init(&cal, &ags10_sim_bus_ops, &bus, TEST_ADDR, set_clock, &bus,
+                                       ags10_clock_rates, AGS10_CLOCK_MAX_RATES + 1U));
+    AGS10_TEST_CHECK(!ags10_clock_init(&cal, &ags10_sim_bus_ops, &bus, TEST_ADDR, NULL, &bus,
+                                       ags10_clock_rates, AGS10_CLOCK_RATE_COUNT));
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    test_sweeps();
+    test_lifecycle();
+    test_storage();
+    test_init();
+
+    return ags10_test_done("clock");
+}
+
+// eof
@@ -0,0 +1,274 @@
+/**
+ * @file test_codec.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Round trips of the sample codec at the delta boundaries, long runs,
+ *        odd block lengths, and truncated or malformed input.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_codec.h"
+#include "ags10_test.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define TEST_MAX_VALUES     20000U
+#define TEST_MAX_BLOCKS     TEST_MAX_VALUES     /**< Enough for a block length of 1. */
+#define TEST_RUN_LEN        10000U
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static uint32_t values[TEST_MAX_VALUES];
+static uint8_t code[TEST_MAX_VALUES * AGS10_CODEC_MAX_BYTES];
+static uint32_t offsets[TEST_MAX_BLOCKS];          /**< Restart points as the encoder reports them. */
+static uint32_t index_offsets[TEST_MAX_BLOCKS];    /**< The same, found by ags10_codec_index(). */
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+/*
+ * Encodes values[0..count), decodes it back as a stream and value by value
+ * through the index, and returns the encoded length.
+ */
+static uint32_t round_trip(uint32_t count, uint16_t block_len)
+{
+    AGS10_CodecEncTypeDef enc;
+    AGS10_CodecDecTypeDef dec;
+    uint32_t len = 0;
+    uint32_t restarts = 0;
+    uint32_t wrong = 0;
+
+    ags10_codec_enc_init(&enc, block_len);
+    for (uint32_t idx = 0; idx < count; idx++)
+    {
+        if (ags10_codec_enc_restart(&enc))
+        {
+            if (restarts < TEST_MAX_BLOCKS)
+            {
+                offsets[restarts] = len;
+            }
+            restarts++;
+        }
+
+        uint8_t used = ags10_codec_encode(&enc, values[idx], &code[len]);
+
+        wrong += ((0U == used) || (AGS10_CODEC_MAX_BYTES < used)) ? 1U : 0U;
+        len += used;
+    }
+
+    uint32_t offset = 0;
+
+    ags10_codec_dec_init(&dec, block_len);
+    for (uint32_t idx = 0; idx < count; idx++)
+    {
+        uint32_t value = ~values[idx];
+        uint8_t used = ags10_codec_decode(&dec, &code[offset], len - offset, &value);
+
+        wrong += ((0U == used) || (values[idx] != value)) ? 1U : 0U;
+        offset += used;
+    }
+    AGS10_TEST_EQ(offset, len);
+
+    // the index finds the encoder's restart points, and each value from them
+    uint32_t blocks = ags10_codec_index(code, len, block_len, index_offsets, TEST_MAX_BLOCKS);
+
+    AGS10_TEST_EQ(blocks, restarts);
+    AGS10_TEST_EQ(memcmp(index_offsets, offsets, blocks * sizeof(offsets[0])), 0);
+    for (uint32_t pos = 0; pos < count; pos++)
+    {
+        uint32_t value = ~values[pos];
+
+        wrong += (!ags10_codec_decode_at(code, len, block_len, index_offsets, blocks, pos, &value) ||
+                  (values[pos] != value)) ? 1U : 0U;
+    }
+
+    uint32_t value = 0;
+
+    AGS10_TEST_CHECK(!ags10_codec_decode_at(code, len, block_len, index_offsets, blocks, count, &value));
+    AGS10_TEST_EQ(wrong, 0);
+
+    return len;
+}
+
+/**
+ * @brief The byte layout: first value as is, then zig-zag deltas.
+ */
+static void test_golden(void)
+{
+    static const uint8_t golden[] = { 0xAC, 0x02, 0x02, 0x01, 0x00 };
+    AGS10_CodecEncTypeDef enc;
+    uint8_t out[sizeof(golden)];
+    uint32_t len = 0;
+
+    values[0] = 300U;
+    values[1] = 301U;
+    values[2] = 300U;
+    values[3] = 300U;
+
+    ags10_codec_enc_init(&enc, 0);
+    for (uint32_t idx = 0; idx < 4U; idx++)
+    {
+        len += ags10_codec_encode(&enc, values[idx], &out[len]);
+    }
+    AGS10_TEST_EQ(len, sizeof(golden));
+    AGS10_TEST_EQ(memcmp(out, golden, sizeof(golden)), 0);
+    AGS10_TEST_EQ(round_trip(4, 0), sizeof(golden));
+}
+
+/**
+ * @brief Each boundary delta between two values, and the code length it
+ *        takes after the first value's.
+ */
+static void test_deltas(void)
+{
+    static const struct {
+        uint32_t first;
+        uint32_t second;
+        uint32_t delta_bytes;
+    } cases[] = {
+        { 0U,          0U,          1U },   // 0
+        { 0U,          1U,          1U },   // +1
+        { 1U,          0U,          1U },   // -1
+        { 0U,          0xFFFFFFFFU, 1U },   // -1, wrapping
+        { 0xFFFFFFFFU, 0U,          1U },   // +1, wrapping
+        { 0U,          0x7FFFFFFFU, 5U },   // INT32_MAX
+        { 0x7FFFFFFFU, 0U,          5U },   // -INT32_MAX
+        { 0U,          0x80000000U, 5U },   // INT32_MIN
+        { 0x80000000U, 0U,          5U },   // INT32_MIN again: -INT32_MIN wraps to itself
+        { 63U,         0U,          1U },   // -63, the largest one-byte step down
+        { 0U,          64U,         2U },   // +64, the smallest two-byte step up
+    };
+
+    for (uint32_t idx = 0; idx < (sizeof(cases) / sizeof(cases[0])); idx++)
+    {
+        uint8_t first_bytes = 1U;
+
+        for (uint32_t rest = cases[idx].first >> 7; 0U != rest; rest >>= 7)
+        {
+            first_bytes++;
+        }
+
+        values[0] = cases[idx].first;
+        values[1] = cases[idx].second;
+        AGS10_TEST_EQ(round_trip(2, 0), first_bytes + cases[idx].delta_bytes);
+    }
+
+    // INT32_MIN zig-zags to all ones: the fifth byte is full at 0x0F
+    values[0] = 0U;
+    values[1] = 0x80000000U;
+    (void)round_trip(2, 0);
+    AGS10_TEST_EQ(code[1], 0xFF);
+    AGS10_TEST_EQ(code[5], 0x0F);
+}
+
+/**
+ * @brief Long runs: one byte per value past each block's first, five when
+ *        every step is an extreme.
+ */
+static void test_runs(void)
+{
+    uint32_t blocks = (TEST_RUN_LEN / AGS10_CODEC_BLOCK_LEN) + 1U;   // the last one partial
+
+    for (uint32_t idx = 0; idx < TEST_RUN_LEN; idx++)
+    {
+        values[idx] = 0xFFFFFFFFU;
+    }
+    AGS10_TEST_EQ(round_trip(TEST_RUN_LEN, 0), (TEST_RUN_LEN - blocks) + (5U * blocks));
+
+    for (uint32_t idx = 0; idx < TEST_RUN_LEN; idx++)
+    {
+        values[idx] = idx;
+    }
+    AGS10_TEST_CHECK(round_trip(TEST_RUN_LEN, 0) < (TEST_RUN_LEN + (2U * blocks)));
+
+    for (uint32_t idx = 0; idx < TEST_RUN_LEN; idx++)
+    {
+        values[idx] = (0U != (idx & 1U)) ? 0x80000000U : 0U;
+    }
+    AGS10_TEST_EQ(round_trip(TEST_RUN_LEN, 0), (5U * TEST_RUN_LEN) - (4U * blocks));
+
+    // odd block lengths, down to every value on its own
+    uint32_t seed = 3;
+    uint32_t prev = 0;
+
+    for (uint32_t idx = 0; idx < TEST_MAX_VALUES; idx++)
+    {
+        uint32_t draw = ags10_test_rand(&seed);
+
+        // small steps with a jump anywhere in 32 bits now and then
+        prev = (0U == (draw % 16U)) ? draw : (prev + ((draw >> 8) % 3U) - 1U);
+        values[idx] = prev;
+    }
+    (void)round_trip(TEST_MAX_VALUES, 1);
+    (void)round_trip(TEST_MAX_VALUES, 7);
+    (void)round_trip(TEST_MAX_VALUES, 0xFFFFU);
+}
+
+/**
+ * @brief Input that ends inside a value, or a value longer than 32 bits,
+ *        decodes to nothing and leaves the decoder as it was.
+ */
+static void test_truncated(void)
+{
+    static const uint8_t too_long[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x10 };
+    static const uint8_t no_end[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x00 };
+    AGS10_CodecDecTypeDef dec;
+    AGS10_CodecDecTypeDef before;
+    uint32_t value = 0x12345678U;
+
+    values[0] = 0U;
+    values[1] = 0x80000000U;
+    values[2] = 0x80000001U;
+    uint32_t len = round_trip(3, 0);
+
+    AGS10_TEST_EQ(len, 7);
+    ags10_codec_dec_init(&dec, 0);
+    AGS10_TEST_EQ(ags10_codec_decode(&dec, code, len, &value), 1);
+    before = dec;
+    for (uint32_t cut = 0; cut < AGS10_CODEC_MAX_BYTES; cut++)
+    {
+        AGS10_TEST_EQ(ags10_codec_decode(&dec, &code[1], cut, &value), 0);
+    }
+    AGS10_TEST_EQ(memcmp(&dec, &before, sizeof(dec)), 0);
+    AGS10_TEST_EQ(value, 0);
+    AGS10_TEST_EQ(ags10_codec_decode(&dec, &code[1], AGS10_CODEC_MAX_BYTES, &value), 5);
+    AGS10_TEST_EQ(value, 0x80000000U);
+
+    // the decoder never reads past what it is given, nor past a malformed value
+    before = dec;
+    AGS10_TEST_EQ(ags10_codec_decode(&dec, too_long, sizeof(too_long), &value), 0);
+    AGS10_TEST_EQ(ags10_codec_decode(&dec, no_end, sizeof(no_end), &value), 0);
+    AGS10_TEST_EQ(memcmp(&dec, &before, sizeof(dec)), 0);
+
+    // a stream cut inside its last value: every earlier one is still there
+    AGS10_TEST_EQ(ags10_codec_index(code, len - 1U, 0, index_offsets, 1), 1);
+    AGS10_TEST_EQ(index_offsets[0], 0);
+    AGS10_TEST_CHECK(ags10_codec_decode_at(code, len - 1U, 0, index_offsets, 1, 1, &value));
+    AGS10_TEST_EQ(value, 0x80000000U);
+    AGS10_TEST_CHECK(!ags10_codec_decode_at(code, len - 1U, 0, index_offsets, 1, 2, &value));
+    AGS10_TEST_CHECK(!ags10_codec_decode_at(code, 3, 0, index_offsets, 1, 1, &value));
+    AGS10_TEST_EQ(ags10_codec_index(code, 0, 0, index_offsets, 1), 0);
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    test_golden();
+    test_deltas();
+    test_runs();
+    test_truncated();
+
+    return ags10_test_done("codec");
+}
+
+// eof
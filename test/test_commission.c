@@ -0,0 +1,345 @@
+/**
+ * @file test_commission.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Re-addressing factory-default AGS10s on the simulator: a whole
+ *        plan confirmed by a scan, the address frame and its CRC, and each
+ *        conflict and failure path with its rollback.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_commission.h"
+#include "ags10_scan.h"
+#include "ags10_sim.h"
+#include "ags10_test.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define TEST_CLOCK_HZ       100000U
+#define TEST_DEVICES        4U
+#define TEST_FIRST_ADDR     0x20U
+#define TEST_DECOY_ADDR     0x21U
+#define TEST_NONE           0xFFFFU
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+/**
+ * @brief The simulator with faults on the address frame: its CRC byte
+ *        damaged on the way, or a NACK reported after it went through.
+ */
+typedef struct {
+    AGS10_SimBusTypeDef *p_sim;
+    bool crc_flip;
+    uint32_t nacks_after;       /**< Address frames still to report as NACKed once through. */
+    uint32_t frames;            /**< Address frames written. */
+    uint8_t frame[1U + AGS10MA_FRAME_LEN];      /**< The last one, as the driver sent it. */
+} TestBusTypeDef;
+
+/**
+ * @brief Power switches of the devices, with one that will not switch and
+ *        one that will not switch off.
+ */
+typedef struct {
+    uint16_t fails;             /**< Index that cannot be switched, or TEST_NONE. */
+    uint16_t stays_on;          /**< Index that is never isolated, or TEST_NONE. */
+    uint32_t ons;
+} TestSelectTypeDef;
+
+static AGS10_SimBusTypeDef sim;
+static AGS10_SimDeviceTypeDef devices[TEST_DEVICES + 1U];     /**< The plan's devices, then a decoy. */
+static TestBusTypeDef bus;
+static TestSelectTypeDef sel;
+static AGS10_CommissionEntryTypeDef plan[TEST_DEVICES];
+static AGS10_CommissionTypeDef comm;
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static AGS10_StatusTypeDef bus_write(void *p_ctx, uint8_t addr, uint8_t *p_data, uint16_t length)
+{
+    TestBusTypeDef *p_bus = (TestBusTypeDef *)p_ctx;
+    uint8_t data[1U + AGS10MA_FRAME_LEN];
+
+    if ((AGS10MA_SET_ADDR_REG != p_data[0]) || (sizeof(data) != length))
+    {
+        return ags10_sim_bus_ops.write(p_bus->p_sim, addr, p_data, length);
+    }
+
+    p_bus->frames++;
+    memcpy(p_bus->frame, p_data, sizeof(p_bus->frame));
+    memcpy(data, p_data, sizeof(data));
+    if (p_bus->crc_flip)
+    {
+        data[AGS10MA_FRAME_LEN] ^= 0x01U;
+    }
+
+    AGS10_StatusTypeDef status = ags10_sim_bus_ops.write(p_bus->p_sim, addr, data, length);
+
+    if ((AGS10_OK == status) && (0U != p_bus->nacks_after))
+    {
+        p_bus->nacks_after--;
+        return AGS10_ERR_NACK;
+    }
+
+    return status;
+}
+
+static AGS10_StatusTypeDef bus_read(void *p_ctx, uint8_t addr, uint8_t *p_data, uint16_t length)
+{
+    return ags10_sim_bus_ops.read(((TestBusTypeDef *)p_ctx)->p_sim, addr, p_data, length);
+}
+
+static void bus_delay(void *p_ctx, uint16_t ms)
+{
+    ags10_sim_bus_ops.delay(((TestBusTypeDef *)p_ctx)->p_sim, ms);
+}
+
+static uint32_t bus_tick_ms(void *p_ctx)
+{
+    return ags10_sim_tick_ms(((TestBusTypeDef *)p_ctx)->p_sim);
+}
+
+static const AGS10_BusOpsTypeDef bus_ops = {
+    .write       = bus_write,
+    .read        = bus_read,
+    .delay       = bus_delay,
+    .get_tick_ms = bus_tick_ms,
+};
+
+static bool select_device(void *p_ctx, uint16_t index, bool on)
+{
+    TestSelectTypeDef *p_sel = (TestSelectTypeDef *)p_ctx;
+
+    if (index == p_sel->fails)
+    {
+        return false;
+    }
+    if (!on && (index == p_sel->stays_on))
+    {
+        return true;
+    }
+
+    p_sel->ons += on ? 1U : 0U;
+    ags10_sim_device_power(&sim, &devices[index], on);
+
+    return true;
+}
+
+/* Isolated factory-default devices with versions 0x0B, 0x0C, ..., a decoy at addr if not 0, and the plan. */
+static void setup(uint8_t decoy_addr)
+{
+    uint16_t count = TEST_DEVICES;
+
+    for (uint16_t idx = 0; idx < TEST_DEVICES; idx++)
+    {
+        ags10_sim_device_init(&devices[idx], AGS10MA_I2C_DEVICE_ADDR);
+        devices[idx].version = (uint8_t)(AGS10_SIM_VERSION + idx);
+        plan[idx] = (AGS10_CommissionEntryTypeDef){ .new_addr = (uint8_t)(TEST_FIRST_ADDR + idx) };
+    }
+    if (0U != decoy_addr)
+    {
+        ags10_sim_device_init(&devices[count], decoy_addr);
+        devices[count].kind = AGS10_SIM_DECOY_REGISTERS;
+        count++;
+    }
+
+    ags10_sim_bus_init(&sim, devices, count, TEST_CLOCK_HZ);
+    for (uint16_t idx = 0; idx < TEST_DEVICES; idx++)
+    {
+        ags10_sim_device_power(&sim, &devices[idx], false);
+    }
+    bus = (TestBusTypeDef){ .p_sim = &sim };
+    sel = (TestSelectTypeDef){ .fails = TEST_NONE, .stays_on = TEST_NONE };
+    AGS10_TEST_CHECK(ags10_commission_init(&comm, &bus_ops, &bus, select_device, &sel, plan, TEST_DEVICES));
+}
+
+/* A failed entry: step, status, back at the factory address and switched off. */
+static void check_rolled_back(uint16_t idx, uint8_t step, AGS10_StatusTypeDef status)
+{
+    AGS10_TEST_EQ(plan[idx].step, step);
+    AGS10_TEST_EQ(plan[idx].status, status);
+    AGS10_TEST_CHECK(plan[idx].rolled_back);
+    AGS10_TEST_EQ(devices[idx].addr, AGS10MA_I2C_DEVICE_ADDR);
+    AGS10_TEST_EQ(devices[idx].addr_nv, AGS10MA_I2C_DEVICE_ADDR);
+    AGS10_TEST_CHECK(!devices[idx].powered);
+}
+
+static void test_init(void)
+{
+    setup(0);
+
+    plan[1].new_addr = plan[0].new_addr;
+    AGS10_TEST_CHECK(!ags10_commission_init(&comm, &bus_ops, &bus, select_device, &sel, plan, TEST_DEVICES));
+    plan[1].new_addr = AGS10MA_I2C_DEVICE_ADDR;
+    AGS10_TEST_CHECK(!ags10_commission_init(&comm, &bus_ops, &bus, select_device, &sel, plan, TEST_DEVICES));
+    plan[1].new_addr = AGS10_SCAN_FIRST_ADDR - 1U;
+    AGS10_TEST_CHECK(!ags10_commission_init(&comm, &bus_ops, &bus, select_device, &sel, plan, TEST_DEVICES));
+    plan[1].new_addr = AGS10_SCAN_LAST_ADDR + 1U;
+    AGS10_TEST_CHECK(!ags10_commission_init(&comm, &bus_ops, &bus, select_device, &sel, plan, TEST_DEVICES));
+    plan[1].new_addr = AGS10_SCAN_LAST_ADDR;
+    AGS10_TEST_CHECK(!ags10_commission_init(&comm, &bus_ops, &bus, NULL, &sel, plan, TEST_DEVICES));
+    AGS10_TEST_CHECK(!ags10_commission_init(&comm, &bus_ops, &bus, select_device, &sel, NULL, TEST_DEVICES));
+    AGS10_TEST_CHECK(ags10_commission_init(&comm, &bus_ops, &bus, select_device, &sel, plan, TEST_DEVICES));
+    AGS10_TEST_EQ(comm.from_addr, AGS10MA_I2C_DEVICE_ADDR);
+    AGS10_TEST_EQ(comm.power_on_ms, AGS10_COMMISSION_POWER_ON_MS);
+    AGS10_TEST_EQ(ags10_commission_device(&comm, TEST_DEVICES), AGS10_ERR_PARAM);
+}
+
+/**
+ * @brief A whole plan: every device at its own address with its version,
+ *        which a scan then finds, and a correct address frame on the wire.
+ */
+static void test_plan(void)
+{
+    AGS10_ScanBusTypeDef scan;
+    AGS10_ScanDeviceTypeDef found[TEST_DEVICES];
+
+    setup(0);
+    AGS10_TEST_EQ(ags10_commission_run(&comm), AGS10_OK);
+    AGS10_TEST_EQ(comm.done, TEST_DEVICES);
+    AGS10_TEST_EQ(comm.failed, 0);
+    AGS10_TEST_EQ(bus.frames, TEST_DEVICES);
+
+    uint32_t devices_ms = 0;
+
+    for (uint16_t idx = 0; idx < TEST_DEVICES; idx++)
+    {
+        devices_ms += plan[idx].elapsed_ms;
+        AGS10_TEST_EQ(plan[idx].step, AGS10_COMMISSION_STEP_DONE);
+        AGS10_TEST_EQ(plan[idx].status, AGS10_OK);
+        AGS10_TEST_EQ(plan[idx].version, AGS10_SIM_VERSION + idx);
+        AGS10_TEST_EQ(devices[idx].addr_nv, TEST_FIRST_ADDR + idx);
+        AGS10_TEST_CHECK(devices[idx].powered);
+        // settle, two version reads and the address write
+        AGS10_TEST_CHECK(plan[idx].elapsed_ms >= (AGS10_COMMISSION_POWER_ON_MS + (2U * AGS10MA_VERSION_DELAY_MS)));
+    }
+    AGS10_TEST_CHECK(comm.total_ms >= devices_ms);
+
+    // new address, its complement twice over, and the CRC of those four bytes
+    uint8_t last = TEST_FIRST_ADDR + TEST_DEVICES - 1U;
+
+    AGS10_TEST_EQ(bus.frame[0], AGS10MA_SET_ADDR_REG);
+    AGS10_TEST_EQ(bus.frame[1], last);
+    AGS10_TEST_EQ(bus.frame[2], (uint8_t)~last);
+    AGS10_TEST_EQ(bus.frame[3], last);
+    AGS10_TEST_EQ(bus.frame[4], (uint8_t)~last);
+    AGS10_TEST_EQ(bus.frame[5], ags10_crc8(&bus.frame[1], AGS10MA_DATA_LEN));
+
+    AGS10_TEST_CHECK(ags10_scan_bus_init(&scan, &bus_ops, &bus, found, TEST_DEVICES));
+    AGS10_TEST_EQ(ags10_scan_bus(&scan), AGS10_OK);
+    AGS10_TEST_EQ(scan.found, TEST_DEVICES);
+    AGS10_TEST_EQ(scan.rejected, 0);
+    for (uint16_t idx = 0; idx < TEST_DEVICES; idx++)
+    {
+        AGS10_TEST_EQ(found[idx].addr, TEST_FIRST_ADDR + idx);
+        AGS10_TEST_EQ(found[idx].version, AGS10_SIM_VERSION + idx);
+    }
+
+    // a power cycle keeps the new addresses
+    ags10_sim_device_power(&sim, &devices[2], false);
+    ags10_sim_device_power(&sim, &devices[2], true);
+    AGS10_TEST_EQ(devices[2].addr, TEST_FIRST_ADDR + 2U);
+}
+
+/**
+ * @brief Something already at a new address, or a device that will not
+ *        isolate and answers at the factory address too.
+ */
+static void test_conflicts(void)
+{
+    setup(TEST_DECOY_ADDR);
+    AGS10_TEST_EQ(ags10_commission_run(&comm), AGS10_ERR_BUSY);
+    AGS10_TEST_EQ(comm.done, TEST_DEVICES - 1U);
+    AGS10_TEST_EQ(comm.failed, 1);
+    AGS10_TEST_EQ(comm.rolled_back, 1);
+    check_rolled_back(1, AGS10_COMMISSION_STEP_CHECK_FREE, AGS10_ERR_BUSY);
+    // never talked to: no version, no address frame
+    AGS10_TEST_EQ(plan[1].version, 0);
+    AGS10_TEST_EQ(bus.frames, TEST_DEVICES - 1U);
+    AGS10_TEST_EQ(devices[2].addr, TEST_FIRST_ADDR + 2U);
+
+    // device 3 is on throughout: device 0 is re-addressed, then 0x1A still answers
+    setup(0);
+    sel.stays_on = 3;
+    ags10_sim_device_power(&sim, &devices[3], true);
+    comm.stop_on_failure = true;
+    AGS10_TEST_EQ(ags10_commission_run(&comm), AGS10_ERR_BUSY);
+    AGS10_TEST_EQ(comm.done, 0);
+    check_rolled_back(0, AGS10_COMMISSION_STEP_RELEASE, AGS10_ERR_BUSY);
+    AGS10_TEST_EQ(bus.frames, 2);       // assigned, then given the factory address back
+    AGS10_TEST_EQ(bus.frame[1], AGS10MA_I2C_DEVICE_ADDR);
+    for (uint16_t idx = 1; idx < TEST_DEVICES; idx++)
+    {
+        AGS10_TEST_EQ(plan[idx].step, AGS10_COMMISSION_STEP_PENDING);
+    }
+}
+
+/**
+ * @brief A device that cannot be switched on, is missing, ignores its
+ *        address frame, or takes it while the write is reported failed.
+ */
+static void test_failures(void)
+{
+    setup(0);
+    sel.fails = 0;
+    AGS10_TEST_EQ(ags10_commission_device(&comm, 0), AGS10_ERR_BUS);
+    AGS10_TEST_EQ(plan[0].step, AGS10_COMMISSION_STEP_SELECT);
+    AGS10_TEST_EQ(plan[0].status, AGS10_ERR_BUS);
+    AGS10_TEST_EQ(devices[0].addr_nv, AGS10MA_I2C_DEVICE_ADDR);
+
+    // switched on, but nothing answers at the factory address
+    setup(0);
+    devices[0].addr_nv = 0x50U;
+    AGS10_TEST_EQ(ags10_commission_device(&comm, 0), AGS10_ERR_NACK_WRITE);
+    AGS10_TEST_EQ(plan[0].step, AGS10_COMMISSION_STEP_FIND);
+    AGS10_TEST_CHECK(plan[0].rolled_back);
+    AGS10_TEST_EQ(bus.frames, 0);
+
+    // a damaged CRC: the device acknowledges and keeps its address
+    setup(0);
+    bus.crc_flip = true;
+    AGS10_TEST_EQ(ags10_commission_run(&comm), AGS10_ERR_NACK_WRITE);
+    AGS10_TEST_EQ(comm.failed, TEST_DEVICES);
+    AGS10_TEST_EQ(comm.rolled_back, TEST_DEVICES);
+    for (uint16_t idx = 0; idx < TEST_DEVICES; idx++)
+    {
+        check_rolled_back(idx, AGS10_COMMISSION_STEP_VERIFY, AGS10_ERR_NACK_WRITE);
+        AGS10_TEST_EQ(plan[idx].version, AGS10_SIM_VERSION + idx);
+    }
+    AGS10_TEST_EQ(bus.frames, TEST_DEVICES);
+
+    // the device took its address but the write was reported failed: found there and moved back
+    setup(0);
+    bus.nacks_after = 1;
+    AGS10_TEST_EQ(ags10_commission_device(&comm, 1), AGS10_ERR_NACK_WRITE);
+    check_rolled_back(1, AGS10_COMMISSION_STEP_ASSIGN, AGS10_ERR_NACK_WRITE);
+    AGS10_TEST_EQ(bus.frames, 2);
+    AGS10_TEST_EQ(bus.frame[1], AGS10MA_I2C_DEVICE_ADDR);
+
+    // and once the fault is gone the same device commissions
+    AGS10_TEST_EQ(ags10_commission_device(&comm, 1), AGS10_OK);
+    AGS10_TEST_EQ(devices[1].addr_nv, TEST_FIRST_ADDR + 1U);
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    test_init();
+    test_plan();
+    test_conflicts();
+    test_failures();
+
+    return ags10_test_done("commission");
+}
+
+// eof
@@ -0,0 +1,161 @@
+/**
+ * @file test_cpp.cpp
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief The header-only C++ driver on the simulator, and against the C
+ *        driver frame for frame.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10.hpp"
+#include "ags10_sim.h"
+#include "ags10_test.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define TEST_ADDR       0x1AU
+#define TEST_NEW_ADDR   0x1BU
+#define TEST_FRAMES     100000U
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+/* Next frame both drivers read, and the status the bus reports for it. */
+static std::uint8_t mem_frame[AGS10MA_FRAME_LEN];
+static AGS10_StatusTypeDef mem_write_status;
+static AGS10_StatusTypeDef mem_read_status;
+
+constexpr std::uint8_t beef[2] = { 0xBE, 0xEF };
+static_assert(0x92U == ags10::detail::crc8(beef, 2), "data sheet CRC example");
+static_assert(0xFFU == ags10::detail::crc8(beef, 0), "CRC of nothing is the initial value");
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+/** Stateless in-memory bus for the C++ driver. */
+struct MemBus {
+    ags10::Status write(std::uint8_t, const std::uint8_t *, std::uint16_t) { return mem_write_status; }
+
+    ags10::Status read(std::uint8_t, std::uint8_t *p_data, std::uint16_t length)
+    {
+        for (std::uint16_t idx = 0; idx < length; idx++)
+        {
+            p_data[idx] = mem_frame[idx];
+        }
+
+        return mem_read_status;
+    }
+
+    void delay_ms(std::uint16_t) {}
+};
+
+static_assert(1U == sizeof(ags10::Ags10<MemBus>), "a stateless bus adds no storage");
+
+/* The same bus as C operations, for the C driver. */
+static AGS10_StatusTypeDef mem_write(void *, uint8_t addr, uint8_t *p_data, uint16_t length)
+{
+    return MemBus{}.write(addr, p_data, length);
+}
+
+static AGS10_StatusTypeDef mem_read(void *, uint8_t addr, uint8_t *p_data, uint16_t length)
+{
+    return MemBus{}.read(addr, p_data, length);
+}
+
+static void mem_delay(void *, uint16_t) {}
+
+/**
+ * @brief Reads, set_address and the read at the new address, on the simulator.
+ */
+static void test_sim(void)
+{
+    AGS10_SimDeviceTypeDef device;
+    AGS10_SimBusTypeDef bus;
+
+    ags10_sim_device_init(&device, TEST_ADDR);
+    device.tvoc_ppb = 321U;
+    device.gas_res = 4567U;
+    ags10_sim_bus_init(&bus, &device, 1, AGS10_SIM_DEFAULT_CLOCK_HZ);
+    ags10_sim_advance_us(&bus, 200000000ULL);  // past preheat
+
+    ags10::Ags10<ags10::OpsBus, TEST_ADDR> sensor(ags10::OpsBus(&ags10_sim_bus_ops, &bus));
+
+    ags10::Result<ags10::Tvoc> tvoc = sensor.tvoc();
+    AGS10_TEST_CHECK(tvoc.ok());
+    AGS10_TEST_EQ(tvoc->ppb, 321U);
+    AGS10_TEST_CHECK(tvoc->fresh());
+
+    ags10::Result<std::uint8_t> version = sensor.version();
+    AGS10_TEST_CHECK(version.ok());
+    AGS10_TEST_EQ(version.value_or(0), device.version);
+    AGS10_TEST_EQ(sensor.resistance().value_or(0), 4567U);
+
+    AGS10_TEST_EQ(sensor.set_address<TEST_NEW_ADDR>(), AGS10_OK);
+    AGS10_TEST_EQ(device.addr, TEST_NEW_ADDR);
+
+    ags10::Ags10<ags10::OpsBus, TEST_NEW_ADDR> moved(ags10::OpsBus(&ags10_sim_bus_ops, &bus));
+    AGS10_TEST_EQ(moved.tvoc().value_or(ags10::Tvoc{ 0, 0 }).ppb, 321U);
+    AGS10_TEST_EQ(sensor.tvoc().status(), AGS10_ERR_NACK_WRITE);
+    AGS10_TEST_CHECK(!sensor.tvoc().to_optional().has_value());
+}
+
+/**
+ * @brief Random frames, a fifth of them corrupted, and NACKs: both drivers
+ *        must return the same status and value.
+ */
+static void test_same_as_c(void)
+{
+    ags10::Ags10<MemBus, TEST_ADDR> sensor;
+    AGS10_BusOpsTypeDef mem_ops = {};
+    AGS10_HandleTypeDef h_sensor;
+    uint32_t seed = 1;
+    uint32_t differ = 0;
+    uint32_t crc_errors = 0;
+
+    mem_ops.write = mem_write;
+    mem_ops.read = mem_read;
+    mem_ops.delay = mem_delay;
+    AGS10_TEST_EQ(ags10_init(&h_sensor, TEST_ADDR, &mem_ops, NULL), AGS10_OK);
+
+    for (uint32_t n = 0; n < TEST_FRAMES; n++)
+    {
+        uint32_t raw = 0;
+        uint32_t pick = ags10_test_rand(&seed);
+
+        for (uint32_t idx = 0; idx < AGS10MA_DATA_LEN; idx++)
+        {
+            mem_frame[idx] = static_cast<std::uint8_t>(ags10_test_rand(&seed));
+        }
+        mem_frame[AGS10MA_DATA_LEN] = ags10_crc8(mem_frame, AGS10MA_DATA_LEN);
+        mem_frame[AGS10MA_DATA_LEN] ^= (0U == (pick % 5U)) ? static_cast<std::uint8_t>(1U << (pick % 8U)) : 0U;
+        mem_write_status = (1U == (pick % 97U)) ? AGS10_ERR_NACK : AGS10_OK;
+        mem_read_status = (2U == (pick % 97U)) ? AGS10_ERR_NACK : AGS10_OK;
+
+        AGS10_StatusTypeDef status = ags10_register_read(&h_sensor, AGS10MA_TVOC_STAT_REG, 0, &raw);
+        ags10::Result<std::uint32_t> result = sensor.register_read(AGS10MA_TVOC_STAT_REG, 0);
+
+        differ += ((result.status() != status) || (result.ok() && (*result != raw))) ? 1U : 0U;
+        crc_errors += (AGS10_ERR_CRC == status) ? 1U : 0U;
+    }
+
+    AGS10_TEST_EQ(differ, 0);
+    AGS10_TEST_CHECK(crc_errors > (TEST_FRAMES / 6U));
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main()
+{
+    test_sim();
+    test_same_as_c();
+
+    return ags10_test_done("cpp");
+}
+
+// eof
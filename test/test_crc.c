@@ -0,0 +1,65 @@
+/**
+ * @file test_crc.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief The CRC-8 engines must give bit-identical results.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10.h"
+#include "ags10_test.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define TEST_BUFFERS    200000U
+#define TEST_MAX_LEN    67U     /**< Odd, so slice-by-4 sees every tail length. */
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    static const uint8_t beef[2] = {0xBE, 0xEF};
+    uint8_t buf[TEST_MAX_LEN + 3U];
+    uint32_t seed = 1;
+    uint32_t mismatches = 0;
+
+    // data sheet example
+    AGS10_TEST_EQ(ags10_crc8_bitwise(beef, 2), 0x92);
+    AGS10_TEST_EQ(ags10_crc8_nibble(beef, 2), 0x92);
+    AGS10_TEST_EQ(ags10_crc8_table(beef, 2), 0x92);
+    AGS10_TEST_EQ(ags10_crc8_slice4(beef, 2), 0x92);
+    AGS10_TEST_EQ(ags10_crc8(beef, 2), 0x92);
+
+    // nothing to checksum leaves the initial value
+    AGS10_TEST_EQ(ags10_crc8_nibble(beef, 0), AGS10MA_CRC8_INIT);
+    AGS10_TEST_EQ(ags10_crc8_table(beef, 0), AGS10MA_CRC8_INIT);
+    AGS10_TEST_EQ(ags10_crc8_slice4(beef, 0), AGS10MA_CRC8_INIT);
+
+    for (uint32_t n = 0; n < TEST_BUFFERS; n++)
+    {
+        // offset the start so slice-by-4 also runs unaligned
+        uint8_t *p_data = &buf[ags10_test_rand(&seed) % 4U];
+        int len = (int)(ags10_test_rand(&seed) % (TEST_MAX_LEN + 1U));
+
+        for (int idx = 0; idx < len; idx++)
+        {
+            p_data[idx] = (uint8_t)ags10_test_rand(&seed);
+        }
+
+        uint8_t ref = ags10_crc8_bitwise(p_data, len);
+
+        mismatches += (ref != ags10_crc8_nibble(p_data, len)) ? 1U : 0U;
+        mismatches += (ref != ags10_crc8_table(p_data, len)) ? 1U : 0U;
+        mismatches += (ref != ags10_crc8_slice4(p_data, len)) ? 1U : 0U;
+        mismatches += (ref != ags10_crc8(p_data, len)) ? 1U : 0U;
+    }
+    AGS10_TEST_EQ(mismatches, 0);
+
+    return ags10_test_done("crc");
+}
+// eof
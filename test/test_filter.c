@@ -0,0 +1,229 @@
+/**
+ * @file test_filter.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Golden vectors for each filter stage, and the whole chain against
+ *        a floating-point reference with the same rounding.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_filter.h"
+#include "ags10_test.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#ifndef TEST_FILTER_NAME
+#define TEST_FILTER_NAME    "filter"
+#endif
+
+#define TEST_SAMPLES        200000U
+/* Stages not under test pass samples through with these. */
+#define TEST_NO_CLAMP       AGS10_FILTER_FROM_PPB(AGS10_FILTER_PPB_MAX)
+#define TEST_LEN(a)         (sizeof(a) / sizeof((a)[0]))
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static const AGS10_FilterConfigTypeDef cfg_chain = { .ema_alpha = AGS10_FILTER_ALPHA_ONE / 8U, .clamp_step = AGS10_FILTER_FROM_PPB(200) };
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+#if AGS10_FILTER_CLAMP_ENABLE
+/**
+ * @brief Steps over 100 ppb are cut to 100, the first sample passes.
+ */
+static void test_clamp(void)
+{
+    static const uint32_t in[]      = { 1000, 1050, 1300, 1300, 900, 0x1000000 };
+    static const uint32_t out[]     = { 1000, 1050, 1150, 1250, 1150, 1250 };
+    static const uint32_t clamped[] = { 0, 0, 1, 2, 3, 4 };
+    static const AGS10_FilterConfigTypeDef cfg_clamp = { .ema_alpha = AGS10_FILTER_ALPHA_ONE, .clamp_step = AGS10_FILTER_FROM_PPB(100) };
+    AGS10_FilterTypeDef filter;
+
+    ags10_filter_init(&filter, &cfg_clamp);
+    for (uint32_t idx = 0; idx < TEST_LEN(in); idx++)
+    {
+        (void)ags10_filter_update(&filter, in[idx]);
+        AGS10_TEST_EQ(filter.clamp_prev, AGS10_FILTER_FROM_PPB(out[idx]));
+        AGS10_TEST_EQ(filter.clamped, clamped[idx]);
+    }
+}
+#endif
+
+#if (0 != AGS10_FILTER_MEDIAN_LEN)
+/**
+ * @brief Lower median of the window while it fills, then of the last
+ *        AGS10_FILTER_MEDIAN_LEN samples; repeated values included.
+ */
+static void test_median(void)
+{
+    static const uint32_t spikes[] = { 10, 50, 20, 90, 30, 40, 1000, 5, 60, 70 };
+    static const uint32_t repeats[] = { 7, 7, 7, 3, 7, 3, 3, 3, 9, 9, 9, 9 };
+#if (5 == AGS10_FILTER_MEDIAN_LEN)
+    static const uint32_t spikes_out[] = { 10, 10, 20, 20, 30, 40, 40, 40, 40, 60 };
+    static const uint32_t repeats_out[] = { 7, 7, 7, 7, 7, 7, 3, 3, 3, 3, 9, 9 };
+#else
+    static const uint32_t spikes_out[] = { 10, 10, 20, 20, 30, 30, 40, 40, 40, 60 };
+    static const uint32_t repeats_out[] = { 7, 7, 7, 7, 7, 7, 7, 3, 3, 3, 7, 9 };
+#endif
+    static const AGS10_FilterConfigTypeDef cfg_median = { .ema_alpha = AGS10_FILTER_ALPHA_ONE, .clamp_step = TEST_NO_CLAMP };
+    AGS10_FilterTypeDef filter;
+
+    ags10_filter_init(&filter, &cfg_median);
+    for (uint32_t idx = 0; idx < TEST_LEN(spikes); idx++)
+    {
+        AGS10_TEST_EQ(ags10_filter_update(&filter, spikes[idx]), AGS10_FILTER_FROM_PPB(spikes_out[idx]));
+    }
+
+    ags10_filter_init(&filter, &cfg_median);
+    for (uint32_t idx = 0; idx < TEST_LEN(repeats); idx++)
+    {
+        AGS10_TEST_EQ(ags10_filter_update(&filter, repeats[idx]), AGS10_FILTER_FROM_PPB(repeats_out[idx]));
+    }
+}
+#endif
+
+#if AGS10_FILTER_EMA_ENABLE
+/**
+ * @brief A step from 0 to 1000 ppb with alpha 1/8: each output moves 1/8 of
+ *        the way, rounded to the nearest 1/256 ppb. A median lets the step
+ *        through one sample late.
+ */
+static void test_ema(void)
+{
+    static const uint32_t out[] = {
+        0, 32000, 60000, 84500, 105938, 124696, 141109, 155470, 168036, 179032, 188653
+    };
+    uint32_t lag = (0 != AGS10_FILTER_MEDIAN_LEN) ? 1U : 0U;
+    static const AGS10_FilterConfigTypeDef cfg_ema = { .ema_alpha = AGS10_FILTER_ALPHA_ONE / 8U, .clamp_step = TEST_NO_CLAMP };
+    AGS10_FilterTypeDef filter;
+
+    ags10_filter_init(&filter, &cfg_ema);
+    AGS10_TEST_EQ(ags10_filter_update(&filter, 0), 0);
+    for (uint32_t idx = 1; idx < TEST_LEN(out); idx++)
+    {
+        AGS10_TEST_EQ(ags10_filter_update(&filter, 1000), out[idx - lag]);
+    }
+
+    // full scale neither overflows nor drifts
+    ags10_filter_init(&filter, &cfg_ema);
+    for (uint32_t idx = 0; idx < 100U; idx++)
+    {
+        AGS10_TEST_EQ(ags10_filter_update(&filter, AGS10_FILTER_PPB_MAX), AGS10_FILTER_FROM_PPB(AGS10_FILTER_PPB_MAX));
+    }
+}
+#endif
+
+#if (0 != AGS10_FILTER_MEDIAN_LEN)
+static int double_cmp(const void *p_a, const void *p_b)
+{
+    double a = *(const double *)p_a;
+    double b = *(const double *)p_b;
+
+    return (a > b) - (a < b);
+}
+#endif
+
+/**
+ * @brief The configured chain, bit for bit against a double reference that
+ *        rounds the same way, on noisy input with spikes and overranges.
+ */
+static void test_chain(void)
+{
+    AGS10_FilterTypeDef filter;
+    uint32_t seed = 3;
+    uint32_t base = 300;
+    uint32_t mismatches = 0;
+    double prev = 0.0;
+    double ema = 0.0;
+#if (0 != AGS10_FILTER_MEDIAN_LEN)
+    double window[AGS10_FILTER_MEDIAN_LEN];
+    uint32_t fill = 0;
+#endif
+
+    ags10_filter_init(&filter, &cfg_chain);
+
+    for (uint32_t idx = 0; idx < TEST_SAMPLES; idx++)
+    {
+        base = base + (ags10_test_rand(&seed) % 21U) - ((base >= 10U) ? 10U : base);
+        base = (base > 60000U) ? 60000U : base;
+
+        uint32_t in = base + (ags10_test_rand(&seed) % 7U);
+
+        if (0U == (ags10_test_rand(&seed) % 200U))
+        {
+            in += ags10_test_rand(&seed) % 5000U;
+        }
+        if (0U == (ags10_test_rand(&seed) % 5000U))
+        {
+            in = AGS10_FILTER_PPB_MAX + (ags10_test_rand(&seed) % 3U);
+        }
+
+        double x = (double)((in > AGS10_FILTER_PPB_MAX) ? AGS10_FILTER_PPB_MAX : in) * AGS10_FILTER_ONE;
+
+#if AGS10_FILTER_CLAMP_ENABLE
+        if (0U != idx)
+        {
+            double step = (double)cfg_chain.clamp_step;
+
+            x = ((x - prev) > step) ? (prev + step) : (((prev - x) > step) ? (prev - step) : x);
+        }
+        prev = x;
+#endif
+#if (0 != AGS10_FILTER_MEDIAN_LEN)
+        double sorted[AGS10_FILTER_MEDIAN_LEN];
+
+        window[idx % AGS10_FILTER_MEDIAN_LEN] = x;
+        fill = (fill < AGS10_FILTER_MEDIAN_LEN) ? (fill + 1U) : fill;
+        for (uint32_t pos = 0; pos < fill; pos++)
+        {
+            sorted[pos] = window[pos];
+        }
+        qsort(sorted, fill, sizeof(sorted[0]), double_cmp);
+        x = sorted[(fill - 1U) / 2U];
+#endif
+#if AGS10_FILTER_EMA_ENABLE
+        double alpha = (double)cfg_chain.ema_alpha;
+        double one = (double)AGS10_FILTER_ALPHA_ONE;
+
+        ema = (0U == idx) ? x : floor(((ema * (one - alpha)) + (x * alpha) + (one / 2.0)) / one);
+        x = ema;
+#endif
+
+        mismatches += ((double)ags10_filter_update(&filter, in) != x) ? 1U : 0U;
+    }
+
+    (void)prev;
+    (void)ema;
+    AGS10_TEST_EQ(mismatches, 0);
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+#if AGS10_FILTER_CLAMP_ENABLE
+    test_clamp();
+#endif
+#if (0 != AGS10_FILTER_MEDIAN_LEN)
+    test_median();
+#endif
+#if AGS10_FILTER_EMA_ENABLE
+    test_ema();
+#endif
+    test_chain();
+
+    return ags10_test_done(TEST_FILTER_NAME);
+}
+
+// eof
@@ -0,0 +1,16 @@
+/**
+ * @file test_filter_median7.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief test_filter.c again, built with AGS10_FILTER_MEDIAN_LEN 7 (see the
+ *        Makefile).
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#define TEST_FILTER_NAME    "filter median 7"
+
+#include "test_filter.c"
+
+// eof
@@ -0,0 +1,356 @@
+/**
+ * @file test_fleet.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief The fleet's MPSC queue on its own and under producer threads, and
+ *        simulated buses run through start, consume and join, lossless and
+ *        dropping.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_fleet.h"
+#include "ags10_sim.h"
+#include "ags10_test.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define TEST_PRODUCERS      4U
+#define TEST_PUSHES         100000U     /**< Per producer thread. */
+#define TEST_BUSES          6U
+#define TEST_SENSORS        34U
+#define TEST_ROUNDS         30U         /**< 6120 samples, more than the queue holds. */
+#define TEST_PERIOD_MS      2000U
+#define TEST_FIRST_ADDR     0x08U
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static AGS10_FleetTypeDef fleet;
+static AGS10_FleetBusTypeDef fleet_buses[TEST_BUSES];
+
+static AGS10_SimBusTypeDef sims[TEST_BUSES];
+static AGS10_SimDeviceTypeDef devices[TEST_BUSES][TEST_SENSORS];
+static AGS10_HandleTypeDef sensors[TEST_BUSES][TEST_SENSORS];
+static AGS10_SchedResultTypeDef results[TEST_BUSES][TEST_SENSORS];
+
+/**
+ * @brief What the consumer saw of each bus.
+ */
+typedef struct {
+    uint32_t samples[TEST_BUSES];
+    uint32_t out_of_turn;       /**< Samples not from the sensor next in round order. */
+    uint32_t wrong;             /**< Failed reads, or a wrong value or address. */
+    uint32_t t_back;            /**< Samples older than the previous one of their bus. */
+    uint32_t last_t_ms[TEST_BUSES];
+} TestSinkTypeDef;
+
+static TestSinkTypeDef sink;
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static AGS10_FleetSampleTypeDef sample_make(uint16_t bus, uint32_t idx)
+{
+    return (AGS10_FleetSampleTypeDef){
+        .t_ms = idx,
+        .value = idx * 7U,
+        .bus = bus,
+        .sensor = (uint16_t)idx,
+    };
+}
+
+/* The queue alone: empty, full, and many laps of its sequence numbers. */
+static void test_queue(void)
+{
+    AGS10_FleetQueueTypeDef *p_queue = &fleet.queue;
+    AGS10_FleetSampleTypeDef sample = sample_make(0, 0);
+    uint32_t wrong = 0;
+
+    AGS10_TEST_CHECK(ags10_fleet_init(&fleet, fleet_buses, 1, TEST_PERIOD_MS, 1));
+    AGS10_TEST_CHECK(!ags10_fleet_queue_pop(p_queue, &sample));
+
+    for (uint32_t idx = 0; idx < AGS10_FLEET_QUEUE_LEN; idx++)
+    {
+        sample = sample_make(0, idx);
+        wrong += ags10_fleet_queue_push(p_queue, &sample) ? 0U : 1U;
+    }
+    AGS10_TEST_EQ(wrong, 0);
+
+    // full: refused until the consumer frees the oldest slot
+    sample = sample_make(0, AGS10_FLEET_QUEUE_LEN);
+    AGS10_TEST_CHECK(!ags10_fleet_queue_push(p_queue, &sample));
+    AGS10_TEST_CHECK(ags10_fleet_queue_pop(p_queue, &sample));
+    AGS10_TEST_EQ(sample.t_ms, 0);
+    sample = sample_make(0, AGS10_FLEET_QUEUE_LEN);
+    AGS10_TEST_CHECK(ags10_fleet_queue_push(p_queue, &sample));
+    AGS10_TEST_CHECK(!ags10_fleet_queue_push(p_queue, &sample));
+
+    // kept full over many laps, then drained, in order throughout
+    uint32_t next = 1;
+
+    for (uint32_t idx = AGS10_FLEET_QUEUE_LEN + 1U; idx < (10U * AGS10_FLEET_QUEUE_LEN); idx++)
+    {
+        wrong += ags10_fleet_queue_pop(p_queue, &sample) ? 0U : 1U;
+        wrong += ((next != sample.t_ms) || ((next * 7U) != sample.value)) ? 1U : 0U;
+        next++;
+
+        sample = sample_make(0, idx);
+        wrong += ags10_fleet_queue_push(p_queue, &sample) ? 0U : 1U;
+    }
+    AGS10_TEST_CHECK(!ags10_fleet_queue_push(p_queue, &sample));
+
+    while (ags10_fleet_queue_pop(p_queue, &sample))
+    {
+        wrong += (next != sample.t_ms) ? 1U : 0U;
+        next++;
+    }
+    AGS10_TEST_EQ(wrong, 0);
+    AGS10_TEST_EQ(next, 10U * AGS10_FLEET_QUEUE_LEN);
+}
+
+static void *producer(void *p_arg)
+{
+    uint16_t bus = (uint16_t)(uintptr_t)p_arg;
+
+    for (uint32_t idx = 0; idx < TEST_PUSHES; idx++)
+    {
+        AGS10_FleetSampleTypeDef sample = sample_make(bus, idx);
+
+        while (!ags10_fleet_queue_push(&fleet.queue, &sample))
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/* Several producers at once: nothing lost, each one's samples in order. */
+static void test_queue_threads(void)
+{
+    pthread_t threads[TEST_PRODUCERS];
+    uint32_t next[TEST_PRODUCERS] = {0};
+    uint32_t wrong = 0;
+    uint32_t total = 0;
+    AGS10_FleetSampleTypeDef sample;
+
+    AGS10_TEST_CHECK(ags10_fleet_init(&fleet, fleet_buses, 1, TEST_PERIOD_MS, 1));
+    for (uintptr_t idx = 0; idx < TEST_PRODUCERS; idx++)
+    {
+        AGS10_TEST_EQ(pthread_create(&threads[idx], NULL, producer, (void *)idx), 0);
+    }
+
+    while (total < (TEST_PRODUCERS * TEST_PUSHES))
+    {
+        if (!ags10_fleet_queue_pop(&fleet.queue, &sample))
+        {
+            sched_yield();
+            continue;
+        }
+
+        if ((TEST_PRODUCERS <= sample.bus) || (next[sample.bus] != sample.t_ms) ||
+            ((sample.t_ms * 7U) != sample.value))
+        {
+            wrong++;
+        }
+        else
+        {
+            next[sample.bus]++;
+        }
+        total++;
+    }
+
+    for (uint32_t idx = 0; idx < TEST_PRODUCERS; idx++)
+    {
+        AGS10_TEST_EQ(pthread_join(threads[idx], NULL), 0);
+        AGS10_TEST_EQ(next[idx], TEST_PUSHES);
+    }
+    AGS10_TEST_EQ(wrong, 0);
+    AGS10_TEST_CHECK(!ags10_fleet_queue_pop(&fleet.queue, &sample));
+}
+
+static void sink_check(void *p_ctx, const AGS10_FleetSampleTypeDef *p_sample)
+{
+    TestSinkTypeDef *p_sink = (TestSinkTypeDef *)p_ctx;
+    uint16_t bus = p_sample->bus;
+
+    if (TEST_BUSES <= bus)
+    {
+        p_sink->wrong++;
+        return;
+    }
+
+    // a bus publishes its sensors in order, once per round
+    if (p_sample->sensor != (p_sink->samples[bus] % TEST_SENSORS))
+    {
+        p_sink->out_of_turn++;
+    }
+    else if ((AGS10_OK != p_sample->status) || ((TEST_FIRST_ADDR + p_sample->sensor) != p_sample->addr) ||
+             (((1000U * bus) + p_sample->sensor) != (p_sample->value & AGS10MA_TVOC_MSK)))
+    {
+        p_sink->wrong++;
+    }
+
+    if ((0U != p_sink->samples[bus]) && ((int32_t)(p_sample->t_ms - p_sink->last_t_ms[bus]) < 0))
+    {
+        p_sink->t_back++;
+    }
+    p_sink->last_t_ms[bus] = p_sample->t_ms;
+    p_sink->samples[bus]++;
+}
+
+/* Like ags10_fleetd -s: every bus simulated, past preheat. */
+static void fleet_setup(bool lossless)
+{
+    for (uint16_t bus = 0; bus < TEST_BUSES; bus++)
+    {
+        ags10_sim_bus_init(&sims[bus], devices[bus], TEST_SENSORS, AGS10_SIM_DEFAULT_CLOCK_HZ);
+        for (uint16_t idx = 0; idx < TEST_SENSORS; idx++)
+        {
+            ags10_sim_device_init(&devices[bus][idx], (uint8_t)(TEST_FIRST_ADDR + idx));
+            devices[bus][idx].tvoc_ppb = (1000U * bus) + idx;
+            AGS10_TEST_EQ(ags10_init(&sensors[bus][idx], (uint8_t)(TEST_FIRST_ADDR + idx),
+                                     &ags10_sim_bus_ops, &sims[bus]), AGS10_OK);
+        }
+        ags10_sim_advance_us(&sims[bus], (uint64_t)AGS10_SIM_PREHEAT_MS * 1000U);
+        AGS10_TEST_CHECK(ags10_fleet_bus_init(&fleet_buses[bus], sensors[bus], results[bus], TEST_SENSORS));
+    }
+
+    AGS10_TEST_CHECK(ags10_fleet_init(&fleet, fleet_buses, TEST_BUSES, TEST_PERIOD_MS, TEST_ROUNDS));
+    fleet.lossless = lossless;
+    sink = (TestSinkTypeDef){ 0 };
+}
+
+static void test_bus_stats(uint32_t *p_dropped)
+{
+    *p_dropped = 0;
+
+    for (uint16_t bus = 0; bus < TEST_BUSES; bus++)
+    {
+        const AGS10_FleetBusTypeDef *p_bus = &fleet_buses[bus];
+
+        AGS10_TEST_EQ(p_bus->rounds, TEST_ROUNDS);
+        AGS10_TEST_EQ(p_bus->samples, TEST_ROUNDS * TEST_SENSORS);
+        AGS10_TEST_EQ(p_bus->failures, 0);
+        AGS10_TEST_EQ(p_bus->overruns, 0);
+        AGS10_TEST_CHECK(p_bus->round_max_ms < TEST_PERIOD_MS);
+        *p_dropped += p_bus->dropped;
+    }
+}
+
+/**
+ * @brief Lossless: the workers outrun the consumer on virtual time and
+ *        wait for space, so every sample of every round arrives.
+ */
+static void test_lossless(void)
+{
+    uint32_t dropped;
+
+    fleet_setup(true);
+    AGS10_TEST_CHECK(ags10_fleet_start(&fleet));
+    uint64_t consumed = ags10_fleet_consume(&fleet, sink_check, &sink);
+    ags10_fleet_join(&fleet);
+
+    AGS10_TEST_EQ(consumed, TEST_BUSES * TEST_SENSORS * TEST_ROUNDS);
+    test_bus_stats(&dropped);
+    AGS10_TEST_EQ(dropped, 0);
+    for (uint16_t bus = 0; bus < TEST_BUSES; bus++)
+    {
+        AGS10_TEST_EQ(sink.samples[bus], TEST_SENSORS * TEST_ROUNDS);
+    }
+    AGS10_TEST_EQ(sink.out_of_turn, 0);
+    AGS10_TEST_EQ(sink.wrong, 0);
+    AGS10_TEST_EQ(sink.t_back, 0);
+}
+
+/**
+ * @brief Dropping: with no consumer until the workers end, the queue keeps
+ *        exactly what fits and every other sample is counted in dropped.
+ */
+static void test_dropping(void)
+{
+    uint32_t dropped;
+
+    fleet_setup(false);
+    AGS10_TEST_CHECK(ags10_fleet_start(&fleet));
+    ags10_fleet_join(&fleet);
+    uint64_t consumed = ags10_fleet_consume(&fleet, sink_check, &sink);
+
+    AGS10_TEST_EQ(consumed, AGS10_FLEET_QUEUE_LEN);
+    test_bus_stats(&dropped);
+    AGS10_TEST_EQ(dropped, (TEST_BUSES * TEST_SENSORS * TEST_ROUNDS) - AGS10_FLEET_QUEUE_LEN);
+    // nothing is popped meanwhile, so each bus keeps a prefix of its samples
+    AGS10_TEST_EQ(sink.out_of_turn, 0);
+    AGS10_TEST_EQ(sink.wrong, 0);
+    AGS10_TEST_EQ(sink.t_back, 0);
+}
+
+/* stop() ends workers without a round limit, and nothing is left behind in the queue. */
+static void test_stop(void)
+{
+    AGS10_FleetSampleTypeDef sample;
+    uint32_t seen = 0;
+
+    fleet_setup(true);
+    fleet.rounds = 0;
+    AGS10_TEST_CHECK(ags10_fleet_start(&fleet));
+
+    // until every bus has published a round
+    while (seen != ((1U << TEST_BUSES) - 1U))
+    {
+        if (ags10_fleet_queue_pop(&fleet.queue, &sample))
+        {
+            seen |= 1U << sample.bus;
+        }
+    }
+    ags10_fleet_stop(&fleet);
+    (void)ags10_fleet_consume(&fleet, sink_check, &sink);
+    ags10_fleet_join(&fleet);
+
+    AGS10_TEST_EQ(atomic_load(&fleet.running), 0);
+    AGS10_TEST_CHECK(!ags10_fleet_queue_pop(&fleet.queue, &sample));
+    for (uint16_t bus = 0; bus < TEST_BUSES; bus++)
+    {
+        AGS10_TEST_CHECK(fleet_buses[bus].rounds > 0U);
+        AGS10_TEST_EQ(fleet_buses[bus].failures, 0);
+    }
+}
+
+static void test_init(void)
+{
+    static const AGS10_BusOpsTypeDef no_tick = { 0 };
+    AGS10_HandleTypeDef bare;
+
+    AGS10_TEST_CHECK(!ags10_fleet_init(&fleet, fleet_buses, 1, 0, 1));
+    AGS10_TEST_CHECK(!ags10_fleet_init(&fleet, NULL, 1, TEST_PERIOD_MS, 1));
+    AGS10_TEST_CHECK(!ags10_fleet_bus_init(&fleet_buses[0], sensors[0], results[0], 0));
+
+    // a bus without get_tick_ms cannot be scheduled
+    bare.p_bus_ops = &no_tick;
+    AGS10_TEST_CHECK(!ags10_fleet_bus_init(&fleet_buses[0], &bare, results[0], 1));
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    test_queue();
+    test_queue_threads();
+    test_lossless();
+    test_dropping();
+    test_stop();
+    test_init();
+
+    return ags10_test_done("fleet");
+}
+
+// eof
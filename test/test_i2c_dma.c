@@ -0,0 +1,193 @@
+/**
+ * @file test_i2c_dma.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief The example's DMA back end on the host HAL: callbacks to xfer_state
+ *        to driver states, lost callbacks and a scheduler round.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10.h"
+#include "ags10_sched.h"
+#include "ags10_sim.h"
+#include "ags10_i2c_dma.h"
+#include "stm32f1xx_hal.h"
+#include "ags10_test.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define TEST_SENSORS    4U
+#define TEST_ADDR       0x1AU
+#define TEST_ABSENT     0x40U
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static AGS10_SimDeviceTypeDef devices[TEST_SENSORS];
+static AGS10_SimBusTypeDef bus;
+static I2C_HandleTypeDef hi2c1;
+static AGS10_I2cDmaTypeDef dma;
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static void test_setup(uint16_t count)
+{
+    for (uint16_t idx = 0; idx < count; idx++)
+    {
+        ags10_sim_device_init(&devices[idx], (uint8_t)(TEST_ADDR + idx));
+        devices[idx].tvoc_ppb = 200U + idx;
+    }
+    ags10_sim_bus_init(&bus, devices, count, AGS10_SIM_DEFAULT_CLOCK_HZ);
+    ags10_sim_advance_us(&bus, (uint64_t)AGS10_SIM_PREHEAT_MS * 1000U);
+    hal_mock_i2c_init(&hi2c1, &bus);
+    (void)ags10_i2c_dma_init(&dma, &hi2c1);
+}
+
+/* Polls once per HAL_Delay(1), the way a main loop would. */
+static AGS10_XferResultTypeDef test_poll(AGS10_HandleTypeDef *ph_sensor, uint32_t *p_value)
+{
+    AGS10_XferResultTypeDef result;
+
+    while (AGS10_XFER_PENDING == (result = ags10_register_read_poll(ph_sensor, HAL_GetTick(), p_value)))
+    {
+        HAL_Delay(1);
+    }
+
+    return result;
+}
+
+static void test_callbacks(void)
+{
+    AGS10_HandleTypeDef sensor;
+    uint32_t value = 0;
+
+    test_setup(1);
+    (void)ags10_init(&sensor, TEST_ADDR, &ags10_i2c_dma_bus_ops, &dma);
+
+    // busy from the start of the DMA transfer until its callback
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_VERSION_REG, AGS10MA_VERSION_DELAY_MS,
+                                            HAL_GetTick()), AGS10_OK);
+    AGS10_TEST_EQ(dma.xfer, AGS10_BUS_XFER_BUSY);
+    AGS10_TEST_EQ(ags10_register_read_poll(&sensor, HAL_GetTick(), &value), AGS10_XFER_PENDING);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_WRITING);
+
+    hal_mock_run(HAL_MOCK_LATENCY_US);
+    AGS10_TEST_EQ(hi2c1.callbacks, 1);
+    AGS10_TEST_EQ(dma.xfer, AGS10_BUS_XFER_DONE);
+    AGS10_TEST_EQ(ags10_register_read_poll(&sensor, HAL_GetTick(), &value), AGS10_XFER_PENDING);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_CONVERTING);
+
+    // the frame is DMA'd into the handle and checked after the Rx callback
+    AGS10_TEST_EQ(test_poll(&sensor, &value), AGS10_XFER_DONE);
+    AGS10_TEST_EQ(value & 0xFFU, AGS10_SIM_VERSION);
+    AGS10_TEST_EQ(hi2c1.callbacks, 2);
+
+    // the blocking API waits in HAL_Delay(), where the callbacks fire
+    AGS10_TEST_EQ(ags10_tvoc_get(&sensor, &value), AGS10_OK);
+    AGS10_TEST_EQ(value, 200U);
+    AGS10_TEST_EQ(hi2c1.busy_rejects, 0);
+}
+
+static void test_errors(void)
+{
+    AGS10_HandleTypeDef sensor;
+    uint32_t value = 0;
+
+    test_setup(1);
+
+    // an address NACK reaches the driver through HAL_I2C_ErrorCallback()
+    (void)ags10_init(&sensor, TEST_ABSENT, &ags10_i2c_dma_bus_ops, &dma);
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_VERSION_REG, AGS10MA_VERSION_DELAY_MS,
+                                            HAL_GetTick()), AGS10_OK);
+    AGS10_TEST_EQ(test_poll(&sensor, &value), AGS10_XFER_ERROR);
+    AGS10_TEST_EQ(sensor.last_status, AGS10_ERR_NACK_WRITE);
+    AGS10_TEST_EQ(dma.xfer, AGS10_BUS_XFER_NACK);
+
+    AGS10_TEST_EQ(ags10_i2c_dma_bus_ops.probe(&dma, TEST_ADDR), AGS10_OK);
+    AGS10_TEST_EQ(ags10_i2c_dma_bus_ops.probe(&dma, TEST_ABSENT), AGS10_ERR_NACK);
+
+    // a lost callback times out, and the bus refuses transfers until aborted
+    (void)ags10_init(&sensor, TEST_ADDR, &ags10_i2c_dma_bus_ops, &dma);
+    hi2c1.lose_callbacks = 1;
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_VERSION_REG, AGS10MA_VERSION_DELAY_MS,
+                                            HAL_GetTick()), AGS10_OK);
+    AGS10_TEST_EQ(test_poll(&sensor, &value), AGS10_XFER_ERROR);
+    AGS10_TEST_EQ(sensor.last_status, AGS10_ERR_TIMEOUT);
+    AGS10_TEST_EQ(hi2c1.lost_callbacks, 1);
+    AGS10_TEST_EQ(ags10_firmware_version_get(&sensor, &value), AGS10_ERR_BUSY);
+
+    AGS10_TEST_EQ(HAL_I2C_Master_Abort_IT(&hi2c1, TEST_ADDR << 1), HAL_OK);
+    AGS10_TEST_EQ(dma.xfer, AGS10_BUS_XFER_ERROR);
+    AGS10_TEST_EQ(ags10_firmware_version_get(&sensor, &value), AGS10_OK);
+    AGS10_TEST_EQ(value, AGS10_SIM_VERSION);
+}
+
+static void test_sched_round(void)
+{
+    AGS10_HandleTypeDef sensors[TEST_SENSORS];
+    AGS10_SchedResultTypeDef results[TEST_SENSORS];
+    AGS10_SchedTypeDef sched;
+    uint32_t ok = 0;
+
+    test_setup(TEST_SENSORS);
+    for (uint16_t idx = 0; idx < TEST_SENSORS; idx++)
+    {
+        (void)ags10_init(&sensors[idx], (uint8_t)(TEST_ADDR + idx), &ags10_i2c_dma_bus_ops, &dma);
+    }
+    AGS10_TEST_CHECK(ags10_sched_init(&sched, sensors, results, TEST_SENSORS, AGS10MA_TVOC_STAT_REG,
+                                      AGS10MA_TVOC_DELAY_MS, ags10_sim_tick_ms, &bus));
+
+    AGS10_TEST_EQ(ags10_sched_round_start(&sched), TEST_SENSORS);
+    while (!ags10_sched_poll(&sched))
+    {
+        HAL_Delay(1);
+    }
+
+    for (uint16_t idx = 0; idx < TEST_SENSORS; idx++)
+    {
+        ok += ((AGS10_OK == results[idx].status) &&
+               ((results[idx].value & AGS10MA_TVOC_MSK) == (200U + idx))) ? 1U : 0U;
+    }
+    AGS10_TEST_EQ(ok, TEST_SENSORS);
+    AGS10_TEST_EQ(hi2c1.busy_rejects, 0);
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+/* Forwarded as in the example's main.c */
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    ags10_i2c_dma_xfer_cplt(hi2c);
+}
+
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    ags10_i2c_dma_xfer_cplt(hi2c);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    ags10_i2c_dma_xfer_error(hi2c);
+}
+
+void HAL_I2C_AbortCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    ags10_i2c_dma_xfer_error(hi2c);
+}
+
+int main(void)
+{
+    test_callbacks();
+    test_errors();
+    test_sched_round();
+
+    return ags10_test_done("i2c_dma");
+}
+// eof
@@ -0,0 +1,202 @@
+/**
+ * @file test_i2c_it.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief The example's interrupt back end on the host HAL, and its event
+ *        queue under an "interrupt" running on another thread.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10.h"
+#include "ags10_sim.h"
+#include "ags10_i2c_it.h"
+#include "stm32f1xx_hal.h"
+#include "ags10_test.h"
+
+#include <signal.h>
+#include <time.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define TEST_ADDR           0x1AU
+#define TEST_EVENTS         50000U
+#define TEST_ISR_PERIOD_NS  10000L
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static AGS10_SimDeviceTypeDef device;
+static AGS10_SimBusTypeDef bus;
+static I2C_HandleTypeDef hi2c1;
+static AGS10_I2cItTypeDef it;
+
+static volatile uint32_t isr_seq;        /* Written by the "interrupt" only. */
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static void test_setup(void)
+{
+    ags10_sim_device_init(&device, TEST_ADDR);
+    ags10_sim_bus_init(&bus, &device, 1, AGS10_SIM_DEFAULT_CLOCK_HZ);
+    ags10_sim_advance_us(&bus, (uint64_t)AGS10_SIM_PREHEAT_MS * 1000U);
+    hal_mock_i2c_init(&hi2c1, &bus);
+    (void)ags10_i2c_it_init(&it, &hi2c1);
+}
+
+static void test_driver(void)
+{
+    AGS10_HandleTypeDef sensor;
+    uint32_t value = 0;
+
+    test_setup();
+    (void)ags10_init(&sensor, TEST_ADDR, &ags10_i2c_it_bus_ops, &it);
+
+    // the callback only queues; xfer changes when the main loop drains it
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_VERSION_REG, AGS10MA_VERSION_DELAY_MS,
+                                            HAL_GetTick()), AGS10_OK);
+    hal_mock_run(HAL_MOCK_LATENCY_US);
+    AGS10_TEST_EQ(it.evq_head - it.evq_tail, 1);
+    AGS10_TEST_EQ(it.xfer, AGS10_BUS_XFER_BUSY);
+    AGS10_TEST_EQ(ags10_register_read_poll(&sensor, HAL_GetTick(), &value), AGS10_XFER_PENDING);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_CONVERTING);
+    AGS10_TEST_EQ(it.evq_head - it.evq_tail, 0);
+    while (AGS10_XFER_PENDING == ags10_register_read_poll(&sensor, HAL_GetTick(), &value))
+    {
+        HAL_Delay(1);
+    }
+    AGS10_TEST_EQ(value & 0xFFU, AGS10_SIM_VERSION);
+
+    AGS10_TEST_EQ(ags10_tvoc_get(&sensor, &value), AGS10_OK);
+    AGS10_TEST_EQ(ags10_firmware_version_get(&sensor, &value), AGS10_OK);
+    AGS10_TEST_EQ(value, AGS10_SIM_VERSION);
+    AGS10_TEST_EQ(it.evq_dropped, 0);
+}
+
+static void test_queue(void)
+{
+    uint8_t pointer = AGS10MA_VERSION_REG;
+
+    test_setup();
+
+    // a full queue drops the newest events and counts them
+    for (uint32_t idx = 0; idx < (AGS10_I2C_IT_EVQ_LEN + 2U); idx++)
+    {
+        hi2c1.ErrorCode = HAL_I2C_ERROR_AF;
+        ags10_i2c_it_isr_event(&hi2c1, (0U == (idx & 1U)) ? AGS10_I2C_IT_EVT_TX_CPLT : AGS10_I2C_IT_EVT_ERROR);
+    }
+    AGS10_TEST_EQ(it.evq_dropped, 2);
+    AGS10_TEST_EQ(ags10_i2c_it_process(&it), AGS10_I2C_IT_EVQ_LEN);
+    AGS10_TEST_EQ(ags10_i2c_it_process(&it), 0);
+
+    // events are applied in order: the last one kept was an error
+    AGS10_TEST_EQ(it.xfer, AGS10_BUS_XFER_NACK);
+    AGS10_TEST_EQ(it.last_error, HAL_I2C_ERROR_AF);
+
+    // a stray completion queued before a transfer is not taken for its own
+    ags10_i2c_it_isr_event(&hi2c1, AGS10_I2C_IT_EVT_TX_CPLT);
+    AGS10_TEST_EQ(ags10_i2c_it_bus_ops.write(&it, TEST_ADDR, &pointer, 1), AGS10_OK);
+    AGS10_TEST_EQ(ags10_i2c_it_bus_ops.xfer_state(&it), AGS10_BUS_XFER_BUSY);
+    AGS10_TEST_EQ(ags10_i2c_it_bus_ops.write(&it, TEST_ADDR, &pointer, 1), AGS10_ERR_BUSY);
+    hal_mock_run(HAL_MOCK_LATENCY_US);
+    AGS10_TEST_EQ(ags10_i2c_it_bus_ops.xfer_state(&it), AGS10_BUS_XFER_DONE);
+}
+
+/* The interrupt: a timer signal preempts the main loop anywhere, as on the MCU. */
+static void test_isr(int sig)
+{
+    (void)sig;
+
+    if (isr_seq < TEST_EVENTS)
+    {
+        isr_seq++;
+        hi2c1.ErrorCode = isr_seq << 8;
+        ags10_i2c_it_isr_event(&hi2c1, AGS10_I2C_IT_EVT_ERROR);
+    }
+}
+
+static void test_concurrent(void)
+{
+    struct sigaction action = { .sa_handler = test_isr };
+    struct sigevent event = { .sigev_notify = SIGEV_SIGNAL, .sigev_signo = SIGALRM };
+    struct itimerspec period = { .it_value = { 0, TEST_ISR_PERIOD_NS }, .it_interval = { 0, TEST_ISR_PERIOD_NS } };
+    timer_t timer;
+    uint32_t seed = 0x1D2C3B4AU;
+    uint32_t consumed = 0;
+    uint32_t last = 0;
+    uint32_t reordered = 0;
+
+    test_setup();
+    isr_seq = 0;
+    sigemptyset(&action.sa_mask);
+    AGS10_TEST_EQ(sigaction(SIGALRM, &action, NULL), 0);
+    AGS10_TEST_EQ(timer_create(CLOCK_MONOTONIC, &event, &timer), 0);
+    AGS10_TEST_EQ(timer_settime(timer, 0, &period, NULL), 0);
+
+    // every drain must leave the newest of its events, never an older one
+    while ((isr_seq < TEST_EVENTS) || (it.evq_head != it.evq_tail))
+    {
+        // a main loop busy elsewhere for a while lets the queue fill up
+        uint32_t draw = ags10_test_rand(&seed);
+
+        for (volatile uint32_t spin = draw % ((0U == (draw & 0x3F000U)) ? 400000U : 4000U); spin > 0U; spin--)
+        {
+        }
+
+        uint32_t count = ags10_i2c_it_process(&it);
+
+        if (0U != count)
+        {
+            uint32_t seq = it.last_error >> 8;
+
+            reordered += (seq <= last) ? 1U : 0U;
+            last = seq;
+            consumed += count;
+        }
+    }
+    (void)timer_delete(timer);
+
+    AGS10_TEST_EQ(consumed + it.evq_dropped, TEST_EVENTS);
+    AGS10_TEST_EQ(reordered, 0);
+    AGS10_TEST_CHECK(consumed > 0U);
+    printf("i2c_it: %u events, %u consumed, %u dropped\n", TEST_EVENTS, consumed, (unsigned)it.evq_dropped);
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+/* Forwarded as in the example's main.c */
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    ags10_i2c_it_isr_event(hi2c, AGS10_I2C_IT_EVT_TX_CPLT);
+}
+
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    ags10_i2c_it_isr_event(hi2c, AGS10_I2C_IT_EVT_RX_CPLT);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    ags10_i2c_it_isr_event(hi2c, AGS10_I2C_IT_EVT_ERROR);
+}
+
+void HAL_I2C_AbortCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    ags10_i2c_it_isr_event(hi2c, AGS10_I2C_IT_EVT_ERROR);
+}
+
+int main(void)
+{
+    test_driver();
+    test_queue();
+    test_concurrent();
+
+    return ags10_test_done("i2c_it");
+}
+// eof
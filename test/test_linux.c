@@ -0,0 +1,322 @@
+/**
+ * @file test_linux.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief The i2c-dev back end on the fake adapter: opening, system calls
+ *        per sample with and without combine, the held-back pointer write
+ *        and the errno mapping.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10.h"
+#include "ags10_linux.h"
+#include "ags10_linux_fake.h"
+#include "ags10_sim.h"
+#include "ags10_test.h"
+
+#include <errno.h>
+#include <stddef.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define TEST_PATH       "/dev/i2c-fake"
+#define TEST_ADDR       0x1AU
+#define TEST_DECOY_ADDR 0x40U       /**< Register-file part, answers without a conversion delay. */
+#define TEST_ABSENT     0x50U
+#define TEST_TVOC_PPB   300U
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static AGS10_SimDeviceTypeDef devices[2];
+static AGS10_SimBusTypeDef sim;
+static AGS10_LinuxFakeTypeDef fake;
+static AGS10_LinuxBusTypeDef bus;
+
+/**
+ * @brief Counters of the fake adapter at one point, to take differences.
+ */
+typedef struct {
+    uint32_t syscalls;
+    uint32_t rdwr;
+    uint32_t msgs;
+    uint32_t bus_syscalls;
+} TestCountTypeDef;
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static void test_setup(bool combine)
+{
+    ags10_sim_device_init(&devices[0], TEST_ADDR);
+    devices[0].tvoc_ppb = TEST_TVOC_PPB;
+    ags10_sim_device_init(&devices[1], TEST_DECOY_ADDR);
+    devices[1].kind = AGS10_SIM_DECOY_REGISTERS;
+    ags10_sim_bus_init(&sim, devices, 2, AGS10_SIM_DEFAULT_CLOCK_HZ);
+    ags10_sim_advance_us(&sim, (uint64_t)AGS10_SIM_PREHEAT_MS * 1000U);
+
+    ags10_linux_fake_init(&fake, &sim);
+    AGS10_TEST_EQ(ags10_linux_open(&bus, TEST_PATH, &ags10_linux_fake_sys, &fake), AGS10_OK);
+    bus.combine = combine;
+}
+
+static TestCountTypeDef test_count(void)
+{
+    return (TestCountTypeDef){
+        .syscalls = ags10_linux_fake_syscalls(&fake),
+        .rdwr = fake.rdwr,
+        .msgs = fake.msgs,
+        .bus_syscalls = bus.syscalls,
+    };
+}
+
+/* The back end's own count must match what the adapter saw. */
+static void test_delta(const TestCountTypeDef *p_before, uint32_t syscalls, uint32_t rdwr, uint32_t msgs)
+{
+    AGS10_TEST_EQ(ags10_linux_fake_syscalls(&fake) - p_before->syscalls, syscalls);
+    AGS10_TEST_EQ(fake.rdwr - p_before->rdwr, rdwr);
+    AGS10_TEST_EQ(fake.msgs - p_before->msgs, msgs);
+    AGS10_TEST_EQ(bus.syscalls - p_before->bus_syscalls, syscalls);
+}
+
+static void test_open(void)
+{
+    AGS10_LinuxBusTypeDef other;
+
+    ags10_sim_bus_init(&sim, devices, 0, AGS10_SIM_DEFAULT_CLOCK_HZ);
+    ags10_linux_fake_init(&fake, &sim);
+    AGS10_TEST_EQ(ags10_linux_open(NULL, TEST_PATH, &ags10_linux_fake_sys, &fake), AGS10_ERR_PARAM);
+    AGS10_TEST_EQ(ags10_linux_open(&bus, NULL, &ags10_linux_fake_sys, &fake), AGS10_ERR_PARAM);
+    AGS10_TEST_EQ(fake.opens, 0);
+
+    // open and I2C_FUNCS
+    AGS10_TEST_EQ(ags10_linux_open(&bus, TEST_PATH, &ags10_linux_fake_sys, &fake), AGS10_OK);
+    AGS10_TEST_EQ(bus.syscalls, 2);
+    AGS10_TEST_EQ(ags10_linux_fake_syscalls(&fake), 2);
+    AGS10_TEST_EQ(fake.ioctls, 1);
+
+    // the node is already open
+    AGS10_TEST_EQ(ags10_linux_open(&other, TEST_PATH, &ags10_linux_fake_sys, &fake), AGS10_ERR_BUS);
+    AGS10_TEST_EQ(other.last_errno, EBUSY);
+
+    ags10_linux_close(&bus);
+    AGS10_TEST_EQ(bus.fd, -1);
+    AGS10_TEST_EQ(fake.closes, 1);
+    ags10_linux_close(&bus);
+    AGS10_TEST_EQ(fake.closes, 1);
+
+    // an SMBus-only controller is refused and closed again
+    fake.funcs = 0;
+    AGS10_TEST_EQ(ags10_linux_open(&bus, TEST_PATH, &ags10_linux_fake_sys, &fake), AGS10_ERR_BUS);
+    AGS10_TEST_EQ(bus.last_errno, EOPNOTSUPP);
+    AGS10_TEST_EQ(bus.fd, -1);
+    AGS10_TEST_EQ(fake.closes, 2);
+    AGS10_TEST_CHECK(!fake.open);
+}
+
+/**
+ * @brief A TVOC sample costs 4 system calls, 2 of them I2C_RDWR ioctls,
+ *        with combine on or off: the conversion delay keeps them apart.
+ */
+static void test_sample(bool combine)
+{
+    AGS10_HandleTypeDef sensor;
+    TestCountTypeDef before;
+    uint32_t value = 0;
+
+    test_setup(combine);
+    AGS10_TEST_EQ(ags10_init(&sensor, TEST_ADDR, &ags10_linux_bus_ops, &bus), AGS10_OK);
+
+    for (uint32_t n = 0; n < 3U; n++)
+    {
+        before = test_count();
+        AGS10_TEST_EQ(ags10_tvoc_get(&sensor, &value), AGS10_OK);
+        AGS10_TEST_EQ(value, TEST_TVOC_PPB);
+        test_delta(&before, 4, 2, 2);
+        AGS10_TEST_EQ(fake.sleeps - n, 1);
+    }
+
+    // split-phase: no delay call, so the pointer must go out in start()
+    uint32_t now_ms = ags10_sim_tick_ms(&sim);
+
+    before = test_count();
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_VERSION_REG, AGS10MA_VERSION_DELAY_MS, now_ms), AGS10_OK);
+    test_delta(&before, 1, 1, 1);
+    AGS10_TEST_CHECK(!bus.deferred);
+
+    ags10_sim_advance_us(&sim, AGS10MA_VERSION_DELAY_MS * 1000U);
+    AGS10_TEST_EQ(ags10_register_read_finish(&sensor, &value), AGS10_OK);
+    AGS10_TEST_EQ(value, AGS10_SIM_VERSION);
+    test_delta(&before, 2, 2, 2);
+
+    AGS10_TEST_EQ(bus.merged, 0);
+    AGS10_TEST_EQ(bus.errors, 0);
+    ags10_linux_close(&bus);
+}
+
+/**
+ * @brief A zero-delay read is one ioctl with combine, two without.
+ */
+static void test_merge(void)
+{
+    uint8_t reg = 0x10U;
+    uint8_t data[3] = {0};
+    TestCountTypeDef before;
+
+    test_setup(false);
+    before = test_count();
+    AGS10_TEST_EQ(ags10_linux_bus_ops.write(&bus, TEST_DECOY_ADDR, &reg, 1), AGS10_OK);
+    AGS10_TEST_EQ(ags10_linux_bus_ops.read(&bus, TEST_DECOY_ADDR, data, 3), AGS10_OK);
+    test_delta(&before, 2, 2, 2);
+    AGS10_TEST_EQ(data[2], 0x12U);
+    ags10_linux_close(&bus);
+
+    test_setup(true);
+    before = test_count();
+    AGS10_TEST_EQ(ags10_linux_bus_ops.write(&bus, TEST_DECOY_ADDR, &reg, 1), AGS10_OK);
+    test_delta(&before, 0, 0, 0);
+    AGS10_TEST_EQ(ags10_linux_bus_ops.read(&bus, TEST_DECOY_ADDR, data, 3), AGS10_OK);
+    test_delta(&before, 1, 1, 2);
+    AGS10_TEST_EQ(bus.merged, 1);
+    AGS10_TEST_EQ(data[0], 0x10U);
+    AGS10_TEST_EQ(data[2], 0x12U);
+
+    // a read from another address sends the held-back write on its own
+    before = test_count();
+    AGS10_TEST_EQ(ags10_linux_bus_ops.write(&bus, TEST_DECOY_ADDR, &reg, 1), AGS10_OK);
+    AGS10_TEST_EQ(ags10_linux_bus_ops.read(&bus, TEST_ABSENT, data, 3), AGS10_ERR_NACK);
+    test_delta(&before, 2, 2, 2);
+    AGS10_TEST_EQ(bus.merged, 1);
+
+    // the AGS10 itself NACKs a merged read: it needs the access delay
+    AGS10_HandleTypeDef sensor;
+    uint32_t value = 0;
+
+    AGS10_TEST_EQ(ags10_init(&sensor, TEST_ADDR, &ags10_linux_bus_ops, &bus), AGS10_OK);
+    AGS10_TEST_EQ(ags10_register_read(&sensor, AGS10MA_VERSION_REG, 0, &value), AGS10_ERR_NACK_READ);
+    AGS10_TEST_EQ(bus.merged, 2);
+
+    // closing sends a write still held back
+    before = test_count();
+    AGS10_TEST_EQ(ags10_linux_bus_ops.write(&bus, TEST_DECOY_ADDR, &reg, 1), AGS10_OK);
+    ags10_linux_close(&bus);
+    test_delta(&before, 2, 1, 1);
+    AGS10_TEST_EQ(fake.closes, 1);
+}
+
+/**
+ * @brief A held-back write that fails is reported once, by the next read
+ *        from its address, unless the flush op already returned it.
+ */
+static void test_flush_failure(void)
+{
+    uint8_t reg = AGS10MA_VERSION_REG;
+    uint8_t data[AGS10MA_FRAME_LEN];
+    TestCountTypeDef before;
+
+    test_setup(true);
+
+    // flushed by a write elsewhere, which itself succeeds
+    AGS10_TEST_EQ(ags10_linux_bus_ops.write(&bus, TEST_ABSENT, &reg, 1), AGS10_OK);
+    AGS10_TEST_EQ(ags10_linux_bus_ops.write(&bus, TEST_DECOY_ADDR, &reg, 1), AGS10_OK);
+    AGS10_TEST_EQ(bus.errors, 1);
+    AGS10_TEST_EQ(bus.last_errno, ENXIO);
+    before = test_count();
+    AGS10_TEST_EQ(ags10_linux_bus_ops.read(&bus, TEST_DECOY_ADDR, data, 1), AGS10_OK);
+    AGS10_TEST_EQ(ags10_linux_bus_ops.read(&bus, TEST_ABSENT, data, sizeof(data)), AGS10_ERR_NACK);
+    test_delta(&before, 1, 1, 2);
+    AGS10_TEST_EQ(ags10_linux_bus_ops.read(&bus, TEST_ABSENT, data, sizeof(data)), AGS10_ERR_NACK);
+    test_delta(&before, 2, 2, 3);
+
+    // flushed by a delay
+    AGS10_TEST_EQ(ags10_linux_bus_ops.write(&bus, TEST_ABSENT, &reg, 1), AGS10_OK);
+    ags10_linux_bus_ops.delay(&bus, 0);
+    before = test_count();
+    AGS10_TEST_EQ(ags10_linux_bus_ops.read(&bus, TEST_ABSENT, data, sizeof(data)), AGS10_ERR_NACK);
+    test_delta(&before, 0, 0, 0);
+
+    // superseded by a new pointer for the same address
+    AGS10_TEST_EQ(ags10_linux_bus_ops.write(&bus, TEST_ABSENT, &reg, 1), AGS10_OK);
+    ags10_linux_bus_ops.delay(&bus, 0);
+    devices[1].addr = TEST_ABSENT;
+    AGS10_TEST_EQ(ags10_linux_bus_ops.write(&bus, TEST_ABSENT, &reg, 1), AGS10_OK);
+    AGS10_TEST_EQ(ags10_linux_bus_ops.read(&bus, TEST_ABSENT, data, 1), AGS10_OK);
+    AGS10_TEST_EQ(data[0], AGS10MA_VERSION_REG);
+    devices[1].addr = TEST_DECOY_ADDR;
+
+    // the flush op returns the failure itself and leaves nothing behind
+    AGS10_TEST_EQ(ags10_linux_bus_ops.write(&bus, TEST_ABSENT, &reg, 1), AGS10_OK);
+    AGS10_TEST_EQ(ags10_linux_bus_ops.flush(&bus), AGS10_ERR_NACK);
+    AGS10_TEST_EQ(ags10_linux_bus_ops.flush(&bus), AGS10_OK);
+    before = test_count();
+    devices[1].addr = TEST_ABSENT;
+    AGS10_TEST_EQ(ags10_linux_bus_ops.read(&bus, TEST_ABSENT, data, 1), AGS10_OK);
+    test_delta(&before, 1, 1, 1);
+    devices[1].addr = TEST_DECOY_ADDR;
+
+    // and the driver sees it as a failed pointer write
+    AGS10_HandleTypeDef sensor;
+    uint32_t value = 0;
+
+    AGS10_TEST_EQ(ags10_init(&sensor, TEST_ABSENT, &ags10_linux_bus_ops, &bus), AGS10_OK);
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_VERSION_REG, AGS10MA_VERSION_DELAY_MS, 0), AGS10_ERR_NACK_WRITE);
+    AGS10_TEST_EQ(ags10_firmware_version_get(&sensor, &value), AGS10_ERR_NACK_WRITE);
+    AGS10_TEST_CHECK(!bus.deferred);
+    ags10_linux_close(&bus);
+}
+
+static void test_errno(void)
+{
+    static const struct {
+        int err;
+        AGS10_StatusTypeDef status;
+    } map[] = {
+        { ENXIO,      AGS10_ERR_NACK },
+        { EREMOTEIO,  AGS10_ERR_NACK },
+        { ETIMEDOUT,  AGS10_ERR_TIMEOUT },
+        { EAGAIN,     AGS10_ERR_BUSY },
+        { EBUSY,      AGS10_ERR_BUSY },
+        { EIO,        AGS10_ERR_BUS },
+        { EOPNOTSUPP, AGS10_ERR_BUS },
+        { 0,          AGS10_ERR_BUS },
+    };
+    uint8_t data[AGS10MA_FRAME_LEN];
+
+    for (size_t idx = 0; idx < (sizeof(map) / sizeof(map[0])); idx++)
+    {
+        AGS10_TEST_EQ(ags10_linux_errno_status(map[idx].err), map[idx].status);
+    }
+
+    // through the adapter: a NACK, then a stuck bus
+    test_setup(false);
+    AGS10_TEST_EQ(ags10_linux_bus_ops.read(&bus, TEST_ABSENT, data, sizeof(data)), AGS10_ERR_NACK);
+    AGS10_TEST_EQ(bus.last_errno, ENXIO);
+    ags10_sim_bus_stuck(&sim);
+    AGS10_TEST_EQ(ags10_linux_bus_ops.read(&bus, TEST_ADDR, data, sizeof(data)), AGS10_ERR_BUSY);
+    AGS10_TEST_EQ(bus.last_errno, EAGAIN);
+    AGS10_TEST_EQ(bus.errors, 2);
+    AGS10_TEST_EQ(bus.transfers, 2);
+    ags10_linux_close(&bus);
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    test_open();
+    test_sample(false);
+    test_sample(true);
+    test_merge();
+    test_flush_failure();
+    test_errno();
+
+    return ags10_test_done("linux");
+}
+
+// eof
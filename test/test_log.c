@@ -0,0 +1,328 @@
+/**
+ * @file test_log.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief The flash sample log on the flash simulator: append and read back,
+ *        page rotation and wear, and power cuts mid-write followed by a
+ *        remount.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_log.h"
+#include "ags10_flash_sim.h"
+#include "ags10_test.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define TEST_BASE           0x0800E000UL
+#define TEST_PAGE_SIZE      1024U
+#define TEST_PAGES          8U
+#define TEST_T0_MS          1000U
+#define TEST_PERIOD_MS      2000U
+#define TEST_ROTATE         10000U      /**< Samples to wrap the region several times. */
+#define TEST_PREFILL        (94U * AGS10_LOG_BATCH)     /**< Whole records, the region about full. */
+#define TEST_CUT_POINTS     1000U       /**< Cut after 0..999 flash operations. */
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static uint8_t flash_mem[TEST_PAGE_SIZE * TEST_PAGES];
+static uint32_t flash_wear[TEST_PAGES];
+static AGS10_FlashSimTypeDef flash;
+static AGS10_LogTypeDef log_fs;
+
+/**
+ * @brief What ags10_log_read() handed over, checked against sample_make().
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t first;             /**< Index of the first sample visited. */
+    uint32_t last;              /**< Index of the last sample visited. */
+    uint32_t wrong;             /**< Samples that match no appended one. */
+    uint32_t gaps;              /**< Samples that skip ahead of the previous one. */
+    uint32_t disorder;          /**< Samples not after the previous one. */
+} TestReadTypeDef;
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+/* Sample number idx, every field different and rebuildable from t_ms. */
+static AGS10_RingSampleTypeDef sample_make(uint32_t idx)
+{
+    return (AGS10_RingSampleTypeDef){
+        .t_ms = TEST_T0_MS + (idx * TEST_PERIOD_MS),
+        .tvoc = 250U + ((idx * 7U) % 50U),
+        .resistance = 20000U + ((idx * 37U) % 4096U),
+        .status = (uint8_t)(idx & 0x7FU),
+    };
+}
+
+static bool read_visit(void *p_ctx, const AGS10_RingSampleTypeDef *p_sample)
+{
+    TestReadTypeDef *p_read = (TestReadTypeDef *)p_ctx;
+    uint32_t idx = (p_sample->t_ms - TEST_T0_MS) / TEST_PERIOD_MS;
+    AGS10_RingSampleTypeDef want = sample_make(idx);
+
+    if ((want.t_ms != p_sample->t_ms) || (want.tvoc != p_sample->tvoc) ||
+        (want.resistance != p_sample->resistance) || (want.status != p_sample->status))
+    {
+        p_read->wrong++;
+    }
+
+    if (0U == p_read->count)
+    {
+        p_read->first = idx;
+    }
+    else if (idx <= p_read->last)
+    {
+        p_read->disorder++;
+    }
+    else if (idx != (p_read->last + 1U))
+    {
+        p_read->gaps++;
+    }
+    p_read->last = idx;
+    p_read->count++;
+
+    return true;
+}
+
+static TestReadTypeDef log_read_all(void)
+{
+    TestReadTypeDef read = { 0 };
+
+    AGS10_TEST_EQ(ags10_log_read(&log_fs, read_visit, &read), read.count);
+
+    return read;
+}
+
+static AGS10_StatusTypeDef log_mount(void)
+{
+    return ags10_log_mount(&log_fs, &ags10_flash_sim_ops, &flash, TEST_BASE, TEST_PAGE_SIZE, TEST_PAGES);
+}
+
+/* Appends samples [first, first + count); the first failure stops it. */
+static AGS10_StatusTypeDef log_fill(uint32_t first, uint32_t count)
+{
+    for (uint32_t idx = first; idx < (first + count); idx++)
+    {
+        AGS10_RingSampleTypeDef sample = sample_make(idx);
+        AGS10_StatusTypeDef status = ags10_log_append(&log_fs, &sample);
+
+        if (AGS10_OK != status)
+        {
+            return status;
+        }
+    }
+
+    return AGS10_OK;
+}
+
+static void test_mount(void)
+{
+    static const AGS10_LogFlashOpsTypeDef no_erase = {
+        .program = NULL,
+    };
+    AGS10_RingSampleTypeDef sample = sample_make(0);
+
+    ags10_flash_sim_init(&flash, flash_mem, flash_wear, TEST_BASE, TEST_PAGE_SIZE, TEST_PAGES);
+    AGS10_TEST_EQ(ags10_log_mount(&log_fs, &ags10_flash_sim_ops, &flash, TEST_BASE, TEST_PAGE_SIZE, 1), AGS10_ERR_PARAM);
+    AGS10_TEST_EQ(ags10_log_mount(&log_fs, &ags10_flash_sim_ops, &flash, TEST_BASE, TEST_PAGE_SIZE + 1U, TEST_PAGES),
+                  AGS10_ERR_PARAM);
+    AGS10_TEST_EQ(ags10_log_mount(&log_fs, &ags10_flash_sim_ops, &flash, TEST_BASE, AGS10_LOG_REC_MAX_LEN, TEST_PAGES),
+                  AGS10_ERR_PARAM);
+    AGS10_TEST_EQ(ags10_log_mount(&log_fs, &no_erase, &flash, TEST_BASE, TEST_PAGE_SIZE, TEST_PAGES), AGS10_ERR_PARAM);
+    AGS10_TEST_EQ(flash.programmed, 0);
+
+    // a blank region is formatted: page 0 headed, no erase needed
+    AGS10_TEST_EQ(log_mount(), AGS10_OK);
+    AGS10_TEST_EQ(flash.erases, 0);
+    AGS10_TEST_EQ(flash.programmed, AGS10_LOG_PAGE_HDR_LEN / 2U);
+    AGS10_TEST_EQ(log_fs.head_page, 0);
+    AGS10_TEST_EQ(log_fs.head_off, AGS10_LOG_PAGE_HDR_LEN);
+    AGS10_TEST_EQ(log_read_all().count, 0);
+
+    // and mounts again without formatting
+    AGS10_TEST_EQ(log_mount(), AGS10_OK);
+    AGS10_TEST_EQ(flash.programmed, AGS10_LOG_PAGE_HDR_LEN / 2U);
+    AGS10_TEST_EQ(log_fs.head_seq, 1);
+
+    AGS10_TEST_EQ(ags10_log_append(NULL, &sample), AGS10_ERR_PARAM);
+    AGS10_TEST_EQ(ags10_log_append(&log_fs, NULL), AGS10_ERR_PARAM);
+}
+
+/**
+ * @brief Only full batches reach flash until a flush, and every sample
+ *        reads back intact, also after a remount.
+ */
+static void test_append(void)
+{
+    TestReadTypeDef read;
+    uint32_t count = (3U * AGS10_LOG_BATCH) + 5U;
+
+    ags10_flash_sim_init(&flash, flash_mem, flash_wear, TEST_BASE, TEST_PAGE_SIZE, TEST_PAGES);
+    AGS10_TEST_EQ(log_mount(), AGS10_OK);
+    AGS10_TEST_EQ(ags10_log_flush(&log_fs), AGS10_OK);
+    AGS10_TEST_EQ(log_fs.records, 0);
+
+    AGS10_TEST_EQ(log_fill(0, count), AGS10_OK);
+    AGS10_TEST_EQ(log_fs.records, 3);
+    AGS10_TEST_EQ(log_fs.batch_count, 5);
+    read = log_read_all();
+    AGS10_TEST_EQ(read.count, 3U * AGS10_LOG_BATCH);
+
+    AGS10_TEST_EQ(ags10_log_flush(&log_fs), AGS10_OK);
+    AGS10_TEST_EQ(log_fs.records, 4);
+    read = log_read_all();
+    AGS10_TEST_EQ(read.count, count);
+    AGS10_TEST_EQ(read.first, 0);
+    AGS10_TEST_EQ(read.wrong, 0);
+    AGS10_TEST_EQ(read.gaps, 0);
+
+    // a reset: the append point is found again and nothing is written twice
+    uint32_t head_off = log_fs.head_off;
+    uint32_t errors = flash.errors;
+
+    AGS10_TEST_EQ(log_mount(), AGS10_OK);
+    AGS10_TEST_EQ(log_fs.head_off, head_off);
+    AGS10_TEST_EQ(log_fs.bad_records, 0);
+    AGS10_TEST_EQ(log_fill(count, AGS10_LOG_BATCH), AGS10_OK);
+    read = log_read_all();
+    AGS10_TEST_EQ(read.count, count + AGS10_LOG_BATCH);
+    AGS10_TEST_EQ(read.gaps, 0);
+    AGS10_TEST_EQ(flash.errors, errors);
+}
+
+/**
+ * @brief Pages are reused in a circle: erases spread evenly, and what is
+ *        left is the newest samples without a gap.
+ */
+static void test_rotation(void)
+{
+    TestReadTypeDef read;
+
+    ags10_flash_sim_init(&flash, flash_mem, flash_wear, TEST_BASE, TEST_PAGE_SIZE, TEST_PAGES);
+    AGS10_TEST_EQ(log_mount(), AGS10_OK);
+    AGS10_TEST_EQ(log_fill(0, TEST_ROTATE), AGS10_OK);
+    AGS10_TEST_EQ(ags10_log_flush(&log_fs), AGS10_OK);
+
+    uint32_t wear_min = flash_wear[0];
+    uint32_t wear_max = flash_wear[0];
+
+    for (uint32_t page = 1; page < TEST_PAGES; page++)
+    {
+        wear_min = (flash_wear[page] < wear_min) ? flash_wear[page] : wear_min;
+        wear_max = (flash_wear[page] > wear_max) ? flash_wear[page] : wear_max;
+    }
+    AGS10_TEST_CHECK(wear_min >= 5U);
+    AGS10_TEST_CHECK((wear_max - wear_min) <= 1U);
+    AGS10_TEST_EQ(flash.erases, log_fs.erases);
+    AGS10_TEST_EQ(flash.errors, 0);
+
+    read = log_read_all();
+    AGS10_TEST_EQ(read.last, TEST_ROTATE - 1U);
+    AGS10_TEST_EQ(read.wrong, 0);
+    AGS10_TEST_EQ(read.gaps, 0);
+    // at least every page but the one being refilled is full
+    AGS10_TEST_CHECK(read.count >= ((TEST_PAGES - 1U) * (TEST_PAGE_SIZE / AGS10_LOG_REC_MAX_LEN) * AGS10_LOG_BATCH));
+
+    // a remount finds the same head, tail and contents
+    uint16_t head_page = log_fs.head_page;
+    uint16_t tail_page = log_fs.tail_page;
+    uint32_t head_seq = log_fs.head_seq;
+
+    AGS10_TEST_EQ(log_mount(), AGS10_OK);
+    AGS10_TEST_EQ(log_fs.head_page, head_page);
+    AGS10_TEST_EQ(log_fs.tail_page, tail_page);
+    AGS10_TEST_EQ(log_fs.head_seq, head_seq);
+    AGS10_TEST_EQ(log_read_all().count, read.count);
+}
+
+/**
+ * @brief A power cut at any point of a record write or page recycle: the
+ *        remount keeps every record written before it, skips the torn one,
+ *        and the log takes new records afterwards.
+ */
+static void test_power_cut(void)
+{
+    uint32_t wrong = 0;
+    uint32_t disorder = 0;
+    uint32_t gaps = 0;
+    uint32_t not_last = 0;
+    uint32_t bad_mounts = 0;
+    uint32_t cut_erases = 0;
+    uint32_t bad_records = 0;
+
+    for (uint32_t cut = 0; cut < TEST_CUT_POINTS; cut++)
+    {
+        TestReadTypeDef read;
+
+        ags10_flash_sim_init(&flash, flash_mem, flash_wear, TEST_BASE, TEST_PAGE_SIZE, TEST_PAGES);
+        (void)log_mount();
+        (void)log_fill(0, TEST_PREFILL);
+
+        // every op from here on is a record, a page erase or a page header
+        uint32_t next = TEST_PREFILL;
+
+        ags10_flash_sim_cut(&flash, cut, cut + 1U);
+        while (AGS10_OK == log_fill(next, AGS10_LOG_BATCH))
+        {
+            next += AGS10_LOG_BATCH;
+        }
+
+        // a cut in an erase may tear the oldest page anywhere, it was being dropped
+        bool hit_erase = (log_fs.erases != flash.erases);
+
+        cut_erases += hit_erase ? 1U : 0U;
+
+        ags10_flash_sim_power_on(&flash);
+        if (AGS10_OK != log_mount())
+        {
+            bad_mounts++;
+            continue;
+        }
+        bad_records += log_fs.bad_records;
+
+        // the batch in flight is lost, everything before it is there
+        read = log_read_all();
+        wrong += read.wrong;
+        disorder += read.disorder;
+        gaps += hit_erase ? 0U : read.gaps;
+        not_last += ((read.last + 1U) != next) ? 1U : 0U;
+
+        (void)log_fill(next, 2U * AGS10_LOG_BATCH);
+        read = log_read_all();
+        wrong += read.wrong;
+        disorder += read.disorder;
+        not_last += ((read.last + 1U) != (next + (2U * AGS10_LOG_BATCH))) ? 1U : 0U;
+    }
+
+    AGS10_TEST_EQ(bad_mounts, 0);
+    AGS10_TEST_EQ(wrong, 0);
+    AGS10_TEST_EQ(disorder, 0);
+    AGS10_TEST_EQ(gaps, 0);
+    AGS10_TEST_EQ(not_last, 0);
+    // torn records were found, and some cuts hit a page erase
+    AGS10_TEST_CHECK(bad_records > 0U);
+    AGS10_TEST_CHECK(cut_erases > 0U);
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    test_mount();
+    test_append();
+    test_rotation();
+    test_power_cut();
+
+    return ags10_test_done("log");
+}
+
+// eof
@@ -0,0 +1,141 @@
+/**
+ * @file test_prof.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief The read profiler timed against the simulator's virtual clock.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10.h"
+#include "ags10_prof.h"
+#include "ags10_sim.h"
+#include "ags10_sim_async.h"
+#include "ags10_test.h"
+
+#include <string.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define TEST_ADDR       0x1AU
+#define TEST_ABSENT     0x40U
+#define TEST_READS      10U
+
+/* Bus time at 20 kHz: START, address, payload bytes with ACK, STOP */
+#define TEST_PTR_US     1000U       /**< 20 clocks. */
+#define TEST_FRAME_US   2800U       /**< 56 clocks. */
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static AGS10_SimDeviceTypeDef device;
+static AGS10_SimBusTypeDef bus;
+static AGS10_SimAsyncTypeDef async;
+static uint32_t dump_lines;
+static bool dump_too_long;
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static void test_setup(void)
+{
+    ags10_sim_device_init(&device, TEST_ADDR);
+    ags10_sim_bus_init(&bus, &device, 1, AGS10_SIM_DEFAULT_CLOCK_HZ);
+    ags10_sim_advance_us(&bus, (uint64_t)AGS10_SIM_PREHEAT_MS * 1000U);
+    ags10_prof_init();
+}
+
+static void test_entry(AGS10_ProfPhaseTypeDef phase, uint32_t count, uint32_t min, uint32_t max)
+{
+    const AGS10_ProfEntryTypeDef *p_entry = ags10_prof_entry_get(phase);
+
+    AGS10_TEST_EQ(p_entry->count, count);
+    AGS10_TEST_EQ(p_entry->min, min);
+    AGS10_TEST_EQ(p_entry->max, max);
+}
+
+static void test_put(void *p_ctx, const char *p_line)
+{
+    (void)p_ctx;
+    dump_lines++;
+    dump_too_long |= (strlen(p_line) > AGS10_PROF_LINE_LEN);
+}
+
+static void test_blocking(void)
+{
+    AGS10_HandleTypeDef sensor;
+    uint32_t value;
+
+    test_setup();
+    (void)ags10_init(&sensor, TEST_ADDR, &ags10_sim_bus_ops, &bus);
+
+    // on a blocking bus each phase is exactly its bus time or its wait
+    for (uint32_t idx = 0; idx < TEST_READS; idx++)
+    {
+        AGS10_TEST_EQ(ags10_tvoc_get(&sensor, &value), AGS10_OK);
+    }
+    test_entry(AGS10_PROF_PTR_WRITE, TEST_READS, TEST_PTR_US, TEST_PTR_US);
+    test_entry(AGS10_PROF_CONVERT, TEST_READS, AGS10MA_TVOC_DELAY_MS * 1000U, AGS10MA_TVOC_DELAY_MS * 1000U);
+    test_entry(AGS10_PROF_FRAME_READ, TEST_READS, TEST_FRAME_US, TEST_FRAME_US);
+    test_entry(AGS10_PROF_CRC, TEST_READS, 0, 0);
+    test_entry(AGS10_PROF_UNPACK, TEST_READS, 0, 0);
+    AGS10_TEST_EQ(ags10_prof_entry_get(AGS10_PROF_CONVERT)->total,
+                  (uint64_t)TEST_READS * AGS10MA_TVOC_DELAY_MS * 1000U);
+
+    // the wait is the register's
+    ags10_prof_reset();
+    AGS10_TEST_EQ(ags10_firmware_version_get(&sensor, &value), AGS10_OK);
+    test_entry(AGS10_PROF_CONVERT, 1, AGS10MA_VERSION_DELAY_MS * 1000U, AGS10MA_VERSION_DELAY_MS * 1000U);
+
+    // a read that is not acknowledged ends before any phase
+    ags10_prof_reset();
+    (void)ags10_init(&sensor, TEST_ABSENT, &ags10_sim_bus_ops, &bus);
+    AGS10_TEST_CHECK(AGS10_OK != ags10_firmware_version_get(&sensor, &value));
+    for (uint32_t phase = 0; phase < AGS10_PROF_PHASE_COUNT; phase++)
+    {
+        AGS10_TEST_EQ(ags10_prof_entry_get((AGS10_ProfPhaseTypeDef)phase)->count, 0);
+    }
+
+    AGS10_TEST_CHECK(NULL == ags10_prof_entry_get(AGS10_PROF_PHASE_COUNT));
+    ags10_prof_dump(test_put, NULL);
+    AGS10_TEST_EQ(dump_lines, 1U + AGS10_PROF_PHASE_COUNT);
+    AGS10_TEST_CHECK(!dump_too_long);
+}
+
+static void test_async(void)
+{
+    AGS10_HandleTypeDef sensor;
+    uint32_t value;
+
+    test_setup();
+    ags10_sim_async_init(&async, &bus);
+    (void)ags10_init(&sensor, TEST_ADDR, &ags10_sim_async_bus_ops, &async);
+
+    // transfers are timed to their completion, not to the start call
+    AGS10_TEST_EQ(ags10_firmware_version_get(&sensor, &value), AGS10_OK);
+    test_entry(AGS10_PROF_PTR_WRITE, 1, TEST_PTR_US + AGS10_SIM_ASYNC_LATENCY_US,
+               TEST_PTR_US + AGS10_SIM_ASYNC_LATENCY_US);
+    test_entry(AGS10_PROF_FRAME_READ, 1, TEST_FRAME_US + AGS10_SIM_ASYNC_LATENCY_US,
+               TEST_FRAME_US + AGS10_SIM_ASYNC_LATENCY_US);
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+uint32_t ags10_prof_sim_us(void)
+{
+    return (uint32_t)bus.now_us;
+}
+
+int main(void)
+{
+    test_blocking();
+    test_async();
+
+    return ags10_test_done("prof");
+}
+// eof
@@ -0,0 +1,249 @@
+/**
+ * @file test_retry.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Retry policy on the split-phase API: start, ready and finish with
+ *        pointer writes that fail, on the simulated buses.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10.h"
+#include "ags10_sim.h"
+#include "ags10_sim_async.h"
+#include "ags10_test.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define TEST_ADDR       0x1AU
+#define TEST_ELSEWHERE  0x50U       /**< Address the device moves to, to NACK. */
+#define TEST_LIMIT_MS   1000U
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static AGS10_SimDeviceTypeDef device;
+static AGS10_SimBusTypeDef bus;
+static AGS10_SimAsyncTypeDef async;
+
+static const AGS10_RetryPolicyTypeDef policy = {
+    .max_attempts = 3,
+    .reread = true,
+    .backoff_ms = 2,
+    .backoff_max_ms = 8,
+};
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static void test_setup(AGS10_HandleTypeDef *ph_sensor, const AGS10_BusOpsTypeDef *p_ops, void *p_ctx)
+{
+    ags10_sim_device_init(&device, TEST_ADDR);
+    ags10_sim_bus_init(&bus, &device, 1, AGS10_SIM_DEFAULT_CLOCK_HZ);
+    ags10_sim_advance_us(&bus, (uint64_t)AGS10_SIM_PREHEAT_MS * 1000U);
+    ags10_sim_async_init(&async, &bus);
+    (void)ags10_init(ph_sensor, TEST_ADDR, p_ops, p_ctx);
+    AGS10_TEST_EQ(ags10_retry_policy_set(ph_sensor, &policy), AGS10_OK);
+}
+
+/* Calls ready() every millisecond until it is true; the number of calls. */
+static uint32_t test_wait_ready(AGS10_HandleTypeDef *ph_sensor)
+{
+    uint32_t calls = 0;
+
+    while (!ags10_register_read_ready(ph_sensor, ags10_sim_tick_ms(&bus)) && (calls < TEST_LIMIT_MS))
+    {
+        ags10_sim_advance_us(&bus, 1000U);
+        calls++;
+    }
+
+    return calls;
+}
+
+static void test_stats(const AGS10_HandleTypeDef *ph_sensor, uint32_t nack_write, uint32_t retries,
+                       uint32_t rescued, uint32_t successful)
+{
+    AGS10_StatsTypeDef stats;
+
+    (void)ags10_stats_get(ph_sensor, &stats);
+    AGS10_TEST_EQ(stats.nack_write, nack_write);
+    AGS10_TEST_EQ(stats.retries, retries);
+    AGS10_TEST_EQ(stats.rescued, rescued);
+    AGS10_TEST_EQ(stats.transactions - (stats.nack_write + stats.nack_read + stats.crc_fail +
+                                        stats.timeout + stats.bus_error - stats.retries), successful);
+}
+
+static void test_rescued(void)
+{
+    AGS10_HandleTypeDef sensor;
+    uint32_t value = 0;
+
+    test_setup(&sensor, &ags10_sim_bus_ops, &bus);
+
+    // the pointer write fails: start succeeds, the handle backs off
+    device.addr = TEST_ELSEWHERE;
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_VERSION_REG, AGS10MA_VERSION_DELAY_MS,
+                                            ags10_sim_tick_ms(&bus)), AGS10_OK);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_BACKOFF);
+    device.addr = TEST_ADDR;
+
+    // ready() sends the pointer again after 2 ms, then waits out the conversion
+    AGS10_TEST_CHECK(!ags10_register_read_ready(&sensor, ags10_sim_tick_ms(&bus)));
+    ags10_sim_advance_us(&bus, (uint64_t)policy.backoff_ms * 1000U);
+
+    uint32_t resend_ms = ags10_sim_tick_ms(&bus);
+
+    AGS10_TEST_CHECK(!ags10_register_read_ready(&sensor, resend_ms));
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_CONVERTING);
+    (void)test_wait_ready(&sensor);
+    AGS10_TEST_EQ(ags10_sim_tick_ms(&bus) - resend_ms, AGS10MA_VERSION_DELAY_MS);
+
+    AGS10_TEST_EQ(ags10_register_read_finish(&sensor, &value), AGS10_OK);
+    AGS10_TEST_EQ(value & 0xFFU, AGS10_SIM_VERSION);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_IDLE);
+    test_stats(&sensor, 1, 1, 1, 1);
+}
+
+static void test_exhausted(void)
+{
+    AGS10_HandleTypeDef sensor;
+    uint32_t value = 0;
+
+    test_setup(&sensor, &ags10_sim_bus_ops, &bus);
+
+    // every attempt fails: ready() gives up after the third, 2 + 4 ms of backoff later
+    uint32_t start_ms = ags10_sim_tick_ms(&bus);
+
+    device.addr = TEST_ELSEWHERE;
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_VERSION_REG, AGS10MA_VERSION_DELAY_MS,
+                                            start_ms), AGS10_OK);
+    (void)test_wait_ready(&sensor);
+    AGS10_TEST_CHECK((ags10_sim_tick_ms(&bus) - start_ms) >= 6U);
+    AGS10_TEST_CHECK((ags10_sim_tick_ms(&bus) - start_ms) < 10U);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_FAILED);
+    AGS10_TEST_EQ(ags10_register_read_finish(&sensor, &value), AGS10_ERR_NACK_WRITE);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_IDLE);
+    AGS10_TEST_EQ(ags10_register_read_finish(&sensor, &value), AGS10_ERR_PARAM);
+    test_stats(&sensor, 3, 2, 0, 0);
+
+    // the handle is free for the next read
+    device.addr = TEST_ADDR;
+    AGS10_TEST_EQ(ags10_firmware_version_get(&sensor, &value), AGS10_OK);
+}
+
+static void test_finish_early(void)
+{
+    AGS10_HandleTypeDef sensor;
+    uint32_t value = 0;
+
+    test_setup(&sensor, &ags10_sim_bus_ops, &bus);
+
+    // finish() cannot wait out the backoff: the failure is final, counted once
+    device.addr = TEST_ELSEWHERE;
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_VERSION_REG, AGS10MA_VERSION_DELAY_MS,
+                                            ags10_sim_tick_ms(&bus)), AGS10_OK);
+    AGS10_TEST_EQ(ags10_register_read_finish(&sensor, &value), AGS10_ERR_NACK_WRITE);
+    AGS10_TEST_EQ(sensor.last_status, AGS10_ERR_NACK_WRITE);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_IDLE);
+    test_stats(&sensor, 1, 0, 0, 0);
+}
+
+/*
+ * More attempts than bits in the wait: the doubling stops at the cap and the
+ * shift never reaches the width of the type (UBSan checks it).
+ */
+static void test_many_attempts(void)
+{
+    static const AGS10_RetryPolicyTypeDef many = {
+        .max_attempts = 200,
+        .reread = false,
+        .backoff_ms = 1,
+        .backoff_max_ms = 100,
+    };
+    AGS10_HandleTypeDef sensor;
+    uint32_t value = 0;
+    uint32_t waits = 0;
+    uint32_t capped = 0;
+    uint16_t last_backoff_ms = 0;
+
+    test_setup(&sensor, &ags10_sim_bus_ops, &bus);
+    AGS10_TEST_EQ(ags10_retry_policy_set(&sensor, &many), AGS10_OK);
+
+    device.addr = TEST_ELSEWHERE;
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_VERSION_REG, AGS10MA_VERSION_DELAY_MS,
+                                            ags10_sim_tick_ms(&bus)), AGS10_OK);
+    while (!ags10_register_read_ready(&sensor, ags10_sim_tick_ms(&bus)) && (waits < (200U * TEST_LIMIT_MS)))
+    {
+        if (sensor.xfer_backoff_ms != last_backoff_ms)
+        {
+            // 1, 2, 4 ... 64, then 100 for every further retry
+            uint32_t expected_ms = (0U == last_backoff_ms) ? many.backoff_ms : (2U * last_backoff_ms);
+
+            AGS10_TEST_EQ(sensor.xfer_backoff_ms, (expected_ms < many.backoff_max_ms) ? expected_ms : many.backoff_max_ms);
+            last_backoff_ms = sensor.xfer_backoff_ms;
+        }
+        capped += (many.backoff_max_ms == sensor.xfer_backoff_ms) ? 1U : 0U;
+        ags10_sim_advance_us(&bus, 1000U);
+        waits++;
+    }
+
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_FAILED);
+    AGS10_TEST_EQ(sensor.xfer_attempt, many.max_attempts - 1U);
+    AGS10_TEST_EQ(sensor.xfer_backoff_ms, many.backoff_max_ms);
+    AGS10_TEST_CHECK(capped > 0U);
+    AGS10_TEST_EQ(ags10_register_read_finish(&sensor, &value), AGS10_ERR_NACK_WRITE);
+    test_stats(&sensor, 200, 199, 0, 0);
+    device.addr = TEST_ADDR;
+}
+
+static void test_async_write(void)
+{
+    AGS10_HandleTypeDef sensor;
+    AGS10_StatusTypeDef status;
+    uint32_t value = 0;
+    uint32_t calls = 0;
+
+    test_setup(&sensor, &ags10_sim_async_bus_ops, &async);
+
+    // the NACK arrives with the completion, which ready() sees and retries
+    device.addr = TEST_ELSEWHERE;
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_VERSION_REG, AGS10MA_VERSION_DELAY_MS,
+                                            ags10_sim_tick_ms(&bus)), AGS10_OK);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_WRITING);
+    ags10_sim_advance_us(&bus, AGS10_SIM_ASYNC_LATENCY_US);
+    AGS10_TEST_CHECK(!ags10_register_read_ready(&sensor, ags10_sim_tick_ms(&bus)));
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_BACKOFF);
+    device.addr = TEST_ADDR;
+
+    AGS10_TEST_CHECK(test_wait_ready(&sensor) < TEST_LIMIT_MS);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_READY);
+
+    // the frame read is asynchronous too: busy until its completion
+    while ((AGS10_ERR_BUSY == (status = ags10_register_read_finish(&sensor, &value))) && (calls++ < TEST_LIMIT_MS))
+    {
+        ags10_sim_advance_us(&bus, 1000U);
+    }
+    AGS10_TEST_EQ(status, AGS10_OK);
+    AGS10_TEST_EQ(value & 0xFFU, AGS10_SIM_VERSION);
+    test_stats(&sensor, 1, 1, 1, 1);
+    AGS10_TEST_EQ(async.busy_rejects, 0);
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    test_rescued();
+    test_exhausted();
+    test_finish_early();
+    test_many_attempts();
+    test_async_write();
+
+    return ags10_test_done("retry");
+}
+// eof
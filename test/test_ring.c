@@ -0,0 +1,210 @@
+/**
+ * @file test_ring.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief The sample ring between a producer and a consumer thread, its
+ *        resistance code, and its drop and gap accounting.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_ring.h"
+#include "ags10_test.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define TEST_SAMPLES        200000U
+#define TEST_T0_MS          1000U
+#define TEST_PERIOD_MS      2000U
+#define TEST_GAP_MS         100000U
+#define TEST_RES_MAX_PPM    500U        /**< Header promise: under 0.05 %. */
+#define TEST_RES_SAT        (AGS10_RING_RES_MANT_MSK << 15)
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static AGS10_RingTypeDef ring;
+static uint32_t rejects;                /* Producer only, read after the join. */
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief Sample number idx, so the consumer can rebuild what it should get.
+ */
+static void sample_make(uint32_t idx, uint32_t t_ms, AGS10_RingSampleTypeDef *p_sample)
+{
+    p_sample->t_ms = t_ms;
+    p_sample->tvoc = idx & AGS10_RING_TVOC_MAX;
+    p_sample->resistance = (idx * 37U) & AGS10_RING_RES_MANT_MSK;   // exact in the code
+    p_sample->status = (uint8_t)idx;
+}
+
+/**
+ * @brief Producer: push every sample, yielding while the ring is full.
+ */
+static void *producer(void *p_arg)
+{
+    AGS10_RingSampleTypeDef sample;
+    uint32_t t_ms = TEST_T0_MS;
+
+    (void)p_arg;
+
+    for (uint32_t idx = 0; idx < TEST_SAMPLES; idx++)
+    {
+        t_ms += 1U + (idx % 7U);
+        sample_make(idx, t_ms, &sample);
+
+        while (!ags10_ring_push(&ring, &sample))
+        {
+            rejects++;
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Consumer side of the stress test, on the main thread.
+ */
+static void test_threads(void)
+{
+    AGS10_RingSampleTypeDef got;
+    AGS10_RingSampleTypeDef want;
+    uint32_t t_ms = TEST_T0_MS;
+    uint32_t bad = 0;
+    pthread_t thread;
+
+    ags10_ring_init(&ring, TEST_T0_MS);
+    AGS10_TEST_EQ(pthread_create(&thread, NULL, producer, NULL), 0);
+
+    for (uint32_t idx = 0; idx < TEST_SAMPLES; idx++)
+    {
+        while (!ags10_ring_pop(&ring, &got))
+        {
+            sched_yield();
+        }
+
+        t_ms += 1U + (idx % 7U);
+        sample_make(idx, t_ms, &want);
+
+        bad += ((got.t_ms != want.t_ms) || (got.tvoc != want.tvoc) ||
+                (got.resistance != want.resistance) || (got.status != want.status)) ? 1U : 0U;
+    }
+
+    AGS10_TEST_EQ(pthread_join(thread, NULL), 0);
+    AGS10_TEST_EQ(bad, 0);
+    AGS10_TEST_EQ(ags10_ring_count(&ring), 0);
+    // a full ring counts every retry the producer made
+    AGS10_TEST_EQ(ring.dropped, rejects);
+}
+
+/**
+ * @brief Resistance code: exact to 4095, 12 significant bits above, then saturated.
+ */
+static void test_res_code(void)
+{
+    uint32_t max_ppm = 0;
+    uint32_t above = 0;
+
+    for (uint32_t res = 0; res <= AGS10_RING_RES_MANT_MSK; res++)
+    {
+        if (res != ags10_ring_res_decode(ags10_ring_res_encode(res)))
+        {
+            AGS10_TEST_EQ(ags10_ring_res_decode(ags10_ring_res_encode(res)), res);
+            break;
+        }
+    }
+
+    for (uint64_t res = AGS10_RING_RES_MANT_MSK + 1U; res <= TEST_RES_SAT; res += (res / 1000U) + 1U)
+    {
+        uint32_t dec = ags10_ring_res_decode(ags10_ring_res_encode((uint32_t)res));
+        uint32_t ppm = (uint32_t)(((res - dec) * 1000000ULL) / res);
+
+        above += (dec > res) ? 1U : 0U;
+        max_ppm = (ppm > max_ppm) ? ppm : max_ppm;
+    }
+
+    AGS10_TEST_EQ(above, 0);
+    AGS10_TEST_CHECK(max_ppm < TEST_RES_MAX_PPM);
+    AGS10_TEST_EQ(ags10_ring_res_decode(ags10_ring_res_encode(TEST_RES_SAT)), TEST_RES_SAT);
+    AGS10_TEST_EQ(ags10_ring_res_decode(ags10_ring_res_encode(TEST_RES_SAT + 1U)), TEST_RES_SAT);
+    AGS10_TEST_EQ(ags10_ring_res_decode(ags10_ring_res_encode(0xFFFFFFFFU)), TEST_RES_SAT);
+}
+
+/**
+ * @brief Full ring, long gap, and the missing-resistance status bit.
+ */
+static void test_drops_and_gap(void)
+{
+    AGS10_RingSampleTypeDef sample = {0};
+    AGS10_RingSampleTypeDef got;
+    uint32_t t_ms = 0;
+
+    ags10_ring_init(&ring, 0);
+
+    for (uint32_t idx = 0; idx < (AGS10_RING_LEN + 44U); idx++)
+    {
+        sample.t_ms += TEST_PERIOD_MS;
+        sample.tvoc = idx;
+        (void)ags10_ring_push(&ring, &sample);
+    }
+
+    AGS10_TEST_EQ(ags10_ring_count(&ring), AGS10_RING_LEN);
+    AGS10_TEST_EQ(ring.dropped, 44);
+
+    for (uint32_t idx = 0; idx < AGS10_RING_LEN; idx++)
+    {
+        AGS10_TEST_CHECK(ags10_ring_pop(&ring, &got));
+        t_ms += TEST_PERIOD_MS;
+        if ((got.t_ms != t_ms) || (got.tvoc != idx))
+        {
+            AGS10_TEST_EQ(got.t_ms, t_ms);
+            AGS10_TEST_EQ(got.tvoc, idx);
+            break;
+        }
+    }
+
+    AGS10_TEST_CHECK(!ags10_ring_pop(&ring, &got));
+
+    // the 44 dropped periods and the gap are carried until absorbed
+    sample.t_ms += TEST_GAP_MS;
+    (void)ags10_ring_push(&ring, &sample);
+    sample.t_ms += TEST_PERIOD_MS;
+    (void)ags10_ring_push(&ring, &sample);
+    sample.t_ms += TEST_PERIOD_MS;
+    sample.resistance = 1234U;
+    sample.status = 0x10U | AGS10_RING_STATUS_NO_RES;
+    (void)ags10_ring_push(&ring, &sample);
+
+    AGS10_TEST_CHECK(ags10_ring_pop(&ring, &got));
+    AGS10_TEST_EQ(got.t_ms, t_ms + AGS10_RING_DT_MAX_MS);
+    AGS10_TEST_CHECK(ags10_ring_pop(&ring, &got));
+    AGS10_TEST_EQ(got.t_ms, t_ms + (2U * AGS10_RING_DT_MAX_MS));
+    AGS10_TEST_CHECK(ags10_ring_pop(&ring, &got));
+    AGS10_TEST_EQ(got.t_ms, sample.t_ms);
+    AGS10_TEST_EQ(got.resistance, 1234U);
+    AGS10_TEST_EQ(got.status, 0x10U | AGS10_RING_STATUS_NO_RES);
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    test_threads();
+    test_res_code();
+    test_drops_and_gap();
+
+    return ags10_test_done("ring");
+}
+
+// eof
@@ -0,0 +1,343 @@
+/**
+ * @file test_scan.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Bus discovery on the simulator: AGS10s among decoys, addresses
+ *        shared by two parts, addresses that NACK, a stuck bus, several
+ *        buses at once, and a bus that holds its last pointer back.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_scan.h"
+#include "ags10_sim.h"
+#include "ags10_test.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define TEST_CLOCK_HZ       100000U
+#define TEST_MAX_DEVICES    8U
+#define TEST_MAX_FOUND      8U
+#define TEST_BUSES          3U
+#define TEST_PROBES         ((AGS10_SCAN_LAST_ADDR - AGS10_SCAN_FIRST_ADDR) + 1U)
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static AGS10_SimBusTypeDef sims[TEST_BUSES];
+static AGS10_SimDeviceTypeDef devices[TEST_BUSES][TEST_MAX_DEVICES];
+static AGS10_ScanDeviceTypeDef found[TEST_BUSES][TEST_MAX_FOUND];
+static AGS10_ScanBusTypeDef scans[TEST_BUSES];
+
+/**
+ * @brief The simulator behind a bus that holds a one-byte write back until
+ *        the next transfer or a flush, like the Linux back end in combine
+ *        mode.
+ */
+typedef struct {
+    AGS10_SimBusTypeDef *p_sim;
+    bool held;
+    uint8_t held_addr;
+    uint8_t held_reg;
+    bool flush_fails;           /**< The held write is NACKed when flushed. */
+    uint32_t flushes;           /**< Held writes sent by the flush op. */
+} TestHoldBusTypeDef;
+
+static TestHoldBusTypeDef hold;
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+/* Sends what is held; the result of a held write other than a flush is not reported. */
+static AGS10_StatusTypeDef hold_send(TestHoldBusTypeDef *p_hold)
+{
+    if (!p_hold->held)
+    {
+        return AGS10_OK;
+    }
+
+    p_hold->held = false;
+
+    return ags10_sim_bus_ops.write(p_hold->p_sim, p_hold->held_addr, &p_hold->held_reg, 1);
+}
+
+static AGS10_StatusTypeDef hold_write(void *p_ctx, uint8_t addr, uint8_t *p_data, uint16_t length)
+{
+    TestHoldBusTypeDef *p_hold = (TestHoldBusTypeDef *)p_ctx;
+
+    (void)hold_send(p_hold);
+    if (1U == length)
+    {
+        p_hold->held = true;
+        p_hold->held_addr = addr;
+        p_hold->held_reg = p_data[0];
+        return AGS10_OK;
+    }
+
+    return ags10_sim_bus_ops.write(p_hold->p_sim, addr, p_data, length);
+}
+
+static AGS10_StatusTypeDef hold_read(void *p_ctx, uint8_t addr, uint8_t *p_data, uint16_t length)
+{
+    TestHoldBusTypeDef *p_hold = (TestHoldBusTypeDef *)p_ctx;
+
+    (void)hold_send(p_hold);
+
+    return ags10_sim_bus_ops.read(p_hold->p_sim, addr, p_data, length);
+}
+
+static void hold_delay(void *p_ctx, uint16_t ms)
+{
+    TestHoldBusTypeDef *p_hold = (TestHoldBusTypeDef *)p_ctx;
+
+    ags10_sim_bus_ops.delay(p_hold->p_sim, ms);
+}
+
+static uint32_t hold_tick_ms(void *p_ctx)
+{
+    return ags10_sim_tick_ms(((TestHoldBusTypeDef *)p_ctx)->p_sim);
+}
+
+static AGS10_StatusTypeDef hold_flush(void *p_ctx)
+{
+    TestHoldBusTypeDef *p_hold = (TestHoldBusTypeDef *)p_ctx;
+
+    if (!p_hold->held)
+    {
+        return AGS10_OK;
+    }
+
+    p_hold->flushes++;
+    if (p_hold->flush_fails)
+    {
+        p_hold->held = false;
+        return AGS10_ERR_NACK;
+    }
+
+    return hold_send(p_hold);
+}
+
+static const AGS10_BusOpsTypeDef hold_ops = {
+    .write       = hold_write,
+    .read        = hold_read,
+    .delay       = hold_delay,
+    .get_tick_ms = hold_tick_ms,
+    .flush       = hold_flush,
+};
+
+/* Bus b with one part of the given kind per address, AGS10s at version addr + 1. */
+static void bus_make(uint16_t b, const uint8_t *p_addrs, const uint8_t *p_kinds, uint16_t count)
+{
+    for (uint16_t idx = 0; idx < count; idx++)
+    {
+        ags10_sim_device_init(&devices[b][idx], p_addrs[idx]);
+        devices[b][idx].kind = p_kinds[idx];
+        devices[b][idx].version = (uint8_t)(p_addrs[idx] + 1U);
+    }
+    ags10_sim_bus_init(&sims[b], devices[b], count, TEST_CLOCK_HZ);
+    AGS10_TEST_CHECK(ags10_scan_bus_init(&scans[b], &ags10_sim_bus_ops, &sims[b], found[b], TEST_MAX_FOUND));
+}
+
+static bool scan_has(const AGS10_ScanBusTypeDef *p_scan, uint8_t addr)
+{
+    return 0U != (p_scan->ack_map[addr >> 3] & (1U << (addr & 7U)));
+}
+
+static void test_init(void)
+{
+    AGS10_SimBusTypeDef sim;
+
+    AGS10_TEST_CHECK(!ags10_scan_bus_init(NULL, &ags10_sim_bus_ops, &sim, found[0], 1));
+    AGS10_TEST_CHECK(!ags10_scan_bus_init(&scans[0], NULL, &sim, found[0], 1));
+    AGS10_TEST_CHECK(!ags10_scan_bus_init(&scans[0], &ags10_sim_bus_ops, &sim, NULL, 1));
+    AGS10_TEST_CHECK(ags10_scan_bus_init(&scans[0], &ags10_sim_bus_ops, &sim, NULL, 0));
+    AGS10_TEST_EQ(scans[0].first_addr, AGS10_SCAN_FIRST_ADDR);
+    AGS10_TEST_EQ(scans[0].last_addr, AGS10_SCAN_LAST_ADDR);
+}
+
+/**
+ * @brief Two AGS10s among one decoy of each kind: only the AGS10s are
+ *        found, in address order, and every decoy is rejected.
+ */
+static void test_decoys(void)
+{
+    static const uint8_t addrs[] = { 0x40U, 0x1AU, 0x20U, 0x50U, 0x1BU };
+    static const uint8_t kinds[] = {
+        AGS10_SIM_DECOY_REGISTERS, AGS10_SIM_AGS10, AGS10_SIM_DECOY_ADDR_ONLY,
+        AGS10_SIM_DECOY_FLOATING, AGS10_SIM_AGS10,
+    };
+
+    bus_make(0, addrs, kinds, 5);
+    AGS10_TEST_EQ(ags10_scan_bus(&scans[0]), AGS10_OK);
+    AGS10_TEST_EQ(scans[0].probes, TEST_PROBES);
+    AGS10_TEST_EQ(scans[0].acked, 5);
+    AGS10_TEST_EQ(scans[0].found, 2);
+    AGS10_TEST_EQ(scans[0].rejected, 3);
+    AGS10_TEST_EQ(found[0][0].addr, 0x1A);
+    AGS10_TEST_EQ(found[0][0].version, 0x1B);
+    AGS10_TEST_EQ(found[0][1].addr, 0x1B);
+    AGS10_TEST_EQ(found[0][1].version, 0x1C);
+
+    // the address-only part refused its pointer and was never read
+    AGS10_TEST_CHECK(!scan_has(&scans[0], 0x20U));
+    AGS10_TEST_CHECK(scan_has(&scans[0], 0x40U) && scan_has(&scans[0], 0x50U));
+    AGS10_TEST_EQ(sims[0].transfers, TEST_PROBES + 5U + 4U);
+
+    // one version wait, after the probes at 100 kHz
+    AGS10_TEST_CHECK(scans[0].confirm_ms >= AGS10MA_VERSION_DELAY_MS);
+    AGS10_TEST_CHECK(scans[0].confirm_ms <= (AGS10MA_VERSION_DELAY_MS + 5U));
+    AGS10_TEST_CHECK(scans[0].probe_ms < 50U);
+
+    // a narrower range, and fewer slots than AGS10s: all counted, the first stored
+    AGS10_TEST_CHECK(ags10_scan_bus_init(&scans[0], &ags10_sim_bus_ops, &sims[0], found[0], 1));
+    scans[0].first_addr = 0x1BU;
+    found[0][1].addr = 0;
+    AGS10_TEST_EQ(ags10_scan_bus(&scans[0]), AGS10_OK);
+    AGS10_TEST_EQ(scans[0].probes, AGS10_SCAN_LAST_ADDR - 0x1BU + 1U);
+    AGS10_TEST_EQ(scans[0].found, 1);
+    AGS10_TEST_EQ(found[0][0].addr, 0x1B);
+
+    scans[0].first_addr = 0x1AU;
+    AGS10_TEST_EQ(ags10_scan_bus(&scans[0]), AGS10_OK);
+    AGS10_TEST_EQ(scans[0].found, 2);
+    AGS10_TEST_EQ(found[0][0].addr, 0x1A);
+    AGS10_TEST_EQ(found[0][1].addr, 0);
+}
+
+/**
+ * @brief Two parts on one address answer as one: two AGS10s are found
+ *        once, and a decoy answering first hides the AGS10 behind it.
+ */
+static void test_conflicts(void)
+{
+    static const uint8_t addrs[] = { 0x1AU, 0x1AU, 0x30U, 0x30U };
+    static const uint8_t kinds[] = {
+        AGS10_SIM_AGS10, AGS10_SIM_AGS10, AGS10_SIM_DECOY_REGISTERS, AGS10_SIM_AGS10,
+    };
+
+    bus_make(0, addrs, kinds, 4);
+    AGS10_TEST_EQ(ags10_scan_bus(&scans[0]), AGS10_OK);
+    AGS10_TEST_EQ(scans[0].acked, 2);
+    AGS10_TEST_EQ(scans[0].found, 1);
+    AGS10_TEST_EQ(scans[0].rejected, 1);
+    AGS10_TEST_EQ(found[0][0].addr, 0x1A);
+
+    // a powered-off part does not answer, its twin still does
+    ags10_sim_device_power(&sims[0], &devices[0][0], false);
+    ags10_sim_device_power(&sims[0], &devices[0][2], false);
+    AGS10_TEST_EQ(ags10_scan_bus(&scans[0]), AGS10_OK);
+    AGS10_TEST_EQ(scans[0].acked, 2);
+    AGS10_TEST_EQ(scans[0].found, 2);
+    AGS10_TEST_EQ(found[0][1].addr, 0x30);
+}
+
+/**
+ * @brief Addresses that NACK every probe or every data byte: nothing is
+ *        read from them, and an empty bus costs the probes alone.
+ */
+static void test_nack_only(void)
+{
+    static const uint8_t addrs[] = { 0x08U, 0x50U, 0x77U };
+    static const uint8_t kinds[] = {
+        AGS10_SIM_DECOY_ADDR_ONLY, AGS10_SIM_DECOY_ADDR_ONLY, AGS10_SIM_DECOY_ADDR_ONLY,
+    };
+
+    bus_make(0, addrs, kinds, 0);
+    AGS10_TEST_EQ(ags10_scan_bus(&scans[0]), AGS10_OK);
+    AGS10_TEST_EQ(scans[0].acked, 0);
+    AGS10_TEST_EQ(sims[0].transfers, TEST_PROBES);
+    AGS10_TEST_EQ(sims[0].nacks, TEST_PROBES);
+    AGS10_TEST_EQ(scans[0].confirm_ms, 0);
+
+    // both ends of the range acknowledge, then refuse their pointers
+    bus_make(0, addrs, kinds, 3);
+    AGS10_TEST_EQ(ags10_scan_bus(&scans[0]), AGS10_OK);
+    AGS10_TEST_EQ(scans[0].acked, 3);
+    AGS10_TEST_EQ(scans[0].rejected, 3);
+    AGS10_TEST_EQ(scans[0].found, 0);
+    AGS10_TEST_EQ(sims[0].transfers, TEST_PROBES + 3U);
+
+    // a stuck bus ends the probe pass at its first timeout
+    bus_make(0, addrs, kinds, 3);
+    ags10_sim_bus_stuck(&sims[0]);
+    AGS10_TEST_EQ(ags10_scan_bus(&scans[0]), AGS10_ERR_BUSY);
+    AGS10_TEST_EQ(scans[0].last_status, AGS10_ERR_BUSY);
+    AGS10_TEST_EQ(scans[0].probes, 1);
+    AGS10_TEST_EQ(scans[0].acked, 0);
+}
+
+/**
+ * @brief Several buses from one thread: every AGS10 found, and a stuck bus
+ *        skipped without holding the others up.
+ */
+static void test_buses(void)
+{
+    static const uint8_t addrs[] = { 0x10U, 0x11U, 0x12U, 0x40U };
+    static const uint8_t kinds[] = {
+        AGS10_SIM_AGS10, AGS10_SIM_AGS10, AGS10_SIM_AGS10, AGS10_SIM_DECOY_FLOATING,
+    };
+
+    for (uint16_t b = 0; b < TEST_BUSES; b++)
+    {
+        bus_make(b, addrs, kinds, (uint16_t)(b + 2U));
+    }
+    ags10_sim_bus_stuck(&sims[1]);
+
+    AGS10_TEST_EQ(ags10_scan(scans, TEST_BUSES), 2U + 3U);
+    AGS10_TEST_EQ(scans[0].found, 2);
+    AGS10_TEST_EQ(scans[1].last_status, AGS10_ERR_BUSY);
+    AGS10_TEST_EQ(scans[1].found, 0);
+    AGS10_TEST_EQ(scans[2].found, 3);
+    AGS10_TEST_EQ(scans[2].rejected, 1);
+}
+
+/**
+ * @brief A bus that holds the last pointer back gets it sent through its
+ *        flush op before the wait; a failed flush rejects that address.
+ */
+static void test_flush(void)
+{
+    static const uint8_t addrs[] = { 0x1AU, 0x1BU, 0x1CU };
+    static const uint8_t kinds[] = { AGS10_SIM_AGS10, AGS10_SIM_AGS10, AGS10_SIM_AGS10 };
+
+    bus_make(0, addrs, kinds, 3);
+    hold = (TestHoldBusTypeDef){ .p_sim = &sims[0] };
+    AGS10_TEST_CHECK(ags10_scan_bus_init(&scans[0], &hold_ops, &hold, found[0], TEST_MAX_FOUND));
+
+    // without the flush the last pointer would go out with its read, too early
+    AGS10_TEST_EQ(ags10_scan_bus(&scans[0]), AGS10_OK);
+    AGS10_TEST_EQ(hold.flushes, 1);
+    AGS10_TEST_EQ(scans[0].found, 3);
+    AGS10_TEST_EQ(scans[0].rejected, 0);
+
+    uint32_t transfers = sims[0].transfers;
+
+    hold.flush_fails = true;
+    AGS10_TEST_EQ(ags10_scan_bus(&scans[0]), AGS10_OK);
+    AGS10_TEST_EQ(hold.flushes, 2);
+    AGS10_TEST_EQ(scans[0].found, 2);
+    AGS10_TEST_EQ(scans[0].rejected, 1);
+    AGS10_TEST_EQ(found[0][1].addr, 0x1B);
+    AGS10_TEST_EQ(sims[0].transfers - transfers, TEST_PROBES + 2U + 2U);
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    test_init();
+    test_decoys();
+    test_conflicts();
+    test_nack_only();
+    test_buses();
+    test_flush();
+
+    return ags10_test_done("scan");
+}
+
+// eof
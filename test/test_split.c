@@ -0,0 +1,230 @@
+/**
+ * @file test_split.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief The split-phase read state machine driven directly: start, ready
+ *        and finish against a fake tick, on an in-memory bus.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10.h"
+#include "ags10_test.h"
+
+#include <stddef.h>
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define TEST_ADDR       0x1AU
+#define TEST_DELAY_MS   30U
+#define TEST_TICK_WRAP  0xFFFFFFF0U     /**< A start 16 ms before the tick wraps. */
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+/**
+ * @brief Bus that answers at once with a fixed frame and counts transfers.
+ */
+typedef struct {
+    uint8_t frame[AGS10MA_FRAME_LEN];
+    AGS10_StatusTypeDef write_status;
+    AGS10_StatusTypeDef read_status;
+    uint32_t writes;
+    uint32_t reads;
+    uint32_t delays;
+} TestBusTypeDef;
+
+static TestBusTypeDef mem;
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static AGS10_StatusTypeDef mem_write(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length)
+{
+    TestBusTypeDef *p_bus = p_ctx;
+
+    (void)addr;
+    (void)pData;
+    (void)length;
+    p_bus->writes++;
+
+    return p_bus->write_status;
+}
+
+static AGS10_StatusTypeDef mem_read(void *p_ctx, uint8_t addr, uint8_t *pData, uint16_t length)
+{
+    TestBusTypeDef *p_bus = p_ctx;
+
+    (void)addr;
+    p_bus->reads++;
+    for (uint16_t idx = 0; (idx < length) && (idx < AGS10MA_FRAME_LEN); idx++)
+    {
+        pData[idx] = p_bus->frame[idx];
+    }
+
+    return p_bus->read_status;
+}
+
+static void mem_delay(void *p_ctx, uint16_t ms)
+{
+    (void)ms;
+    ((TestBusTypeDef *)p_ctx)->delays++;
+}
+
+static const AGS10_BusOpsTypeDef mem_ops = {
+    .write = mem_write,
+    .read = mem_read,
+    .delay = mem_delay,
+};
+
+static void test_setup(AGS10_HandleTypeDef *ph_sensor, uint32_t value)
+{
+    mem = (TestBusTypeDef){ 0 };
+    mem.frame[0] = (uint8_t)(value >> 24);
+    mem.frame[1] = (uint8_t)(value >> 16);
+    mem.frame[2] = (uint8_t)(value >> 8);
+    mem.frame[3] = (uint8_t)value;
+    mem.frame[AGS10MA_DATA_LEN] = ags10_crc8(mem.frame, AGS10MA_DATA_LEN);
+    AGS10_TEST_EQ(ags10_init(ph_sensor, TEST_ADDR, &mem_ops, &mem), AGS10_OK);
+}
+
+/**
+ * @brief ready() follows the caller's tick only, including across its wrap.
+ */
+static void test_ready(uint32_t start_ms)
+{
+    AGS10_HandleTypeDef sensor;
+    uint32_t value = 0;
+
+    test_setup(&sensor, 0x0000012CU);
+    AGS10_TEST_CHECK(!ags10_register_read_ready(&sensor, start_ms));
+
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_TVOC_STAT_REG, TEST_DELAY_MS, start_ms), AGS10_OK);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_CONVERTING);
+    AGS10_TEST_EQ(mem.writes, 1);
+    AGS10_TEST_EQ(ags10_register_read_wait_ms(&sensor, start_ms), TEST_DELAY_MS);
+
+    // a second read on the same handle waits for this one
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_VERSION_REG, TEST_DELAY_MS, start_ms), AGS10_ERR_BUSY);
+    AGS10_TEST_EQ(ags10_address_set(&sensor, 0x20U), AGS10_ERR_BUSY);
+    AGS10_TEST_EQ(mem.writes, 1);
+
+    for (uint32_t ms = 0; ms < TEST_DELAY_MS; ms++)
+    {
+        AGS10_TEST_CHECK(!ags10_register_read_ready(&sensor, start_ms + ms));
+    }
+    AGS10_TEST_EQ(ags10_register_read_wait_ms(&sensor, start_ms + TEST_DELAY_MS - 1U), 1);
+    AGS10_TEST_CHECK(ags10_register_read_ready(&sensor, start_ms + TEST_DELAY_MS));
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_READY);
+    AGS10_TEST_CHECK(ags10_register_read_ready(&sensor, start_ms + TEST_DELAY_MS + 1000U));
+    AGS10_TEST_EQ(mem.reads, 0);
+
+    AGS10_TEST_EQ(ags10_register_read_finish(&sensor, &value), AGS10_OK);
+    AGS10_TEST_EQ(value, 0x0000012CU);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_IDLE);
+    AGS10_TEST_EQ(mem.reads, 1);
+    AGS10_TEST_EQ(mem.delays, 0);
+}
+
+/**
+ * @brief finish() outside a transaction, and transactions that fail.
+ */
+static void test_wrong_state(void)
+{
+    AGS10_HandleTypeDef sensor;
+    uint32_t value = 0xA5A5A5A5U;
+
+    test_setup(&sensor, 0x0000012CU);
+
+    // nothing started: no transfer, value untouched, the handle stays idle
+    AGS10_TEST_EQ(ags10_register_read_finish(&sensor, &value), AGS10_ERR_PARAM);
+    AGS10_TEST_EQ(value, 0xA5A5A5A5U);
+    AGS10_TEST_EQ(ags10_register_read_poll(&sensor, 0, &value), AGS10_XFER_ERROR);
+    AGS10_TEST_EQ(sensor.last_status, AGS10_ERR_PARAM);
+    AGS10_TEST_EQ(mem.reads, 0);
+
+    // collected twice: the second finish() has nothing to collect
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_TVOC_STAT_REG, TEST_DELAY_MS, 0), AGS10_OK);
+    AGS10_TEST_EQ(ags10_register_read_finish(&sensor, NULL), AGS10_ERR_PARAM);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_CONVERTING);
+    AGS10_TEST_EQ(ags10_register_read_finish(&sensor, &value), AGS10_OK);
+    AGS10_TEST_EQ(ags10_register_read_finish(&sensor, &value), AGS10_ERR_PARAM);
+
+    // abort() drops a read without touching the bus
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_TVOC_STAT_REG, TEST_DELAY_MS, 0), AGS10_OK);
+    ags10_register_read_abort(&sensor);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_IDLE);
+    AGS10_TEST_EQ(ags10_register_read_finish(&sensor, &value), AGS10_ERR_PARAM);
+    AGS10_TEST_EQ(mem.reads, 1);
+
+    // without a retry policy a failed pointer write ends the read in start()
+    mem.write_status = AGS10_ERR_NACK;
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_TVOC_STAT_REG, TEST_DELAY_MS, 0), AGS10_ERR_NACK_WRITE);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_IDLE);
+    AGS10_TEST_CHECK(!ags10_register_read_ready(&sensor, TEST_DELAY_MS));
+    mem.write_status = AGS10_OK;
+
+    // a bad frame or a NACKed read ends in finish(), and the handle is free again
+    mem.frame[AGS10MA_DATA_LEN] ^= 0x01U;
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_TVOC_STAT_REG, TEST_DELAY_MS, 0), AGS10_OK);
+    AGS10_TEST_CHECK(ags10_register_read_ready(&sensor, TEST_DELAY_MS));
+    AGS10_TEST_EQ(ags10_register_read_finish(&sensor, &value), AGS10_ERR_CRC);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_IDLE);
+    mem.frame[AGS10MA_DATA_LEN] ^= 0x01U;
+
+    mem.read_status = AGS10_ERR_NACK;
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_TVOC_STAT_REG, TEST_DELAY_MS, 0), AGS10_OK);
+    AGS10_TEST_EQ(ags10_register_read_finish(&sensor, &value), AGS10_ERR_NACK_READ);
+    AGS10_TEST_EQ(sensor.last_status, AGS10_ERR_NACK_READ);
+    mem.read_status = AGS10_OK;
+
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_TVOC_STAT_REG, TEST_DELAY_MS, 0), AGS10_OK);
+    AGS10_TEST_EQ(ags10_register_read_finish(&sensor, &value), AGS10_OK);
+    AGS10_TEST_EQ(value, 0x0000012CU);
+
+    // NULL handles are refused everywhere
+    AGS10_TEST_EQ(ags10_register_read_start(NULL, AGS10MA_TVOC_STAT_REG, TEST_DELAY_MS, 0), AGS10_ERR_PARAM);
+    AGS10_TEST_CHECK(!ags10_register_read_ready(NULL, 0));
+    AGS10_TEST_EQ(ags10_register_read_finish(NULL, &value), AGS10_ERR_PARAM);
+}
+
+/**
+ * @brief poll() reaches the same result as ready() and finish().
+ */
+static void test_poll(void)
+{
+    AGS10_HandleTypeDef sensor;
+    uint32_t value = 0;
+    uint32_t now_ms = TEST_TICK_WRAP;
+
+    test_setup(&sensor, 0x0B000000U);
+    AGS10_TEST_EQ(ags10_register_read_start(&sensor, AGS10MA_VERSION_REG, TEST_DELAY_MS, now_ms), AGS10_OK);
+    while (AGS10_XFER_PENDING == ags10_register_read_poll(&sensor, now_ms, &value))
+    {
+        AGS10_TEST_EQ(mem.reads, 0);
+        now_ms++;
+    }
+    AGS10_TEST_EQ(now_ms - TEST_TICK_WRAP, TEST_DELAY_MS);
+    AGS10_TEST_EQ(value, 0x0B000000U);
+    AGS10_TEST_EQ(sensor.last_status, AGS10_OK);
+    AGS10_TEST_EQ(sensor.xfer_state, AGS10_XFER_IDLE);
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    test_ready(1000U);
+    test_ready(TEST_TICK_WRAP);
+    test_wrong_state();
+    test_poll();
+
+    return ags10_test_done("split");
+}
+
+// eof
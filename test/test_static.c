@@ -0,0 +1,143 @@
+/**
+ * @file test_static.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief The driver built with AGS10_STATIC_BUS_HEADER: CRC, reads and a
+ *        stuck bus through the static functions of ags10_static_sim_bus.h.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10.h"
+#include "ags10_sim.h"
+#include "ags10_test.h"
+
+#ifndef AGS10_STATIC_BUS_HEADER
+#error "test_static must be built with -DAGS10_STATIC_BUS_HEADER"
+#endif
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define TEST_ADDR       0x1AU
+#define TEST_READS      2000U
+#define TEST_TVOC_PPB   300U
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static AGS10_SimDeviceTypeDef device;
+static AGS10_SimBusTypeDef bus;
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+/* No ops table at all: the driver must only go through the static bus. */
+static void test_setup(AGS10_HandleTypeDef *ph_sensor)
+{
+    ags10_sim_device_init(&device, TEST_ADDR);
+    device.tvoc_ppb = TEST_TVOC_PPB;
+    ags10_sim_bus_init(&bus, &device, 1, AGS10_SIM_DEFAULT_CLOCK_HZ);
+    ags10_sim_advance_us(&bus, (uint64_t)AGS10_SIM_PREHEAT_MS * 1000U);
+    AGS10_TEST_EQ(ags10_init(ph_sensor, TEST_ADDR, NULL, &bus), AGS10_OK);
+}
+
+static void test_read(void)
+{
+    static const uint8_t beef[2] = {0xBE, 0xEF};
+    AGS10_HandleTypeDef sensor;
+    uint32_t value = 0;
+
+    AGS10_TEST_EQ(ags10_crc8(beef, 2), 0x92);
+
+    test_setup(&sensor);
+    AGS10_TEST_EQ(ags10_firmware_version_get(&sensor, &value), AGS10_OK);
+    AGS10_TEST_EQ(value, AGS10_SIM_VERSION);
+
+    // the blocking wait goes through ags10_bus_delay()
+    uint64_t start_us = bus.now_us;
+
+    AGS10_TEST_EQ(ags10_tvoc_get(&sensor, &value), AGS10_OK);
+    AGS10_TEST_EQ(value, TEST_TVOC_PPB);
+    AGS10_TEST_CHECK((bus.now_us - start_us) >= (AGS10MA_TVOC_DELAY_MS * 1000U));
+    AGS10_TEST_EQ(bus.transfers, 4);
+}
+
+/*
+ * A clock past clean_hz corrupts frames and loses addresses: every frame
+ * accepted must be the right one, and the failures carry the sim's tick.
+ */
+static void test_crc(void)
+{
+    AGS10_HandleTypeDef sensor;
+    AGS10_StatsTypeDef stats;
+    uint32_t good = 0;
+    uint32_t wrong = 0;
+    uint32_t crc_fail = 0;
+    uint32_t nack_read = 0;
+    uint32_t nack_write = 0;
+
+    test_setup(&sensor);
+    bus.clean_hz = AGS10_SIM_DEFAULT_CLOCK_HZ / 2U;
+    bus.fail_hz = AGS10_SIM_DEFAULT_CLOCK_HZ * 2U;
+    bus.seed = 7;
+
+    for (uint32_t n = 0; n < TEST_READS; n++)
+    {
+        uint32_t value = 0;
+        AGS10_StatusTypeDef status = ags10_firmware_version_get(&sensor, &value);
+
+        good += (AGS10_OK == status) ? 1U : 0U;
+        wrong += ((AGS10_OK == status) && (AGS10_SIM_VERSION != value)) ? 1U : 0U;
+        crc_fail += (AGS10_ERR_CRC == status) ? 1U : 0U;
+        nack_read += (AGS10_ERR_NACK_READ == status) ? 1U : 0U;
+        nack_write += (AGS10_ERR_NACK_WRITE == status) ? 1U : 0U;
+    }
+
+    AGS10_TEST_EQ(wrong, 0);
+    AGS10_TEST_CHECK(crc_fail > 0U);
+    AGS10_TEST_CHECK(nack_read > 0U);
+    AGS10_TEST_EQ(good + crc_fail + nack_read + nack_write, TEST_READS);
+    AGS10_TEST_EQ(ags10_stats_get(&sensor, &stats), AGS10_OK);
+    AGS10_TEST_EQ(stats.crc_fail, crc_fail);
+    // the blocking API's own clock starts at 0, the sim's is past preheat
+    AGS10_TEST_CHECK(stats.last_error_ms > AGS10_SIM_PREHEAT_MS);
+    AGS10_TEST_CHECK(stats.last_error_ms <= ags10_sim_tick_ms(&bus));
+}
+
+static void test_stuck(void)
+{
+    AGS10_HandleTypeDef sensor;
+    uint32_t value = 0;
+
+    test_setup(&sensor);
+    ags10_sim_bus_stuck(&bus);
+
+    uint64_t start_us = bus.now_us;
+
+    AGS10_TEST_EQ(ags10_firmware_version_get(&sensor, &value), AGS10_ERR_BUSY);
+    AGS10_TEST_EQ(bus.now_us - start_us, AGS10_SIM_BUSY_TIMEOUT_MS * 1000U);
+    AGS10_TEST_EQ(bus.stuck_rejects, 1);
+    AGS10_TEST_EQ(bus.transfers, 0);
+
+    AGS10_TEST_CHECK(ags10_sim_bus_recover(&bus));
+    AGS10_TEST_EQ(ags10_firmware_version_get(&sensor, &value), AGS10_OK);
+    AGS10_TEST_EQ(value, AGS10_SIM_VERSION);
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    test_read();
+    test_crc();
+    test_stuck();
+
+    return ags10_test_done("static");
+}
+
+// eof
@@ -0,0 +1,155 @@
+/**
+ * @file test_stuck.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief A bus stuck with SDA low, injected with ags10_sim_bus_stuck(): what
+ *        the driver reports, what it costs and how reads resume.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10.h"
+#include "ags10_sim.h"
+#include "ags10_test.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define TEST_ADDR       0x1AU
+#define TEST_WINDOWS    6U          /**< One-second windows, the fault in the third. */
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static AGS10_SimDeviceTypeDef device;
+static AGS10_SimBusTypeDef bus;
+
+static const AGS10_RetryPolicyTypeDef policy = {
+    .max_attempts = 3,
+    .reread = true,
+    .backoff_ms = 2,
+    .backoff_max_ms = 8,
+};
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static void test_setup(AGS10_HandleTypeDef *ph_sensor)
+{
+    ags10_sim_device_init(&device, TEST_ADDR);
+    ags10_sim_bus_init(&bus, &device, 1, AGS10_SIM_DEFAULT_CLOCK_HZ);
+    ags10_sim_advance_us(&bus, (uint64_t)AGS10_SIM_PREHEAT_MS * 1000U);
+    (void)ags10_init(ph_sensor, TEST_ADDR, &ags10_sim_bus_ops, &bus);
+}
+
+static void test_fault(void)
+{
+    AGS10_HandleTypeDef sensor;
+    uint32_t value = 0;
+
+    test_setup(&sensor);
+    ags10_sim_bus_stuck(&bus);
+
+    // each transfer waits out the HAL busy timeout and touches nothing
+    uint64_t start_us = bus.now_us;
+
+    AGS10_TEST_EQ(ags10_firmware_version_get(&sensor, &value), AGS10_ERR_BUSY);
+    AGS10_TEST_EQ(bus.now_us - start_us, AGS10_SIM_BUSY_TIMEOUT_MS * 1000U);
+    AGS10_TEST_EQ(bus.stuck_rejects, 1);
+    AGS10_TEST_EQ(bus.transfers, 0);
+
+    // retries only multiply the cost: 3 timeouts and 2 + 4 ms of backoff
+    AGS10_TEST_EQ(ags10_retry_policy_set(&sensor, &policy), AGS10_OK);
+    start_us = bus.now_us;
+    AGS10_TEST_EQ(ags10_firmware_version_get(&sensor, &value), AGS10_ERR_BUSY);
+    AGS10_TEST_EQ(bus.now_us - start_us, ((3U * AGS10_SIM_BUSY_TIMEOUT_MS) + 6U) * 1000U);
+    AGS10_TEST_EQ(bus.stuck_rejects, 4);
+
+    // nine clocks and a STOP free it, at the cost of 11 SCL periods
+    start_us = bus.now_us;
+    AGS10_TEST_CHECK(ags10_sim_bus_recover(&bus));
+    AGS10_TEST_EQ(bus.now_us - start_us, (AGS10_SIM_RECOVER_CLOCKS * 1000000U) / AGS10_SIM_DEFAULT_CLOCK_HZ);
+    AGS10_TEST_EQ(bus.recoveries, 1);
+    AGS10_TEST_EQ(ags10_firmware_version_get(&sensor, &value), AGS10_OK);
+    AGS10_TEST_EQ(value, AGS10_SIM_VERSION);
+
+    // on a free bus the sequence is harmless and not counted
+    AGS10_TEST_CHECK(!ags10_sim_bus_recover(&bus));
+    AGS10_TEST_EQ(bus.recoveries, 1);
+    AGS10_TEST_EQ(ags10_firmware_version_get(&sensor, &value), AGS10_OK);
+}
+
+/* Reads back to back for TEST_WINDOWS s, with the bus stuck 2 s in. */
+static void test_run(bool recover, uint32_t *p_reads)
+{
+    AGS10_HandleTypeDef sensor;
+    uint32_t value;
+
+    test_setup(&sensor);
+    (void)ags10_retry_policy_set(&sensor, &policy);
+
+    uint64_t start_us = bus.now_us;
+    bool injected = false;
+
+    for (uint32_t idx = 0; idx < TEST_WINDOWS; idx++)
+    {
+        p_reads[idx] = 0;
+    }
+
+    while ((bus.now_us - start_us) < (TEST_WINDOWS * 1000000ULL))
+    {
+        uint32_t window = (uint32_t)((bus.now_us - start_us) / 1000000U);
+
+        if ((2U == window) && !injected)
+        {
+            ags10_sim_bus_stuck(&bus);
+            injected = true;
+        }
+
+        AGS10_StatusTypeDef status = ags10_firmware_version_get(&sensor, &value);
+
+        if (AGS10_OK == status)
+        {
+            p_reads[window]++;
+        }
+        else if (recover && (AGS10_ERR_BUSY == status))
+        {
+            (void)ags10_sim_bus_recover(&bus);
+        }
+    }
+}
+
+static void test_throughput(void)
+{
+    uint32_t reads[TEST_WINDOWS];
+
+    // without recovery nothing gets through after the fault
+    test_run(false, reads);
+    AGS10_TEST_CHECK(reads[1] >= 25U);
+    AGS10_TEST_EQ(reads[3] + reads[4] + reads[5], 0);
+
+    // with it, one failed read and the rate is back within the window
+    test_run(true, reads);
+    AGS10_TEST_EQ(bus.recoveries, 1);
+    for (uint32_t idx = 0; idx < TEST_WINDOWS; idx++)
+    {
+        AGS10_TEST_CHECK(reads[idx] >= 25U);
+    }
+    printf("stuck: reads per second with recovery: %u %u %u %u %u %u\n",
+           reads[0], reads[1], reads[2], reads[3], reads[4], reads[5]);
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    test_fault();
+    test_throughput();
+
+    return ags10_test_done("stuck");
+}
+// eof
@@ -0,0 +1,202 @@
+/**
+ * @file test_tvoc.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief Readiness-driven TVOC polling on the simulator: the warm-up, fresh
+ *        and stale samples, the learnt period and the backoff after failures.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10.h"
+#include "ags10_sim.h"
+#include "ags10_test.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#define TEST_ADDR           0x1AU
+#define TEST_ELSEWHERE      0x50U       /**< Address the device moves to, to NACK. */
+#define TEST_TVOC_PPB       300U
+#define TEST_RUN_MS         30000U
+#define TEST_FAIL_MS        5000U
+#define TEST_LATE_MS        (2U * AGS10MA_TVOC_POLL_MIN_MS + 10U)   /**< Edge step plus one read. */
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static AGS10_SimDeviceTypeDef device;
+static AGS10_SimBusTypeDef bus;
+static AGS10_HandleTypeDef sensor;
+static AGS10_TvocSampleTypeDef sample;
+
+/**
+ * @brief What a stretch of polling saw.
+ */
+typedef struct {
+    uint32_t fresh;
+    uint32_t reads;             /**< Reads that ended, fresh, stale or failed. */
+    uint32_t failed;
+    uint32_t stale;
+    uint32_t preheating;        /**< Successful reads that reported preheating. */
+    uint32_t wrong;             /**< Samples with a wrong value, age or flag. */
+    uint32_t max_late_ms;       /**< Longest a fresh value waited, from the 4th on. */
+} TestRunTypeDef;
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+/* When the sim's current sample was taken, in ms of virtual time. */
+static uint32_t test_sample_ms(void)
+{
+    uint32_t up_ms = ags10_sim_tick_ms(&bus) - (uint32_t)(device.power_on_us / 1000U);
+
+    return (uint32_t)(device.power_on_us / 1000U) + AGS10_SIM_PREHEAT_MS +
+           (((up_ms - AGS10_SIM_PREHEAT_MS) / AGS10_SIM_SAMPLE_MS) * AGS10_SIM_SAMPLE_MS);
+}
+
+/*
+ * Calls ags10_tvoc_poll() every millisecond for run_ms. A read has ended
+ * whenever the handle moves its next read time.
+ */
+static void test_run(uint32_t run_ms, TestRunTypeDef *p_run)
+{
+    uint32_t end_ms = ags10_sim_tick_ms(&bus) + run_ms;
+
+    *p_run = (TestRunTypeDef){ 0 };
+
+    while ((int32_t)(ags10_sim_tick_ms(&bus) - end_ms) < 0)
+    {
+        uint32_t now_ms = ags10_sim_tick_ms(&bus);
+        uint32_t next_ms = sensor.tvoc_next_ms;
+        bool fresh = ags10_tvoc_poll(&sensor, now_ms, &sample);
+
+        if (fresh)
+        {
+            uint32_t late_ms = ags10_sim_tick_ms(&bus) - test_sample_ms();
+
+            p_run->fresh++;
+            p_run->wrong += ((TEST_TVOC_PPB != sample.tvoc_ppb) || (0U != sample.age_ms) ||
+                             sample.preheating) ? 1U : 0U;
+            if ((p_run->fresh > 3U) && (late_ms > p_run->max_late_ms))
+            {
+                p_run->max_late_ms = late_ms;
+            }
+        }
+
+        if (next_ms != sensor.tvoc_next_ms)
+        {
+            p_run->reads++;
+            if (AGS10_OK != sensor.last_status)
+            {
+                p_run->failed++;
+            }
+            else if (!fresh)
+            {
+                p_run->stale++;
+                p_run->preheating += sample.preheating ? 1U : 0U;
+            }
+        }
+
+        ags10_sim_advance_us(&bus, 1000U);
+    }
+}
+
+/**
+ * @brief Nothing is fresh during the warm-up, and the reads back off to
+ *        the longest step.
+ */
+static void test_preheat(void)
+{
+    TestRunTypeDef run;
+
+    test_run(AGS10_SIM_PREHEAT_MS - 1000U, &run);
+
+    AGS10_TEST_EQ(run.fresh, 0);
+    AGS10_TEST_EQ(run.failed, 0);
+    AGS10_TEST_EQ(run.preheating, run.stale);
+    AGS10_TEST_EQ(sample.age_ms, UINT32_MAX);
+    AGS10_TEST_EQ(sample.tvoc_ppb, 0);
+    AGS10_TEST_EQ(sensor.tvoc_backoff_ms, AGS10MA_TVOC_POLL_MAX_MS);
+    AGS10_TEST_CHECK(run.reads <= ((AGS10_SIM_PREHEAT_MS / AGS10MA_TVOC_POLL_MAX_MS) + 10U));
+}
+
+/**
+ * @brief Every sample arrives once and soon after it is taken, with few
+ *        stale reads in between once the period is learnt.
+ */
+static void test_fresh(void)
+{
+    TestRunTypeDef run;
+
+    test_run(TEST_RUN_MS, &run);
+
+    AGS10_TEST_CHECK(run.fresh >= (TEST_RUN_MS / AGS10_SIM_SAMPLE_MS));
+    AGS10_TEST_CHECK(run.fresh <= ((TEST_RUN_MS / AGS10_SIM_SAMPLE_MS) + 1U));
+    AGS10_TEST_EQ(run.wrong, 0);
+    AGS10_TEST_EQ(run.failed, 0);
+    AGS10_TEST_EQ(run.preheating, 0);
+    AGS10_TEST_CHECK(run.max_late_ms <= TEST_LATE_MS);
+    AGS10_TEST_CHECK(run.stale <= (4U * run.fresh));
+    AGS10_TEST_CHECK(sensor.tvoc_period_ms >= (AGS10_SIM_SAMPLE_MS - AGS10MA_TVOC_POLL_MIN_MS));
+    AGS10_TEST_CHECK(sensor.tvoc_period_ms <= (AGS10_SIM_SAMPLE_MS + AGS10MA_TVOC_POLL_MIN_MS));
+
+    // a stale read still updates the sample, with its age
+    AGS10_TEST_CHECK(!sample.fresh);
+    AGS10_TEST_EQ(sample.tvoc_ppb, TEST_TVOC_PPB);
+    AGS10_TEST_CHECK(sample.age_ms < AGS10_SIM_SAMPLE_MS);
+}
+
+/**
+ * @brief Failed reads back off like stale ones, and the first fresh value
+ *        afterwards resets the step.
+ */
+static void test_failures(void)
+{
+    TestRunTypeDef run;
+
+    device.addr = TEST_ELSEWHERE;
+    test_run(TEST_FAIL_MS, &run);
+
+    // 30, 60, 120, 240, 480 ms, then every 500 ms
+    AGS10_TEST_EQ(run.fresh, 0);
+    AGS10_TEST_EQ(run.failed, run.reads);
+    AGS10_TEST_EQ(sensor.last_status, AGS10_ERR_NACK_WRITE);
+    AGS10_TEST_EQ(sensor.tvoc_backoff_ms, AGS10MA_TVOC_POLL_MAX_MS);
+    AGS10_TEST_CHECK(run.reads >= 8U);
+    AGS10_TEST_CHECK(run.reads <= 16U);
+
+    device.addr = TEST_ADDR;
+    test_run(AGS10_SIM_SAMPLE_MS + AGS10MA_TVOC_POLL_MAX_MS + 100U, &run);
+    AGS10_TEST_CHECK(run.fresh >= 1U);
+    AGS10_TEST_EQ(run.wrong, 0);
+    AGS10_TEST_EQ(sensor.last_status, AGS10_OK);
+    AGS10_TEST_CHECK(sensor.tvoc_backoff_ms < AGS10MA_TVOC_POLL_MAX_MS);
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    ags10_sim_device_init(&device, TEST_ADDR);
+    device.tvoc_ppb = TEST_TVOC_PPB;
+    ags10_sim_bus_init(&bus, &device, 1, AGS10_SIM_DEFAULT_CLOCK_HZ);
+    AGS10_TEST_EQ(ags10_init(&sensor, TEST_ADDR, &ags10_sim_bus_ops, &bus), AGS10_OK);
+
+    AGS10_TEST_CHECK(!ags10_tvoc_poll(NULL, 0, &sample));
+    AGS10_TEST_CHECK(!ags10_tvoc_poll(&sensor, 0, NULL));
+
+    test_preheat();
+    // across the end of the warm-up into steady updates
+    ags10_sim_advance_us(&bus, 1000000U);
+    test_fresh();
+    test_failures();
+
+    return ags10_test_done("tvoc");
+}
+
+// eof
@@ -0,0 +1,235 @@
+/**
+ * @file test_wheel.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief The timer wheel against a reference model: random adds, cancels and
+ *        advances across a tick wrap, each timer expiring on its own tick.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ags10_wheel.h"
+#include "ags10_test.h"
+
+/*******************************************************************************
+* Defines
+ ******************************************************************************/
+#ifndef TEST_WHEEL_NAME
+#define TEST_WHEEL_NAME     "wheel"
+#endif
+
+#define TEST_TIMERS         4096U
+#define TEST_STEPS          1000000U
+#define TEST_T0_MS          0xFFFFF000U     /**< Wraps a few seconds in. */
+#define TEST_PERIOD_MS      1000U
+#define TEST_PERIODS        100U
+
+/*******************************************************************************
+* Private Variables
+ ******************************************************************************/
+static AGS10_WheelTimerTypeDef slab[TEST_TIMERS];
+static AGS10_WheelTypeDef wheel;
+
+/* Reference model, by timer id */
+static bool ref_armed[TEST_TIMERS];
+static uint32_t ref_expires[TEST_TIMERS];
+static uint32_t ref_due[TEST_TIMERS];       /**< Tick it must expire on. */
+
+static uint32_t fired;
+static uint32_t wrong;                      /**< Expired on another tick, or not armed. */
+
+/*******************************************************************************
+* Private Function Definitions
+ ******************************************************************************/
+
+static void on_expire(void *p_ctx, uint32_t id, uint32_t arg, uint32_t expires_ms)
+{
+    (void)p_ctx;
+
+    if ((id >= TEST_TIMERS) || !ref_armed[id] || (arg != id) ||
+        (expires_ms != ref_expires[id]) || (wheel.now_ms != ref_due[id]))
+    {
+        wrong++;
+        return;
+    }
+
+    ref_armed[id] = false;
+    fired++;
+}
+
+/**
+ * @brief A deadline: mostly near, some within 5 s, some far beyond the
+ *        span, some already overdue.
+ */
+static uint32_t delay_pick(uint32_t *p_seed)
+{
+    uint32_t kind = ags10_test_rand(p_seed) % 10U;
+    uint32_t r = ags10_test_rand(p_seed);
+
+    if (kind < 5U)
+    {
+        return r % 64U;
+    }
+    if (kind < 8U)
+    {
+        return r % 5000U;
+    }
+
+    return (kind < 9U) ? (r % 40000000U) : (0U - (r % 100U));
+}
+
+static void test_random(void)
+{
+    uint32_t seed = 1;
+    uint32_t now = TEST_T0_MS;
+    uint32_t idle_late = 0;
+    uint32_t cancel_wrong = 0;
+
+    AGS10_TEST_CHECK(ags10_wheel_init(&wheel, slab, TEST_TIMERS, now));
+
+    for (uint32_t step = 0; step < TEST_STEPS; step++)
+    {
+        uint32_t op = ags10_test_rand(&seed) % 100U;
+
+        if (op < 40U)
+        {
+            uint32_t delay = delay_pick(&seed);
+            uint32_t id = ags10_wheel_add(&wheel, now + delay, 0);
+
+            if (AGS10_WHEEL_NONE == id)
+            {
+                continue;
+            }
+
+            // overdue or wrapped deadlines expire on the next tick
+            slab[id].arg = id;
+            ref_armed[id] = true;
+            ref_expires[id] = now + delay;
+            ref_due[id] = ((int32_t)delay > 0) ? (now + delay) : (now + 1U);
+            idle_late += (ags10_wheel_idle_ms(&wheel) > (ref_due[id] - now)) ? 1U : 0U;
+        }
+        else if (op < 50U)
+        {
+            uint32_t id = ags10_test_rand(&seed) % TEST_TIMERS;
+
+            cancel_wrong += (ags10_wheel_cancel(&wheel, id) != ref_armed[id]) ? 1U : 0U;
+            ref_armed[id] = false;
+        }
+        else
+        {
+            uint32_t idle = ags10_wheel_idle_ms(&wheel);
+            uint32_t target = (0U == (ags10_test_rand(&seed) % 3U)) ? idle : (ags10_test_rand(&seed) % 200U);
+
+            // never jump past a timer, so each must expire exactly on its tick
+            target = now + ((target > idle) ? idle : target);
+            if (0U != (ags10_test_rand(&seed) % 2U))
+            {
+                while (now != target)
+                {
+                    now++;
+                    (void)ags10_wheel_advance(&wheel, now, on_expire, NULL);
+                }
+            }
+            else
+            {
+                now = target;
+                (void)ags10_wheel_advance(&wheel, now, on_expire, NULL);
+            }
+        }
+    }
+
+    // drain, sleeping as long as the wheel allows each time
+    while (0U != wheel.count)
+    {
+        now += ags10_wheel_idle_ms(&wheel);
+        (void)ags10_wheel_advance(&wheel, now, on_expire, NULL);
+    }
+
+    uint32_t left = 0;
+
+    for (uint32_t id = 0; id < TEST_TIMERS; id++)
+    {
+        left += ref_armed[id] ? 1U : 0U;
+    }
+
+    AGS10_TEST_EQ(wrong, 0);
+    AGS10_TEST_EQ(idle_late, 0);
+    AGS10_TEST_EQ(cancel_wrong, 0);
+    AGS10_TEST_EQ(left, 0);
+    AGS10_TEST_CHECK(fired > (TEST_STEPS / 10U));
+    AGS10_TEST_EQ(ags10_wheel_idle_ms(&wheel), UINT32_MAX);
+}
+
+static void on_count(void *p_ctx, uint32_t id, uint32_t arg, uint32_t expires_ms)
+{
+    (void)id;
+    (void)arg;
+    (void)expires_ms;
+    (*(uint32_t *)p_ctx)++;
+}
+
+static void on_periodic(void *p_ctx, uint32_t id, uint32_t arg, uint32_t expires_ms)
+{
+    uint32_t *p_count = p_ctx;
+
+    (void)id;
+    wrong += (wheel.now_ms != expires_ms) ? 1U : 0U;
+    (*p_count)++;
+    if (*p_count < TEST_PERIODS)
+    {
+        (void)ags10_wheel_add(&wheel, expires_ms + TEST_PERIOD_MS, arg);
+    }
+}
+
+/**
+ * @brief A full slab, and a timer re-armed from its own callback.
+ */
+static void test_slab_and_rearm(void)
+{
+    AGS10_WheelTimerTypeDef small[4];
+    uint32_t periods = 0;
+    uint32_t now = TEST_T0_MS;
+
+    AGS10_TEST_CHECK(ags10_wheel_init(&wheel, small, 4U, now));
+    for (uint32_t idx = 0; idx < 4U; idx++)
+    {
+        AGS10_TEST_CHECK(AGS10_WHEEL_NONE != ags10_wheel_add(&wheel, now + 10U, idx));
+    }
+    AGS10_TEST_EQ(ags10_wheel_add(&wheel, now + 10U, 4U), AGS10_WHEEL_NONE);
+    AGS10_TEST_CHECK(ags10_wheel_cancel(&wheel, 2U));
+    AGS10_TEST_CHECK(!ags10_wheel_cancel(&wheel, 2U));
+    AGS10_TEST_EQ(ags10_wheel_add(&wheel, now + 10U, 4U), 2U);
+    AGS10_TEST_EQ(ags10_wheel_advance(&wheel, now + 9U, on_count, &periods), 0);
+    AGS10_TEST_EQ(ags10_wheel_advance(&wheel, now + 10U, on_count, &periods), 4);
+    AGS10_TEST_EQ(periods, 4);
+    AGS10_TEST_EQ(wheel.count, 0);
+
+    // periodic, no drift, across the tick wrap
+    periods = 0;
+    wrong = 0;
+    AGS10_TEST_CHECK(ags10_wheel_init(&wheel, small, 4U, now));
+    (void)ags10_wheel_add(&wheel, now + TEST_PERIOD_MS, 0);
+    while (0U != wheel.count)
+    {
+        now += ags10_wheel_idle_ms(&wheel);
+        (void)ags10_wheel_advance(&wheel, now, on_periodic, &periods);
+    }
+    AGS10_TEST_EQ(periods, TEST_PERIODS);
+    AGS10_TEST_EQ(wrong, 0);
+    AGS10_TEST_EQ(now, TEST_T0_MS + (TEST_PERIODS * TEST_PERIOD_MS));
+}
+
+/*******************************************************************************
+* Public Function Definitions
+ ******************************************************************************/
+
+int main(void)
+{
+    test_random();
+    test_slab_and_rearm();
+
+    return ags10_test_done(TEST_WHEEL_NAME);
+}
+
+// eof
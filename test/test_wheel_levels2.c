@@ -0,0 +1,16 @@
+/**
+ * @file test_wheel_levels2.c
+ * @author emirsatlm (emir@satlm.dev)
+ * @brief test_wheel.c again, built with two levels (see the Makefile), so
+ *        a 4 s span and many deadlines parked beyond it.
+ * @version 0.3
+ * @date 2025-19-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#define TEST_WHEEL_NAME     "wheel levels 2"
+
+#include "test_wheel.c"
+
+// eof